@@ -0,0 +1,860 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "oskar_kernel_benchmark.h"
+
+#include "correlate/oskar_auto_correlate.h"
+#include "correlate/oskar_cross_correlate.h"
+#include "imager/oskar_grid_wproj2.h"
+#include "interferometer/oskar_evaluate_jones_K.h"
+#include "interferometer/oskar_jones.h"
+#include "math/oskar_cmath.h"
+#include "math/oskar_dftw.h"
+#include "math/oskar_fft.h"
+#include "sky/oskar_sky.h"
+#include "splines/oskar_splines.h"
+#include "splines/private_splines.h"
+#include "telescope/oskar_telescope.h"
+#include "telescope/station/element/private_element.h"
+#include "telescope/station/element/oskar_element.h"
+#include "telescope/station/oskar_station_work.h"
+
+#include <cstdlib>
+#include <vector>
+
+#define FREQ_HZ 100e6
+
+namespace oskar {
+
+KernelBenchmark::KernelBenchmark(const char* kernel, const char* variant,
+        const char* unit)
+: kernel_(kernel), variant_(variant), unit_(unit),
+  items_(0.0), flops_(0.0), bytes_(0.0)
+{
+}
+
+KernelBenchmark::~KernelBenchmark()
+{
+}
+
+void KernelBenchmark::prepare(int* /*status*/)
+{
+}
+
+void KernelBenchmark::set_cost(double items, double flops, double bytes)
+{
+    items_ = items;
+    flops_ = flops;
+    bytes_ = bytes;
+}
+
+void KernelBenchmark::set_size(const char* name, long long value)
+{
+    for (size_t i = 0; i < sizes_.size(); ++i)
+    {
+        if (sizes_[i].first == name)
+        {
+            sizes_[i].second = value;
+            return;
+        }
+    }
+    sizes_.push_back(std::make_pair(std::string(name), value));
+}
+
+} // namespace oskar
+
+using oskar::KernelBenchmark;
+
+// Returns the size of one real value of the given precision, in bytes.
+static double fp_bytes(int precision)
+{
+    return (double) oskar_mem_element_size(precision);
+}
+
+template<typename FP>
+static void fill_z(int num, const FP* x, const FP* y, FP* z)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        z[i] = sqrt((FP)1 - x[i] * x[i] - y[i] * y[i]);
+    }
+}
+
+// Fills direction cosines with random directions above the horizon.
+static void random_directions(oskar_Mem* x, oskar_Mem* y, oskar_Mem* z,
+        int* status)
+{
+    const int num = (int) oskar_mem_length(x);
+    oskar_mem_random_range(x, -0.7, 0.7, status);
+    oskar_mem_random_range(y, -0.7, 0.7, status);
+    if (*status) return;
+    if (oskar_mem_precision(x) == OSKAR_DOUBLE)
+    {
+        fill_z(num, oskar_mem_double_const(x, status),
+                oskar_mem_double_const(y, status),
+                oskar_mem_double(z, status));
+    }
+    else
+    {
+        fill_z(num, oskar_mem_float_const(x, status),
+                oskar_mem_float_const(y, status),
+                oskar_mem_float(z, status));
+    }
+}
+
+
+// Cross-correlation of station beams, for point or Gaussian sources.
+class CrossCorrelate : public KernelBenchmark
+{
+public:
+    CrossCorrelate(const char* variant, int gaussian, int matrix)
+    : KernelBenchmark("cross_correlate", variant, "source_baselines"),
+      gaussian_(gaussian), matrix_(matrix), num_sources_(0),
+      jones_(0), tel_(0), vis_(0)
+    {
+        for (int i = 0; i < 3; ++i) dir_[i] = ext_[i] = uvw_[i] = 0;
+        for (int i = 0; i < 4; ++i) flux_[i] = 0;
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int num_stations = 64;
+        const int type = precision | OSKAR_COMPLEX |
+                (matrix_ ? OSKAR_MATRIX : 0);
+        num_sources_ = 256 * scale;
+        srand(2);
+        tel_ = oskar_telescope_create(precision, OSKAR_CPU,
+                num_stations, status);
+        jones_ = oskar_jones_create(type, OSKAR_CPU,
+                num_stations, num_sources_, status);
+        const int num_baselines = oskar_telescope_num_baselines(tel_);
+        vis_ = oskar_mem_create(type, OSKAR_CPU, num_baselines, status);
+        for (int i = 0; i < 4; ++i)
+        {
+            flux_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_sources_, status);
+            oskar_mem_random_range(flux_[i], 0.1, 1.0, status);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            dir_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_sources_, status);
+            ext_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_sources_, status);
+            uvw_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_stations, status);
+            oskar_mem_random_range(uvw_[i], -1000.0, 1000.0, status);
+            oskar_mem_random_range(ext_[i], 0.1e-6, 0.2e-6, status);
+            oskar_mem_random_range(
+                    oskar_telescope_station_true_offset_ecef_metres(tel_, i),
+                    0.1, 1000.0, status);
+        }
+        random_directions(dir_[0], dir_[1], dir_[2], status);
+        oskar_mem_random_range(oskar_jones_mem(jones_), -1.0, 1.0, status);
+        oskar_mem_clear_contents(vis_, status);
+
+        // Per source-baseline pair: the product of the brightness matrix
+        // with the Jones matrices either side (two 2x2 complex matrix
+        // products), or of the scalar terms, then the accumulation.
+        // Gaussian sources add the evaluation of the source envelope.
+        const double num_pairs = (double) num_baselines * num_sources_;
+        double flops_pair = matrix_ ? (112.0 + 8.0) : (8.0 + 2.0);
+        if (gaussian_) flops_pair += 10.0;
+        const double jones_bytes = (double) num_stations * num_sources_ *
+                oskar_mem_element_size(type);
+        const double source_bytes = (double) num_sources_ *
+                fp_bytes(precision) * (gaussian_ ? 10 : 7);
+        const double station_bytes = (double) num_stations *
+                fp_bytes(precision) * 5;
+        const double vis_bytes = 2.0 * num_baselines *
+                oskar_mem_element_size(type);
+        set_size("num_stations", num_stations);
+        set_size("num_sources", num_sources_);
+        set_cost(num_pairs, flops_pair * num_pairs,
+                jones_bytes + source_bytes + station_bytes + vis_bytes);
+    }
+
+    void run(int* status)
+    {
+        oskar_cross_correlate(gaussian_, num_sources_, jones_,
+                flux_, dir_, ext_, tel_, uvw_, 0.0, FREQ_HZ, 0, vis_, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_jones_free(jones_, status);
+        oskar_telescope_free(tel_, status);
+        oskar_mem_free(vis_, status);
+        for (int i = 0; i < 3; ++i)
+        {
+            oskar_mem_free(dir_[i], status);
+            oskar_mem_free(ext_[i], status);
+            oskar_mem_free(uvw_[i], status);
+        }
+        for (int i = 0; i < 4; ++i) oskar_mem_free(flux_[i], status);
+    }
+
+private:
+    int gaussian_, matrix_, num_sources_;
+    oskar_Mem *dir_[3], *ext_[3], *flux_[4], *uvw_[3];
+    oskar_Jones* jones_;
+    oskar_Telescope* tel_;
+    oskar_Mem* vis_;
+};
+
+
+// Auto-correlation of station beams.
+class AutoCorrelate : public KernelBenchmark
+{
+public:
+    AutoCorrelate(const char* variant, int matrix)
+    : KernelBenchmark("auto_correlate", variant, "source_stations"),
+      matrix_(matrix), num_sources_(0), jones_(0), vis_(0)
+    {
+        for (int i = 0; i < 4; ++i) flux_[i] = 0;
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int num_stations = 64;
+        const int type = precision | OSKAR_COMPLEX |
+                (matrix_ ? OSKAR_MATRIX : 0);
+        num_sources_ = 4096 * scale;
+        srand(2);
+        jones_ = oskar_jones_create(type, OSKAR_CPU,
+                num_stations, num_sources_, status);
+        vis_ = oskar_mem_create(type, OSKAR_CPU, num_stations, status);
+        for (int i = 0; i < 4; ++i)
+        {
+            flux_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_sources_, status);
+            oskar_mem_random_range(flux_[i], 0.1, 1.0, status);
+        }
+        oskar_mem_random_range(oskar_jones_mem(jones_), -1.0, 1.0, status);
+        oskar_mem_clear_contents(vis_, status);
+
+        // Per source-station pair: the product of the brightness matrix
+        // with the Jones matrix and its Hermitian transpose, or the power
+        // of the scalar term, then the accumulation.
+        const double num_pairs = (double) num_stations * num_sources_;
+        const double flops_pair = matrix_ ? (112.0 + 8.0) : (4.0 + 1.0);
+        const double jones_bytes = num_pairs * oskar_mem_element_size(type);
+        const double source_bytes = (double) num_sources_ *
+                fp_bytes(precision) * 4;
+        const double vis_bytes = 2.0 * num_stations *
+                oskar_mem_element_size(type);
+        set_size("num_stations", num_stations);
+        set_size("num_sources", num_sources_);
+        set_cost(num_pairs, flops_pair * num_pairs,
+                jones_bytes + source_bytes + vis_bytes);
+    }
+
+    void run(int* status)
+    {
+        oskar_auto_correlate(num_sources_, jones_, flux_, 0, vis_, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_jones_free(jones_, status);
+        oskar_mem_free(vis_, status);
+        for (int i = 0; i < 4; ++i) oskar_mem_free(flux_[i], status);
+    }
+
+private:
+    int matrix_, num_sources_;
+    oskar_Mem* flux_[4];
+    oskar_Jones* jones_;
+    oskar_Mem* vis_;
+};
+
+
+// Interferometer phase (Jones K) for all stations and sources.
+class JonesK : public KernelBenchmark
+{
+public:
+    JonesK()
+    : KernelBenchmark("evaluate_jones_K", "scalar", "source_stations"),
+      num_sources_(0), jones_(0), filter_(0)
+    {
+        for (int i = 0; i < 3; ++i) lmn_[i] = uvw_[i] = 0;
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int num_stations = 64;
+        num_sources_ = 4096 * scale;
+        srand(2);
+        jones_ = oskar_jones_create(precision | OSKAR_COMPLEX, OSKAR_CPU,
+                num_stations, num_sources_, status);
+        filter_ = oskar_mem_create(precision, OSKAR_CPU,
+                num_sources_, status);
+        oskar_mem_random_range(filter_, 0.1, 1.0, status);
+        for (int i = 0; i < 3; ++i)
+        {
+            lmn_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_sources_, status);
+            uvw_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_stations, status);
+            oskar_mem_random_range(uvw_[i], -1000.0, 1000.0, status);
+        }
+        random_directions(lmn_[0], lmn_[1], lmn_[2], status);
+
+        // Per source-station pair: the phase (5), its sine and cosine (2).
+        const double num_pairs = (double) num_stations * num_sources_;
+        const double fp = fp_bytes(precision);
+        set_size("num_stations", num_stations);
+        set_size("num_sources", num_sources_);
+        set_cost(num_pairs, 7.0 * num_pairs,
+                num_pairs * 2 * fp + num_sources_ * 4 * fp +
+                num_stations * 3 * fp);
+    }
+
+    void run(int* status)
+    {
+        oskar_evaluate_jones_K(jones_, num_sources_,
+                lmn_[0], lmn_[1], lmn_[2], uvw_[0], uvw_[1], uvw_[2],
+                FREQ_HZ, filter_, 0.0, 1e9, 0, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_jones_free(jones_, status);
+        oskar_mem_free(filter_, status);
+        for (int i = 0; i < 3; ++i)
+        {
+            oskar_mem_free(lmn_[i], status);
+            oskar_mem_free(uvw_[i], status);
+        }
+    }
+
+private:
+    int num_sources_;
+    oskar_Jones* jones_;
+    oskar_Mem *filter_, *lmn_[3], *uvw_[3];
+};
+
+
+// Weighted DFT used to evaluate station beams.
+class Dftw : public KernelBenchmark
+{
+public:
+    Dftw(const char* variant, int matrix)
+    : KernelBenchmark("dftw", variant, "element_directions"),
+      matrix_(matrix), num_in_(0), num_out_(0),
+      weights_(0), data_idx_(0), data_(0), output_(0)
+    {
+        for (int i = 0; i < 3; ++i) in_[i] = out_[i] = 0;
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int type = precision | OSKAR_COMPLEX;
+        const int data_type = type | (matrix_ ? OSKAR_MATRIX : 0);
+        num_in_ = 256;
+        num_out_ = 4096 * scale;
+        srand(2);
+        weights_ = oskar_mem_create(type, OSKAR_CPU, num_in_, status);
+        data_idx_ = oskar_mem_create(OSKAR_INT, OSKAR_CPU, num_in_, status);
+        data_ = oskar_mem_create(data_type, OSKAR_CPU, num_out_, status);
+        output_ = oskar_mem_create(data_type, OSKAR_CPU, num_out_, status);
+        oskar_mem_random_range(weights_, -1.0, 1.0, status);
+        oskar_mem_random_range(data_, -1.0, 1.0, status);
+        oskar_mem_clear_contents(data_idx_, status);
+        for (int i = 0; i < 3; ++i)
+        {
+            in_[i] = oskar_mem_create(precision, OSKAR_CPU, num_in_, status);
+            out_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_out_, status);
+            oskar_mem_random_range(in_[i], -20.0, 20.0, status);
+        }
+        random_directions(out_[0], out_[1], out_[2], status);
+
+        // Per element-direction pair: the phase (5), its sine and cosine
+        // (2), the product with the weight (6), and the multiply-add of
+        // each complex element response (8 each).
+        const double num_pairs = (double) num_in_ * num_out_;
+        const double flops_pair = 13.0 + (matrix_ ? 32.0 : 8.0);
+        const double fp = fp_bytes(precision);
+        const double in_bytes = num_in_ * (2 * fp + 3 * fp + 4);
+        const double out_bytes = num_out_ * (3 * fp +
+                2.0 * oskar_mem_element_size(data_type));
+        set_size("num_elements", num_in_);
+        set_size("num_directions", num_out_);
+        set_cost(num_pairs, flops_pair * num_pairs, in_bytes + out_bytes);
+    }
+
+    void run(int* status)
+    {
+        oskar_dftw(0, num_in_, 2.0 * M_PI, weights_,
+                in_[0], in_[1], in_[2], 0, num_out_, out_[0], out_[1], out_[2],
+                data_idx_, data_, 1, 1, 0, output_, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_mem_free(weights_, status);
+        oskar_mem_free(data_idx_, status);
+        oskar_mem_free(data_, status);
+        oskar_mem_free(output_, status);
+        for (int i = 0; i < 3; ++i)
+        {
+            oskar_mem_free(in_[i], status);
+            oskar_mem_free(out_[i], status);
+        }
+    }
+
+private:
+    int matrix_, num_in_, num_out_;
+    oskar_Mem *in_[3], *out_[3], *weights_, *data_idx_, *data_, *output_;
+};
+
+
+// Polarised element pattern evaluation.
+class ElementEvaluate : public KernelBenchmark
+{
+public:
+    enum { DIPOLE, SPLINE, SPHERICAL_WAVE };
+
+    ElementEvaluate(const char* variant, int model)
+    : KernelBenchmark("element_evaluate", variant, "points"),
+      model_(model), num_points_(0), element_(0),
+      theta_(0), phi_x_(0), phi_y_(0), output_(0)
+    {
+        for (int i = 0; i < 3; ++i) xyz_[i] = 0;
+        for (int i = 0; i < 4; ++i) fitted_[i] = 0;
+    }
+
+    ~ElementEvaluate()
+    {
+        int status = 0;
+        for (int i = 0; i < 4; ++i) oskar_splines_free(fitted_[i], &status);
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int type = precision | OSKAR_COMPLEX | OSKAR_MATRIX;
+        const int l_max = 10;
+        const int num_coeff = (l_max + 1) * (l_max + 1) - 1;
+        num_points_ = 16384 * scale;
+        srand(2);
+        element_ = oskar_element_create(precision, OSKAR_CPU, status);
+        oskar_element_set_element_type(element_, "Dipole", status);
+        oskar_element_set_dipole_length(element_, 0.5, "Wavelengths", status);
+        oskar_element_resize_freq_data(element_, 1, status);
+        if (*status) return;
+        element_->freqs_hz[0] = FREQ_HZ;
+        double flops_point = 20.0 + 16.0; // Coordinates and Ludwig-3.
+        double model_bytes = 0.0;
+        if (model_ == DIPOLE)
+        {
+            flops_point += 2 * 15.0;
+        }
+        else if (model_ == SPLINE)
+        {
+            // Each surface is a bicubic spline: 16 multiply-adds, plus
+            // the basis functions in each direction.
+            if (!fitted_[0]) fit_surfaces(status);
+            oskar_Splines** x[] = {&element_->x_h_re[0],
+                    &element_->x_h_im[0], &element_->x_v_re[0],
+                    &element_->x_v_im[0]};
+            oskar_Splines** y[] = {&element_->y_h_re[0],
+                    &element_->y_h_im[0], &element_->y_v_re[0],
+                    &element_->y_v_im[0]};
+            for (int i = 0; i < 4; ++i)
+            {
+                *x[i] = convert_splines(fitted_[i], precision, status);
+                *y[i] = convert_splines(fitted_[i], precision, status);
+                model_bytes += 2.0 * fp_bytes(precision) * (
+                        oskar_mem_length(fitted_[i]->coeff) +
+                        fitted_[i]->num_knots_x_theta +
+                        fitted_[i]->num_knots_y_phi);
+            }
+            flops_point += 8 * (32.0 + 40.0) + 2 * 4.0;
+        }
+        else if (model_ == SPHERICAL_WAVE)
+        {
+            // Each coefficient adds four complex multiply-adds for
+            // each polarisation, plus the Legendre recurrence.
+            element_->l_max[0] = l_max;
+            element_->sph_wave[0] = oskar_mem_create(type, OSKAR_CPU,
+                    num_coeff, status);
+            oskar_mem_random_range(element_->sph_wave[0], -1.0, 1.0, status);
+            flops_point += num_coeff * (2 * 4 * 8.0 + 16.0);
+            model_bytes = num_coeff * oskar_mem_element_size(type);
+            set_size("l_max", l_max);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            xyz_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_points_, status);
+        }
+        random_directions(xyz_[0], xyz_[1], xyz_[2], status);
+        theta_ = oskar_mem_create(precision, OSKAR_CPU, num_points_, status);
+        phi_x_ = oskar_mem_create(precision, OSKAR_CPU, num_points_, status);
+        phi_y_ = oskar_mem_create(precision, OSKAR_CPU, num_points_, status);
+        output_ = oskar_mem_create(type, OSKAR_CPU, num_points_, status);
+
+        // Coordinates are read, the work arrays are written, and the
+        // complex matrix response is written for each point.
+        const double point_bytes = 6 * fp_bytes(precision) +
+                oskar_mem_element_size(type);
+        set_size("num_points", num_points_);
+        set_cost(num_points_, flops_point * num_points_,
+                point_bytes * num_points_ + model_bytes);
+    }
+
+    void run(int* status)
+    {
+        oskar_element_evaluate(element_, 0, 0, 0.0, M_PI / 2.0, 0,
+                num_points_, xyz_[0], xyz_[1], xyz_[2], FREQ_HZ,
+                theta_, phi_x_, phi_y_, 0, output_, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_element_free(element_, status);
+        oskar_mem_free(theta_, status);
+        oskar_mem_free(phi_x_, status);
+        oskar_mem_free(phi_y_, status);
+        oskar_mem_free(output_, status);
+        for (int i = 0; i < 3; ++i) oskar_mem_free(xyz_[i], status);
+    }
+
+private:
+    // Fits splines to the Ludwig-3 components of a short dipole pattern,
+    // in the same way as a numerical element pattern file.
+    void fit_surfaces(int* status)
+    {
+        const int num_theta = 19, num_phi = 37, n = num_theta * num_phi;
+        std::vector<double> theta(n), phi(n), weight(n, 1.0), data[4];
+        for (int i = 0; i < 4; ++i) data[i].resize(n);
+        for (int t = 0, k = 0; t < num_theta; ++t)
+        {
+            for (int p = 0; p < num_phi; ++p, ++k)
+            {
+                theta[k] = (t * 5.0) * M_PI / 180.0;
+                phi[k] = (p * 10.0) * M_PI / 180.0;
+                const double e_theta = cos(theta[k]) * cos(phi[k]);
+                const double e_phi = -sin(phi[k]);
+                const double phase = 0.5 * sin(theta[k]);
+                const double h = e_theta * cos(phi[k]) - e_phi * sin(phi[k]);
+                const double v = e_theta * sin(phi[k]) + e_phi * cos(phi[k]);
+                data[0][k] = h * cos(phase);
+                data[1][k] = h * sin(phase);
+                data[2][k] = v * cos(phase);
+                data[3][k] = v * sin(phase);
+            }
+        }
+        for (int i = 0; i < 4 && !*status; ++i)
+        {
+            double avg_frac_error = 0.005;
+            fitted_[i] = oskar_splines_create(OSKAR_DOUBLE, OSKAR_CPU, status);
+            oskar_splines_fit(fitted_[i], n, &theta[0], &phi[0], &data[i][0],
+                    &weight[0], OSKAR_SPLINES_SPHERICAL, 1, &avg_frac_error,
+                    1.1, 1.0, 1e-14, status);
+        }
+    }
+
+    static oskar_Splines* convert_splines(const oskar_Splines* in,
+            int precision, int* status)
+    {
+        oskar_Splines* out = oskar_splines_create(precision, OSKAR_CPU, status);
+        if (*status) return out;
+        oskar_mem_free(out->knots_x_theta, status);
+        oskar_mem_free(out->knots_y_phi, status);
+        oskar_mem_free(out->coeff, status);
+        out->num_knots_x_theta = in->num_knots_x_theta;
+        out->num_knots_y_phi = in->num_knots_y_phi;
+        out->smoothing_factor = in->smoothing_factor;
+        out->knots_x_theta = oskar_mem_convert_precision(in->knots_x_theta,
+                precision, status);
+        out->knots_y_phi = oskar_mem_convert_precision(in->knots_y_phi,
+                precision, status);
+        out->coeff = oskar_mem_convert_precision(in->coeff,
+                precision, status);
+        return out;
+    }
+
+    int model_, num_points_;
+    oskar_Element* element_;
+    oskar_Splines* fitted_[4];
+    oskar_Mem *xyz_[3], *theta_, *phi_x_, *phi_y_, *output_;
+};
+
+
+// W-projection gridding of visibilities.
+class GridWproj : public KernelBenchmark
+{
+public:
+    GridWproj()
+    : KernelBenchmark("grid_wproj", "host", "visibilities"),
+      precision_(0), num_points_(0), grid_size_(0),
+      cell_size_rad_(0.0), w_scale_(0.0), norm_(0.0),
+      conv_func_(0), vis_(0), weight_(0), grid_(0)
+    {
+        for (int i = 0; i < 3; ++i) uvw_[i] = 0;
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int num_w_planes = 32, oversample = 4;
+        const double w_max = 1000.0;
+        precision_ = precision;
+        num_points_ = 32768 * scale;
+        grid_size_ = 1024;
+        cell_size_rad_ = 1e-5;
+        support_.resize(num_w_planes);
+        kernel_start_.resize(num_w_planes);
+        double taps = 0.0;
+        size_t conv_len = 0;
+        for (int i = 0; i < num_w_planes; ++i)
+        {
+            // Kernels are stored in the rearranged layout used by the imager.
+            support_[i] = 4 + i / 4;
+            const size_t len = 2 * (size_t) support_[i] + 1;
+            kernel_start_[i] = (int) conv_len;
+            conv_len += ((oversample / 2) * len + 1) * len *
+                    (oversample / 2 + 1);
+            taps += (double) len * len;
+        }
+        taps /= num_w_planes;
+        w_scale_ = (num_w_planes - 1) * (num_w_planes - 1) / w_max;
+        srand(2);
+        const double uv_max = 0.4 / cell_size_rad_;
+        const int type = precision | OSKAR_COMPLEX;
+        conv_func_ = oskar_mem_create(type, OSKAR_CPU, conv_len, status);
+        vis_ = oskar_mem_create(type, OSKAR_CPU, num_points_, status);
+        weight_ = oskar_mem_create(precision, OSKAR_CPU, num_points_, status);
+        grid_ = oskar_mem_create(type, OSKAR_CPU,
+                (size_t) grid_size_ * grid_size_, status);
+        oskar_mem_random_range(conv_func_, -1.0, 1.0, status);
+        oskar_mem_random_range(vis_, -1.0, 1.0, status);
+        oskar_mem_random_range(weight_, 0.5, 1.0, status);
+        for (int i = 0; i < 3; ++i)
+        {
+            uvw_[i] = oskar_mem_create(precision, OSKAR_CPU,
+                    num_points_, status);
+            oskar_mem_random_range(uvw_[i], i < 2 ? -uv_max : -w_max,
+                    i < 2 ? uv_max : w_max, status);
+        }
+
+        // Per visibility, the complex multiply-add and the normalisation
+        // sum for each tap of the convolution kernel.
+        const double fp = fp_bytes(precision);
+        set_size("num_visibilities", num_points_);
+        set_size("grid_size", grid_size_);
+        set_size("num_w_planes", num_w_planes);
+        set_size("oversample", oversample);
+        set_cost(num_points_, num_points_ * (10.0 * taps + 20.0),
+                num_points_ * 6 * fp + conv_len * 2 * fp +
+                2.0 * grid_size_ * grid_size_ * 2 * fp);
+    }
+
+    void prepare(int* status)
+    {
+        norm_ = 0.0;
+        oskar_mem_clear_contents(grid_, status);
+    }
+
+    void run(int* status)
+    {
+        size_t num_skipped = 0;
+        const size_t num_w_planes = support_.size();
+        if (precision_ == OSKAR_DOUBLE)
+        {
+            oskar_grid_wproj2_d(num_w_planes, &support_[0], 4,
+                    &kernel_start_[0],
+                    oskar_mem_double_const(conv_func_, status),
+                    (size_t) num_points_,
+                    oskar_mem_double_const(uvw_[0], status),
+                    oskar_mem_double_const(uvw_[1], status),
+                    oskar_mem_double_const(uvw_[2], status),
+                    oskar_mem_double_const(vis_, status),
+                    oskar_mem_double_const(weight_, status),
+                    cell_size_rad_, w_scale_, grid_size_, &num_skipped,
+                    &norm_, oskar_mem_double(grid_, status));
+        }
+        else
+        {
+            oskar_grid_wproj2_f(num_w_planes, &support_[0], 4,
+                    &kernel_start_[0],
+                    oskar_mem_float_const(conv_func_, status),
+                    (size_t) num_points_,
+                    oskar_mem_float_const(uvw_[0], status),
+                    oskar_mem_float_const(uvw_[1], status),
+                    oskar_mem_float_const(uvw_[2], status),
+                    oskar_mem_float_const(vis_, status),
+                    oskar_mem_float_const(weight_, status),
+                    (float) cell_size_rad_, (float) w_scale_, grid_size_,
+                    &num_skipped, &norm_, oskar_mem_float(grid_, status));
+        }
+    }
+
+    void teardown(int* status)
+    {
+        oskar_mem_free(conv_func_, status);
+        oskar_mem_free(vis_, status);
+        oskar_mem_free(weight_, status);
+        oskar_mem_free(grid_, status);
+        for (int i = 0; i < 3; ++i) oskar_mem_free(uvw_[i], status);
+    }
+
+private:
+    int precision_, num_points_, grid_size_;
+    double cell_size_rad_, w_scale_, norm_;
+    std::vector<int> support_, kernel_start_;
+    oskar_Mem *conv_func_, *uvw_[3], *vis_, *weight_, *grid_;
+};
+
+
+// Two-dimensional complex FFT, as used to make images from grids.
+class Fft : public KernelBenchmark
+{
+public:
+    Fft()
+    : KernelBenchmark("fft_exec", "2d", "cells"),
+      fft_(0), input_(0), data_(0)
+    {
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int size = 256 * scale;
+        const double num_cells = (double) size * size;
+        const int type = precision | OSKAR_COMPLEX;
+        srand(2);
+        fft_ = oskar_fft_create(precision, OSKAR_CPU, 2, size, 0, status);
+        input_ = oskar_mem_create(type, OSKAR_CPU, (size_t) num_cells,
+                status);
+        data_ = oskar_mem_create(type, OSKAR_CPU, (size_t) num_cells,
+                status);
+        oskar_mem_random_range(input_, -1.0, 1.0, status);
+
+        // The usual estimate of 5 N log2(N) operations for a complex FFT,
+        // with the grid read and written once.
+        set_size("grid_size", size);
+        set_cost(num_cells, 5.0 * num_cells * log2(num_cells),
+                2.0 * num_cells * oskar_mem_element_size(type));
+    }
+
+    void prepare(int* status)
+    {
+        // Start from the same data each time, so the values stay finite.
+        oskar_mem_copy(data_, input_, status);
+    }
+
+    void run(int* status)
+    {
+        oskar_fft_exec(fft_, data_, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_fft_free(fft_);
+        oskar_mem_free(input_, status);
+        oskar_mem_free(data_, status);
+    }
+
+private:
+    oskar_FFT* fft_;
+    oskar_Mem *input_, *data_;
+};
+
+
+// Removal of sources below the horizon for all station models.
+class SkyHorizonClip : public KernelBenchmark
+{
+public:
+    SkyHorizonClip()
+    : KernelBenchmark("sky_horizon_clip", "4_stations", "sources"),
+      sky_in_(0), sky_out_(0), tel_(0), work_(0)
+    {
+    }
+
+    void setup(int precision, int scale, int* status)
+    {
+        const int num_sources = 65536 * scale, num_stations = 4;
+        const double deg2rad = M_PI / 180.0;
+        srand(2);
+        sky_in_ = oskar_sky_create(precision, OSKAR_CPU, num_sources, status);
+        sky_out_ = oskar_sky_create(precision, OSKAR_CPU, 0, status);
+        oskar_mem_random_range(oskar_sky_ra_rad(sky_in_),
+                0.0, 2.0 * M_PI, status);
+        oskar_mem_random_range(oskar_sky_dec_rad(sky_in_),
+                -M_PI / 2.0, M_PI / 2.0, status);
+        oskar_mem_random_range(oskar_sky_I(sky_in_), 0.1, 1.0, status);
+        oskar_sky_evaluate_relative_directions(sky_in_,
+                0.3, -0.5, status);
+        tel_ = oskar_telescope_create(precision, OSKAR_CPU,
+                num_stations, status);
+        oskar_telescope_resize_station_array(tel_, num_stations, status);
+        for (int i = 0; i < num_stations && !*status; ++i)
+        {
+            oskar_station_set_position(oskar_telescope_station(tel_, i),
+                    i * 20.0 * deg2rad, -30.0 * deg2rad, 0.0, 0.0, 0.0, 0.0);
+        }
+        work_ = oskar_station_work_create(precision, OSKAR_CPU, status);
+
+        // Find how many sources are copied.
+        run(status);
+        const int num_out = oskar_sky_num_sources(sky_out_);
+
+        // Per source and station model, the test against the horizon (6),
+        // then the prefix sum of the mask (1).
+        // The directions, mask and indices are read and written, and all
+        // 18 columns of each visible source are copied.
+        const double fp = fp_bytes(precision);
+        set_size("num_sources", num_sources);
+        set_size("num_station_models", num_stations);
+        set_size("num_visible", num_out);
+        set_cost(num_sources, num_sources * (6.0 * num_stations + 1.0),
+                num_sources * (3 * fp + 3 * 4.0) + num_out * 2 * 18 * fp);
+    }
+
+    void run(int* status)
+    {
+        oskar_sky_horizon_clip(sky_out_, sky_in_, tel_, 0.0, work_, status);
+    }
+
+    void teardown(int* status)
+    {
+        oskar_sky_free(sky_in_, status);
+        oskar_sky_free(sky_out_, status);
+        oskar_telescope_free(tel_, status);
+        oskar_station_work_free(work_, status);
+    }
+
+private:
+    oskar_Sky *sky_in_, *sky_out_;
+    oskar_Telescope* tel_;
+    oskar_StationWork* work_;
+};
+
+
+namespace oskar {
+
+std::vector<KernelBenchmark*> kernel_benchmarks_create()
+{
+    std::vector<KernelBenchmark*> list;
+    list.push_back(new CrossCorrelate("point_matrix", 0, 1));
+    list.push_back(new CrossCorrelate("gaussian_matrix", 1, 1));
+    list.push_back(new CrossCorrelate("point_scalar", 0, 0));
+    list.push_back(new AutoCorrelate("matrix", 1));
+    list.push_back(new AutoCorrelate("scalar", 0));
+    list.push_back(new JonesK);
+    list.push_back(new Dftw("c2c", 0));
+    list.push_back(new Dftw("m2m", 1));
+    list.push_back(new ElementEvaluate("dipole", ElementEvaluate::DIPOLE));
+    list.push_back(new ElementEvaluate("spline", ElementEvaluate::SPLINE));
+    list.push_back(new ElementEvaluate("spherical_wave",
+            ElementEvaluate::SPHERICAL_WAVE));
+    list.push_back(new GridWproj);
+    list.push_back(new Fft);
+    list.push_back(new SkyHorizonClip);
+    return list;
+}
+
+} // namespace oskar
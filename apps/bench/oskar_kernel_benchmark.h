@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_KERNEL_BENCHMARK_H_
+#define OSKAR_KERNEL_BENCHMARK_H_
+
+/**
+ * @file oskar_kernel_benchmark.h
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oskar {
+
+/**
+ * @brief
+ * Base class for a benchmark of one processing kernel on the CPU.
+ *
+ * @details
+ * Each benchmark creates its own input data for a given precision and
+ * problem scale in setup(), calls the kernel once in run(), and frees the
+ * data in teardown(). Before each call to run(), prepare() is called to
+ * reset any data that the kernel updates. Only run() is timed.
+ *
+ * After setup(), the benchmark describes the problem size, and gives an
+ * estimate of the work done by each call to run():
+ *
+ * - items: The number of work items (for example, source-baseline pairs).
+ * - flops: The number of floating-point operations. Transcendental
+ *   functions are counted as one operation each, so rates derived from
+ *   this are a lower bound on the arithmetic actually done.
+ * - bytes: The compulsory memory traffic, counting each input as read
+ *   once and each output as written once.
+ *
+ * The ratio of flops to bytes gives the arithmetic intensity of the kernel,
+ * which places it on a roofline plot for comparison with the machine limits.
+ */
+class KernelBenchmark
+{
+public:
+    KernelBenchmark(const char* kernel, const char* variant,
+            const char* unit);
+    virtual ~KernelBenchmark();
+
+    // Creates the input data for the given precision and problem scale.
+    virtual void setup(int precision, int scale, int* status) = 0;
+
+    // Resets any data changed by the kernel. This is not timed.
+    virtual void prepare(int* status);
+
+    // Calls the kernel once.
+    virtual void run(int* status) = 0;
+
+    // Frees the input data.
+    virtual void teardown(int* status) = 0;
+
+    const char* kernel() const { return kernel_; }
+    const char* variant() const { return variant_; }
+    const char* unit() const { return unit_; }
+    double items() const { return items_; }
+    double flops() const { return flops_; }
+    double bytes() const { return bytes_; }
+    const std::vector<std::pair<std::string, long long> >& sizes() const
+    {
+        return sizes_;
+    }
+
+protected:
+    // Sets the work done by one call to run().
+    void set_cost(double items, double flops, double bytes);
+
+    // Records a named problem dimension.
+    void set_size(const char* name, long long value);
+
+private:
+    const char *kernel_, *variant_, *unit_;
+    double items_, flops_, bytes_;
+    std::vector<std::pair<std::string, long long> > sizes_;
+};
+
+/**
+ * @brief
+ * Creates all the kernel benchmarks.
+ *
+ * @details
+ * The caller takes ownership of the returned objects.
+ */
+std::vector<KernelBenchmark*> kernel_benchmarks_create();
+
+} // namespace oskar
+
+#endif /* include guard */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "oskar_kernel_benchmark.h"
+
+#include "mem/oskar_mem.h"
+#include "settings/oskar_option_parser.h"
+#include "utility/oskar_get_error_string.h"
+#include "utility/oskar_perf_report.h"
+#include "utility/oskar_timer.h"
+#include "oskar_version.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using oskar::KernelBenchmark;
+
+struct Result
+{
+    double min, median, mean;
+};
+
+// Calls the kernel once without timing it, then the given number of times.
+static Result time_kernel(KernelBenchmark* b, int num_iter, int* status)
+{
+    Result r = {0.0, 0.0, 0.0};
+    std::vector<double> times;
+    oskar_Timer* tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    b->prepare(status);
+    b->run(status);
+    for (int i = 0; i < num_iter && !*status; ++i)
+    {
+        b->prepare(status);
+        oskar_timer_start(tmr);
+        b->run(status);
+        times.push_back(oskar_timer_elapsed(tmr));
+    }
+    oskar_timer_free(tmr);
+    if (*status || times.empty()) return r;
+    std::sort(times.begin(), times.end());
+    const size_t n = times.size();
+    r.min = times[0];
+    r.median = (n % 2) ? times[n / 2] :
+            0.5 * (times[n / 2 - 1] + times[n / 2]);
+    for (size_t i = 0; i < n; ++i) r.mean += times[i];
+    r.mean /= n;
+    return r;
+}
+
+static void write_result(oskar_PerfReport* report, const KernelBenchmark* b,
+        const char* precision, int scale, const Result& r)
+{
+    const double t = r.median;
+    oskar_perf_report_begin_object(report, 0);
+    oskar_perf_report_string(report, "kernel", b->kernel());
+    oskar_perf_report_string(report, "variant", b->variant());
+    oskar_perf_report_string(report, "precision", precision);
+    oskar_perf_report_int(report, "scale", scale);
+    oskar_perf_report_begin_object(report, "size");
+    for (size_t i = 0; i < b->sizes().size(); ++i)
+    {
+        oskar_perf_report_int(report, b->sizes()[i].first.c_str(),
+                b->sizes()[i].second);
+    }
+    oskar_perf_report_end(report);
+    oskar_perf_report_begin_object(report, "time_sec");
+    oskar_perf_report_double(report, "min", r.min);
+    oskar_perf_report_double(report, "median", r.median);
+    oskar_perf_report_double(report, "mean", r.mean);
+    oskar_perf_report_end(report);
+    oskar_perf_report_string(report, "work_unit", b->unit());
+    oskar_perf_report_double(report, "work_items", b->items());
+    oskar_perf_report_double(report, "items_per_sec", b->items() / t);
+    oskar_perf_report_double(report, "flops", b->flops());
+    oskar_perf_report_double(report, "bytes", b->bytes());
+    oskar_perf_report_double(report, "arithmetic_intensity",
+            b->flops() / b->bytes());
+    oskar_perf_report_double(report, "gflops_per_sec", 1e-9 * b->flops() / t);
+    oskar_perf_report_double(report, "gbytes_per_sec", 1e-9 * b->bytes() / t);
+    oskar_perf_report_end(report);
+}
+
+int main(int argc, char** argv)
+{
+    int status = 0;
+    oskar::OptionParser opt("oskar_kernel_benchmark", OSKAR_VERSION_STR);
+    opt.set_description("Times the main processing kernels on the CPU, "
+            "for a range of problem sizes and precisions.");
+    opt.add_flag("-p", "Precision: 'single', 'double' or 'both'.",
+            1, "both");
+    opt.add_flag("-s", "Comma-separated list of problem size scale factors.",
+            1, "1,4");
+    opt.add_flag("-n", "Number of timed iterations.", 1, "5");
+    opt.add_flag("-k", "Only run kernels with names containing this text.",
+            1, "");
+    opt.add_flag("-o", "Write a JSON report to this file.", 1, "");
+    opt.add_flag("-l", "List the kernels and exit.");
+    if (!opt.check_options(argc, argv)) return EXIT_FAILURE;
+
+    // Get the benchmarks to run.
+    const char* filter_ = opt.get_string("-k");
+    const std::string filter = filter_ ? filter_ : "";
+    std::vector<KernelBenchmark*> all = oskar::kernel_benchmarks_create();
+    std::vector<KernelBenchmark*> list;
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        const std::string name =
+                std::string(all[i]->kernel()) + "/" + all[i]->variant();
+        if (opt.is_set("-l")) printf("%s\n", name.c_str());
+        if (name.find(filter) != std::string::npos) list.push_back(all[i]);
+    }
+    if (opt.is_set("-l")) list.clear();
+
+    // Get the precisions and problem sizes.
+    std::vector<int> precisions, scales;
+    const std::string precision = opt.get_string("-p");
+    if (precision == "single" || precision == "both")
+    {
+        precisions.push_back(OSKAR_SINGLE);
+    }
+    if (precision == "double" || precision == "both")
+    {
+        precisions.push_back(OSKAR_DOUBLE);
+    }
+    const std::string scale_list = opt.get_string("-s");
+    for (const char* p = scale_list.c_str(); *p; )
+    {
+        const int scale = atoi(p);
+        if (scale > 0) scales.push_back(scale);
+        p = strchr(p, ',');
+        if (!p) break;
+        ++p;
+    }
+    const int num_iter = opt.get_int("-n");
+    if (precisions.empty() || scales.empty() || num_iter < 1)
+    {
+        opt.error("Invalid precision, scale or number of iterations.");
+        return EXIT_FAILURE;
+    }
+
+    // Start the report.
+    oskar_PerfReport* report = 0;
+    const char* report_name = opt.get_string("-o");
+    if (report_name && strlen(report_name) > 0 && !list.empty())
+    {
+        report = oskar_perf_report_create(report_name,
+                "oskar_kernel_benchmark", 0, &status);
+        if (status)
+        {
+            fprintf(stderr, "ERROR: Could not open '%s'.\n", report_name);
+            return EXIT_FAILURE;
+        }
+#ifdef _OPENMP
+        oskar_perf_report_int(report, "num_threads", omp_get_max_threads());
+#endif
+        oskar_perf_report_int(report, "num_iterations", num_iter);
+        oskar_perf_report_begin_array(report, "results");
+    }
+
+    // Run the benchmarks.
+    if (!list.empty())
+    {
+        printf("%-18s %-16s %-6s %5s %11s %12s %-19s %8s %8s %7s\n",
+                "Kernel", "Variant", "Prec.", "Scale", "Time [ms]",
+                "Rate [/s]", "Unit", "GFLOP/s", "GB/s", "FLOP/B");
+    }
+    for (size_t i = 0; i < list.size() && !status; ++i)
+    {
+        KernelBenchmark* b = list[i];
+        for (size_t j = 0; j < precisions.size() && !status; ++j)
+        {
+            const char* prec = precisions[j] == OSKAR_DOUBLE ?
+                    "double" : "single";
+            for (size_t k = 0; k < scales.size() && !status; ++k)
+            {
+                b->setup(precisions[j], scales[k], &status);
+                const Result r = time_kernel(b, num_iter, &status);
+                b->teardown(&status);
+                if (status)
+                {
+                    fprintf(stderr, "ERROR: %s/%s failed with code %i: %s\n",
+                            b->kernel(), b->variant(), status,
+                            oskar_get_error_string(status));
+                    break;
+                }
+                printf("%-18s %-16s %-6s %5d %11.3f %12.4e %-19s "
+                        "%8.2f %8.2f %7.2f\n", b->kernel(), b->variant(),
+                        prec, scales[k], 1e3 * r.median,
+                        b->items() / r.median, b->unit(),
+                        1e-9 * b->flops() / r.median,
+                        1e-9 * b->bytes() / r.median,
+                        b->flops() / b->bytes());
+                fflush(stdout);
+                write_result(report, b, prec, scales[k], r);
+            }
+        }
+    }
+    oskar_perf_report_close(report, &status);
+    for (size_t i = 0; i < all.size(); ++i) delete all[i];
+    return status ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -114,7 +114,8 @@ static void scan_file(const char* filename, oskar_Log* log, int* status)
         /* Display more info if available. */
         const char* label = oskar_get_binary_tag_string(group, tag);
         temp = oskar_mem_create(type, OSKAR_CPU, 0, status);
-        if (bytes <= 512 || type == OSKAR_CHAR)
+        if ((bytes <= 512 || type == OSKAR_CHAR) &&
+                group != OSKAR_TAG_GROUP_INDEX)
         {
             oskar_binary_read_mem(h, temp, group, tag, idx, status);
         }
@@ -130,6 +131,11 @@ static void scan_file(const char* filename, oskar_Log* log, int* status)
             char* data = oskar_mem_char(temp);
             const int max_string_length = 40;
             const char* fmt = "%s: %.*s";
+            if (!data)
+            {
+                oskar_log_message(log, p, depth, "%s", label);
+                break;
+            }
             for (c = 0; c < bytes && c < oskar_mem_length(temp); ++c)
             {
                 if (data[c] < 32 && data[c] != 0) data[c] = ' ';
@@ -30,6 +30,8 @@ int main(int argc, char** argv)
             "below this fraction will be ignored.", 1, "0.0");
     opt.add_flag("-n", "Noise floor in units of original image. "
             "Pixels below this value will be ignored.", 1, "0.0");
+    opt.add_flag("-b", "Save a compact OSKAR binary sky model file "
+            "instead of a text file.", false, "--binary");
     if (!opt.check_options(argc, argv)) return EXIT_FAILURE;
 
     // Parse command line.
@@ -43,7 +45,14 @@ int main(int argc, char** argv)
             &error);
 
     // Write out the sky model.
-    oskar_sky_save(sky, opt.get_arg(1), &error);
+    if (opt.is_set("-b"))
+    {
+        oskar_sky_write_compact(sky, opt.get_arg(1), 0, &error);
+    }
+    else
+    {
+        oskar_sky_save(sky, opt.get_arg(1), &error);
+    }
     if (error)
     {
         oskar_log_error(0, oskar_get_error_string(error));
@@ -28,6 +28,7 @@ set_setting $app $ini observation/num_time_steps 30
 set_setting $app $ini sky/generator/grid/side_length 64
 set_setting $app $ini sky/generator/grid/fov_deg 5
 set_setting $app $ini sky/generator/grid/mean_flux_jy 1
+set_setting $app $ini interferometer/performance_report performance.json
 
 # Run the interferometry simulation in single precision
 set_setting $app $ini simulator/double_precision false
@@ -38,7 +39,8 @@ echo " - Finished in ~$(($(date +%s)-T0)) s"
 oskar_log=$(ls oskar*.log)
 mv "${oskar_log}" "SINGLE_${oskar_log}"
 echo "........................................................................."
-sed -n '125,136p' "SINGLE_${oskar_log}"
+mv performance.json "SINGLE_performance.json"
+cat "SINGLE_performance.json"
 echo "........................................................................."
 echo ""
 
@@ -51,7 +53,8 @@ echo " - Finished in ~$(($(date +%s)-T0)) s"
 oskar_log=$(ls oskar*.log)
 mv "$oskar_log" "DOUBLE_${oskar_log}"
 echo "........................................................................."
-sed -n '125,136p' "DOUBLE_${oskar_log}"
+mv performance.json "DOUBLE_performance.json"
+cat "DOUBLE_performance.json"
 echo "........................................................................."
 echo ""
 
@@ -59,10 +62,10 @@ echo ""
 echo "-------------------------------------------------------------------------"
 echo "Run complete!"
 echo ""
-echo "Please inspect the OSKAR run logs for timing results. This benchmark has"
-echo "generated the following log files:"
+echo "Please inspect the OSKAR performance reports and run logs for timing"
+echo "results. This benchmark has generated the following files:"
 echo ""
-oskar_logs=$(ls ./*.log)
+oskar_logs=$(ls ./*_performance.json ./*.log)
 idx=1
 for log in ${oskar_logs[*]}; do
     echo "  ${idx}. ${log}"
@@ -49,6 +49,12 @@
  * This function creates and returns a populated sky model from the given
  * settings.
  *
+ * Source parameters that the settings make unnecessary are not read from
+ * OSKAR sky model binary files, and are set to zero instead:
+ * polarised fluxes and rotation measures if telescope/pol_mode is Scalar,
+ * and any parameters that are overridden. All parameters are read if the
+ * sky model is written to an output file.
+ *
  * @param[in] s           A pointer to the settings tree.
  * @param[in,out] log     A pointer to the log to use.
  * @param[in,out] status  Status return code.
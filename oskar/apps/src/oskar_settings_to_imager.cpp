@@ -64,7 +64,29 @@ oskar_Imager* oskar_settings_to_imager(oskar::SettingsTree* s,
             s->to_int("scale_norm_with_num_input_files", status));
     oskar_imager_set_ms_column(h,
             s->to_string("ms_column", status), status);
+    if (!s->starts_with("ms_rows_per_read", "auto", status))
+    {
+        oskar_imager_set_ms_rows_per_read(h,
+                s->to_int("ms_rows_per_read", status));
+    }
+    oskar_imager_set_num_read_buffers(h,
+            s->to_int("num_read_buffers", status));
+    if (s->starts_with("num_parallel_files", "auto", status))
+    {
+        oskar_imager_set_num_parallel_files(h, 0);
+    }
+    else
+    {
+        oskar_imager_set_num_parallel_files(h,
+                s->to_int("num_parallel_files", status));
+    }
+    oskar_imager_set_partial_grid_memory_mb(h,
+            s->to_double("partial_grid_memory_mb", status));
     oskar_imager_set_output_root(h, s->to_string("root_path", status));
+    oskar_imager_set_scratch_dir(h, s->to_string("scratch_dir", status));
+    oskar_imager_set_performance_report(h,
+            s->to_string("performance_report", status));
+    oskar_imager_set_settings_path(h, s->file_name());
 
     // Set remaining imager options.
     oskar_imager_set_image_type(h,
@@ -88,10 +88,19 @@ oskar_Interferometer* oskar_settings_to_interferometer(oskar::SettingsTree* s,
             s->to_int("max_time_samples_per_block", status));
     oskar_interferometer_set_max_channels_per_block(h,
             s->to_int("max_channels_per_block", status));
+    oskar_interferometer_set_num_vis_buffers(h,
+            s->to_int("num_output_buffers", status), status);
+    oskar_interferometer_set_beam_cull_threshold(h,
+            s->to_double("beam_cull_threshold_jy", status));
+    oskar_interferometer_set_beam_interpolation(h,
+            s->to_double("beam_interp_tolerance", status),
+            s->to_int("beam_interp_validate", status));
     oskar_interferometer_set_output_vis_file(h,
             s->to_string("oskar_vis_filename", status));
     oskar_interferometer_set_output_measurement_set(h,
             s->to_string("ms_filename", status));
+    oskar_interferometer_set_performance_report(h,
+            s->to_string("performance_report", status));
     oskar_interferometer_set_force_polarised_ms(h,
             s->to_int("force_polarised_ms", status));
     oskar_interferometer_set_ignore_w_components(h,
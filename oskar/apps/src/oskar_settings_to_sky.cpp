@@ -23,7 +23,8 @@ using oskar::SettingsTree;
 #define D2R M_PI/180.0
 #define ARCSEC2RAD M_PI/648000.0
 
-static void load_osm(oskar_Sky* sky, SettingsTree* s,
+static int required_columns(SettingsTree* s, int* status);
+static void load_osm(oskar_Sky* sky, SettingsTree* s, int columns,
         double ra0, double dec0, oskar_Log* log, int* status);
 #if 0
 static void load_gsm(oskar_Sky* sky, SettingsTree* s,
@@ -70,10 +71,13 @@ oskar_Sky* oskar_settings_to_sky(SettingsTree* s, oskar_Log* log, int* status)
     }
 
     s->end_group();
+
+    /* Get the source parameters needed from sky model binary files. */
+    const int columns = required_columns(s, status);
     s->begin_group("sky");
 
     /* Load sky model data files. */
-    load_osm(sky, s, ra0, dec0, log, status);
+    load_osm(sky, s, columns, ra0, dec0, log, status);
     //load_gsm(sky, s, ra0, dec0, log, status);
     load_fits_image(sky, s, ra0, dec0, log, status);
     load_healpix_fits(sky, s, ra0, dec0, log, status);
@@ -133,7 +137,22 @@ oskar_Sky* oskar_settings_to_sky(SettingsTree* s, oskar_Log* log, int* status)
     {
         oskar_log_message(log, 'M', 1,
                 "Writing sky model binary file: %s", filename);
-        oskar_sky_write(sky, filename, status);
+        if (s->starts_with("output_binary_format", "Compact (32", status))
+        {
+            oskar_sky_write_compact(sky, filename, 32, status);
+        }
+        else if (s->starts_with("output_binary_format", "Compact (16", status))
+        {
+            oskar_sky_write_compact(sky, filename, 16, status);
+        }
+        else if (s->starts_with("output_binary_format", "Compact", status))
+        {
+            oskar_sky_write_compact(sky, filename, 0, status);
+        }
+        else
+        {
+            oskar_sky_write(sky, filename, status);
+        }
     }
 
     s->clear_group();
@@ -141,12 +160,60 @@ oskar_Sky* oskar_settings_to_sky(SettingsTree* s, oskar_Log* log, int* status)
 }
 
 
-static void load_osm(oskar_Sky* sky, SettingsTree* s,
+static int required_columns(SettingsTree* s, int* status)
+{
+    int columns = OSKAR_SKY_COLUMNS_ALL;
+    const char* text_file = 0;
+    const char* binary_file = 0;
+
+    /* Read everything if the sky model is written out again. */
+    s->begin_group("sky");
+    text_file = s->to_string("output_text_file", status);
+    binary_file = s->to_string("output_binary_file", status);
+    if ((text_file && strlen(text_file) > 0) ||
+            (binary_file && strlen(binary_file) > 0))
+    {
+        s->end_group();
+        return columns;
+    }
+
+    /* Spectral parameters are not needed if they are overridden. */
+    if (s->to_int("spectral_index/override", status))
+    {
+        columns &= ~(OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_REF_FREQ) |
+                OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_SPECTRAL_INDEX));
+    }
+    s->end_group();
+
+    /* Polarised fluxes and rotation measures are not used
+     * by simulations in scalar mode. */
+    if (s->contains("telescope/pol_mode") &&
+            s->starts_with("telescope/pol_mode", "S", status))
+    {
+        columns &= ~(OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_STOKES_Q) |
+                OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_STOKES_U) |
+                OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_STOKES_V) |
+                OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_ROTATION_MEASURE));
+    }
+    return columns;
+}
+
+
+static void load_osm(oskar_Sky* sky, SettingsTree* s, int columns,
         double ra0, double dec0, oskar_Log* log, int* status)
 {
     int num_files = 0;
     s->begin_group("oskar_sky_model");
     const char* const* files = s->to_string_list("file", &num_files, status);
+
+    /* Gaussian source parameters are not needed if they are overridden. */
+    if (s->to_double("extended_sources/FWHM_major", status) > 0.0 ||
+            s->to_double("extended_sources/FWHM_minor", status) > 0.0)
+    {
+        columns &= ~(OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_FWHM_MAJOR) |
+                OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_FWHM_MINOR) |
+                OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_POSITION_ANGLE));
+    }
     for (int i = 0; i < num_files; ++i)
     {
         int binary_file_error = 0;
@@ -159,8 +226,8 @@ static void load_osm(oskar_Sky* sky, SettingsTree* s,
 
         /* Try to read sky model as a binary file first. */
         /* If this fails, read it as an ASCII file. */
-        oskar_Sky* t = oskar_sky_read(files[i],
-                OSKAR_CPU, &binary_file_error);
+        oskar_Sky* t = oskar_sky_read_columns(files[i],
+                OSKAR_CPU, columns, &binary_file_error);
         if (binary_file_error)
         {
             t = oskar_sky_load(files[i],
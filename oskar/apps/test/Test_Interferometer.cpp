@@ -6,12 +6,17 @@
 #include <gtest/gtest.h>
 
 #include "apps/oskar_apps.h"
+#include "binary/oskar_binary.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_version_string.h"
+#include "vis/oskar_vis_block.h"
+#include "vis/oskar_vis_header.h"
 
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 using oskar::SettingsTree;
 using std::string;
@@ -21,6 +26,46 @@ static const char* app_imager = "oskar_imager";
 void create_sky_model(const char* filename, int* status);
 void create_telescope_model(const char* filename, int* status);
 
+static void read_cross_correlations(const char* filename,
+        std::vector<double>& vis, int* status)
+{
+    oskar_Binary* h = oskar_binary_create(filename, 'r', status);
+    oskar_VisHeader* hdr = oskar_vis_header_read(h, status);
+    oskar_VisBlock* blk = oskar_vis_block_create_from_header(
+            OSKAR_CPU, hdr, status);
+    const int num_blocks = oskar_vis_header_num_blocks(hdr);
+    for (int i_block = 0; i_block < num_blocks && !*status; ++i_block)
+    {
+        oskar_vis_block_read(blk, hdr, h, i_block, status);
+        const oskar_Mem* xc = oskar_vis_block_cross_correlations_const(blk);
+        const double* v = oskar_mem_double_const(xc, status);
+        if (*status) break;
+        vis.insert(vis.end(), v, v + 2 * oskar_mem_length(xc));
+    }
+    oskar_vis_header_free(hdr, status);
+    oskar_vis_block_free(blk, status);
+    oskar_binary_free(h);
+}
+
+static void run_interferometer(SettingsTree* settings, oskar_Sky* sky,
+        const char* vis_filename, int* status)
+{
+    if (!settings->set_value("interferometer/oskar_vis_filename",
+            vis_filename))
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        return;
+    }
+    oskar_Interferometer* sim = oskar_settings_to_interferometer(
+            settings, 0, status);
+    oskar_Telescope* tel = oskar_settings_to_telescope(settings, 0, status);
+    oskar_interferometer_set_telescope_model(sim, tel, status);
+    oskar_interferometer_set_sky_model(sim, sky, status);
+    oskar_interferometer_run(sim, status);
+    oskar_interferometer_free(sim, status);
+    oskar_telescope_free(tel, status);
+}
+
 TEST(apps, test_interferometer_modes)
 {
     int status = 0;
@@ -209,3 +254,96 @@ TEST(apps, test_interferometer_modes)
     // Free settings.
     SettingsTree::free(sim_settings);
 }
+
+TEST(apps, test_interferometer_beam_cull)
+{
+    int status = 0;
+
+    // Create a telescope model directory.
+    const char* tel_model_dir = "apps_test_telescope.tm";
+    create_telescope_model(tel_model_dir, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create a sky model in which the 1 Jy source at the phase centre is
+    // below the culling threshold, and a copy of it without that source.
+    const char* sources[] = {
+            "20.0 -30.0 1 0 0 0 100e6 -0.7 0",
+            "20.0 -30.5 3 0 0 0 100e6 -0.7 0",
+            "20.5 -30.5 3 0 0 0 100e6 -0.7 0"
+    };
+    oskar_Sky* sky_all = oskar_sky_create(OSKAR_DOUBLE, OSKAR_CPU, 3, &status);
+    oskar_Sky* sky_bright = oskar_sky_create(
+            OSKAR_DOUBLE, OSKAR_CPU, 2, &status);
+    for (int i = 0; i < 3; ++i)
+    {
+        oskar_sky_set_source_str(sky_all, i, sources[i], &status);
+        if (i > 0)
+        {
+            oskar_sky_set_source_str(sky_bright, i - 1, sources[i], &status);
+        }
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Use scalar mode, so that the correlator needs Jones K and J.
+    const char* sim_par[] = {
+            "observation/phase_centre_ra_deg", "20.0",
+            "observation/phase_centre_dec_deg", "-30.0",
+            "observation/start_frequency_hz", "100e6",
+            "observation/num_channels", "2",
+            "observation/frequency_inc_hz", "20e6",
+            "observation/start_time_utc", "2000-01-01 12:00:00.0",
+            "observation/length", "01:00:00.0",
+            "observation/num_time_steps", "4",
+            "telescope/input_directory", tel_model_dir,
+            "telescope/pol_mode", "Scalar",
+            "telescope/normalise_beams_at_phase_centre", "true",
+            "telescope/allow_station_beam_duplication", "true",
+            "simulator/double_precision", "true",
+            "simulator/use_gpus", "false",
+            "interferometer/correlation_type", "Cross-correlations",
+            NULL, NULL
+    };
+    SettingsTree* settings = oskar_app_settings_tree(app_interferometer, 0);
+    ASSERT_TRUE(settings->set_values(0, sim_par));
+
+    // Simulate all sources, only the bright ones, and all sources culled.
+    std::vector<double> vis_all, vis_bright, vis_culled;
+    const char* vis_all_file = "apps_test_beam_cull_all.vis";
+    const char* vis_bright_file = "apps_test_beam_cull_bright.vis";
+    const char* vis_culled_file = "apps_test_beam_cull_culled.vis";
+    run_interferometer(settings, sky_all, vis_all_file, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    run_interferometer(settings, sky_bright, vis_bright_file, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_TRUE(settings->set_value(
+            "interferometer/beam_cull_threshold_jy", "2.0"));
+    run_interferometer(settings, sky_all, vis_culled_file, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    read_cross_correlations(vis_all_file, vis_all, &status);
+    read_cross_correlations(vis_bright_file, vis_bright, &status);
+    read_cross_correlations(vis_culled_file, vis_culled, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_GT(vis_culled.size(), 0u);
+    ASSERT_EQ(vis_bright.size(), vis_culled.size());
+    ASSERT_EQ(vis_all.size(), vis_culled.size());
+
+    // Culling must match leaving out the faint source.
+    double max_diff_bright = 0.0, max_diff_all = 0.0;
+    for (size_t i = 0; i < vis_culled.size(); ++i)
+    {
+        const double diff_bright = fabs(vis_culled[i] - vis_bright[i]);
+        const double diff_all = fabs(vis_culled[i] - vis_all[i]);
+        if (diff_bright > max_diff_bright) max_diff_bright = diff_bright;
+        if (diff_all > max_diff_all) max_diff_all = diff_all;
+    }
+    EXPECT_LT(max_diff_bright, 1e-10);
+    EXPECT_GT(max_diff_all, 0.1);
+
+    // Clean up.
+    SettingsTree::free(settings);
+    oskar_sky_free(sky_all, &status);
+    oskar_sky_free(sky_bright, &status);
+    remove(vis_all_file);
+    remove(vis_bright_file);
+    remove(vis_culled_file);
+}
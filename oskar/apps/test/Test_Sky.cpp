@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include "apps/oskar_apps.h"
+#include "math/oskar_cmath.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_version_string.h"
 
@@ -106,3 +107,92 @@ TEST(apps_test, test_sky_model_options)
     // Free the settings.
     SettingsTree::free(sim_settings);
 }
+
+TEST(apps_test, test_sky_model_binary_columns)
+{
+    int status = 0;
+    const int num_sources = 20;
+    const double deg2rad = M_PI / 180.0, arcsec2rad = M_PI / 648000.0;
+
+    // Write a sky model binary file with every parameter set.
+    const char* sky_model_file = "apps_test_sky_columns.osm";
+    oskar_Sky* sky = oskar_sky_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_sources, &status);
+    for (int i = 0; i < num_sources; ++i)
+    {
+        oskar_sky_set_source(sky, i, (20.0 + 0.1 * i) * deg2rad,
+                -30.0 * deg2rad, 1.0 + i, 0.5, 0.25, 0.125, 100e6 + i,
+                -0.7, 2.0, 10.0 * arcsec2rad, 5.0 * arcsec2rad,
+                30.0 * deg2rad, &status);
+    }
+    oskar_sky_write(sky, sky_model_file, &status);
+    oskar_sky_free(sky, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Load it using settings for a simulation in the given mode.
+    const char* sim_par[] = {
+            "sky/oskar_sky_model/file", sky_model_file,
+            "simulator/double_precision", "1",
+            "observation/phase_centre_ra_deg", "20.0",
+            "observation/phase_centre_dec_deg", "-30.0",
+            NULL, NULL
+    };
+    SettingsTree* sim_settings = oskar_app_settings_tree(app_interferometer, 0);
+    ASSERT_TRUE(sim_settings->set_values(0, sim_par));
+    const char* modes[] = {"Full", "Scalar"};
+    for (int i_mode = 0; i_mode < 2; ++i_mode)
+    {
+        const int scalar = (i_mode == 1);
+        ASSERT_TRUE(sim_settings->set_value("telescope/pol_mode",
+                modes[i_mode]));
+        for (int extended_override = 0; extended_override < 2;
+                ++extended_override)
+        {
+            ASSERT_TRUE(sim_settings->set_value(
+                    "sky/oskar_sky_model/extended_sources/FWHM_major",
+                    extended_override ? "20.0" : "0.0"));
+            sky = oskar_settings_to_sky(sim_settings, 0, &status);
+            ASSERT_EQ(0, status) << oskar_get_error_string(status);
+            ASSERT_EQ(num_sources, oskar_sky_num_sources(sky));
+
+            // Unpolarised simulations do not read polarised columns.
+            const double* I = oskar_mem_double_const(oskar_sky_I_const(sky),
+                    &status);
+            const double* Q = oskar_mem_double_const(oskar_sky_Q_const(sky),
+                    &status);
+            const double* V = oskar_mem_double_const(oskar_sky_V_const(sky),
+                    &status);
+            const double* rm = oskar_mem_double_const(
+                    oskar_sky_rotation_measure_rad_const(sky), &status);
+            const double* spix = oskar_mem_double_const(
+                    oskar_sky_spectral_index_const(sky), &status);
+            const double* maj = oskar_mem_double_const(
+                    oskar_sky_fwhm_major_rad_const(sky), &status);
+            for (int i = 0; i < num_sources; ++i)
+            {
+                EXPECT_DOUBLE_EQ(1.0 + i, I[i]);
+                EXPECT_DOUBLE_EQ(scalar ? 0.0 : 0.5, Q[i]);
+                EXPECT_DOUBLE_EQ(scalar ? 0.0 : 0.125, V[i]);
+                EXPECT_DOUBLE_EQ(scalar ? 0.0 : 2.0, rm[i]);
+                EXPECT_DOUBLE_EQ(-0.7, spix[i]);
+                EXPECT_NEAR((extended_override ? 20.0 : 10.0) * arcsec2rad,
+                        maj[i], 1e-15);
+            }
+            oskar_sky_free(sky, &status);
+        }
+    }
+
+    // Everything is read if the sky model is written out again.
+    const char* out_file = "apps_test_sky_columns_out.osm";
+    ASSERT_TRUE(sim_settings->set_value("sky/output_binary_file", out_file));
+    sky = oskar_settings_to_sky(sim_settings, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_DOUBLE_EQ(0.5, oskar_mem_double_const(
+            oskar_sky_Q_const(sky), &status)[0]);
+    oskar_sky_free(sky, &status);
+
+    // Free the settings and remove the files.
+    SettingsTree::free(sim_settings);
+    (void) remove(sky_model_file);
+    (void) remove(out_file);
+}
@@ -714,6 +714,11 @@ static void set_up_device_data(oskar_BeamPattern* h, int* status)
                 oskar_station_work_set_tec_screen_path(d->work,
                         oskar_telescope_tec_screen_path(d->tel));
             }
+
+            /* Beam images have enough pixels to use an FFT for array
+             * factors of stations on a regular lattice. */
+            oskar_station_work_set_array_factor_fft(d->work,
+                    h->coord_grid_type == 'B');
         }
 
         /* Host memory. */
@@ -67,7 +67,8 @@ enum OSKAR_TAG_GROUPS
     OSKAR_TAG_GROUP_SPLINE_DATA      = 9,
     OSKAR_TAG_GROUP_ELEMENT_DATA     = 10,
     OSKAR_TAG_GROUP_VIS_HEADER       = 11,
-    OSKAR_TAG_GROUP_VIS_BLOCK        = 12
+    OSKAR_TAG_GROUP_VIS_BLOCK        = 12,
+    OSKAR_TAG_GROUP_INDEX            = 13
 };
 
 /* Standard metadata tags. */
@@ -92,6 +93,12 @@ enum OSKAR_TAG_RUN
     OSKAR_TAG_RUN_LOG  = 1
 };
 
+/* Standard index tags. */
+enum OSKAR_TAG_INDEX
+{
+    OSKAR_TAG_INDEX_TAGS = 1
+};
+
 /* Binary file error codes are in the range -100 to -149. */
 enum OSKAR_BINARY_ERROR_CODES
 {
@@ -59,6 +59,31 @@ OSKAR_BINARY_EXPORT
 void oskar_binary_read_block(oskar_Binary* handle,
         int chunk_index, size_t data_size, void* data, int* status);
 
+/**
+ * @brief Returns a read-only view of the data for a single tag.
+ *
+ * @details
+ * This low-level function returns a pointer to the payload of a single tag
+ * in the memory-mapped input file, without copying it.
+ * The pointer remains valid until the handle is freed.
+ *
+ * NULL is returned (without an error) if the file could not be mapped
+ * into memory, or if the data are not suitably aligned for their type.
+ * In these cases, use oskar_binary_read_block() instead.
+ *
+ * The tag is specified by its sequence number in the stream, as returned by
+ * oskar_binary_query() or oskar_binary_query_ext().
+ *
+ * @param[in,out] handle   Binary file handle.
+ * @param[in] chunk_index  Sequence index of the chunk's tag in the file.
+ * @param[in,out] status   Status return code.
+ *
+ * @return Pointer to the payload data, or NULL if not available.
+ */
+OSKAR_BINARY_EXPORT
+const void* oskar_binary_read_block_view(oskar_Binary* handle,
+        int chunk_index, int* status);
+
 /**
  * @brief Reads a block of binary data for a single tag from an input stream.
  *
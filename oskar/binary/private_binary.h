@@ -178,6 +178,7 @@ struct oskar_Binary
 
     /* Tag data. */
     int num_chunks;             /* Number of tags in the index. */
+    int num_alloc;              /* Number of tags allocated in the index. */
     int* extended;              /* True if tag is extended. */
     int* data_type;             /* Tag data type. */
     int* id_group;              /* Tag group ID. */
@@ -190,6 +191,24 @@ struct oskar_Binary
     unsigned long* crc;         /* CRC-32C code. */
     unsigned long* crc_header;  /* CRC-32C code of payload identifier. */
 
+    /* Hash table used to look up tags by their identifiers. */
+    int hash_size;              /* Number of buckets (a power of 2). */
+    int* hash_head;             /* First tag in each bucket, or -1. */
+    int* hash_next;             /* Next tag in the same bucket, or -1. */
+
+    /* Tag index to write at the end of the file, when it is closed. */
+    int write_index;            /* If set, write the index when closing. */
+    int64_t write_offset;       /* Offset of the next tag to be written. */
+    size_t index_size;          /* Number of bytes used in index_data. */
+    size_t index_capacity;      /* Number of bytes allocated in index_data. */
+    int index_num_tags;         /* Number of tags in index_data. */
+    unsigned char* index_data;  /* Index entries for all tags written. */
+
+    /* Memory map of the file, if available.
+     * The pages are mapped read-only, so this must not be written to. */
+    unsigned char* map;
+    size_t map_size;
+
     /* Data tables used for CRC computation. */
     oskar_CRC* crc_data;
 };
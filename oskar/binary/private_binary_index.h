@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_BINARY_INDEX_H_
+#define OSKAR_PRIVATE_BINARY_INDEX_H_
+
+#include <binary/private_binary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * When a file opened in write mode is closed, a copy of all the tags written
+ * to it is appended as a standard chunk with group ID OSKAR_TAG_GROUP_INDEX
+ * and tag ID OSKAR_TAG_INDEX_TAGS, so that the tags do not need to be
+ * scanned when the file is opened again for reading.
+ * Readers that do not understand the index will see it as an ordinary chunk.
+ *
+ * The payload of the index chunk contains one entry for each chunk before it:
+ *
+ * Offset  Length  Description
+ * ----------------------------------------------------------------------------
+ *  0      8       Offset of the tag from the start of the file,
+ *                 as little-endian 8-byte integer.
+ *  8      20      The tag, exactly as written in the file.
+ * 28      n       The group name and tag name, if the tag is extended.
+ * 28+n    4       The CRC-32C code of the chunk, exactly as written,
+ *                 or 0 if not present.
+ *
+ * The payload ends with a 24-byte trailer, which is followed only by the
+ * CRC-32C code of the index chunk itself:
+ *
+ * Offset  Length  Description
+ * ----------------------------------------------------------------------------
+ *  0      8       Number of entries, as little-endian 8-byte integer.
+ *  8      8       Offset of the index tag from the start of the file,
+ *                 as little-endian 8-byte integer.
+ * 16      8       The ASCII string "OSKARIDX" (no trailing zero).
+ *
+ * The index is only used if it is consistent with the file, so files that
+ * have been truncated or appended to are still read by scanning all tags.
+ */
+
+/* Checks that a tag is valid and compatible with this system. */
+void oskar_binary_index_check_tag(const oskar_BinaryTag* tag, int* status);
+
+/* Returns the block size stored in a tag. */
+size_t oskar_binary_index_block_size(const oskar_BinaryTag* tag);
+
+/* Stores tag data at position i in the handle, allocating more if needed. */
+void oskar_binary_index_set_tag(oskar_Binary* handle, int i,
+        const oskar_BinaryTag* tag, const char* name_group,
+        const char* name_tag, int64_t payload_offset, unsigned long crc);
+
+/* Removes all tag data from the handle. */
+void oskar_binary_index_clear(oskar_Binary* handle);
+
+/* Records a tag that has just been written to the file. */
+void oskar_binary_index_add(oskar_Binary* handle, const oskar_BinaryTag* tag,
+        const char* name_group, const char* name_tag, const void* crc);
+
+/* Writes the index chunk to the end of the file. */
+void oskar_binary_index_write(oskar_Binary* handle);
+
+/* Loads tag data from the index chunk, returning 1 if successful. */
+int oskar_binary_index_read(oskar_Binary* handle, int64_t file_size);
+
+/* Creates the hash table used to look up tags. */
+void oskar_binary_index_build_hash(oskar_Binary* handle);
+
+/* Returns the index of the first matching tag, or -1 if not found. */
+int oskar_binary_index_find(const oskar_Binary* handle, int extended,
+        unsigned char data_type, int id_group, int id_tag,
+        const char* name_group, const char* name_tag, int user_index);
+
+/* Maps the file into memory for reading, if possible. */
+void oskar_binary_index_map(oskar_Binary* handle, int64_t file_size);
+
+/* Frees all memory used by the index, and unmaps the file. */
+void oskar_binary_index_free(oskar_Binary* handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_BINARY_INDEX_H_ */
@@ -5,6 +5,7 @@
 
 #include "binary/oskar_binary.h"
 #include "binary/private_binary.h"
+#include "binary/private_binary_index.h"
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -16,9 +17,11 @@ void oskar_binary_free(oskar_Binary* handle)
     int i = 0;
     if (!handle) return;
 
-    /* Close the file. */
+    /* Write the tag index and close the file. */
     if (handle->stream)
     {
+        oskar_binary_index_write(handle);
+        oskar_binary_index_free(handle);
         fclose(handle->stream);
     }
 
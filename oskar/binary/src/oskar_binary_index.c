@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "binary/oskar_binary.h"
+#include "binary/oskar_endian.h"
+#include "binary/private_binary.h"
+#include "binary/private_binary_index.h"
+#include <limits.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#ifndef _MSC_VER
+#include <sys/types.h>
+#endif
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef _MSC_VER
+#define FSEEK _fseeki64
+#define FTELL _ftelli64
+#else
+#define FSEEK(S, O, W) fseeko(S, (off_t) (O), W)
+#define FTELL ftello
+#endif
+
+#define TAG_SIZE ((int64_t) sizeof(oskar_BinaryTag))
+#define TRAILER_SIZE 24
+
+static const char index_magic[] = "OSKARIDX";
+
+static uint64_t get_le64(const unsigned char* p)
+{
+    int k = 0;
+    uint64_t v = 0;
+    for (k = 7; k >= 0; --k) v = (v << 8) | p[k];
+    return v;
+}
+
+
+static unsigned long get_le32(const unsigned char* p)
+{
+    return (unsigned long) p[0] | ((unsigned long) p[1] << 8) |
+            ((unsigned long) p[2] << 16) | ((unsigned long) p[3] << 24);
+}
+
+
+static void put_le64(unsigned char* p, uint64_t v)
+{
+    int k = 0;
+    for (k = 0; k < 8; ++k, v >>= 8) p[k] = (unsigned char) (v & 0xFF);
+}
+
+
+static unsigned int hash_tag(int extended, int id_group, int id_tag,
+        const char* name_group, const char* name_tag, int user_index)
+{
+    /* FNV-1a hash of the tag identifiers. */
+    int k = 0;
+    unsigned int h = 2166136261u;
+    const unsigned int u = (unsigned int) user_index;
+    h = (h ^ (unsigned int) extended) * 16777619u;
+    h = (h ^ (unsigned int) id_group) * 16777619u;
+    h = (h ^ (unsigned int) id_tag) * 16777619u;
+    for (k = 0; k < 32; k += 8) h = (h ^ ((u >> k) & 0xFF)) * 16777619u;
+    if (extended)
+    {
+        for (; *name_group; ++name_group)
+        {
+            h = (h ^ (unsigned char) *name_group) * 16777619u;
+        }
+        for (; *name_tag; ++name_tag)
+        {
+            h = (h ^ (unsigned char) *name_tag) * 16777619u;
+        }
+    }
+    return h;
+}
+
+
+static void resize(oskar_Binary* handle, int m)
+{
+    handle->num_alloc = m;
+    handle->extended = (int*) realloc(handle->extended, m * sizeof(int));
+    handle->data_type = (int*) realloc(handle->data_type, m * sizeof(int));
+    handle->id_group = (int*) realloc(handle->id_group, m * sizeof(int));
+    handle->id_tag = (int*) realloc(handle->id_tag, m * sizeof(int));
+    handle->name_group = (char**) realloc(
+            handle->name_group, m * sizeof(char*));
+    handle->name_tag = (char**) realloc(handle->name_tag, m * sizeof(char*));
+    handle->user_index = (int*) realloc(handle->user_index, m * sizeof(int));
+    handle->payload_offset_bytes = (int64_t*) realloc(
+            handle->payload_offset_bytes, m * sizeof(int64_t));
+    handle->payload_size_bytes = (size_t*) realloc(
+            handle->payload_size_bytes, m * sizeof(size_t));
+    handle->crc = (unsigned long*) realloc(
+            handle->crc, m * sizeof(unsigned long));
+    handle->crc_header = (unsigned long*) realloc(
+            handle->crc_header, m * sizeof(unsigned long));
+}
+
+
+static char* copy_name(const char* name, size_t len)
+{
+    char* copy = (char*) malloc(len);
+    if (copy) memcpy(copy, name, len);
+    return copy;
+}
+
+
+void oskar_binary_index_check_tag(const oskar_BinaryTag* tag, int* status)
+{
+    int format_version = 0, element_size = 0;
+
+    /* If the bytes read are not a tag, or the reserved flag bits
+     * are not zero, then return an error. */
+    if (tag->magic[0] != 'T' || tag->magic[2] != 'G'
+            || (tag->flags & 0x1F) != 0)
+    {
+        *status = OSKAR_ERR_BINARY_FILE_INVALID;
+        return;
+    }
+
+    /* Get the binary format version. */
+    format_version = tag->magic[1] - 0x40;
+    if (format_version < 1 || format_version > OSKAR_BINARY_FORMAT_VERSION)
+    {
+        *status = OSKAR_ERR_BINARY_VERSION_UNKNOWN;
+        return;
+    }
+
+    /* Additional checks if format version > 1. */
+    if (format_version > 1)
+    {
+        /* Check system byte order is compatible. */
+        if (oskar_endian() && !(tag->flags & (1 << 5)))
+        {
+            *status = OSKAR_ERR_BINARY_ENDIAN_MISMATCH;
+            return;
+        }
+
+        /* Check data size is compatible. */
+        element_size = tag->magic[3];
+        if (tag->data_type & OSKAR_MATRIX)
+        {
+            element_size /= 4;
+        }
+        if (tag->data_type & OSKAR_COMPLEX)
+        {
+            element_size /= 2;
+        }
+        if (tag->data_type & OSKAR_CHAR)
+        {
+            if (element_size != sizeof(char))
+            {
+                *status = OSKAR_ERR_BINARY_FORMAT_BAD;
+            }
+        }
+        else if (tag->data_type & OSKAR_INT)
+        {
+            if (element_size != sizeof(int))
+            {
+                *status = OSKAR_ERR_BINARY_INT_UNKNOWN;
+            }
+        }
+        else if (tag->data_type & OSKAR_SINGLE)
+        {
+            if (element_size != sizeof(float))
+            {
+                *status = OSKAR_ERR_BINARY_FLOAT_UNKNOWN;
+            }
+        }
+        else if (tag->data_type & OSKAR_DOUBLE)
+        {
+            if (element_size != sizeof(double))
+            {
+                *status = OSKAR_ERR_BINARY_DOUBLE_UNKNOWN;
+            }
+        }
+        else
+        {
+            *status = OSKAR_ERR_BINARY_TYPE_UNKNOWN;
+        }
+    }
+}
+
+
+size_t oskar_binary_index_block_size(const oskar_BinaryTag* tag)
+{
+    return (size_t) get_le64((const unsigned char*) tag->size_bytes);
+}
+
+
+void oskar_binary_index_set_tag(oskar_Binary* handle, int i,
+        const oskar_BinaryTag* tag, const char* name_group,
+        const char* name_tag, int64_t payload_offset, unsigned long crc)
+{
+    unsigned long crc_header = 0;
+    size_t payload_size = 0;
+
+    /* Check if we need to allocate more storage for the tag data. */
+    if (i >= handle->num_alloc)
+    {
+        resize(handle, i < 8 ? 16 : 2 * i);
+    }
+
+    /* Store the data type, IDs and index in native byte order. */
+    handle->extended[i] = (tag->flags & (1 << 7)) ? 1 : 0;
+    handle->data_type[i] = (int) tag->data_type;
+    handle->id_group[i] = (int) tag->group.id;
+    handle->id_tag[i] = (int) tag->tag.id;
+    handle->user_index[i] =
+            (int) get_le32((const unsigned char*) tag->user_index);
+    handle->name_group[i] = 0;
+    handle->name_tag[i] = 0;
+
+    /* Set payload size to block size, minus 4 bytes if CRC-32 present. */
+    payload_size = oskar_binary_index_block_size(tag);
+    payload_size -= (tag->flags & (1 << 6) ? 4 : 0);
+
+    /* Compute the CRC code of the tag. */
+    crc_header = oskar_crc_compute(handle->crc_data, tag,
+            sizeof(oskar_BinaryTag));
+    if (handle->extended[i])
+    {
+        /* Reduce payload size by sum of length of tag names. */
+        payload_size -= (tag->group.bytes + tag->tag.bytes);
+
+        /* Store the tag names and update the CRC code. */
+        handle->name_group[i] = copy_name(name_group, tag->group.bytes);
+        handle->name_tag[i] = copy_name(name_tag, tag->tag.bytes);
+        crc_header = oskar_crc_update(handle->crc_data, crc_header,
+                name_group, tag->group.bytes);
+        crc_header = oskar_crc_update(handle->crc_data, crc_header,
+                name_tag, tag->tag.bytes);
+    }
+    handle->payload_offset_bytes[i] = payload_offset;
+    handle->payload_size_bytes[i] = payload_size;
+    handle->crc_header[i] = crc_header;
+    handle->crc[i] = crc;
+}
+
+
+void oskar_binary_index_clear(oskar_Binary* handle)
+{
+    int i = 0;
+    for (i = 0; i < handle->num_chunks; ++i)
+    {
+        free(handle->name_group[i]);
+        free(handle->name_tag[i]);
+    }
+    handle->num_chunks = 0;
+}
+
+
+void oskar_binary_index_add(oskar_Binary* handle, const oskar_BinaryTag* tag,
+        const char* name_group, const char* name_tag, const void* crc)
+{
+    unsigned char* p = 0;
+    const size_t name_bytes = (tag->flags & (1 << 7)) ?
+            (size_t) (tag->group.bytes + tag->tag.bytes) : 0;
+    const size_t entry_size = 8 + sizeof(oskar_BinaryTag) + name_bytes + 4;
+    if (!handle->write_index) return;
+
+    /* Allocate more space for the index if required, leaving enough room
+     * for the trailer. */
+    if (handle->index_size + entry_size + TRAILER_SIZE >
+            handle->index_capacity)
+    {
+        size_t capacity = 2 * handle->index_capacity;
+        if (capacity < 4096) capacity = 4096;
+        if (capacity < handle->index_size + entry_size + TRAILER_SIZE)
+        {
+            capacity = handle->index_size + entry_size + TRAILER_SIZE;
+        }
+        p = (unsigned char*) realloc(handle->index_data, capacity);
+        if (!p)
+        {
+            handle->write_index = 0;
+            return;
+        }
+        handle->index_data = p;
+        handle->index_capacity = capacity;
+    }
+
+    /* Append the entry. */
+    p = handle->index_data + handle->index_size;
+    put_le64(p, (uint64_t) handle->write_offset);
+    p += 8;
+    memcpy(p, tag, sizeof(oskar_BinaryTag));
+    p += sizeof(oskar_BinaryTag);
+    if (name_bytes > 0)
+    {
+        memcpy(p, name_group, tag->group.bytes);
+        p += tag->group.bytes;
+        memcpy(p, name_tag, tag->tag.bytes);
+        p += tag->tag.bytes;
+    }
+    memcpy(p, crc, 4);
+    handle->index_size += entry_size;
+    handle->index_num_tags++;
+    handle->write_offset += TAG_SIZE +
+            (int64_t) oskar_binary_index_block_size(tag);
+}
+
+
+void oskar_binary_index_write(oskar_Binary* handle)
+{
+    int status = 0;
+    unsigned char* p = 0;
+    if (!handle->write_index || handle->index_num_tags == 0) return;
+    handle->write_index = 0;
+
+    /* Don't write the index if the file is not as expected. */
+    if (FTELL(handle->stream) != handle->write_offset) return;
+
+    /* Append the trailer and write the index chunk. */
+    p = handle->index_data + handle->index_size;
+    put_le64(p, (uint64_t) handle->index_num_tags);
+    put_le64(p + 8, (uint64_t) handle->write_offset);
+    memcpy(p + 16, index_magic, 8);
+    oskar_binary_write(handle, OSKAR_CHAR,
+            OSKAR_TAG_GROUP_INDEX, OSKAR_TAG_INDEX_TAGS, 0,
+            handle->index_size + TRAILER_SIZE, handle->index_data, &status);
+}
+
+
+int oskar_binary_index_read(oskar_Binary* handle, int64_t file_size)
+{
+    int i = 0, num_tags = 0, error = 0;
+    oskar_BinaryTag index_tag;
+    unsigned char trailer[TRAILER_SIZE + 4], *data = 0;
+    const unsigned char *p = 0, *end = 0;
+    size_t block_size = 0;
+    int64_t index_offset = 0, offset = 0;
+    uint64_t num_entries = 0;
+    FILE* stream = handle->stream;
+    const int64_t header_size = (int64_t) sizeof(oskar_BinaryHeader);
+
+    /* Read the trailer at the end of the file, and check it is valid. */
+    if (file_size < header_size + TAG_SIZE + TRAILER_SIZE + 4) return 0;
+    if (FSEEK(stream, file_size - TRAILER_SIZE - 4, SEEK_SET) ||
+            fread(trailer, TRAILER_SIZE + 4, 1, stream) != 1 ||
+            memcmp(trailer + 16, index_magic, 8) != 0)
+    {
+        return 0;
+    }
+    num_entries = get_le64(trailer);
+    index_offset = (int64_t) get_le64(trailer + 8);
+    if (num_entries > (uint64_t) (INT_MAX - 1) ||
+            index_offset < header_size ||
+            index_offset > file_size - TAG_SIZE - TRAILER_SIZE - 4)
+    {
+        return 0;
+    }
+    num_tags = (int) num_entries;
+
+    /* Read the index tag, and check it spans the rest of the file. */
+    if (FSEEK(stream, index_offset, SEEK_SET) ||
+            fread(&index_tag, sizeof(oskar_BinaryTag), 1, stream) != 1)
+    {
+        return 0;
+    }
+    oskar_binary_index_check_tag(&index_tag, &error);
+    block_size = oskar_binary_index_block_size(&index_tag);
+    if (error || (index_tag.flags & (1 << 7)) ||
+            !(index_tag.flags & (1 << 6)) ||
+            index_tag.group.id != OSKAR_TAG_GROUP_INDEX ||
+            index_tag.tag.id != OSKAR_TAG_INDEX_TAGS ||
+            index_offset + TAG_SIZE + (int64_t) block_size != file_size)
+    {
+        return 0;
+    }
+
+    /* Read the index payload and check its CRC code. */
+    data = (unsigned char*) malloc(block_size);
+    if (!data || fread(data, 1, block_size, stream) != block_size ||
+            get_le32(data + block_size - 4) != oskar_crc_update(
+                    handle->crc_data, oskar_crc_compute(handle->crc_data,
+                            &index_tag, sizeof(oskar_BinaryTag)),
+                    data, block_size - 4))
+    {
+        free(data);
+        return 0;
+    }
+
+    /* Store each tag, checking that the tags follow each other. */
+    p = data;
+    end = data + block_size - 4 - TRAILER_SIZE;
+    offset = header_size;
+    for (i = 0; i < num_tags; ++i)
+    {
+        oskar_BinaryTag tag;
+        size_t name_bytes = 0, crc_bytes = 0;
+        const char *name_group = 0, *name_tag = 0;
+        if (end - p < 8 + TAG_SIZE + 4) break;
+        if ((int64_t) get_le64(p) != offset) break;
+        memcpy(&tag, p + 8, sizeof(oskar_BinaryTag));
+        p += 8 + TAG_SIZE;
+        oskar_binary_index_check_tag(&tag, &error);
+        if (error) break;
+        if (tag.flags & (1 << 7))
+        {
+            name_bytes = tag.group.bytes + tag.tag.bytes;
+            if (tag.group.bytes == 0 || tag.tag.bytes == 0 ||
+                    (size_t) (end - p) < name_bytes + 4) break;
+            name_group = (const char*) p;
+            name_tag = (const char*) p + tag.group.bytes;
+            if (name_group[tag.group.bytes - 1] != 0 ||
+                    name_tag[tag.tag.bytes - 1] != 0) break;
+            p += name_bytes;
+        }
+        crc_bytes = (tag.flags & (1 << 6)) ? 4 : 0;
+        block_size = oskar_binary_index_block_size(&tag);
+        if (block_size < name_bytes + crc_bytes) break;
+        oskar_binary_index_set_tag(handle, i, &tag, name_group, name_tag,
+                offset + TAG_SIZE + (int64_t) name_bytes,
+                crc_bytes ? get_le32(p) : 0);
+        handle->num_chunks = i + 1;
+        p += 4;
+        offset += TAG_SIZE + (int64_t) block_size;
+    }
+    if (i < num_tags || p != end || offset != index_offset)
+    {
+        /* Index is inconsistent with the file: discard it. */
+        free(data);
+        oskar_binary_index_clear(handle);
+        return 0;
+    }
+
+    /* Store the index chunk itself, so that the tags are the same as if
+     * the file had been scanned. */
+    oskar_binary_index_set_tag(handle, num_tags, &index_tag, 0, 0,
+            index_offset + TAG_SIZE, get_le32(trailer + TRAILER_SIZE));
+    handle->num_chunks = num_tags + 1;
+    free(data);
+    return 1;
+}
+
+
+void oskar_binary_index_build_hash(oskar_Binary* handle)
+{
+    int i = 0, size = 16;
+    while (size < 2 * handle->num_chunks && size < (INT_MAX / 2)) size *= 2;
+    free(handle->hash_head);
+    free(handle->hash_next);
+    handle->hash_head = (int*) malloc(size * sizeof(int));
+    handle->hash_next = (int*) malloc(
+            (handle->num_chunks > 0 ? handle->num_chunks : 1) * sizeof(int));
+    if (!handle->hash_head || !handle->hash_next)
+    {
+        free(handle->hash_head);
+        free(handle->hash_next);
+        handle->hash_head = 0;
+        handle->hash_next = 0;
+        handle->hash_size = 0;
+        return;
+    }
+    handle->hash_size = size;
+    for (i = 0; i < size; ++i) handle->hash_head[i] = -1;
+
+    /* Insert tags in reverse order, so each bucket is in ascending order. */
+    for (i = handle->num_chunks - 1; i >= 0; --i)
+    {
+        const unsigned int b = hash_tag(handle->extended[i],
+                handle->id_group[i], handle->id_tag[i],
+                handle->name_group[i], handle->name_tag[i],
+                handle->user_index[i]) & (unsigned int) (size - 1);
+        handle->hash_next[i] = handle->hash_head[b];
+        handle->hash_head[b] = i;
+    }
+}
+
+
+static int tag_matches(const oskar_Binary* handle, int i, int extended,
+        unsigned char data_type, int id_group, int id_tag,
+        const char* name_group, const char* name_tag, int user_index)
+{
+    if (handle->extended[i] != extended ||
+            ((handle->data_type[i] != (int) data_type) && data_type) ||
+            handle->id_group[i] != id_group ||
+            handle->id_tag[i] != id_tag ||
+            handle->user_index[i] != user_index)
+    {
+        return 0;
+    }
+    if (extended && (strcmp(name_group, handle->name_group[i]) ||
+            strcmp(name_tag, handle->name_tag[i])))
+    {
+        return 0;
+    }
+    return 1;
+}
+
+
+int oskar_binary_index_find(const oskar_Binary* handle, int extended,
+        unsigned char data_type, int id_group, int id_tag,
+        const char* name_group, const char* name_tag, int user_index)
+{
+    int i = 0;
+    if (handle->hash_size == 0)
+    {
+        /* No hash table, so search linearly. */
+        for (i = handle->query_search_start; i < handle->num_chunks; ++i)
+        {
+            if (tag_matches(handle, i, extended, data_type, id_group, id_tag,
+                    name_group, name_tag, user_index)) return i;
+        }
+        return -1;
+    }
+    i = handle->hash_head[hash_tag(extended, id_group, id_tag,
+            name_group, name_tag, user_index) &
+            (unsigned int) (handle->hash_size - 1)];
+    for (; i >= 0; i = handle->hash_next[i])
+    {
+        if (i < handle->query_search_start) continue;
+        if (tag_matches(handle, i, extended, data_type, id_group, id_tag,
+                name_group, name_tag, user_index)) return i;
+    }
+    return -1;
+}
+
+
+void oskar_binary_index_map(oskar_Binary* handle, int64_t file_size)
+{
+#ifndef _WIN32
+    void* map = 0;
+    if (file_size <= 0 || (uint64_t) file_size > (uint64_t) SIZE_MAX) return;
+    map = mmap(0, (size_t) file_size, PROT_READ, MAP_SHARED,
+            fileno(handle->stream), 0);
+    if (map == MAP_FAILED) return;
+    handle->map = (unsigned char*) map;
+    handle->map_size = (size_t) file_size;
+#else
+    (void) handle;
+    (void) file_size;
+#endif
+}
+
+
+void oskar_binary_index_free(oskar_Binary* handle)
+{
+#ifndef _WIN32
+    if (handle->map)
+    {
+        munmap(handle->map, handle->map_size);
+    }
+#endif
+    handle->map = 0;
+    handle->map_size = 0;
+    free(handle->hash_head);
+    free(handle->hash_next);
+    free(handle->index_data);
+    handle->hash_head = 0;
+    handle->hash_next = 0;
+    handle->index_data = 0;
+    handle->hash_size = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
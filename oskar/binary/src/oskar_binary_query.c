@@ -5,6 +5,7 @@
 
 #include "binary/oskar_binary.h"
 #include "binary/private_binary.h"
+#include "binary/private_binary_index.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -40,21 +41,11 @@ int oskar_binary_query(const oskar_Binary* handle,
     if (*status) return 0;
 
     /* Find the tag in the index. */
-    for (i = handle->query_search_start; i < handle->num_chunks; ++i)
-    {
-        if (!(handle->extended[i]) &&
-                ((handle->data_type[i] == (int) data_type) || (!data_type)) &&
-                handle->id_group[i] == (int) id_group &&
-                handle->id_tag[i] == (int) id_tag &&
-                handle->user_index[i] == user_index)
-        {
-            /* Match found, so break. */
-            break;
-        }
-    }
+    i = oskar_binary_index_find(handle, 0, data_type,
+            (int) id_group, (int) id_tag, 0, 0, user_index);
 
     /* Check if tag is not present. */
-    if (i >= handle->num_chunks)
+    if (i < 0)
     {
         *status = OSKAR_ERR_BINARY_TAG_NOT_FOUND;
         return -1;
@@ -83,31 +74,11 @@ int oskar_binary_query_ext(const oskar_Binary* handle,
     }
 
     /* Find the tag in the index. */
-    for (i = handle->query_search_start; i < handle->num_chunks; ++i)
-    {
-        if (handle->extended[i] &&
-                ((handle->data_type[i] == (int) data_type) || (!data_type)) &&
-                handle->id_group[i] == (int) lgroup &&
-                handle->id_tag[i] == (int) ltag &&
-                handle->user_index[i] == user_index)
-        {
-            /* Possible match: check names. */
-            if (strcmp(name_group, handle->name_group[i]))
-            {
-                continue;
-            }
-            if (strcmp(name_tag, handle->name_tag[i]))
-            {
-                continue;
-            }
-
-            /* Match found, so break. */
-            break;
-        }
-    }
+    i = oskar_binary_index_find(handle, 1, data_type,
+            lgroup, ltag, name_group, name_tag, user_index);
 
     /* Check if tag is not present. */
-    if (i >= handle->num_chunks)
+    if (i < 0)
     {
         *status = OSKAR_ERR_BINARY_TAG_NOT_FOUND;
         return -1;
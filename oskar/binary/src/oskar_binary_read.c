@@ -49,32 +49,46 @@ void oskar_binary_read_block(oskar_Binary* handle,
         return;
     }
 
-    /* Copy the data out of the stream. */
-#ifdef _MSC_VER
-    if (_fseeki64(handle->stream,
-            handle->payload_offset_bytes[chunk_index], SEEK_SET) != 0)
-#else
-    if (fseeko(handle->stream,
-            (off_t) handle->payload_offset_bytes[chunk_index], SEEK_SET) != 0)
-#endif
+    /* Copy the data out of the memory map, if the file is mapped. */
+    const int64_t offset = handle->payload_offset_bytes[chunk_index];
+    if (handle->map)
     {
-        *status = OSKAR_ERR_BINARY_SEEK_FAIL;
-        return;
+        bytes = handle->payload_size_bytes[chunk_index];
+        if ((size_t) offset > handle->map_size ||
+                bytes > handle->map_size - (size_t) offset)
+        {
+            *status = OSKAR_ERR_BINARY_READ_FAIL;
+            return;
+        }
+        memcpy(data, handle->map + offset, bytes);
     }
-
-    /* Read the data in chunks of 2^29 bytes (512 MB). */
-    /* This works around a bug in some versions of fread() which are
-     * limited to reading a maximum of 2 GB at once. */
-    for (p = (char*)data, bytes = handle->payload_size_bytes[chunk_index];
-            bytes > 0; p += chunk_size)
+    else
     {
-        if (bytes < chunk_size) chunk_size = bytes;
-        if (fread(p, 1, chunk_size, handle->stream) != chunk_size)
+        /* Copy the data out of the stream. */
+#ifdef _MSC_VER
+        if (_fseeki64(handle->stream, offset, SEEK_SET) != 0)
+#else
+        if (fseeko(handle->stream, (off_t) offset, SEEK_SET) != 0)
+#endif
         {
-            *status = OSKAR_ERR_BINARY_READ_FAIL;
+            *status = OSKAR_ERR_BINARY_SEEK_FAIL;
             return;
         }
-        bytes -= chunk_size;
+
+        /* Read the data in chunks of 2^29 bytes (512 MB). */
+        /* This works around a bug in some versions of fread() which are
+         * limited to reading a maximum of 2 GB at once. */
+        for (p = (char*)data, bytes = handle->payload_size_bytes[chunk_index];
+                bytes > 0; p += chunk_size)
+        {
+            if (bytes < chunk_size) chunk_size = bytes;
+            if (fread(p, 1, chunk_size, handle->stream) != chunk_size)
+            {
+                *status = OSKAR_ERR_BINARY_READ_FAIL;
+                return;
+            }
+            bytes -= chunk_size;
+        }
     }
 
     /* Check CRC-32 code, if present. */
@@ -91,6 +105,73 @@ void oskar_binary_read_block(oskar_Binary* handle,
     }
 }
 
+const void* oskar_binary_read_block_view(oskar_Binary* handle,
+        int chunk_index, int* status)
+{
+    size_t offset = 0, size = 0, element_size = 0;
+    const unsigned char* ptr = 0;
+
+    /* Check if safe to proceed. */
+    if (*status) return 0;
+
+    /* Check file was opened for reading. */
+    if (handle->open_mode != 'r')
+    {
+        *status = OSKAR_ERR_BINARY_NOT_OPEN_FOR_READ;
+        return 0;
+    }
+
+    /* Check index is in range. */
+    if (chunk_index < 0 || chunk_index >= handle->num_chunks)
+    {
+        *status = OSKAR_ERR_BINARY_TAG_OUT_OF_RANGE;
+        return 0;
+    }
+
+    /* Return if the file is not mapped, or the payload is not in range. */
+    offset = (size_t) handle->payload_offset_bytes[chunk_index];
+    size = handle->payload_size_bytes[chunk_index];
+    if (!handle->map || offset > handle->map_size ||
+            size > handle->map_size - offset)
+    {
+        return 0;
+    }
+
+    /* Return if the payload is not aligned for its data type. */
+    ptr = handle->map + offset;
+    if (handle->data_type[chunk_index] & OSKAR_DOUBLE)
+    {
+        element_size = sizeof(double);
+    }
+    else if (handle->data_type[chunk_index] & OSKAR_SINGLE)
+    {
+        element_size = sizeof(float);
+    }
+    else if (handle->data_type[chunk_index] & OSKAR_INT)
+    {
+        element_size = sizeof(int);
+    }
+    else
+    {
+        element_size = sizeof(char);
+    }
+    if (((uintptr_t) ptr) % element_size != 0) return 0;
+
+    /* Check CRC-32 code, if present. */
+    if (handle->crc[chunk_index])
+    {
+        unsigned long crc = 0;
+        crc = handle->crc_header[chunk_index];
+        crc = oskar_crc_update(handle->crc_data, crc, ptr, size);
+        if (crc != handle->crc[chunk_index])
+        {
+            *status = OSKAR_ERR_BINARY_CRC_FAIL;
+            return 0;
+        }
+    }
+    return ptr;
+}
+
 void oskar_binary_read(oskar_Binary* handle,
         unsigned char data_type, unsigned char id_group, unsigned char id_tag,
         int user_index, size_t data_size, void* data, int* status)
@@ -5,6 +5,7 @@
 
 #include "binary/oskar_binary.h"
 #include "binary/private_binary.h"
+#include "binary/private_binary_index.h"
 #include "binary/oskar_endian.h"
 #include <string.h>
 #include <stdlib.h>
@@ -125,7 +126,11 @@ void oskar_binary_write(oskar_Binary* handle, unsigned char data_type,
     if (fwrite(&crc, 4, 1, handle->stream) != 1)
     {
         *status = OSKAR_ERR_BINARY_WRITE_FAIL;
+        return;
     }
+
+    /* Add the tag to the index. */
+    oskar_binary_index_add(handle, &tag, 0, 0, &crc);
 }
 
 void oskar_binary_write_double(oskar_Binary* handle, unsigned char id_group,
@@ -278,7 +283,11 @@ void oskar_binary_write_ext(oskar_Binary* handle, unsigned char data_type,
     if (fwrite(&crc, 4, 1, handle->stream) != 1)
     {
         *status = OSKAR_ERR_BINARY_WRITE_FAIL;
+        return;
     }
+
+    /* Add the tag to the index. */
+    oskar_binary_index_add(handle, &tag, name_group, name_tag, &crc);
 }
 
 void oskar_binary_write_ext_double(oskar_Binary* handle, const char* name_group,
@@ -25,6 +25,93 @@
     }
 
 
+static void check_tags(const char* filename, int num_tags_expected)
+{
+    int i = 0, status = 0, value = 0, chunk = 0;
+    double value_double = 0.0;
+    oskar_Binary* h = 0;
+    const void* view = 0;
+
+    /* Open the file and check the number of tags. */
+    h = oskar_binary_create(filename, 'r', &status);
+    ASSERT_INT_EQ(0, status);
+    if (num_tags_expected > 0)
+    {
+        ASSERT_INT_EQ(num_tags_expected, oskar_binary_num_tags(h));
+    }
+
+    /* Read the values back in a different order. */
+    for (i = 999; i >= 0; --i)
+    {
+        oskar_binary_read_int(h, 12, 1, i, &value, &status);
+        ASSERT_INT_EQ(0, status);
+        ASSERT_INT_EQ(3 * i, value);
+        if (i % 10 == 0)
+        {
+            oskar_binary_read_ext_double(h, "group", "tag", i,
+                    &value_double, &status);
+            ASSERT_INT_EQ(0, status);
+            ASSERT_DOUBLE_EQ(0.5 * i, value_double);
+        }
+    }
+
+    /* Check that the search start is used for repeated tags. */
+    oskar_binary_read_int(h, 1, 1, 0, &value, &status);
+    ASSERT_INT_EQ(100, value);
+    oskar_binary_set_query_search_start(h, 1, &status);
+    oskar_binary_read_int(h, 1, 1, 0, &value, &status);
+    ASSERT_INT_EQ(200, value);
+    oskar_binary_set_query_search_start(h, 0, &status);
+
+    /* Check the data view, if it is available. */
+    chunk = oskar_binary_query(h, OSKAR_INT, 12, 1, 500, 0, &status);
+    view = oskar_binary_read_block_view(h, chunk, &status);
+    ASSERT_INT_EQ(0, status);
+    if (view)
+    {
+        ASSERT_INT_EQ(1500, *((const int*) view));
+    }
+    oskar_binary_free(h);
+}
+
+
+static void test_index(void)
+{
+    const char filename[] = "temp_test_binary_index.dat";
+    int i = 0, num_tags = 0, status = 0;
+    oskar_Binary* h = 0;
+    FILE* file = 0;
+
+    /* Write a file with many tags. */
+    h = oskar_binary_create(filename, 'w', &status);
+    oskar_binary_write_int(h, 1, 1, 0, 100, &status);
+    for (i = 0; i < 1000; ++i)
+    {
+        oskar_binary_write_int(h, 12, 1, i, 3 * i, &status);
+        if (i % 10 == 0)
+        {
+            oskar_binary_write_ext_double(h, "group", "tag", i, 0.5 * i,
+                    &status);
+        }
+    }
+    oskar_binary_write_int(h, 1, 1, 0, 200, &status);
+    ASSERT_INT_EQ(0, status);
+    oskar_binary_free(h);
+
+    /* Read the file using the index. The index is the last tag. */
+    num_tags = 1000 + 100 + 2 + 1;
+    check_tags(filename, num_tags);
+
+    /* Damage the index trailer, and check the file can still be read. */
+    file = fopen(filename, "r+b");
+    fseek(file, -12, SEEK_END);
+    fputc('X', file);
+    fclose(file);
+    check_tags(filename, num_tags);
+    remove(filename);
+}
+
+
 int main(void)
 {
     const char filename[] = "temp_test_binary_file.dat";
@@ -172,6 +259,9 @@ int main(void)
     /* Remove the file. */
     remove(filename);
 
+    /* Test the tag index. */
+    test_index();
+
     printf("PASS: Test_binary OK.\n");
     return 0;
 }
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_CONVERT_THETA_PHI_TO_HEALPIX_NEST_H_
+#define OSKAR_CONVERT_THETA_PHI_TO_HEALPIX_NEST_H_
+
+/**
+ * @file oskar_convert_theta_phi_to_healpix_nest.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Converts angles to a HEALPix pixel ID for the HEALPix NESTED scheme.
+ *
+ * @details
+ * Returns the pixel containing the direction given by \p theta and \p phi
+ * for a parameter \p nside in the NESTED scheme.
+ *
+ * In this scheme, pixels with consecutive IDs are close together on the
+ * sky at every level of the hierarchy, so the pixel IDs can be used as
+ * sort keys to group nearby directions.
+ *
+ * Note that \p theta is the polar angle (the colatitude) and \p phi is the
+ * east longitude.
+ *
+ * \p nside must be a power of 2 in the range 1 to 8192.
+ */
+OSKAR_EXPORT
+unsigned int oskar_convert_theta_phi_to_healpix_nest_pixel(
+        unsigned int nside, double theta, double phi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
+#include "math/oskar_cmath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Interleaves the bits of x and y, with x in the even bits. */
+static unsigned int xy_to_pixel(unsigned int x, unsigned int y)
+{
+    unsigned int i = 0, p = 0;
+    for (i = 0; i < 16; ++i)
+    {
+        p |= ((x >> i) & 1u) << (2 * i);
+        p |= ((y >> i) & 1u) << (2 * i + 1);
+    }
+    return p;
+}
+
+unsigned int oskar_convert_theta_phi_to_healpix_nest_pixel(
+        unsigned int nside, double theta, double phi)
+{
+    unsigned int face = 0, ix = 0, iy = 0;
+    const int ns = (int) nside;
+    const double z = cos(theta), za = fabs(z);
+
+    /* Longitude in units of 90 degrees, in the range [0, 4). */
+    double tt = fmod(phi, 2.0 * M_PI) / (0.5 * M_PI);
+    if (tt < 0.0) tt += 4.0;
+    if (tt >= 4.0) tt -= 4.0;
+    if (za <= 2.0 / 3.0)
+    {
+        /* Equatorial region. */
+        const double t1 = ns * (0.5 + tt), t2 = ns * z * 0.75;
+        const int jp = (int) (t1 - t2), jm = (int) (t1 + t2);
+        const int ifp = jp / ns, ifm = jm / ns;
+        face = (ifp == ifm) ? (ifp | 4) : ((ifp < ifm) ? ifp : (ifm + 8));
+        ix = (unsigned int) (jm & (ns - 1));
+        iy = (unsigned int) (ns - (jp & (ns - 1)) - 1);
+    }
+    else
+    {
+        /* Polar caps. */
+        int ntt = (int) tt;
+        if (ntt >= 4) ntt = 3;
+        const double tp = tt - ntt, tmp = ns * sqrt(3.0 * (1.0 - za));
+        int jp = (int) (tp * tmp), jm = (int) ((1.0 - tp) * tmp);
+        if (jp >= ns) jp = ns - 1;
+        if (jm >= ns) jm = ns - 1;
+        if (z >= 0.0)
+        {
+            face = (unsigned int) ntt;
+            ix = (unsigned int) (ns - jm - 1);
+            iy = (unsigned int) (ns - jp - 1);
+        }
+        else
+        {
+            face = (unsigned int) (ntt + 8);
+            ix = (unsigned int) jp;
+            iy = (unsigned int) jm;
+        }
+    }
+    return face * nside * nside + xy_to_pixel(ix, iy);
+}
+
+#ifdef __cplusplus
+}
+#endif
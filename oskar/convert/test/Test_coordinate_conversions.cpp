@@ -6,9 +6,11 @@
 #include <gtest/gtest.h>
 
 #include "convert/oskar_convert_cirs_relative_directions_to_enu_directions.h"
+#include "convert/oskar_convert_healpix_ring_to_theta_phi.h"
 #include "convert/oskar_convert_lon_lat_to_relative_directions.h"
 #include "convert/oskar_convert_lon_lat_to_xyz.h"
 #include "convert/oskar_convert_relative_directions_to_lon_lat.h"
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
 #include "convert/oskar_convert_xyz_to_lon_lat.h"
 #include "math/oskar_cmath.h"
 #include "math/oskar_evaluate_image_lm_grid.h"
@@ -41,6 +43,44 @@ TEST(coordinate_conversions, lon_lat_to_xyz)
     ASSERT_NEAR(lat_in[0], lat_out[0], delta);
 }
 
+TEST(coordinate_conversions, theta_phi_to_healpix_nest)
+{
+    const unsigned int nside_max = 64;
+    for (unsigned int nside = 1; nside <= nside_max; nside *= 2)
+    {
+        // The centre of each pixel must map to a different pixel.
+        const unsigned int num_pixels = 12 * nside * nside;
+        std::vector<int> count(num_pixels, 0);
+        for (unsigned int i = 0; i < num_pixels; ++i)
+        {
+            double theta = 0.0, phi = 0.0;
+            oskar_convert_healpix_ring_to_theta_phi_pixel(nside, i,
+                    &theta, &phi);
+            const unsigned int p =
+                    oskar_convert_theta_phi_to_healpix_nest_pixel(
+                            nside, theta, phi);
+            ASSERT_LT(p, num_pixels);
+            count[p]++;
+
+            // Pixels are nested in their parents at lower resolution.
+            for (unsigned int n = nside / 2, q = p / 4; n >= 1; n /= 2, q /= 4)
+            {
+                EXPECT_EQ(q, oskar_convert_theta_phi_to_healpix_nest_pixel(
+                        n, theta, phi));
+            }
+        }
+        for (unsigned int i = 0; i < num_pixels; ++i)
+        {
+            EXPECT_EQ(1, count[i]);
+        }
+    }
+
+    // Negative longitudes wrap around.
+    EXPECT_EQ(oskar_convert_theta_phi_to_healpix_nest_pixel(64, 1.0, 6.0),
+            oskar_convert_theta_phi_to_healpix_nest_pixel(64, 1.0,
+                    6.0 - 2.0 * M_PI));
+}
+
 TEST(coordinate_conversions, ra_dec_to_directions)
 {
     // Image size.
@@ -60,6 +60,56 @@ void oskar_cross_correlate(
         oskar_Mem* vis,
         int* status);
 
+/**
+ * @brief
+ * Cross-correlates station beams, applying the interferometer phase.
+ *
+ * @details
+ * This function gives the same visibilities as evaluating the
+ * interferometer phase (Jones K) using oskar_evaluate_jones_K() with no
+ * source filter, joining it with the station beams using
+ * oskar_jones_join(), and calling oskar_cross_correlate().
+ * The phase is evaluated on the fly, for blocks of sources and stations,
+ * so neither Jones K nor the joined Jones matrices need to be stored.
+ *
+ * The phase factors agree with those from oskar_evaluate_jones_K() to
+ * within 4e-16 in double precision, and 2e-7 in single precision.
+ *
+ * This is currently only available for polarised data in CPU memory,
+ * and OSKAR_ERR_FUNCTION_NOT_AVAILABLE is returned otherwise.
+ *
+ * @param[in]  source_type    Source type (0 = point, 1 = Gaussian).
+ * @param[in]  num_sources    Number of sources to use.
+ * @param[in]  jones          Station beams (Jones E) for each source.
+ * @param[in]  src_flux[4]    Vectors of source Stokes (I, Q, U, V) values.
+ * @param[in]  src_dir[3]     Vectors of source direction cosines.
+ * @param[in]  src_ext[3]     Vectors of extended source parameters.
+ * @param[in]  tel            Telescope model.
+ * @param[in]  station_uvw[3] Station (u, v, w) coordinates, in metres.
+ * @param[in]  gast           Greenwich apparent sidereal time, in radians.
+ * @param[in]  frequency_hz   Current observation frequency, in Hz.
+ * @param[in]  ignore_w_components If true, ignore w in the phase.
+ * @param[in]  offset_out     Output visibility start offset.
+ * @param[out] vis            Output visibility amplitudes.
+ * @param[in,out] status      Status return code.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_phase(
+        int source_type,
+        int num_sources,
+        const oskar_Jones* jones,
+        const oskar_Mem* const src_flux[4],
+        const oskar_Mem* const src_dir[3],
+        const oskar_Mem* const src_ext[3],
+        const oskar_Telescope* tel,
+        const oskar_Mem* const station_uvw[3],
+        double gast,
+        double frequency_hz,
+        int ignore_w_components,
+        int offset_out,
+        oskar_Mem* vis,
+        int* status);
+
 #ifdef __cplusplus
 }
 #endif
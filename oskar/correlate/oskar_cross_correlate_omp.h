@@ -73,7 +73,12 @@ extern "C" {
  * @param[in] time_int_sec   Time averaging interval, in seconds.
  * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
  * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] ignore_w_components If true, ignore w in the phase.
+ * @param[in] wavenumber     If non-zero, the interferometer phase is
+ *                           evaluated for each station using this
+ *                           wavenumber and applied to the Jones matrices.
  * @param[in,out] vis        Modified output complex visibilities.
+ * @param[in,out] status     Status return code.
  */
 OSKAR_EXPORT
 void oskar_cross_correlate_point_omp_f(
@@ -86,7 +91,8 @@ void oskar_cross_correlate_point_omp_f(
         const float* station_x, const float* station_y,
         float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
         float frac_bandwidth, float time_int_sec, float gha0_rad,
-        float dec0_rad, float4c* vis);
+        float dec0_rad, int ignore_w_components,
+        float wavenumber, float4c* vis, int* status);
 
 /**
  * @brief
@@ -121,7 +127,12 @@ void oskar_cross_correlate_point_omp_f(
  * @param[in] time_int_sec   Time averaging interval, in seconds.
  * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
  * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] ignore_w_components If true, ignore w in the phase.
+ * @param[in] wavenumber     If non-zero, the interferometer phase is
+ *                           evaluated for each station using this
+ *                           wavenumber and applied to the Jones matrices.
  * @param[in,out] vis        Modified output complex visibilities.
+ * @param[in,out] status     Status return code.
  */
 OSKAR_EXPORT
 void oskar_cross_correlate_point_omp_d(
@@ -134,7 +145,8 @@ void oskar_cross_correlate_point_omp_d(
         const double* station_x, const double* station_y,
         double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
         double frac_bandwidth, double time_int_sec, double gha0_rad,
-        double dec0_rad, double4c* vis);
+        double dec0_rad, int ignore_w_components,
+        double wavenumber, double4c* vis, int* status);
 
 /**
  * @brief
@@ -175,7 +187,12 @@ void oskar_cross_correlate_point_omp_d(
  * @param[in] time_int_sec   Time averaging interval, in seconds.
  * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
  * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] ignore_w_components If true, ignore w in the phase.
+ * @param[in] wavenumber     If non-zero, the interferometer phase is
+ *                           evaluated for each station using this
+ *                           wavenumber and applied to the Jones matrices.
  * @param[in,out] vis        Modified output complex visibilities.
+ * @param[in,out] status     Status return code.
  */
 OSKAR_EXPORT
 void oskar_cross_correlate_gaussian_omp_f(
@@ -188,7 +205,8 @@ void oskar_cross_correlate_gaussian_omp_f(
         const float* station_w, const float* station_x,
         const float* station_y, float uv_min_lambda, float uv_max_lambda,
         float inv_wavelength, float frac_bandwidth, float time_int_sec,
-        float gha0_rad, float dec0_rad, float4c* vis);
+        float gha0_rad, float dec0_rad, int ignore_w_components,
+        float wavenumber, float4c* vis, int* status);
 
 /**
  * @brief
@@ -229,7 +247,12 @@ void oskar_cross_correlate_gaussian_omp_f(
  * @param[in] time_int_sec   Time averaging interval, in seconds.
  * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
  * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] ignore_w_components If true, ignore w in the phase.
+ * @param[in] wavenumber     If non-zero, the interferometer phase is
+ *                           evaluated for each station using this
+ *                           wavenumber and applied to the Jones matrices.
  * @param[in,out] vis        Modified output complex visibilities.
+ * @param[in,out] status     Status return code.
  */
 OSKAR_EXPORT
 void oskar_cross_correlate_gaussian_omp_d(
@@ -242,7 +265,8 @@ void oskar_cross_correlate_gaussian_omp_d(
         const double* station_w, const double* station_x,
         const double* station_y, double uv_min_lambda, double uv_max_lambda,
         double inv_wavelength, double frac_bandwidth, double time_int_sec,
-        double gha0_rad, double dec0_rad, double4c* vis);
+        double gha0_rad, double dec0_rad, int ignore_w_components,
+        double wavenumber, double4c* vis, int* status);
 
 #ifdef __cplusplus
 }
@@ -8,16 +8,18 @@
 #include "correlate/oskar_cross_correlate_omp.h"
 #include "correlate/oskar_cross_correlate_scalar_cuda.h"
 #include "correlate/oskar_cross_correlate_scalar_omp.h"
+#include "math/oskar_cmath.h"
 #include "utility/oskar_device.h"
 
 #include <float.h>
-#include <math.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void oskar_cross_correlate(
+static void cross_correlate(
+        int apply_phase,
+        int ignore_w_components,
         int source_type,
         int num_sources,
         const oskar_Jones* jones,
@@ -37,6 +39,12 @@ void oskar_cross_correlate(
     double time_avg = 0.0, gha0 = 0.0, dec0 = 0.0;
     if (*status) return;
 
+    /* Get the wavenumber for the interferometer phase, if required.
+     * This is the same as in oskar_evaluate_jones_K(). */
+    const double wavenumber = apply_phase ?
+            2.0 * M_PI * frequency_hz / 299792458.0 : 0.0;
+    const float wavenumber_f = (float) wavenumber;
+
     /* Get the data dimensions. */
     const int num_stations = oskar_telescope_num_stations(tel);
     const int use_extended = (source_type == 1);
@@ -113,6 +121,15 @@ void oskar_cross_correlate(
     x = oskar_telescope_station_true_offset_ecef_metres_const(tel, 0);
     y = oskar_telescope_station_true_offset_ecef_metres_const(tel, 1);
 
+    /* The interferometer phase can only be applied by the CPU
+     * correlator for polarised data. */
+    if (apply_phase &&
+            (location != OSKAR_CPU || !oskar_type_is_matrix(jones_type)))
+    {
+        *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+        return;
+    }
+
     /* Select kernel. */
     if (location == OSKAR_CPU)
     {
@@ -141,7 +158,8 @@ void oskar_cross_correlate(
                         oskar_mem_float_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_float4c(vis, status));
+                        ignore_w_components, wavenumber_f,
+                        oskar_mem_float4c(vis, status), status);
                 break;
             case OSKAR_DOUBLE_COMPLEX_MATRIX:
                 oskar_cross_correlate_gaussian_omp_d(
@@ -164,7 +182,8 @@ void oskar_cross_correlate(
                         oskar_mem_double_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_double4c(vis, status));
+                        ignore_w_components, wavenumber,
+                        oskar_mem_double4c(vis, status), status);
                 break;
             case OSKAR_SINGLE_COMPLEX:
                 oskar_cross_correlate_scalar_gaussian_omp_f(
@@ -233,7 +252,8 @@ void oskar_cross_correlate(
                         oskar_mem_float_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_float4c(vis, status));
+                        ignore_w_components, wavenumber_f,
+                        oskar_mem_float4c(vis, status), status);
                 break;
             case OSKAR_DOUBLE_COMPLEX_MATRIX:
                 oskar_cross_correlate_point_omp_d(
@@ -253,7 +273,8 @@ void oskar_cross_correlate(
                         oskar_mem_double_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_double4c(vis, status));
+                        ignore_w_components, wavenumber,
+                        oskar_mem_double4c(vis, status), status);
                 break;
             case OSKAR_SINGLE_COMPLEX:
                 oskar_cross_correlate_scalar_point_omp_f(
@@ -716,6 +737,47 @@ void oskar_cross_correlate(
     }
 }
 
+void oskar_cross_correlate(
+        int source_type,
+        int num_sources,
+        const oskar_Jones* jones,
+        const oskar_Mem* const src_flux[4],
+        const oskar_Mem* const src_dir[3],
+        const oskar_Mem* const src_ext[3],
+        const oskar_Telescope* tel,
+        const oskar_Mem* const station_uvw[3],
+        double gast,
+        double frequency_hz,
+        int offset_out,
+        oskar_Mem* vis,
+        int* status)
+{
+    cross_correlate(0, 0, source_type, num_sources, jones,
+            src_flux, src_dir, src_ext, tel, station_uvw,
+            gast, frequency_hz, offset_out, vis, status);
+}
+
+void oskar_cross_correlate_phase(
+        int source_type,
+        int num_sources,
+        const oskar_Jones* jones,
+        const oskar_Mem* const src_flux[4],
+        const oskar_Mem* const src_dir[3],
+        const oskar_Mem* const src_ext[3],
+        const oskar_Telescope* tel,
+        const oskar_Mem* const station_uvw[3],
+        double gast,
+        double frequency_hz,
+        int ignore_w_components,
+        int offset_out,
+        oskar_Mem* vis,
+        int* status)
+{
+    cross_correlate(1, ignore_w_components, source_type, num_sources, jones,
+            src_flux, src_dir, src_ext, tel, station_uvw,
+            gast, frequency_hz, offset_out, vis, status);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,10 +6,30 @@
 #include "correlate/define_correlate_utils.h"
 #include "correlate/oskar_cross_correlate_omp.h"
 #include "math/define_multiply.h"
-#include "math/oskar_kahan_sum.h"
+#include "math/private_sincos_fast.h"
 #include "utility/oskar_kernel_macros.h"
 #include "utility/oskar_vector_types.h"
 
+#include <cstdlib>
+
+// Number of stations in each side of a baseline tile.
+#define XCORR_TILE_STATIONS 16
+
+// Number of sources processed for a tile before moving to the next block.
+// The Jones matrices for two station tiles are kept in thread-local
+// buffers of size 2 * 8 * XCORR_TILE_STATIONS * XCORR_BLOCK_SOURCES.
+#define XCORR_BLOCK_SOURCES 64
+
+// Vectorise the source loop, where the compiler supports it.
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define XCORR_SIMD_REDUCTION \
+    _Pragma("omp simd reduction(+:s_ax,s_ay,s_bx,s_by,s_cx,s_cy,s_dx,s_dy)")
+#define XCORR_SIMD _Pragma("omp simd")
+#else
+#define XCORR_SIMD_REDUCTION
+#define XCORR_SIMD
+#endif
+
 template<typename T1, typename T2>
 struct oskar_IsSame
 {
@@ -24,10 +44,72 @@ struct oskar_IsSame<T,T>
     typedef oskar_IsSame<T,T> type;
 };
 
+static inline void oskar_xcorr_sincos(double x, double* s, double* c)
+{
+    oskar_sincos_fast_d(x, s, c);
+}
+
+static inline void oskar_xcorr_sincos(float x, float* s, float* c)
+{
+    oskar_sincos_fast_f(x, s, c);
+}
+
+// Evaluates the interferometer phase (Jones K) of one station for a block
+// of sources, using the same expression as oskar_evaluate_jones_K().
+template<typename REAL>
+void oskar_xcorr_phase(const int ns, const REAL* const RESTRICT l,
+        const REAL* const RESTRICT m, const REAL* const RESTRICT n,
+        const REAL u, const REAL v, const REAL w, const int ignore_w,
+        const REAL wavenumber, REAL* RESTRICT k_re, REAL* RESTRICT k_im)
+{
+    const REAL max_arg = oskar_IsSame<REAL, float>::value ?
+            (REAL) OSKAR_SINCOS_FAST_MAX_ARG_F :
+            (REAL) OSKAR_SINCOS_FAST_MAX_ARG_D;
+    REAL max_phase = (REAL) 0;
+    for (int i = 0; i < ns; ++i)
+    {
+        REAL phase = u * l[i] + v * m[i];
+        if (!ignore_w) phase += w * (n[i] - (REAL) 1);
+        phase *= wavenumber;
+        k_re[i] = phase;
+        if (fabs(phase) > max_phase) max_phase = fabs(phase);
+    }
+    if (max_phase <= max_arg)
+    {
+        XCORR_SIMD
+        for (int i = 0; i < ns; ++i)
+        {
+            REAL s, c;
+            oskar_xcorr_sincos(k_re[i], &s, &c);
+            k_re[i] = c;
+            k_im[i] = s;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < ns; ++i)
+        {
+            const REAL phase = k_re[i];
+            k_re[i] = cos(phase);
+            k_im[i] = sin(phase);
+        }
+    }
+}
+
+// Per-baseline terms for one baseline in a tile.
+// The visibility sums are always held in double precision.
+template<typename REAL>
+struct oskar_XcorrBaseline
+{
+    REAL uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
+    double sum[8];
+    int use;
+};
+
 template
 <
 // Compile-time parameters.
-bool BANDWIDTH_SMEARING, bool TIME_SMEARING, bool GAUSSIAN,
+bool BANDWIDTH_SMEARING, bool TIME_SMEARING, bool GAUSSIAN, bool PHASE,
 typename REAL, typename REAL2, typename REAL4c
 >
 void oskar_xcorr_omp(
@@ -57,109 +139,316 @@ void oskar_xcorr_omp(
         const REAL                   time_int_sec,
         const REAL                   gha0_rad,
         const REAL                   dec0_rad,
-        REAL4c*             RESTRICT vis)
+        const int                    ignore_w,
+        const REAL                   wavenumber,
+        REAL4c*             RESTRICT vis,
+        int*                         status)
 {
-    // Loop over stations.
-#pragma omp parallel for schedule(dynamic, 1)
-    for (int SQ = 0; SQ < num_stations; ++SQ)
+    const int T = XCORR_TILE_STATIONS, B = XCORR_BLOCK_SOURCES;
+    const int smearing = GAUSSIAN || BANDWIDTH_SMEARING || TIME_SMEARING;
+    const int num_tiles = (num_stations + T - 1) / T;
+    const int num_tile_pairs = num_tiles * (num_tiles + 1) / 2;
+    int num_failed = 0;
+    if (num_stations < 2 || num_sources == 0) return;
+
+    // The baselines are split into square tiles of T x T stations, and the
+    // sources are processed in blocks of B for each tile, so that the
+    // Jones matrices for both tiles stay in cache while they are reused
+    // for every baseline in the tile.
+    // Each 2x2 complex matrix is stored as eight separate real arrays
+    // (structure-of-arrays) so that the loop over sources can be vectorised.
+    // If PHASE is set, the Jones matrices do not yet include the
+    // interferometer phase, which is applied here when filling the
+    // tile buffers, so that it never needs to be stored for all sources.
+#pragma omp parallel
     {
-        // Pointer to source vector for station q.
-        const REAL4c* const station_q = &jones[SQ * num_sources];
+        // Thread-local buffers.
+        REAL* RESTRICT tile_p = (REAL*) malloc(8 * T * B * sizeof(REAL));
+        REAL* RESTRICT tile_q = (REAL*) malloc(8 * T * B * sizeof(REAL));
+        REAL* RESTRICT smear = (REAL*) malloc(B * sizeof(REAL));
+        REAL* RESTRICT k_re = (REAL*) malloc(B * sizeof(REAL));
+        REAL* RESTRICT k_im = (REAL*) malloc(B * sizeof(REAL));
+        oskar_XcorrBaseline<REAL>* bl = (oskar_XcorrBaseline<REAL>*)
+                malloc(T * T * sizeof(oskar_XcorrBaseline<REAL>));
+        if (!tile_p || !tile_q || !smear || !k_re || !k_im || !bl)
+        {
+#pragma omp atomic
+            num_failed++;
+        }
 
-        // Loop over baselines for this station.
-        for (int SP = SQ + 1; SP < num_stations; ++SP)
+        // All threads must see every failed allocation before the loop,
+        // so that they all skip it together.
+#pragma omp barrier
+
+        // Loop over tiles.
+#pragma omp for schedule(dynamic, 1)
+        for (int tile = 0; tile < num_tile_pairs; ++tile)
         {
-            REAL uv_len, uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
-            REAL4c m1, m2, sum, guard;
-            OSKAR_CLEAR_COMPLEX_MATRIX(REAL, sum)
-            if (oskar_IsSame<REAL, float>::value)
+            if (num_failed) continue;
+
+            // Get the station tile indices (tile_idx_p >= tile_idx_q).
+            int tile_idx_q = 0, tile_idx_p = tile;
+            while (tile_idx_p >= num_tiles - tile_idx_q)
             {
-                OSKAR_CLEAR_COMPLEX_MATRIX(REAL, guard)
+                tile_idx_p -= num_tiles - tile_idx_q;
+                tile_idx_q++;
             }
+            tile_idx_p += tile_idx_q;
+            const int q0 = tile_idx_q * T, p0 = tile_idx_p * T;
+            const int nq = (num_stations - q0 < T) ? num_stations - q0 : T;
+            const int np = (num_stations - p0 < T) ? num_stations - p0 : T;
 
-            // Pointer to source vector for station p.
-            const REAL4c* const station_p = &jones[SP * num_sources];
-
-            // Get common baseline values.
-            OSKAR_BASELINE_TERMS(REAL, station_u[SP], station_u[SQ],
-                    station_v[SP], station_v[SQ], station_w[SP], station_w[SQ],
-                    uu, vv, ww, uu2, vv2, uuvv, uv_len);
+            // Get common baseline values for all baselines in the tile.
+            for (int jq = 0; jq < nq; ++jq)
+            {
+                for (int jp = 0; jp < np; ++jp)
+                {
+                    const int SQ = q0 + jq, SP = p0 + jp;
+                    oskar_XcorrBaseline<REAL>* b = &bl[jq * T + jp];
+                    REAL uv_len;
+                    b->use = 0;
+                    if (SP <= SQ) continue;
+                    OSKAR_BASELINE_TERMS(REAL,
+                            station_u[SP], station_u[SQ],
+                            station_v[SP], station_v[SQ],
+                            station_w[SP], station_w[SQ],
+                            b->uu, b->vv, b->ww, b->uu2, b->vv2, b->uuvv,
+                            uv_len);
 
-            // Apply the baseline length filter.
-            if (uv_len < uv_min_lambda || uv_len > uv_max_lambda) continue;
+                    // Apply the baseline length filter.
+                    if (uv_len < uv_min_lambda || uv_len > uv_max_lambda)
+                        continue;
 
-            // Compute the deltas for time-average smearing.
-            if (TIME_SMEARING)
-                OSKAR_BASELINE_DELTAS(REAL, station_x[SP], station_x[SQ],
-                        station_y[SP], station_y[SQ], du, dv, dw);
+                    // Compute the deltas for time-average smearing.
+                    if (TIME_SMEARING)
+                        OSKAR_BASELINE_DELTAS(REAL,
+                                station_x[SP], station_x[SQ],
+                                station_y[SP], station_y[SQ],
+                                b->du, b->dv, b->dw);
+                    for (int k = 0; k < 8; ++k) b->sum[k] = 0.0;
+                    b->use = 1;
+                }
+            }
 
-            // Loop over sources.
-            for (int i = 0; i < num_sources; ++i)
+            // Loop over source blocks.
+            for (int s0 = 0; s0 < num_sources; s0 += B)
             {
-                REAL smearing;
-                if (GAUSSIAN)
-                {
-                    const REAL t = source_a[i] * uu2 + source_b[i] * uuvv +
-                            source_c[i] * vv2;
-                    smearing = exp((REAL) -t);
-                }
-                else smearing = (REAL) 1;
-                if (BANDWIDTH_SMEARING || TIME_SMEARING)
+                const int ns = (num_sources - s0 < B) ? num_sources - s0 : B;
+
+                // Copy Jones matrices for stations q into the tile buffer.
+                for (int jq = 0; jq < nq; ++jq)
                 {
-                    const REAL l = source_l[i];
-                    const REAL m = source_m[i];
-                    const REAL n = source_n[i] - (REAL) 1;
-                    if (BANDWIDTH_SMEARING)
+                    const int SQ = q0 + jq;
+                    const REAL4c* const in = &jones[SQ * num_sources];
+                    REAL* RESTRICT out = &tile_q[jq * 8 * B];
+                    if (PHASE)
+                        oskar_xcorr_phase<REAL>(ns, &source_l[s0],
+                                &source_m[s0], &source_n[s0],
+                                station_u[SQ], station_v[SQ], station_w[SQ],
+                                ignore_w, wavenumber, k_re, k_im);
+                    for (int i = 0; i < ns; ++i)
                     {
-                        const REAL t = uu * l + vv * m + ww * n;
-                        smearing *= OSKAR_SINC(REAL, t);
+                        REAL4c m = in[s0 + i];
+                        if (PHASE)
+                        {
+                            REAL2 k;
+                            k.x = k_re[i]; k.y = k_im[i];
+                            OSKAR_MUL_COMPLEX_MATRIX_COMPLEX_SCALAR_IN_PLACE(
+                                    REAL2, m, k)
+                        }
+                        out[0 * B + i] = m.a.x; out[1 * B + i] = m.a.y;
+                        out[2 * B + i] = m.b.x; out[3 * B + i] = m.b.y;
+                        out[4 * B + i] = m.c.x; out[5 * B + i] = m.c.y;
+                        out[6 * B + i] = m.d.x; out[7 * B + i] = m.d.y;
                     }
-                    if (TIME_SMEARING)
+                }
+
+                // Multiply Jones matrices for stations p with source
+                // brightness matrices, and store in the tile buffer.
+                for (int jp = 0; jp < np; ++jp)
+                {
+                    const int SP = p0 + jp;
+                    const REAL4c* const in = &jones[SP * num_sources];
+                    REAL* RESTRICT out = &tile_p[jp * 8 * B];
+                    if (PHASE)
+                        oskar_xcorr_phase<REAL>(ns, &source_l[s0],
+                                &source_m[s0], &source_n[s0],
+                                station_u[SP], station_v[SP], station_w[SP],
+                                ignore_w, wavenumber, k_re, k_im);
+                    for (int i = 0; i < ns; ++i)
                     {
-                        const REAL t = du * l + dv * m + dw * n;
-                        smearing *= OSKAR_SINC(REAL, t);
+                        REAL4c m1, m2;
+                        const int s = s0 + i;
+                        OSKAR_CONSTRUCT_B(REAL, m2,
+                                source_I[s], source_Q[s],
+                                source_U[s], source_V[s])
+                        OSKAR_LOAD_MATRIX(m1, in[s])
+                        if (PHASE)
+                        {
+                            REAL2 k;
+                            k.x = k_re[i]; k.y = k_im[i];
+                            OSKAR_MUL_COMPLEX_MATRIX_COMPLEX_SCALAR_IN_PLACE(
+                                    REAL2, m1, k)
+                        }
+                        OSKAR_MUL_COMPLEX_MATRIX_HERMITIAN_IN_PLACE(
+                                REAL2, m1, m2)
+                        out[0 * B + i] = m1.a.x; out[1 * B + i] = m1.a.y;
+                        out[2 * B + i] = m1.b.x; out[3 * B + i] = m1.b.y;
+                        out[4 * B + i] = m1.c.x; out[5 * B + i] = m1.c.y;
+                        out[6 * B + i] = m1.d.x; out[7 * B + i] = m1.d.y;
                     }
                 }
 
-                // Construct source brightness matrix.
-                OSKAR_CONSTRUCT_B(REAL, m2,
-                        source_I[i], source_Q[i], source_U[i], source_V[i])
+                // Loop over baselines in the tile.
+                for (int jq = 0; jq < nq; ++jq)
+                {
+                    const REAL* RESTRICT q = &tile_q[jq * 8 * B];
+                    for (int jp = 0; jp < np; ++jp)
+                    {
+                        oskar_XcorrBaseline<REAL>* b = &bl[jq * T + jp];
+                        if (!b->use) continue;
+                        const REAL* RESTRICT p = &tile_p[jp * 8 * B];
 
-                // Multiply first Jones matrix with source brightness matrix.
-                OSKAR_LOAD_MATRIX(m1, station_p[i])
-                OSKAR_MUL_COMPLEX_MATRIX_HERMITIAN_IN_PLACE(REAL2, m1, m2)
+                        // Evaluate smearing terms for this block of sources.
+                        if (smearing)
+                        {
+                            for (int i = 0; i < ns; ++i)
+                            {
+                                const int s = s0 + i;
+                                REAL f;
+                                if (GAUSSIAN)
+                                {
+                                    const REAL t = source_a[s] * b->uu2 +
+                                            source_b[s] * b->uuvv +
+                                            source_c[s] * b->vv2;
+                                    f = exp((REAL) -t);
+                                }
+                                else f = (REAL) 1;
+                                if (BANDWIDTH_SMEARING || TIME_SMEARING)
+                                {
+                                    const REAL l = source_l[s];
+                                    const REAL m = source_m[s];
+                                    const REAL n = source_n[s] - (REAL) 1;
+                                    if (BANDWIDTH_SMEARING)
+                                    {
+                                        const REAL t = b->uu * l +
+                                                b->vv * m + b->ww * n;
+                                        f *= OSKAR_SINC(REAL, t);
+                                    }
+                                    if (TIME_SMEARING)
+                                    {
+                                        const REAL t = b->du * l +
+                                                b->dv * m + b->dw * n;
+                                        f *= OSKAR_SINC(REAL, t);
+                                    }
+                                }
+                                smear[i] = f;
+                            }
+                        }
 
-                // Multiply result with second (Hermitian transposed) Jones matrix.
-                OSKAR_LOAD_MATRIX(m2, station_q[i])
-                OSKAR_MUL_COMPLEX_MATRIX_CONJUGATE_TRANSPOSE_IN_PLACE(REAL2, m1, m2)
+                        // Multiply (J_p * B) by conjugate transpose of J_q,
+                        // and accumulate over sources in the block.
+                        // The products are formed in the working precision,
+                        // but summed in double precision. In single
+                        // precision this is as accurate as a Kahan sum,
+                        // but unlike one, it can still be vectorised.
+                        double s_ax = 0, s_ay = 0, s_bx = 0, s_by = 0;
+                        double s_cx = 0, s_cy = 0, s_dx = 0, s_dy = 0;
+                        XCORR_SIMD_REDUCTION
+                        for (int i = 0; i < ns; ++i)
+                        {
+                            const REAL p_ax = p[0 * B + i], p_ay = p[1 * B + i];
+                            const REAL p_bx = p[2 * B + i], p_by = p[3 * B + i];
+                            const REAL p_cx = p[4 * B + i], p_cy = p[5 * B + i];
+                            const REAL p_dx = p[6 * B + i], p_dy = p[7 * B + i];
+                            const REAL q_ax = q[0 * B + i], q_ay = q[1 * B + i];
+                            const REAL q_bx = q[2 * B + i], q_by = q[3 * B + i];
+                            const REAL q_cx = q[4 * B + i], q_cy = q[5 * B + i];
+                            const REAL q_dx = q[6 * B + i], q_dy = q[7 * B + i];
+                            REAL ax, ay, bx, by, cx, cy, dx, dy;
+                            ax = p_ax * q_ax + p_ay * q_ay +
+                                    p_bx * q_bx + p_by * q_by;
+                            ay = p_ay * q_ax - p_ax * q_ay +
+                                    p_by * q_bx - p_bx * q_by;
+                            bx = p_bx * q_dx + p_by * q_dy +
+                                    p_ax * q_cx + p_ay * q_cy;
+                            by = p_by * q_dx - p_bx * q_dy +
+                                    p_ay * q_cx - p_ax * q_cy;
+                            cx = p_cx * q_ax + p_cy * q_ay +
+                                    p_dx * q_bx + p_dy * q_by;
+                            cy = p_cy * q_ax - p_cx * q_ay +
+                                    p_dy * q_bx - p_dx * q_by;
+                            dx = p_dx * q_dx + p_dy * q_dy +
+                                    p_cx * q_cx + p_cy * q_cy;
+                            dy = p_dy * q_dx - p_dx * q_dy +
+                                    p_cy * q_cx - p_cx * q_cy;
+                            if (smearing)
+                            {
+                                const REAL f = smear[i];
+                                ax *= f; ay *= f; bx *= f; by *= f;
+                                cx *= f; cy *= f; dx *= f; dy *= f;
+                            }
+                            s_ax += ax; s_ay += ay; s_bx += bx; s_by += by;
+                            s_cx += cx; s_cy += cy; s_dx += dx; s_dy += dy;
+                        }
 
-                // Multiply result by smearing term and accumulate.
-                if (oskar_IsSame<REAL, float>::value)
-                {
-                    OSKAR_KAHAN_SUM_MULTIPLY_COMPLEX_MATRIX(
-                            REAL, sum, m1, smearing, guard)
+                        // Add the block sum to the baseline total.
+                        b->sum[0] += s_ax; b->sum[1] += s_ay;
+                        b->sum[2] += s_bx; b->sum[3] += s_by;
+                        b->sum[4] += s_cx; b->sum[5] += s_cy;
+                        b->sum[6] += s_dx; b->sum[7] += s_dy;
+                    }
                 }
-                else
+            }
+
+            // Add results to the baseline visibilities.
+            for (int jq = 0; jq < nq; ++jq)
+            {
+                for (int jp = 0; jp < np; ++jp)
                 {
-                    OSKAR_MUL_ADD_COMPLEX_MATRIX_SCALAR(sum, m1, smearing)
+                    const oskar_XcorrBaseline<REAL>* b = &bl[jq * T + jp];
+                    if (!b->use) continue;
+                    const int SQ = q0 + jq, SP = p0 + jp;
+                    const int i = OSKAR_BASELINE_INDEX(num_stations, SP, SQ) +
+                            offset_out;
+                    vis[i].a.x += (REAL) b->sum[0];
+                    vis[i].a.y += (REAL) b->sum[1];
+                    vis[i].b.x += (REAL) b->sum[2];
+                    vis[i].b.y += (REAL) b->sum[3];
+                    vis[i].c.x += (REAL) b->sum[4];
+                    vis[i].c.y += (REAL) b->sum[5];
+                    vis[i].d.x += (REAL) b->sum[6];
+                    vis[i].d.y += (REAL) b->sum[7];
                 }
             }
-
-            // Add result to the baseline visibility.
-            int i = OSKAR_BASELINE_INDEX(num_stations, SP, SQ) + offset_out;
-            OSKAR_ADD_COMPLEX_MATRIX_IN_PLACE(vis[i], sum);
         }
+
+        // Free thread-local buffers.
+        free(tile_p);
+        free(tile_q);
+        free(smear);
+        free(k_re);
+        free(k_im);
+        free(bl);
     }
+    if (num_failed) *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
 }
 
-#define XCORR_KERNEL(BS, TS, GAUSSIAN, REAL, REAL2, REAL4c)                 \
-        oskar_xcorr_omp<BS, TS, GAUSSIAN, REAL, REAL2, REAL4c>              \
+#define XCORR_KERNEL_P(BS, TS, GAUSSIAN, PHASE, REAL, REAL2, REAL4c)       \
+        oskar_xcorr_omp<BS, TS, GAUSSIAN, PHASE, REAL, REAL2, REAL4c>       \
         (num_sources, num_stations, offset_out, d_jones,                    \
                 d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_a, d_b, d_c,           \
                 d_station_u, d_station_v, d_station_w,                      \
                 d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,     \
                 inv_wavelength, frac_bandwidth, time_int_sec,               \
-                gha0_rad, dec0_rad, d_vis);
+                gha0_rad, dec0_rad, ignore_w_components, wavenumber, d_vis, \
+                status);
+
+#define XCORR_KERNEL(BS, TS, GAUSSIAN, REAL, REAL2, REAL4c) {              \
+        if (wavenumber != (REAL)0)                                          \
+            XCORR_KERNEL_P(BS, TS, GAUSSIAN, true, REAL, REAL2, REAL4c)     \
+        else                                                                \
+            XCORR_KERNEL_P(BS, TS, GAUSSIAN, false, REAL, REAL2, REAL4c) }
 
 #define XCORR_SELECT(GAUSSIAN, REAL, REAL2, REAL4c)                         \
         if (frac_bandwidth == (REAL)0 && time_int_sec == (REAL)0)           \
@@ -181,7 +470,8 @@ void oskar_cross_correlate_point_omp_f(
         const float* d_station_x, const float* d_station_y,
         float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
         float frac_bandwidth, float time_int_sec, float gha0_rad,
-        float dec0_rad, float4c* d_vis)
+        float dec0_rad, int ignore_w_components, float wavenumber,
+        float4c* d_vis, int* status)
 {
     const float *d_a = 0, *d_b = 0, *d_c = 0;
     XCORR_SELECT(false, float, float2, float4c)
@@ -197,7 +487,8 @@ void oskar_cross_correlate_point_omp_d(
         const double* d_station_x, const double* d_station_y,
         double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
         double frac_bandwidth, double time_int_sec, double gha0_rad,
-        double dec0_rad, double4c* d_vis)
+        double dec0_rad, int ignore_w_components, double wavenumber,
+        double4c* d_vis, int* status)
 {
     const double *d_a = 0, *d_b = 0, *d_c = 0;
     XCORR_SELECT(false, double, double2, double4c)
@@ -213,7 +504,8 @@ void oskar_cross_correlate_gaussian_omp_f(
         const float* d_station_w, const float* d_station_x,
         const float* d_station_y, float uv_min_lambda, float uv_max_lambda,
         float inv_wavelength, float frac_bandwidth, float time_int_sec,
-        float gha0_rad, float dec0_rad, float4c* d_vis)
+        float gha0_rad, float dec0_rad, int ignore_w_components,
+        float wavenumber, float4c* d_vis, int* status)
 {
     XCORR_SELECT(true, float, float2, float4c)
 }
@@ -228,7 +520,8 @@ void oskar_cross_correlate_gaussian_omp_d(
         const double* d_station_w, const double* d_station_x,
         const double* d_station_y, double uv_min_lambda, double uv_max_lambda,
         double inv_wavelength, double frac_bandwidth, double time_int_sec,
-        double gha0_rad, double dec0_rad, double4c* d_vis)
+        double gha0_rad, double dec0_rad, int ignore_w_components,
+        double wavenumber, double4c* d_vis, int* status)
 {
     XCORR_SELECT(true, double, double2, double4c)
 }
@@ -8,8 +8,13 @@
 #include "utility/oskar_timer.h"
 
 #include "correlate/oskar_cross_correlate.h"
+#include "interferometer/oskar_evaluate_jones_K.h"
+#include "interferometer/oskar_jones.h"
 #include "utility/oskar_get_error_string.h"
 #include "math/oskar_kahan_sum.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <cstdlib>
 
 // Comment out this line to disable benchmark timer printing.
@@ -221,6 +226,83 @@ protected:
                 time2 * 1000.0);
 #endif
     }
+
+    void run_phase_test(int prec, int extended, int ignore_w,
+            double time_average, double freq_average)
+    {
+        int status = 0;
+        const double frequency = 100e6;
+        create_test_data(prec, OSKAR_CPU, 1);
+        const int num_baselines = oskar_telescope_num_baselines(tel);
+        const int type = prec | OSKAR_COMPLEX | OSKAR_MATRIX;
+        oskar_Mem* vis1 = oskar_mem_create(type, OSKAR_CPU,
+                num_baselines, &status);
+        oskar_Mem* vis2 = oskar_mem_create(type, OSKAR_CPU,
+                num_baselines, &status);
+        oskar_mem_clear_contents(vis1, &status);
+        oskar_mem_clear_contents(vis2, &status);
+        oskar_telescope_set_channel_bandwidth(tel, freq_average);
+        oskar_telescope_set_time_average(tel, time_average);
+        for (int i = 0; i < 3; ++i)
+        {
+            oskar_mem_scale_real(uvw[i], 2000.0, 0, num_stations, &status);
+        }
+
+        // Evaluate Jones K, join it with the station beams and correlate.
+        oskar_Jones* K = oskar_jones_create(prec | OSKAR_COMPLEX,
+                OSKAR_CPU, num_stations, num_sources, &status);
+        oskar_Jones* J = oskar_jones_create(type,
+                OSKAR_CPU, num_stations, num_sources, &status);
+        oskar_evaluate_jones_K(K, num_sources, src_dir[0], src_dir[1],
+                src_dir[2], uvw[0], uvw[1], uvw[2], frequency, src_flux[0],
+                -DBL_MAX, DBL_MAX, ignore_w, &status);
+        oskar_jones_join(J, K, jones, &status);
+        oskar_cross_correlate(extended, num_sources, J,
+                src_flux, src_dir, src_ext,
+                tel, uvw, 1.0, frequency, 0, vis1, &status);
+
+        // Apply the phase in the correlator instead.
+        oskar_cross_correlate_phase(extended, num_sources, jones,
+                src_flux, src_dir, src_ext,
+                tel, uvw, 1.0, frequency, ignore_w, 0, vis2, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Compare results, relative to the largest visibility amplitude.
+        oskar_Mem* v1 = oskar_mem_convert_precision(vis1, OSKAR_DOUBLE,
+                &status);
+        oskar_Mem* v2 = oskar_mem_convert_precision(vis2, OSKAR_DOUBLE,
+                &status);
+        const double* p1 = oskar_mem_double_const(v1, &status);
+        const double* p2 = oskar_mem_double_const(v2, &status);
+        double max_diff = 0.0, max_val = 0.0;
+        for (int i = 0; i < 8 * num_baselines; ++i)
+        {
+            max_diff = std::max(max_diff, fabs(p1[i] - p2[i]));
+            max_val = std::max(max_val, fabs(p1[i]));
+        }
+        EXPECT_LT(max_diff / max_val, prec == OSKAR_DOUBLE ? 1e-14 : 1e-6);
+
+        // The scalar version is not available.
+        oskar_Jones* scalar = oskar_jones_create(prec | OSKAR_COMPLEX,
+                OSKAR_CPU, num_stations, num_sources, &status);
+        oskar_Mem* vis3 = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_baselines, &status);
+        oskar_cross_correlate_phase(extended, num_sources, scalar,
+                src_flux, src_dir, src_ext,
+                tel, uvw, 1.0, frequency, ignore_w, 0, vis3, &status);
+        EXPECT_EQ((int) OSKAR_ERR_FUNCTION_NOT_AVAILABLE, status);
+        status = 0;
+
+        oskar_jones_free(scalar, &status);
+        oskar_jones_free(K, &status);
+        oskar_jones_free(J, &status);
+        oskar_mem_free(vis1, &status);
+        oskar_mem_free(vis2, &status);
+        oskar_mem_free(vis3, &status);
+        oskar_mem_free(v1, &status);
+        oskar_mem_free(v2, &status);
+        destroy_test_data();
+    }
 };
 
 
@@ -252,6 +334,135 @@ TEST_F(cross_correlate, CPU)
     }
 }
 
+// Check that applying the interferometer phase in the correlator gives
+// the same result as joining it with the station beams first.
+TEST_F(cross_correlate, CPU_apply_phase)
+{
+    const int precision[] = {OSKAR_SINGLE, OSKAR_DOUBLE};
+    for (int i_prec = 0; i_prec < 2; ++i_prec)
+    {
+        for (int extended = 0; extended < 2; ++extended)
+        {
+            for (int ignore_w = 0; ignore_w < 2; ++ignore_w)
+            {
+                run_phase_test(precision[i_prec], extended, ignore_w,
+                        0.0, 0.0);
+            }
+        }
+        run_phase_test(precision[i_prec], 0, 0, 10.0, 1.e4);
+    }
+}
+
+// Rounds values in double precision to single precision, and copies them.
+static void round_to_single(oskar_Mem* in_out_d, oskar_Mem* out_f)
+{
+    int status = 0;
+    double* d = oskar_mem_double(in_out_d, &status);
+    float* f = oskar_mem_float(out_f, &status);
+    const size_t n = oskar_mem_length(in_out_d) *
+            oskar_mem_element_size(oskar_mem_type(in_out_d)) / sizeof(double);
+    for (size_t i = 0; i < n; ++i)
+    {
+        f[i] = (float) d[i];
+        d[i] = (double) f[i];
+    }
+}
+
+// Check the accuracy of the sum over many sources in single precision,
+// using inputs that are exactly representable in both precisions.
+TEST(cross_correlate_accuracy, CPU_single)
+{
+    int status = 0;
+    const int num_sources = 20000, num_stations = 20;
+    const int prec[] = {OSKAR_DOUBLE, OSKAR_SINGLE};
+    const int type = OSKAR_COMPLEX | OSKAR_MATRIX;
+    oskar_Jones* jones[2];
+    oskar_Telescope* tel[2];
+    oskar_Mem *src_flux[2][4], *src_dir[2][3], *src_ext[2][3], *uvw[2][3];
+    oskar_Mem *vis[2];
+    srand(2);
+    for (int p = 0; p < 2; ++p)
+    {
+        jones[p] = oskar_jones_create(prec[p] | type, OSKAR_CPU,
+                num_stations, num_sources, &status);
+        tel[p] = oskar_telescope_create(prec[p], OSKAR_CPU,
+                num_stations, &status);
+        for (int i = 0; i < 4; ++i)
+        {
+            src_flux[p][i] = oskar_mem_create(prec[p], OSKAR_CPU,
+                    num_sources, &status);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            src_dir[p][i] = oskar_mem_create(prec[p], OSKAR_CPU,
+                    num_sources, &status);
+            src_ext[p][i] = oskar_mem_create(prec[p], OSKAR_CPU,
+                    num_sources, &status);
+            uvw[p][i] = oskar_mem_create(prec[p], OSKAR_CPU,
+                    num_stations, &status);
+        }
+        vis[p] = oskar_mem_create(prec[p] | type, OSKAR_CPU,
+                oskar_telescope_num_baselines(tel[p]), &status);
+        oskar_mem_clear_contents(vis[p], &status);
+    }
+    oskar_mem_random_range(oskar_jones_mem(jones[0]), -1.0, 1.0, &status);
+    round_to_single(oskar_jones_mem(jones[0]), oskar_jones_mem(jones[1]));
+    for (int i = 0; i < 4; ++i)
+    {
+        oskar_mem_random_range(src_flux[0][i], i == 0 ? 1.0 : -0.1,
+                i == 0 ? 2.0 : 0.1, &status);
+        round_to_single(src_flux[0][i], src_flux[1][i]);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        oskar_mem_random_range(src_dir[0][i], 0.1, 0.9, &status);
+        oskar_mem_random_range(uvw[0][i], 1.0, 5.0, &status);
+        round_to_single(src_dir[0][i], src_dir[1][i]);
+        round_to_single(uvw[0][i], uvw[1][i]);
+        oskar_mem_clear_contents(src_ext[0][i], &status);
+        oskar_mem_clear_contents(src_ext[1][i], &status);
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    for (int p = 0; p < 2; ++p)
+    {
+        oskar_cross_correlate(0, num_sources, jones[p],
+                src_flux[p], src_dir[p], src_ext[p],
+                tel[p], uvw[p], 1.0, 100e6, 0, vis[p], &status);
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Compare each visibility with the result in double precision,
+    // relative to the amplitude of the largest term in its matrix.
+    const int num_baselines = oskar_telescope_num_baselines(tel[0]);
+    const double* v_d = oskar_mem_double_const(vis[0], &status);
+    const float* v_f = oskar_mem_float_const(vis[1], &status);
+    double max_rel_error = 0.0;
+    for (int b = 0; b < num_baselines; ++b)
+    {
+        double max_diff = 0.0, max_val = 0.0;
+        for (int i = 8 * b; i < 8 * (b + 1); ++i)
+        {
+            max_diff = std::max(max_diff, fabs(v_d[i] - v_f[i]));
+            max_val = std::max(max_val, fabs(v_d[i]));
+        }
+        max_rel_error = std::max(max_rel_error, max_diff / max_val);
+    }
+    EXPECT_LT(max_rel_error, 5e-7);
+    for (int p = 0; p < 2; ++p)
+    {
+        oskar_jones_free(jones[p], &status);
+        oskar_telescope_free(tel[p], &status);
+        for (int i = 0; i < 4; ++i) oskar_mem_free(src_flux[p][i], &status);
+        for (int i = 0; i < 3; ++i)
+        {
+            oskar_mem_free(src_dir[p][i], &status);
+            oskar_mem_free(src_ext[p][i], &status);
+            oskar_mem_free(uvw[p][i], &status);
+        }
+        oskar_mem_free(vis[p], &status);
+    }
+}
+
 #ifdef OSKAR_HAVE_CUDA
 // Check for consistency between CPU and CUDA versions.
 TEST_F(cross_correlate, CUDA)
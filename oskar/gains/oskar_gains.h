@@ -42,6 +42,25 @@ void oskar_gains_free(oskar_Gains* h, int* status);
 OSKAR_EXPORT
 void oskar_gains_open_hdf5(oskar_Gains* h, const char* path, int* status);
 
+/**
+ * @brief
+ * Sets the memory limits of the gain table cache.
+ *
+ * @details
+ * Sets the maximum number of bytes held in the gain table cache, and the
+ * maximum size of each page of time samples, if the whole table does not
+ * fit in the cache. A value of 0 selects the default limit.
+ *
+ * This must be called before oskar_gains_open_hdf5().
+ *
+ * @param[in,out] h          Handle to gain model.
+ * @param[in] cache_bytes    Maximum size of the cache, in bytes.
+ * @param[in] page_bytes     Maximum size of each page, in bytes.
+ */
+OSKAR_EXPORT
+void oskar_gains_set_cache_size(oskar_Gains* h, size_t cache_bytes,
+        size_t page_bytes);
+
 #ifdef __cplusplus
 }
 #endif
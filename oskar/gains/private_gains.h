@@ -8,12 +8,32 @@
 
 #include <mem/oskar_mem.h>
 #include <utility/oskar_hdf5.h>
+#include <utility/oskar_thread.h>
+
+/* Cache of gain table pages, shared between copies of the gain model.
+ * Each page holds all channels and antennas for a block of time samples,
+ * in the precision of the gain model. */
+struct oskar_GainsCache
+{
+    oskar_Mutex* mutex;
+    int refcount;
+    int num_pages;        /* Maximum number of resident pages. */
+    int page_num_times;   /* Number of time samples per page. */
+    unsigned long long counter; /* Access counter, for page replacement. */
+    int* page_time_start; /* First time index in each page, or -1 if empty. */
+    unsigned long long* page_last_used; /* Counter value when page last used. */
+    oskar_Mem** page_x;   /* Gains for X polarisation, per page. */
+    oskar_Mem** page_y;   /* Gains for Y polarisation, per page (or NULL). */
+};
+typedef struct oskar_GainsCache oskar_GainsCache;
 
 struct oskar_Gains
 {
     int precision, num_dims;
     size_t* dims;
     oskar_HDF5* hdf5_file;
+    size_t cache_max_bytes, page_max_bytes;
+    oskar_GainsCache* cache;
     oskar_Mem* freqs;
 };
 
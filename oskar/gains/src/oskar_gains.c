@@ -10,6 +10,16 @@
 #include "log/oskar_log.h"
 #include "math/oskar_find_closest_match.h"
 
+/* Upper limits on the memory used by the gain table cache. */
+#define GAINS_CACHE_MAX_BYTES (256 * 1024 * 1024)
+#define GAINS_PAGE_MAX_BYTES  (32 * 1024 * 1024)
+
+static oskar_GainsCache* cache_create(const oskar_Gains* h);
+static void cache_free(oskar_GainsCache* cache, int* status);
+static int cache_page(const oskar_Gains* h, int time_index, int* status);
+static oskar_Mem* read_gains(const oskar_Gains* h, const char* dataset,
+        const size_t* offsets, const size_t* sizes, int* status);
+
 oskar_Gains* oskar_gains_create(int precision)
 {
     oskar_Gains* h = (oskar_Gains*) calloc(1, sizeof(oskar_Gains));
@@ -22,12 +32,21 @@ oskar_Gains* oskar_gains_create_copy(const oskar_Gains* other, int* status)
     oskar_Gains* h = (oskar_Gains*) calloc(1, sizeof(oskar_Gains));
     h->precision = other->precision;
     h->num_dims = other->num_dims;
+    h->cache_max_bytes = other->cache_max_bytes;
+    h->page_max_bytes = other->page_max_bytes;
     if (other->freqs)
     {
         h->freqs = oskar_mem_create_copy(other->freqs, OSKAR_CPU, status);
     }
     h->hdf5_file = other->hdf5_file;
     oskar_hdf5_ref_inc(h->hdf5_file);
+    h->cache = other->cache;
+    if (h->cache)
+    {
+        oskar_mutex_lock(h->cache->mutex);
+        h->cache->refcount++;
+        oskar_mutex_unlock(h->cache->mutex);
+    }
     if (other->dims)
     {
         int i = 0;
@@ -56,7 +75,7 @@ void oskar_gains_evaluate(const oskar_Gains* h, int time_index_sim,
     if (*status) return;
 
     /* Check data have been loaded. */
-    if (!h->freqs || !h->hdf5_file)
+    if (!h->freqs || !h->hdf5_file || !h->cache)
     {
         oskar_log_error(0, "HDF5 file not opened.");
         *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
@@ -88,39 +107,50 @@ void oskar_gains_evaluate(const oskar_Gains* h, int time_index_sim,
         channel_index = (int) h->dims[1] - 1;
     }
 
-    /* Get the dimensions to read. */
+    /* Get the cache page holding this time sample, loading it if needed.
+     * The cache is shared, so take a reference to the page data while it
+     * is locked. The page can then be replaced by another thread while
+     * the gains are being copied out, without freeing the data. */
+    oskar_GainsCache* cache = h->cache;
+    oskar_mutex_lock(cache->mutex);
+    const int page = cache_page(h, time_index_sim, status);
+    if (*status)
+    {
+        oskar_mutex_unlock(cache->mutex);
+        return;
+    }
+    const int page_time_start = cache->page_time_start[page];
+    oskar_Mem* const page_x = cache->page_x[page];
+    oskar_Mem* const page_y = cache->page_y[page];
+    oskar_mem_ref_inc(page_x);
+    oskar_mem_ref_inc(page_y);
+    oskar_mutex_unlock(cache->mutex);
+
+    /* Get the offset of the gains for this time and channel in the page. */
     const size_t num_antennas = h->dims[2];
-    const size_t offsets[] = {time_index_sim, channel_index, 0};
-    const size_t sizes[] = {1, 1, num_antennas};
+    const size_t time_in_page = (size_t) (time_index_sim - page_time_start);
+    size_t offset = num_antennas * (h->dims[1] * time_in_page + channel_index);
     const int out_prec = oskar_mem_precision(gains);
     oskar_mem_ensure(gains, num_antennas, status);
-
-    /* Check if requested gains are fully polarised. */
-    if (oskar_mem_is_matrix(gains))
+    ptr_x = page_x;
+    ptr_y = page_y;
+    if (out_prec != h->precision)
     {
-        /* Read gains for X polarisation. */
-        ptr_x = x = oskar_hdf5_read_hyperslab(h->hdf5_file, "gain_xpol",
-                3, offsets, sizes, status);
-        if (oskar_mem_precision(x) != out_prec)
+        /* Convert only the required gains to the output precision. */
+        x = oskar_mem_create_alias(ptr_x, offset, num_antennas, status);
+        ptr_x = temp_x = oskar_mem_convert_precision(x, out_prec, status);
+        if (ptr_y)
         {
-            ptr_x = temp_x = oskar_mem_convert_precision(x, out_prec, status);
+            y = oskar_mem_create_alias(ptr_y, offset, num_antennas, status);
+            ptr_y = temp_y = oskar_mem_convert_precision(y, out_prec, status);
         }
+        offset = 0;
+    }
 
-        /* Read gains for Y polarisation. */
-        if (oskar_hdf5_dataset_exists(h->hdf5_file, "/gain_ypol"))
-        {
-            ptr_y = y = oskar_hdf5_read_hyperslab(h->hdf5_file, "gain_ypol",
-                    3, offsets, sizes, status);
-            if (oskar_mem_precision(y) != out_prec)
-            {
-                ptr_y = temp_y = oskar_mem_convert_precision(
-                        y, out_prec, status);
-            }
-        }
-        else
-        {
-            ptr_y = ptr_x;
-        }
+    /* Check if requested gains are fully polarised. */
+    if (oskar_mem_is_matrix(gains))
+    {
+        if (!ptr_y) ptr_y = ptr_x;
 
         /* Check output is writable by the CPU. */
         ptr_gains = gains;
@@ -140,10 +170,10 @@ void oskar_gains_evaluate(const oskar_Gains* h, int time_index_sim,
             out = oskar_mem_double4c(ptr_gains, status);
             for (i = 0; i < num_antennas; ++i)
             {
-                out[i].a = in_x[i];
+                out[i].a = in_x[offset + i];
                 out[i].b = zero;
                 out[i].c = zero;
-                out[i].d = in_y[i];
+                out[i].d = in_y[offset + i];
             }
         }
         else
@@ -155,10 +185,10 @@ void oskar_gains_evaluate(const oskar_Gains* h, int time_index_sim,
             out = oskar_mem_float4c(ptr_gains, status);
             for (i = 0; i < num_antennas; ++i)
             {
-                out[i].a = in_x[i];
+                out[i].a = in_x[offset + i];
                 out[i].b = zero;
                 out[i].c = zero;
-                out[i].d = in_y[i];
+                out[i].d = in_y[offset + i];
             }
         }
 
@@ -170,27 +200,19 @@ void oskar_gains_evaluate(const oskar_Gains* h, int time_index_sim,
     }
     else
     {
-        /* Read gains only for specified polarisation. */
-        const char* dataset = "gain_xpol";
-        if (feed == 1 && oskar_hdf5_dataset_exists(h->hdf5_file, "/gain_ypol"))
-        {
-            dataset = "gain_ypol";
-        }
-        ptr_x = x = oskar_hdf5_read_hyperslab(h->hdf5_file, dataset,
-                3, offsets, sizes, status);
-        if (oskar_mem_precision(x) != out_prec)
-        {
-            ptr_x = temp_x = oskar_mem_convert_precision(x, out_prec, status);
-        }
-        oskar_mem_copy_contents(gains, ptr_x, 0, 0, num_antennas, status);
+        /* Copy gains only for specified polarisation. */
+        oskar_mem_copy_contents(gains, (feed == 1 && ptr_y) ? ptr_y : ptr_x,
+                0, offset, num_antennas, status);
     }
 
-    /* Free scratch memory. */
+    /* Free scratch memory and release the page. */
     oskar_mem_free(temp_gains, status);
     oskar_mem_free(temp_x, status);
     oskar_mem_free(temp_y, status);
     oskar_mem_free(x, status);
     oskar_mem_free(y, status);
+    oskar_mem_free(page_x, status);
+    oskar_mem_free(page_y, status);
 }
 
 void oskar_gains_free(oskar_Gains* h, int* status)
@@ -198,6 +220,7 @@ void oskar_gains_free(oskar_Gains* h, int* status)
     if (!h) return;
     free(h->dims);
     oskar_mem_free(h->freqs, status);
+    cache_free(h->cache, status);
     oskar_hdf5_close(h->hdf5_file);
     free(h);
 }
@@ -231,4 +254,152 @@ void oskar_gains_open_hdf5(oskar_Gains* h, const char* path, int* status)
         *status = OSKAR_ERR_DIMENSION_MISMATCH;
         return;
     }
+
+    /* Create the cache for the gain table. Pages are loaded on demand. */
+    cache_free(h->cache, status);
+    h->cache = cache_create(h);
+}
+
+void oskar_gains_set_cache_size(oskar_Gains* h, size_t cache_bytes,
+        size_t page_bytes)
+{
+    h->cache_max_bytes = cache_bytes;
+    h->page_max_bytes = page_bytes;
+}
+
+static oskar_GainsCache* cache_create(const oskar_Gains* h)
+{
+    int i = 0;
+    oskar_GainsCache* cache = 0;
+    cache = (oskar_GainsCache*) calloc(1, sizeof(oskar_GainsCache));
+    cache->mutex = oskar_mutex_create();
+    cache->refcount = 1;
+
+    /* Keep the whole table in memory if it fits in the cache.
+     * Otherwise, use blocks of time samples. */
+    const size_t num_times = h->dims[0];
+    const size_t num_pols =
+            oskar_hdf5_dataset_exists(h->hdf5_file, "/gain_ypol") ? 2 : 1;
+    const size_t bytes_per_time = h->dims[1] * h->dims[2] * num_pols *
+            oskar_mem_element_size(h->precision | OSKAR_COMPLEX);
+    const size_t max_bytes = h->cache_max_bytes > 0 ?
+            h->cache_max_bytes : GAINS_CACHE_MAX_BYTES;
+    const size_t page_bytes = h->page_max_bytes > 0 ?
+            h->page_max_bytes : GAINS_PAGE_MAX_BYTES;
+    if (num_times * bytes_per_time <= max_bytes)
+    {
+        cache->page_num_times = (int) num_times;
+        cache->num_pages = 1;
+    }
+    else
+    {
+        size_t page_num_times = page_bytes / bytes_per_time;
+        if (page_num_times < 1) page_num_times = 1;
+        cache->page_num_times = (int) page_num_times;
+        cache->num_pages = (int) (max_bytes /
+                (page_num_times * bytes_per_time));
+        if (cache->num_pages < 2) cache->num_pages = 2;
+    }
+    cache->page_time_start = (int*) calloc(cache->num_pages, sizeof(int));
+    cache->page_last_used = (unsigned long long*) calloc(
+            cache->num_pages, sizeof(unsigned long long));
+    cache->page_x = (oskar_Mem**) calloc(cache->num_pages, sizeof(oskar_Mem*));
+    cache->page_y = (oskar_Mem**) calloc(cache->num_pages, sizeof(oskar_Mem*));
+    for (i = 0; i < cache->num_pages; ++i)
+    {
+        cache->page_time_start[i] = -1;
+    }
+    return cache;
+}
+
+static void cache_free(oskar_GainsCache* cache, int* status)
+{
+    int i = 0;
+    if (!cache) return;
+    oskar_mutex_lock(cache->mutex);
+    cache->refcount--;
+    if (cache->refcount > 0)
+    {
+        oskar_mutex_unlock(cache->mutex);
+        return;
+    }
+    oskar_mutex_unlock(cache->mutex);
+    for (i = 0; i < cache->num_pages; ++i)
+    {
+        oskar_mem_free(cache->page_x[i], status);
+        oskar_mem_free(cache->page_y[i], status);
+    }
+    oskar_mutex_free(cache->mutex);
+    free(cache->page_time_start);
+    free(cache->page_last_used);
+    free(cache->page_x);
+    free(cache->page_y);
+    free(cache);
+}
+
+static int cache_page(const oskar_Gains* h, int time_index, int* status)
+{
+    int i = 0, page = 0;
+    oskar_GainsCache* cache = h->cache;
+    const int time_start =
+            (time_index / cache->page_num_times) * cache->page_num_times;
+    cache->counter++;
+
+    /* Return the page if it is already loaded. Otherwise, replace either an
+     * empty page, or the one which has not been used for the longest time. */
+    for (i = 0; i < cache->num_pages; ++i)
+    {
+        if (cache->page_time_start[i] == time_start)
+        {
+            cache->page_last_used[i] = cache->counter;
+            return i;
+        }
+        if (cache->page_time_start[i] < 0 || (
+                cache->page_time_start[page] >= 0 &&
+                cache->page_last_used[i] < cache->page_last_used[page]))
+        {
+            page = i;
+        }
+    }
+    oskar_mem_free(cache->page_x[page], status);
+    oskar_mem_free(cache->page_y[page], status);
+    cache->page_x[page] = cache->page_y[page] = 0;
+    cache->page_time_start[page] = -1;
+
+    /* Read all channels and antennas for the time samples in the page. */
+    size_t num_times = (size_t) cache->page_num_times;
+    if (time_start + num_times > h->dims[0])
+    {
+        num_times = h->dims[0] - time_start;
+    }
+    const size_t offsets[] = {(size_t) time_start, 0, 0};
+    const size_t sizes[] = {num_times, h->dims[1], h->dims[2]};
+    cache->page_x[page] = read_gains(h, "gain_xpol", offsets, sizes, status);
+    if (oskar_hdf5_dataset_exists(h->hdf5_file, "/gain_ypol"))
+    {
+        cache->page_y[page] = read_gains(h, "gain_ypol",
+                offsets, sizes, status);
+    }
+    if (!*status)
+    {
+        cache->page_time_start[page] = time_start;
+        cache->page_last_used[page] = cache->counter;
+    }
+    return page;
+}
+
+static oskar_Mem* read_gains(const oskar_Gains* h, const char* dataset,
+        const size_t* offsets, const size_t* sizes, int* status)
+{
+    oskar_Mem* data = 0;
+    data = oskar_hdf5_read_hyperslab(h->hdf5_file, dataset,
+            3, offsets, sizes, status);
+    if (data && oskar_mem_precision(data) != h->precision)
+    {
+        oskar_Mem* temp = oskar_mem_convert_precision(
+                data, h->precision, status);
+        oskar_mem_free(data, status);
+        data = temp;
+    }
+    return data;
 }
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "gains/oskar_gains.h"
+#include "gains/private_gains.h"
+#include "utility/oskar_hdf5.h"
+#include "utility/oskar_thread.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#ifdef OSKAR_HAVE_HDF5
+#include <hdf5.h>
+
+#define NUM_TIMES 20
+#define NUM_CHANNELS 3
+#define NUM_ANTENNAS 5
+
+// Size of one time sample of both polarisations in double precision.
+#define BYTES_PER_TIME (NUM_CHANNELS * NUM_ANTENNAS * 2 * 16)
+
+static const char* filename = "temp_test_gains.h5";
+
+static double freq_hz(int channel)
+{
+    return 100e6 + channel * 1e6;
+}
+
+static void write_dataset(hid_t file, const char* name, int num_dims,
+        const hsize_t* dims, hid_t type, const void* data)
+{
+    const hid_t space = H5Screate_simple(num_dims, dims, 0);
+    const hid_t dataset = H5Dcreate2(file, name, type, space,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    H5Dclose(dataset);
+    H5Sclose(space);
+}
+
+// Writes a gain table in double precision, with a distinct value
+// for each time, channel, antenna and polarisation.
+static void write_gain_table()
+{
+    std::vector<double> freqs(NUM_CHANNELS);
+    std::vector<double> x(2 * NUM_TIMES * NUM_CHANNELS * NUM_ANTENNAS);
+    std::vector<double> y(x.size());
+    for (int c = 0; c < NUM_CHANNELS; ++c) freqs[c] = freq_hz(c);
+    for (size_t i = 0; i < x.size() / 2; ++i)
+    {
+        x[2 * i]     = 1.0 + 0.001 * i;
+        x[2 * i + 1] = std::sin(0.1 * i);
+        y[2 * i]     = -1.0 - 0.002 * i;
+        y[2 * i + 1] = std::cos(0.3 * i);
+    }
+    const hid_t file = H5Fcreate(filename, H5F_ACC_TRUNC,
+            H5P_DEFAULT, H5P_DEFAULT);
+    const hid_t complex_type = H5Tcreate(H5T_COMPOUND, 2 * sizeof(double));
+    H5Tinsert(complex_type, "r", 0, H5T_NATIVE_DOUBLE);
+    H5Tinsert(complex_type, "i", sizeof(double), H5T_NATIVE_DOUBLE);
+    const hsize_t freq_dims[] = {NUM_CHANNELS};
+    const hsize_t gain_dims[] = {NUM_TIMES, NUM_CHANNELS, NUM_ANTENNAS};
+    write_dataset(file, "freq (Hz)", 1, freq_dims, H5T_NATIVE_DOUBLE,
+            &freqs[0]);
+    write_dataset(file, "gain_xpol", 3, gain_dims, complex_type, &x[0]);
+    write_dataset(file, "gain_ypol", 3, gain_dims, complex_type, &y[0]);
+    H5Tclose(complex_type);
+    H5Fclose(file);
+}
+
+// Reads the gains for one time and channel directly from the file.
+static oskar_Mem* read_direct(const char* dataset, int time_index,
+        int channel, int* status)
+{
+    oskar_HDF5* hdf5 = oskar_hdf5_open(filename, status);
+    const size_t offsets[] = {(size_t) time_index, (size_t) channel, 0};
+    const size_t sizes[] = {1, 1, NUM_ANTENNAS};
+    oskar_Mem* data = oskar_hdf5_read_hyperslab(hdf5, dataset,
+            3, offsets, sizes, status);
+    oskar_hdf5_close(hdf5);
+    return data;
+}
+
+// Checks the gains for one time, channel and feed against the file.
+static void check_scalar(const oskar_Gains* h, int time_index, int channel,
+        int feed, int precision, double tol)
+{
+    int status = 0;
+    oskar_Mem* gains = oskar_mem_create(precision | OSKAR_COMPLEX,
+            OSKAR_CPU, NUM_ANTENNAS, &status);
+    oskar_gains_evaluate(h, time_index, freq_hz(channel), gains, feed,
+            &status);
+    ASSERT_EQ(0, status);
+    oskar_Mem* expected = read_direct(feed == 1 ? "gain_ypol" : "gain_xpol",
+            time_index, channel, &status);
+    ASSERT_EQ(0, status);
+    const double* e = oskar_mem_double_const(expected, &status);
+    for (int a = 0; a < 2 * NUM_ANTENNAS; ++a)
+    {
+        const double v = (precision == OSKAR_DOUBLE) ?
+                oskar_mem_double_const(gains, &status)[a] :
+                oskar_mem_float_const(gains, &status)[a];
+        EXPECT_NEAR(e[a], v, tol) << "time " << time_index <<
+                ", channel " << channel << ", feed " << feed;
+    }
+    oskar_mem_free(gains, &status);
+    oskar_mem_free(expected, &status);
+}
+
+static std::vector<int> resident_pages(const oskar_Gains* h)
+{
+    std::vector<int> pages;
+    for (int i = 0; i < h->cache->num_pages; ++i)
+    {
+        pages.push_back(h->cache->page_time_start[i]);
+    }
+    std::sort(pages.begin(), pages.end());
+    return pages;
+}
+
+// Opens the gain table with a cache of three pages of four time samples.
+static oskar_Gains* open_paged(int precision, int* status)
+{
+    oskar_Gains* h = oskar_gains_create(precision);
+    oskar_gains_set_cache_size(h, 3 * 4 * BYTES_PER_TIME,
+            4 * BYTES_PER_TIME);
+    oskar_gains_open_hdf5(h, filename, status);
+    return h;
+}
+
+TEST(gains, whole_table_in_one_page)
+{
+    int status = 0;
+    write_gain_table();
+    oskar_Gains* h = oskar_gains_create(OSKAR_DOUBLE);
+    oskar_gains_open_hdf5(h, filename, &status);
+    ASSERT_EQ(0, status);
+    ASSERT_EQ(1, h->cache->num_pages);
+    ASSERT_EQ(NUM_TIMES, h->cache->page_num_times);
+    for (int t = 0; t < NUM_TIMES; ++t)
+    {
+        check_scalar(h, t, 1, 0, OSKAR_DOUBLE, 0.0);
+    }
+
+    // Times past the end of the table use the last time sample.
+    int status2 = 0;
+    oskar_Mem* last = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            NUM_ANTENNAS, &status2);
+    oskar_Mem* past = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            NUM_ANTENNAS, &status2);
+    oskar_gains_evaluate(h, NUM_TIMES - 1, freq_hz(2), last, 0, &status2);
+    oskar_gains_evaluate(h, NUM_TIMES + 5, freq_hz(2), past, 0, &status2);
+    ASSERT_EQ(0, status2);
+    for (int a = 0; a < 2 * NUM_ANTENNAS; ++a)
+    {
+        EXPECT_EQ(oskar_mem_double(last, &status2)[a],
+                oskar_mem_double(past, &status2)[a]);
+    }
+    oskar_mem_free(last, &status2);
+    oskar_mem_free(past, &status2);
+    oskar_gains_free(h, &status);
+    remove(filename);
+}
+
+TEST(gains, page_in_across_time_blocks)
+{
+    int status = 0;
+    write_gain_table();
+    oskar_Gains* h = open_paged(OSKAR_DOUBLE, &status);
+    ASSERT_EQ(0, status);
+    ASSERT_EQ(3, h->cache->num_pages);
+    ASSERT_EQ(4, h->cache->page_num_times);
+
+    // Step through every time sample, crossing each page boundary.
+    for (int t = 0; t < NUM_TIMES; ++t)
+    {
+        for (int c = 0; c < NUM_CHANNELS; ++c)
+        {
+            check_scalar(h, t, c, 0, OSKAR_DOUBLE, 0.0);
+            check_scalar(h, t, c, 1, OSKAR_DOUBLE, 0.0);
+        }
+    }
+
+    // The last three blocks of four time samples should be resident.
+    std::vector<int> pages = resident_pages(h);
+    EXPECT_EQ(8, pages[0]);
+    EXPECT_EQ(12, pages[1]);
+    EXPECT_EQ(16, pages[2]);
+
+    // Go back across the boundaries.
+    for (int t = NUM_TIMES - 1; t >= 0; --t)
+    {
+        check_scalar(h, t, 2, 1, OSKAR_DOUBLE, 0.0);
+    }
+    oskar_gains_free(h, &status);
+    remove(filename);
+}
+
+TEST(gains, lru_eviction)
+{
+    int status = 0;
+    write_gain_table();
+    oskar_Gains* h = open_paged(OSKAR_DOUBLE, &status);
+    ASSERT_EQ(0, status);
+
+    // Fill the cache, then use the first page again.
+    check_scalar(h, 1, 0, 0, OSKAR_DOUBLE, 0.0);
+    check_scalar(h, 5, 0, 0, OSKAR_DOUBLE, 0.0);
+    check_scalar(h, 9, 0, 0, OSKAR_DOUBLE, 0.0);
+    check_scalar(h, 2, 0, 0, OSKAR_DOUBLE, 0.0);
+    std::vector<int> pages = resident_pages(h);
+    EXPECT_EQ(0, pages[0]);
+    EXPECT_EQ(4, pages[1]);
+    EXPECT_EQ(8, pages[2]);
+
+    // A new page replaces the least recently used one (times 4 to 7).
+    check_scalar(h, 13, 1, 1, OSKAR_DOUBLE, 0.0);
+    pages = resident_pages(h);
+    EXPECT_EQ(0, pages[0]);
+    EXPECT_EQ(8, pages[1]);
+    EXPECT_EQ(12, pages[2]);
+
+    // Loading times 4 to 7 again replaces times 8 to 11.
+    check_scalar(h, 6, 2, 0, OSKAR_DOUBLE, 0.0);
+    pages = resident_pages(h);
+    EXPECT_EQ(0, pages[0]);
+    EXPECT_EQ(4, pages[1]);
+    EXPECT_EQ(12, pages[2]);
+    oskar_gains_free(h, &status);
+    remove(filename);
+}
+
+TEST(gains, convert_precision)
+{
+    int status = 0;
+    write_gain_table();
+
+    // Gain model in single precision, from a table in double precision.
+    oskar_Gains* h = open_paged(OSKAR_SINGLE, &status);
+    ASSERT_EQ(0, status);
+    for (int t = 0; t < NUM_TIMES; t += 3)
+    {
+        check_scalar(h, t, 1, 0, OSKAR_SINGLE, 1e-6);
+        check_scalar(h, t, 1, 1, OSKAR_DOUBLE, 1e-6);
+    }
+    for (int i = 0; i < h->cache->num_pages; ++i)
+    {
+        if (h->cache->page_x[i])
+        {
+            EXPECT_EQ(OSKAR_SINGLE_COMPLEX,
+                    oskar_mem_type(h->cache->page_x[i]));
+        }
+    }
+
+    // Check matrix gains hold both polarisations on the diagonal.
+    oskar_Mem* gains = oskar_mem_create(OSKAR_SINGLE_COMPLEX_MATRIX,
+            OSKAR_CPU, NUM_ANTENNAS, &status);
+    oskar_gains_evaluate(h, 10, freq_hz(2), gains, 0, &status);
+    oskar_Mem* x = read_direct("gain_xpol", 10, 2, &status);
+    oskar_Mem* y = read_direct("gain_ypol", 10, 2, &status);
+    ASSERT_EQ(0, status);
+    const float4c* g = oskar_mem_float4c_const(gains, &status);
+    const double2* gx = oskar_mem_double2_const(x, &status);
+    const double2* gy = oskar_mem_double2_const(y, &status);
+    for (int a = 0; a < NUM_ANTENNAS; ++a)
+    {
+        EXPECT_NEAR(gx[a].x, g[a].a.x, 1e-6);
+        EXPECT_NEAR(gx[a].y, g[a].a.y, 1e-6);
+        EXPECT_EQ(0.0f, g[a].b.x);
+        EXPECT_EQ(0.0f, g[a].c.y);
+        EXPECT_NEAR(gy[a].x, g[a].d.x, 1e-6);
+        EXPECT_NEAR(gy[a].y, g[a].d.y, 1e-6);
+    }
+    oskar_mem_free(gains, &status);
+    oskar_mem_free(x, &status);
+    oskar_mem_free(y, &status);
+    oskar_gains_free(h, &status);
+    remove(filename);
+}
+
+struct ThreadArgs
+{
+    const oskar_Gains* gains;
+    const oskar_Mem* expected_x;
+    const oskar_Mem* expected_y;
+    int thread_id, num_errors, status;
+};
+
+// Evaluates gains in a different order in each thread, and counts values
+// that do not match the table read from the file.
+static void* lookup_thread(void* arg)
+{
+    ThreadArgs* args = (ThreadArgs*) arg;
+    int* status = &args->status;
+    oskar_Gains* h = oskar_gains_create_copy(args->gains, status);
+    oskar_Mem* gains = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            NUM_ANTENNAS, status);
+    for (int i = 0; i < 200 && !*status; ++i)
+    {
+        const int t = (7 * i + 5 * args->thread_id) % NUM_TIMES;
+        const int c = (i + args->thread_id) % NUM_CHANNELS;
+        const int feed = (i + args->thread_id) % 2;
+        oskar_gains_evaluate(h, t, freq_hz(c), gains, feed, status);
+        const double* e = oskar_mem_double_const(
+                feed == 1 ? args->expected_y : args->expected_x, status);
+        const double* v = oskar_mem_double_const(gains, status);
+        const size_t offset = 2 * NUM_ANTENNAS * (NUM_CHANNELS * t + c);
+        for (int a = 0; a < 2 * NUM_ANTENNAS; ++a)
+        {
+            if (e[offset + a] != v[a]) args->num_errors++;
+        }
+    }
+    oskar_mem_free(gains, status);
+    oskar_gains_free(h, status);
+    return 0;
+}
+
+TEST(gains, concurrent_lookups)
+{
+    int status = 0;
+    const int num_threads = 6;
+    write_gain_table();
+    oskar_Gains* h = open_paged(OSKAR_DOUBLE, &status);
+    ASSERT_EQ(0, status);
+
+    // Read the whole table directly for comparison.
+    oskar_HDF5* hdf5 = oskar_hdf5_open(filename, &status);
+    const size_t offsets[] = {0, 0, 0};
+    const size_t sizes[] = {NUM_TIMES, NUM_CHANNELS, NUM_ANTENNAS};
+    oskar_Mem* x = oskar_hdf5_read_hyperslab(hdf5, "gain_xpol",
+            3, offsets, sizes, &status);
+    oskar_Mem* y = oskar_hdf5_read_hyperslab(hdf5, "gain_ypol",
+            3, offsets, sizes, &status);
+    oskar_hdf5_close(hdf5);
+    ASSERT_EQ(0, status);
+
+    // Look up gains from several threads sharing the same cache,
+    // as the device threads of the interferometer simulator do.
+    std::vector<ThreadArgs> args(num_threads);
+    std::vector<oskar_Thread*> threads(num_threads);
+    for (int i = 0; i < num_threads; ++i)
+    {
+        args[i].gains = h;
+        args[i].expected_x = x;
+        args[i].expected_y = y;
+        args[i].thread_id = i;
+        args[i].num_errors = 0;
+        args[i].status = 0;
+        threads[i] = oskar_thread_create(lookup_thread, &args[i], 0);
+    }
+    for (int i = 0; i < num_threads; ++i)
+    {
+        oskar_thread_join(threads[i]);
+        oskar_thread_free(threads[i]);
+        EXPECT_EQ(0, args[i].status);
+        EXPECT_EQ(0, args[i].num_errors);
+    }
+    EXPECT_EQ(1, h->cache->refcount);
+    oskar_mem_free(x, &status);
+    oskar_mem_free(y, &status);
+    oskar_gains_free(h, &status);
+    remove(filename);
+}
+
+#endif /* OSKAR_HAVE_HDF5 */
@@ -0,0 +1,291 @@
+/* Copyright (c) 2026, The OSKAR Developers. See LICENSE file. */
+
+/*
+ * Gridding of visibilities in parallel tiles on the CPU.
+ *
+ * The points are first converted to grid coordinates and sorted into
+ * tiles of OSKAR_GRID_TILE_SIZE cells, which are then updated in parallel.
+ * Tiles do not overlap, so no atomic operations are needed.
+ *
+ * Each function returns 1 if the visibilities were gridded, or 0 if
+ * memory could not be allocated, in which case the grid is unchanged.
+ */
+
+#define OSKAR_GRID_TILE_BLOCK 4096
+
+/*
+ * Converts the coordinates of each point to grid coordinates.
+ * SET_W must set the w-plane index and kernel support of point p.
+ */
+#define OSKAR_GRID_TILE_POINTS(FP, RND, SET_W) {\
+    int b = 0;\
+    const int num_blocks = (int) ((num_points + OSKAR_GRID_TILE_BLOCK - 1) /\
+            OSKAR_GRID_TILE_BLOCK);\
+    DO_PRAGMA(omp parallel for)\
+    for (b = 0; b < num_blocks; ++b)\
+    {\
+        size_t i = 0;\
+        const size_t start = (size_t) b * OSKAR_GRID_TILE_BLOCK;\
+        const size_t end = (start + OSKAR_GRID_TILE_BLOCK < num_points) ?\
+                start + OSKAR_GRID_TILE_BLOCK : num_points;\
+        for (i = start; i < end; ++i)\
+        {\
+            oskar_GridTilePoint* p = &points[i];\
+            const FP pos_u = -uu[i] * grid_scale;\
+            const FP pos_v = vv[i] * grid_scale;\
+            p->grid_u = (int)RND(pos_u) + grid_centre;\
+            p->grid_v = (int)RND(pos_v) + grid_centre;\
+            p->off_u = (int)RND((RND(pos_u) - pos_u) * oversample);\
+            p->off_v = (int)RND((RND(pos_v) - pos_v) * oversample);\
+            SET_W\
+            \
+            /* Catch points that would lie outside the grid. */\
+            if (p->grid_u + p->support >= grid_size ||\
+                    p->grid_u - p->support < 0 ||\
+                    p->grid_v + p->support >= grid_size ||\
+                    p->grid_v - p->support < 0)\
+            {\
+                p->support = -1;\
+            }\
+        }\
+    }\
+    }\
+
+/* Sorts the points into tiles, and counts the ones that were skipped. */
+#define OSKAR_GRID_TILE_SORT {\
+    size_t s = 0;\
+    if (oskar_grid_tiles_sort(&tiles, num_points, points, grid_size))\
+    {\
+        free(points);\
+        return 0;\
+    }\
+    *num_skipped = 0;\
+    for (s = 0; s < num_points; ++s)\
+    {\
+        if (points[s].support < 0) *num_skipped += 1;\
+    }\
+    }\
+
+/* Gets the tile bounds and the part of the kernel that overlaps it. */
+#define OSKAR_GRID_TILE_OVERLAP(SUPPORT)\
+    const int u0 = (t % tiles.num_tiles_u) * OSKAR_GRID_TILE_SIZE;\
+    const int v0 = (t / tiles.num_tiles_u) * OSKAR_GRID_TILE_SIZE;\
+    const int u1 = u0 + OSKAR_GRID_TILE_SIZE - 1;\
+    const int v1 = v0 + OSKAR_GRID_TILE_SIZE - 1;\
+    const int j_min = (v0 - p->grid_v > -SUPPORT) ? v0 - p->grid_v : -SUPPORT;\
+    const int j_max = (v1 - p->grid_v < SUPPORT) ? v1 - p->grid_v : SUPPORT;\
+    const int k_min = (u0 - p->grid_u > -SUPPORT) ? u0 - p->grid_u : -SUPPORT;\
+    const int k_max = (u1 - p->grid_u < SUPPORT) ? u1 - p->grid_u : SUPPORT;\
+    const int len = k_max - k_min + 1;\
+
+/* Frees the tiles and returns, after the parallel update. */
+#define OSKAR_GRID_TILE_FINISH\
+    oskar_grid_tiles_free(&tiles);\
+    free(points);\
+    if (num_failed) return 0;\
+    *norm += norm_tiles;\
+    return 1;\
+
+#define OSKAR_GRID_SIMPLE_TILED_CPU(NAME, FP, RND)\
+static int NAME(\
+        const int support,\
+        const int oversample,\
+        const FP* RESTRICT conv_func,\
+        const size_t num_points,\
+        const FP* RESTRICT uu,\
+        const FP* RESTRICT vv,\
+        const FP* RESTRICT vis,\
+        const FP* RESTRICT weight,\
+        const FP cell_size_rad,\
+        const int grid_size,\
+        size_t* RESTRICT num_skipped,\
+        double* RESTRICT norm,\
+        FP* RESTRICT grid)\
+{\
+    int num_failed = 0;\
+    double norm_tiles = 0.0;\
+    oskar_GridTiles tiles;\
+    const int grid_centre = grid_size / 2;\
+    const FP grid_scale = grid_size * cell_size_rad;\
+    oskar_GridTilePoint* points = (oskar_GridTilePoint*) malloc(\
+            num_points * sizeof(oskar_GridTilePoint));\
+    if (!points) return 0;\
+    OSKAR_GRID_TILE_POINTS(FP, RND, p->support = support; p->grid_w = 0;)\
+    OSKAR_GRID_TILE_SORT\
+    DO_PRAGMA(omp parallel reduction(+:norm_tiles))\
+    {\
+        int t = 0;\
+        const int num_tiles = tiles.num_tiles_u * tiles.num_tiles_v;\
+        const size_t conv_len = 2 * support + 1;\
+        FP* RESTRICT c_u = (FP*) malloc(conv_len * sizeof(FP));\
+        if (!c_u)\
+        {\
+            DO_PRAGMA(omp atomic)\
+            num_failed++;\
+        }\
+        /* All threads must agree whether to skip the work-sharing loop. */\
+        DO_PRAGMA(omp barrier)\
+        DO_PRAGMA(omp for schedule(dynamic, 1))\
+        for (t = 0; t < num_tiles; ++t)\
+        {\
+            size_t k = 0;\
+            if (num_failed) continue;\
+            for (k = tiles.tile_start[t]; k < tiles.tile_start[t + 1]; ++k)\
+            {\
+                int j = 0, m = 0;\
+                double sum = 0.0, sum_u = 0.0;\
+                const size_t i = tiles.sorted_index[k];\
+                const oskar_GridTilePoint* p = &points[i];\
+                \
+                /* Get visibility data. */\
+                const FP weight_i = weight[i];\
+                const FP v_re = weight_i * vis[2 * i];\
+                const FP v_im = weight_i * vis[2 * i + 1];\
+                \
+                /* Get the part of the kernel that overlaps this tile. */\
+                OSKAR_GRID_TILE_OVERLAP(support)\
+                for (m = 0; m < len; ++m)\
+                {\
+                    const int iu = abs(p->off_u + (k_min + m) * oversample);\
+                    c_u[m] = conv_func[iu];\
+                    sum_u += c_u[m];\
+                }\
+                \
+                /* Convolve this point onto the tile. */\
+                for (j = j_min; j <= j_max; ++j)\
+                {\
+                    const FP c1 = conv_func[abs(p->off_v + j * oversample)];\
+                    size_t p1 = p->grid_v + j;\
+                    p1 *= grid_size; /* Tested to avoid int overflow. */\
+                    p1 += p->grid_u + k_min;\
+                    FP* RESTRICT g = &grid[p1 << 1];\
+                    for (m = 0; m < len; ++m)\
+                    {\
+                        const FP c = c_u[m] * c1;\
+                        g[2 * m]     += v_re * c;\
+                        g[2 * m + 1] += v_im * c;\
+                    }\
+                    sum += sum_u * c1;\
+                }\
+                norm_tiles += sum * weight_i;\
+            }\
+        }\
+        free(c_u);\
+    }\
+    OSKAR_GRID_TILE_FINISH\
+}\
+
+#define OSKAR_GRID_WPROJ2_TILED_CPU(NAME, FP, RND, SQRT, FABS)\
+static int NAME(\
+        const size_t num_w_planes,\
+        const int* RESTRICT support,\
+        const int oversample,\
+        const int* wkernel_start,\
+        const FP* RESTRICT wkernel,\
+        const size_t num_points,\
+        const FP* RESTRICT uu,\
+        const FP* RESTRICT vv,\
+        const FP* RESTRICT ww,\
+        const FP* RESTRICT vis,\
+        const FP* RESTRICT weight,\
+        const FP cell_size_rad,\
+        const FP w_scale,\
+        const int grid_size,\
+        size_t* RESTRICT num_skipped,\
+        double* RESTRICT norm,\
+        FP* RESTRICT grid)\
+{\
+    size_t n = 0;\
+    int max_support = 0, num_failed = 0;\
+    double norm_tiles = 0.0;\
+    oskar_GridTiles tiles;\
+    const int grid_centre = grid_size / 2;\
+    const int oversample_h = oversample / 2;\
+    const FP grid_scale = grid_size * cell_size_rad;\
+    oskar_GridTilePoint* points = (oskar_GridTilePoint*) malloc(\
+            num_points * sizeof(oskar_GridTilePoint));\
+    if (!points) return 0;\
+    for (n = 0; n < num_w_planes; ++n)\
+    {\
+        if (support[n] > max_support) max_support = support[n];\
+    }\
+    OSKAR_GRID_TILE_POINTS(FP, RND,\
+            size_t grid_w = (size_t)RND(SQRT(FABS(ww[i] * w_scale)));\
+            if (grid_w >= num_w_planes) grid_w = num_w_planes - 1;\
+            p->support = support[grid_w];\
+            p->grid_w = (int) grid_w;)\
+    OSKAR_GRID_TILE_SORT\
+    DO_PRAGMA(omp parallel reduction(+:norm_tiles))\
+    {\
+        int t = 0;\
+        const int num_tiles = tiles.num_tiles_u * tiles.num_tiles_v;\
+        const size_t max_len = 2 * max_support + 1;\
+        FP* RESTRICT c_re = (FP*) malloc(max_len * sizeof(FP));\
+        FP* RESTRICT c_im = (FP*) malloc(max_len * sizeof(FP));\
+        if (!c_re || !c_im)\
+        {\
+            DO_PRAGMA(omp atomic)\
+            num_failed++;\
+        }\
+        /* All threads must agree whether to skip the work-sharing loop. */\
+        DO_PRAGMA(omp barrier)\
+        DO_PRAGMA(omp for schedule(dynamic, 1))\
+        for (t = 0; t < num_tiles; ++t)\
+        {\
+            size_t k = 0;\
+            if (num_failed) continue;\
+            for (k = tiles.tile_start[t]; k < tiles.tile_start[t + 1]; ++k)\
+            {\
+                int j = 0, m = 0;\
+                double sum = 0.0;\
+                const size_t i = tiles.sorted_index[k];\
+                const oskar_GridTilePoint* p = &points[i];\
+                const int w_support = p->support;\
+                const FP conv_conj = (ww[i] > (FP) 0) ? (FP) -1 : (FP) 1;\
+                \
+                /* Get visibility data. */\
+                const FP weight_i = weight[i];\
+                const FP v_re = weight_i * vis[2 * i];\
+                const FP v_im = weight_i * vis[2 * i + 1];\
+                \
+                /* Get the part of the kernel that overlaps this tile. */\
+                OSKAR_GRID_TILE_OVERLAP(w_support)\
+                \
+                /* Convolve this point onto the tile. */\
+                const int conv_len = 2 * w_support + 1;\
+                const int width = (oversample_h * conv_len + 1) * conv_len;\
+                const int mid = wkernel_start[p->grid_w] +\
+                        (abs(p->off_u) + 1) * width - 1 - w_support;\
+                const int stride = (p->off_u >= 0) ? 1 : -1;\
+                for (j = j_min; j <= j_max; ++j)\
+                {\
+                    const int t0 = mid -\
+                            abs(p->off_v + j * oversample) * conv_len;\
+                    size_t p1 = p->grid_v + j;\
+                    p1 *= grid_size; /* Tested to avoid int overflow. */\
+                    p1 += p->grid_u + k_min;\
+                    FP* RESTRICT g = &grid[p1 << 1];\
+                    \
+                    /* Copy the kernel row so the update has unit stride. */\
+                    for (m = 0; m < len; ++m)\
+                    {\
+                        const int q = (t0 + stride * (k_min + m)) << 1;\
+                        c_re[m] = wkernel[q];\
+                        c_im[m] = wkernel[q + 1] * conv_conj;\
+                        sum += c_re[m]; /* Real part only. */\
+                    }\
+                    for (m = 0; m < len; ++m)\
+                    {\
+                        g[2 * m]     += (v_re * c_re[m] - v_im * c_im[m]);\
+                        g[2 * m + 1] += (v_im * c_re[m] + v_re * c_im[m]);\
+                    }\
+                }\
+                norm_tiles += sum * weight_i;\
+            }\
+        }\
+        free(c_re);\
+        free(c_im);\
+    }\
+    OSKAR_GRID_TILE_FINISH\
+}\
+
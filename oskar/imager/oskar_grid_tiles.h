@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_GRID_TILES_H_
+#define OSKAR_GRID_TILES_H_
+
+/**
+ * @file oskar_grid_tiles.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Side length of a grid tile, in grid cells. */
+#define OSKAR_GRID_TILE_SIZE 64
+
+/**
+ * @brief Grid coordinates of a visibility point.
+ */
+struct oskar_GridTilePoint
+{
+    int grid_u, grid_v; /* Grid cell nearest to the point. */
+    int off_u, off_v;   /* Scaled distance from nearest grid cell. */
+    int support;        /* Kernel support size, or -1 if point is skipped. */
+    int grid_w;         /* W-projection plane index. */
+};
+typedef struct oskar_GridTilePoint oskar_GridTilePoint;
+
+/**
+ * @brief Visibility indices bucket-sorted by grid tile.
+ */
+struct oskar_GridTiles
+{
+    int num_tiles_u, num_tiles_v;
+    size_t* tile_start;   /* Start of each tile in sorted_index. */
+    size_t* sorted_index; /* Visibility indices for each tile, in order. */
+};
+typedef struct oskar_GridTiles oskar_GridTiles;
+
+/**
+ * @brief
+ * Returns true if visibilities should be gridded in parallel using tiles.
+ *
+ * @details
+ * Returns true if more than one OpenMP thread is available and there are
+ * enough visibilities for the tiled gridder to be worthwhile.
+ *
+ * @param[in] num_points  Number of visibility points.
+ */
+int oskar_grid_tiles_enabled(size_t num_points);
+
+/**
+ * @brief
+ * Bucket-sorts visibility points into square tiles of the grid.
+ *
+ * @details
+ * Each point is added to every tile that its convolution kernel overlaps.
+ * Within each tile, points remain in their original order, so gridding
+ * the tiles independently gives the same result as a serial loop.
+ *
+ * Points with a negative support size are ignored.
+ *
+ * @param[out] tiles      Tile structure to fill.
+ * @param[in] num_points  Number of visibility points.
+ * @param[in] points      Grid coordinates of each point.
+ * @param[in] grid_size   Side length of grid.
+ *
+ * @return Zero on success, or non-zero if memory allocation failed.
+ */
+int oskar_grid_tiles_sort(oskar_GridTiles* tiles, size_t num_points,
+        const oskar_GridTilePoint* points, int grid_size);
+
+/**
+ * @brief Frees memory held by the tile structure.
+ *
+ * @param[in] tiles  Tile structure to free.
+ */
+void oskar_grid_tiles_free(oskar_GridTiles* tiles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_GRID_TILES_H_ */
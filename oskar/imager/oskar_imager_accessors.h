@@ -200,6 +200,19 @@ oskar_Log* oskar_imager_log(oskar_Imager* h);
 OSKAR_EXPORT
 const char* oskar_imager_ms_column(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the number of Measurement Set rows read at once.
+ *
+ * @details
+ * Returns the number of Measurement Set rows read at once,
+ * or 0 if this is chosen automatically.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+int oskar_imager_ms_rows_per_read(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the number of image planes in use.
@@ -223,6 +236,31 @@ int oskar_imager_num_image_planes(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_num_input_files(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the number of input files gridded in parallel.
+ *
+ * @details
+ * Returns the number of input files gridded in parallel,
+ * or 0 if this is chosen automatically.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+int oskar_imager_num_parallel_files(const oskar_Imager* h);
+
+/**
+ * @brief
+ * Returns the number of buffers used to read visibility data.
+ *
+ * @details
+ * Returns the number of buffers used to read visibility data.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+int oskar_imager_num_read_buffers(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the number of W-planes in use.
@@ -245,6 +283,19 @@ int oskar_imager_num_w_planes(const oskar_Imager* h);
 OSKAR_EXPORT
 const char* oskar_imager_output_root(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the memory allowed for partial grids, in MB.
+ *
+ * @details
+ * Returns the memory allowed for partial grids, in MB,
+ * when gridding input files in parallel.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+double oskar_imager_partial_grid_memory_mb(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the grid size required by the algorithm.
@@ -286,6 +337,19 @@ int oskar_imager_precision(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_scale_norm_with_num_input_files(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the directory used for the visibility scratch cache.
+ *
+ * @details
+ * Returns the directory used for the visibility scratch cache,
+ * or NULL if the cache is not used.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+const char* oskar_imager_scratch_dir(const oskar_Imager* h);
+
 /**
  * @brief
  * Sets the algorithm used by the imager.
@@ -511,6 +575,20 @@ void oskar_imager_set_grid_kernel(oskar_Imager* h, const char* type,
 OSKAR_EXPORT
 void oskar_imager_set_grid_on_gpu(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the path of the settings file used to set up the imager.
+ *
+ * @details
+ * If set, a checksum of the settings file is included in the
+ * performance report, so that runs with the same settings can be compared.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     filename   Path of the settings file.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_settings_path(oskar_Imager* h, const char* filename);
+
 /**
  * @brief
  * Sets image side length.
@@ -585,6 +663,23 @@ OSKAR_EXPORT
 void oskar_imager_set_ms_column(oskar_Imager* h, const char* column,
         int* status);
 
+/**
+ * @brief
+ * Sets the number of Measurement Set rows read at once.
+ *
+ * @details
+ * Sets the number of rows read from a Measurement Set in each call to
+ * casacore, when reading visibility data.
+ *
+ * If this is 0, as many whole time steps are read as will fit in about
+ * 32 MB of visibility amplitudes, with a minimum of one time step.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Number of rows to read at once, or 0 for auto.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_ms_rows_per_read(oskar_Imager* h, int value);
+
 /**
  * @brief
  * Sets the number of compute devices used by the imager.
@@ -600,6 +695,46 @@ void oskar_imager_set_ms_column(oskar_Imager* h, const char* column,
 OSKAR_EXPORT
 void oskar_imager_set_num_devices(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the number of input files gridded in parallel.
+ *
+ * @details
+ * When using the FFT or W-projection algorithms with gridding on the host,
+ * up to this many input files are read and gridded at the same time,
+ * each by its own worker thread. The first worker grids into the image
+ * planes, and each of the others uses its own partial copy of the planes,
+ * which are added together once all the files have been read.
+ * The number of workers is limited by the number of input files,
+ * and by oskar_imager_set_partial_grid_memory_mb().
+ *
+ * If this is 0, the number of CPU cores is used.
+ * The default is 1, which grids the input files in turn.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Number of input files to grid in parallel.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_num_parallel_files(oskar_Imager* h, int value);
+
+/**
+ * @brief
+ * Sets the number of buffers used to read visibility data.
+ *
+ * @details
+ * When reading a Measurement Set, or the scratch cache, visibility data
+ * are read by a separate thread into a queue of this many buffers,
+ * so that reading can overlap with gridding.
+ *
+ * If this is 1, data are read and gridded in turn, without a separate thread.
+ * The default is 3.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Number of read buffers.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_num_read_buffers(oskar_Imager* h, int value);
+
 /**
  * @brief
  * Sets the root path of output images.
@@ -627,6 +762,42 @@ void oskar_imager_set_output_root(oskar_Imager* h, const char* filename);
 OSKAR_EXPORT
 void oskar_imager_set_oversample(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the memory allowed for partial grids, in MB.
+ *
+ * @details
+ * Sets the maximum memory used for partial copies of the image planes
+ * when gridding input files in parallel, which limits the number of
+ * files that are gridded at the same time.
+ * The default is 2048 MB.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Memory allowed for partial grids, in MB.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_partial_grid_memory_mb(oskar_Imager* h, double value);
+
+/**
+ * @brief
+ * Sets the path of the performance report.
+ *
+ * @details
+ * If set, a machine-readable (JSON) report of the imager performance
+ * is written to this file by oskar_imager_finalise().
+ * The report contains the time taken by each stage, the number of
+ * visibilities and pixels processed, the derived throughput, and the
+ * CPU time and peak memory used by the process.
+ *
+ * Set this to NULL or an empty string to disable the report.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     filename   Path of the report file.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_performance_report(oskar_Imager* h,
+        const char* filename);
+
 /**
  * @brief
  * Sets the option to scale image normalisation with number of input files.
@@ -647,6 +818,27 @@ OSKAR_EXPORT
 void oskar_imager_set_scale_norm_with_num_input_files(oskar_Imager* h,
         int value);
 
+/**
+ * @brief
+ * Sets the directory used for the visibility scratch cache.
+ *
+ * @details
+ * If a second pass over the input data is needed (for uniform weighting
+ * or W-projection), and a scratch directory has been set, then
+ * oskar_imager_run() will read each input file only once.
+ * The visibility data are written to a temporary file in this directory
+ * while the coordinates are scanned, and the data are then gridded
+ * from the temporary file instead of being read again from the input files.
+ * The temporary file is removed when imaging has finished.
+ *
+ * Set this to NULL or an empty string to disable the cache.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     dir_path   Path of scratch directory.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_scratch_dir(oskar_Imager* h, const char* dir_path);
+
 /**
  * @brief
  * Sets image side length.
@@ -9,6 +9,7 @@
 #include <mem/oskar_mem.h>
 #include <utility/oskar_thread.h>
 #include <utility/oskar_timer.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,7 +41,7 @@ struct oskar_Imager
     oskar_Timer *tmr_overall, *tmr_grid_update, *tmr_grid_finalise, *tmr_init;
     oskar_Timer *tmr_select_scale, *tmr_filter, *tmr_read, *tmr_write;
     oskar_Timer *tmr_copy_convert, *tmr_coord_scan, *tmr_rotate;
-    oskar_Timer *tmr_weights_grid, *tmr_weights_lookup;
+    oskar_Timer *tmr_weights_grid, *tmr_weights_lookup, *tmr_read_wait;
 
     /* Settings parameters. */
     int imager_prec, num_devices, num_gpus_avail, dev_loc, num_gpus, *gpu_ids;
@@ -49,20 +50,25 @@ struct oskar_Imager
     int image_size, use_stokes, support, oversample;
     int generate_w_kernels_on_gpu, set_cellsize, set_fov, weighting;
     int num_files, scale_norm_with_num_input_files;
+    int num_read_buffers, ms_rows_per_read, num_parallel_files;
     char direction_type, kernel_type;
-    char **input_files, *input_root, *output_root, *ms_column;
+    char **input_files, *input_root, *output_root, *ms_column, *scratch_dir;
+    char *perf_report_name, *settings_path;
     double cellsize_rad, fov_deg, image_padding, im_centre_deg[2];
     double uv_filter_min, uv_filter_max, uv_taper[2];
     double time_min_utc, time_max_utc, freq_min_hz, freq_max_hz;
+    double partial_grid_memory_mb;
 
     /* Visibility meta-data. */
     int num_sel_freqs;
     double *im_freqs, *sel_freqs;
-    double vis_freq_start_hz, freq_inc_hz;
+    double vis_freq_start_hz, freq_inc_hz, vis_centre_deg[2];
 
     /* State. */
     int init, status, i_block;
     int coords_only; /* Set if doing a first pass for uniform weighting. */
+    FILE* scratch_file; /* Visibility cache written during the first pass. */
+    char* scratch_name;
     oskar_Mutex* mutex;
     oskar_Log* log;
     size_t num_vis_processed;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_IMAGER_READ_PARALLEL_H_
+#define OSKAR_PRIVATE_IMAGER_READ_PARALLEL_H_
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Function that reads one input file and updates the imager with its data.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in]     filename     Name of the input file.
+ * @param[in]     i_file       Index of the input file, for progress messages.
+ * @param[in]     num_files    Number of input files, for progress messages.
+ * @param[in,out] percent_done Percentage of the input done.
+ * @param[in,out] percent_next Percentage at which to report progress,
+ *                             or NULL to report nothing.
+ * @param[in,out] status       Status return code.
+ */
+typedef void (*oskar_ImagerReadFile)(oskar_Imager* h, const char* filename,
+        int i_file, int num_files, int* percent_done, int* percent_next,
+        int* status);
+
+/**
+ * @brief
+ * Returns the number of input files that can be gridded in parallel.
+ *
+ * @details
+ * Returns the number of worker threads to use to grid the input files,
+ * or 1 if they should be gridded in turn.
+ *
+ * Files can only be gridded in parallel using the FFT or W-projection
+ * algorithms, with gridding done on the host. Each worker after the first
+ * needs its own copy of the image planes, so the number of workers is
+ * limited by the memory allowed for these partial grids.
+ *
+ * @param[in] h  Handle to imager.
+ */
+int oskar_imager_num_file_workers(oskar_Imager* h);
+
+/**
+ * @brief
+ * Reads all the input files and grids them using a pool of worker threads.
+ *
+ * @details
+ * The input files are shared among the workers in a fixed round-robin
+ * order. The first worker grids into the imager's own planes, and the
+ * others grid into partial planes, which are added to the imager's planes
+ * in worker order once all the files have been read. The result is
+ * therefore the same from one run to the next, but may differ by
+ * rounding errors from gridding the files in turn.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in]     read_file    Function used to read each file.
+ * @param[in]     num_workers  Number of worker threads to use.
+ * @param[in,out] status       Status return code.
+ */
+void oskar_imager_read_files_parallel(oskar_Imager* h,
+        oskar_ImagerReadFile read_file, int num_workers, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_IMAGER_READ_PARALLEL_H_ */
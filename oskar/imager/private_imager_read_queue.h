@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_IMAGER_READ_QUEUE_H_
+#define OSKAR_PRIVATE_IMAGER_READ_QUEUE_H_
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A slab of visibility data, ready to be passed to oskar_imager_update(). */
+struct oskar_ImagerSlab
+{
+    oskar_Mem *uu, *vv, *ww, *amps, *weight, *time_centroid;
+    size_t num_rows;
+    int start_chan, end_chan, num_pols, has_time;
+
+    /* Visibility meta-data, restored before gridding if has_meta is set. */
+    int has_meta;
+    double freq_start_hz, freq_inc_hz, ra_deg, dec_deg;
+
+    /* Fraction of the input that has been read, for progress messages. */
+    double fraction_done;
+};
+typedef struct oskar_ImagerSlab oskar_ImagerSlab;
+
+/**
+ * @brief
+ * Function that reads the next slab of visibility data.
+ *
+ * @details
+ * The arrays in the slab are owned by the queue, and are reused for later
+ * slabs. They are NULL the first time the slab is used, and should be
+ * created or resized using oskar_imager_slab_ensure().
+ *
+ * The function returns 1 if the slab was filled, or 0 at the end of the data.
+ *
+ * @param[in,out] reader     Handle to reader state.
+ * @param[in,out] slab       Slab to fill.
+ * @param[in,out] status     Status return code.
+ */
+typedef int (*oskar_ImagerReadSlab)(void* reader, oskar_ImagerSlab* slab,
+        int* status);
+
+/**
+ * @brief
+ * Ensures an array in a slab has the required type and length.
+ *
+ * @param[in,out] mem        Pointer to array handle, which may be NULL.
+ * @param[in]     type       Required data type.
+ * @param[in]     num        Required number of elements.
+ * @param[in,out] status     Status return code.
+ */
+void oskar_imager_slab_ensure(oskar_Mem** mem, int type, size_t num,
+        int* status);
+
+/**
+ * @brief
+ * Reads slabs of visibility data and updates the imager with them.
+ *
+ * @details
+ * If the imager has more than one read buffer, the slabs are read in a
+ * separate thread, which runs ahead of the gridding by up to the number of
+ * buffers. Otherwise, each slab is read and gridded in turn.
+ *
+ * The time spent reading is recorded by the imager's read timer, and the
+ * time spent waiting for data is recorded by its read-wait timer.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in]     read_slab    Function used to read each slab.
+ * @param[in,out] reader       Handle to reader state.
+ * @param[in]     i_file       Index of the input file, for progress messages.
+ * @param[in]     num_files    Number of input files, for progress messages.
+ * @param[in,out] percent_done Percentage of the input done.
+ * @param[in,out] percent_next Percentage at which to report progress,
+ *                             or NULL to report nothing.
+ * @param[in,out] status       Status return code.
+ */
+void oskar_imager_read_slabs(oskar_Imager* h, oskar_ImagerReadSlab read_slab,
+        void* reader, int i_file, int num_files, int* percent_done,
+        int* percent_next, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_IMAGER_READ_QUEUE_H_ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_IMAGER_SCRATCH_H_
+#define OSKAR_PRIVATE_IMAGER_SCRATCH_H_
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Opens a new scratch cache file in the imager's scratch directory.
+ *
+ * @details
+ * While the scratch file is open, oskar_imager_update() appends all
+ * visibility data passed to it in coordinate-only mode to the file,
+ * so that the data can be replayed later without re-reading the input files.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in,out] status     Status return code.
+ */
+void oskar_imager_scratch_open(oskar_Imager* h, int* status);
+
+/**
+ * @brief
+ * Appends a visibility block to the scratch cache file.
+ *
+ * @details
+ * The arguments are the same as those for oskar_imager_update().
+ * The current visibility frequency and phase centre are stored with the data.
+ */
+void oskar_imager_scratch_write(oskar_Imager* h, size_t num_rows,
+        int start_chan, int end_chan, int num_pols, const oskar_Mem* uu,
+        const oskar_Mem* vv, const oskar_Mem* ww, const oskar_Mem* amps,
+        const oskar_Mem* weight, const oskar_Mem* time_centroid, int* status);
+
+/**
+ * @brief
+ * Updates the imager using all visibility data in the scratch cache file.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in,out] status     Status return code.
+ */
+void oskar_imager_scratch_replay(oskar_Imager* h, int* status);
+
+/**
+ * @brief
+ * Closes and removes the scratch cache file, if it is open.
+ *
+ * @param[in,out] h          Handle to imager.
+ */
+void oskar_imager_scratch_close(oskar_Imager* h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_IMAGER_SCRATCH_H_ */
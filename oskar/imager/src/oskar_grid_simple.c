@@ -4,6 +4,9 @@
  */
 
 #include "imager/oskar_grid_simple.h"
+#include "imager/oskar_grid_tiles.h"
+#include "imager/define_grid_tile_cpu.h"
+#include "utility/oskar_kernel_macros.h"
 #include <math.h>
 #include <stdlib.h>
 
@@ -14,6 +17,9 @@ extern "C" {
 #define D_SUPPORT 3
 #define D_OVERSAMPLE 100
 
+OSKAR_GRID_SIMPLE_TILED_CPU(oskar_grid_simple_tiled_d, double, round)
+OSKAR_GRID_SIMPLE_TILED_CPU(oskar_grid_simple_tiled_f, float, roundf)
+
 static void oskar_grid_simple_default_d(
         const double* RESTRICT conv_func,
         const size_t num_points,
@@ -171,6 +177,15 @@ void oskar_grid_simple_d(
     const int grid_centre = grid_size / 2;
     const double grid_scale = grid_size * cell_size_rad;
 
+    /* Grid tiles in parallel if possible. */
+    if (oskar_grid_tiles_enabled(num_points) &&
+            oskar_grid_simple_tiled_d(support, oversample, conv_func,
+                    num_points, uu, vv, vis, weight, cell_size_rad,
+                    grid_size, num_skipped, norm, grid))
+    {
+        return;
+    }
+
     /* Use slightly more efficient version for default parameters. */
     if (support == D_SUPPORT && oversample == D_OVERSAMPLE)
     {
@@ -250,6 +265,15 @@ void oskar_grid_simple_f(
     const int grid_centre = grid_size / 2;
     const float grid_scale = grid_size * cell_size_rad;
 
+    /* Grid tiles in parallel if possible. */
+    if (oskar_grid_tiles_enabled(num_points) &&
+            oskar_grid_simple_tiled_f(support, oversample, conv_func,
+                    num_points, uu, vv, vis, weight, cell_size_rad,
+                    grid_size, num_skipped, norm, grid))
+    {
+        return;
+    }
+
     /* Use slightly more efficient version for default parameters. */
     if (support == D_SUPPORT && oversample == D_OVERSAMPLE)
     {
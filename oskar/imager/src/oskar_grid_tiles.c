@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/oskar_grid_tiles.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Minimum number of visibilities to make tiled gridding worthwhile. */
+#define MIN_POINTS 4096
+
+int oskar_grid_tiles_enabled(size_t num_points)
+{
+#ifdef _OPENMP
+    return (num_points >= MIN_POINTS && omp_get_max_threads() > 1);
+#else
+    (void) num_points;
+    return 0;
+#endif
+}
+
+
+int oskar_grid_tiles_sort(oskar_GridTiles* tiles, size_t num_points,
+        const oskar_GridTilePoint* points, int grid_size)
+{
+    size_t i = 0, num_total = 0;
+    int t = 0;
+    const int tile_size = OSKAR_GRID_TILE_SIZE;
+    memset(tiles, 0, sizeof(oskar_GridTiles));
+    tiles->num_tiles_u = (grid_size + tile_size - 1) / tile_size;
+    tiles->num_tiles_v = tiles->num_tiles_u;
+    const int num_tiles = tiles->num_tiles_u * tiles->num_tiles_v;
+    tiles->tile_start = (size_t*) calloc(num_tiles + 1, sizeof(size_t));
+    if (!tiles->tile_start) return 1;
+
+    /* Count the number of points in each tile. */
+    for (i = 0; i < num_points; ++i)
+    {
+        int pu = 0, pv = 0;
+        const oskar_GridTilePoint* p = &points[i];
+        if (p->support < 0) continue;
+        const int u_min = (p->grid_u - p->support) / tile_size;
+        const int u_max = (p->grid_u + p->support) / tile_size;
+        const int v_min = (p->grid_v - p->support) / tile_size;
+        const int v_max = (p->grid_v + p->support) / tile_size;
+        for (pv = v_min; pv <= v_max; ++pv)
+        {
+            for (pu = u_min; pu <= u_max; ++pu)
+            {
+                tiles->tile_start[pu + pv * tiles->num_tiles_u + 1]++;
+            }
+        }
+    }
+
+    /* Get the start of each tile using prefix sum. */
+    for (t = 0; t < num_tiles; ++t)
+    {
+        tiles->tile_start[t + 1] += tiles->tile_start[t];
+    }
+    num_total = tiles->tile_start[num_tiles];
+
+    /* Bucket sort the point indices into tiles, preserving their order. */
+    tiles->sorted_index = (size_t*) malloc(
+            (num_total > 0 ? num_total : 1) * sizeof(size_t));
+    size_t* fill = (size_t*) malloc(num_tiles * sizeof(size_t));
+    if (!tiles->sorted_index || !fill)
+    {
+        free(fill);
+        oskar_grid_tiles_free(tiles);
+        return 1;
+    }
+    memcpy(fill, tiles->tile_start, num_tiles * sizeof(size_t));
+    for (i = 0; i < num_points; ++i)
+    {
+        int pu = 0, pv = 0;
+        const oskar_GridTilePoint* p = &points[i];
+        if (p->support < 0) continue;
+        const int u_min = (p->grid_u - p->support) / tile_size;
+        const int u_max = (p->grid_u + p->support) / tile_size;
+        const int v_min = (p->grid_v - p->support) / tile_size;
+        const int v_max = (p->grid_v + p->support) / tile_size;
+        for (pv = v_min; pv <= v_max; ++pv)
+        {
+            for (pu = u_min; pu <= u_max; ++pu)
+            {
+                tiles->sorted_index[fill[pu + pv * tiles->num_tiles_u]++] = i;
+            }
+        }
+    }
+    free(fill);
+    return 0;
+}
+
+
+void oskar_grid_tiles_free(oskar_GridTiles* tiles)
+{
+    free(tiles->tile_start);
+    free(tiles->sorted_index);
+    tiles->tile_start = 0;
+    tiles->sorted_index = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,9 @@
  */
 
 #include "imager/oskar_grid_wproj2.h"
+#include "imager/oskar_grid_tiles.h"
+#include "imager/define_grid_tile_cpu.h"
+#include "utility/oskar_kernel_macros.h"
 #include <math.h>
 #include <stdlib.h>
 
@@ -11,6 +14,11 @@
 extern "C" {
 #endif
 
+OSKAR_GRID_WPROJ2_TILED_CPU(oskar_grid_wproj2_tiled_d, double, round, sqrt, fabs)
+OSKAR_GRID_WPROJ2_TILED_CPU(oskar_grid_wproj2_tiled_f, float,
+        roundf, sqrtf, fabsf)
+
+
 void oskar_grid_wproj2_d(
         const size_t num_w_planes,
         const int* RESTRICT support,
@@ -35,6 +43,16 @@ void oskar_grid_wproj2_d(
     const int oversample_h = oversample / 2;
     const double grid_scale = grid_size * cell_size_rad;
 
+    /* Grid tiles in parallel if possible. */
+    if (oskar_grid_tiles_enabled(num_points) &&
+            oskar_grid_wproj2_tiled_d(num_w_planes, support, oversample,
+                    wkernel_start, wkernel, num_points, uu, vv, ww, vis,
+                    weight, cell_size_rad, w_scale, grid_size,
+                    num_skipped, norm, grid))
+    {
+        return;
+    }
+
     /* Loop over visibilities. */
     *num_skipped = 0;
     for (i = 0; i < num_points; ++i)
@@ -125,6 +143,16 @@ void oskar_grid_wproj2_f(
     const int oversample_h = oversample / 2;
     const float grid_scale = grid_size * cell_size_rad;
 
+    /* Grid tiles in parallel if possible. */
+    if (oskar_grid_tiles_enabled(num_points) &&
+            oskar_grid_wproj2_tiled_f(num_w_planes, support, oversample,
+                    wkernel_start, wkernel, num_points, uu, vv, ww, vis,
+                    weight, cell_size_rad, w_scale, grid_size,
+                    num_skipped, norm, grid))
+    {
+        return;
+    }
+
     /* Loop over visibilities. */
     *num_skipped = 0;
     for (i = 0; i < num_points; ++i)
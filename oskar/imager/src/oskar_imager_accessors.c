@@ -137,6 +137,12 @@ const char* oskar_imager_ms_column(const oskar_Imager* h)
 }
 
 
+int oskar_imager_ms_rows_per_read(const oskar_Imager* h)
+{
+    return h->ms_rows_per_read;
+}
+
+
 int oskar_imager_num_image_planes(const oskar_Imager* h)
 {
     return h->num_planes;
@@ -149,6 +155,18 @@ int oskar_imager_num_input_files(const oskar_Imager* h)
 }
 
 
+int oskar_imager_num_parallel_files(const oskar_Imager* h)
+{
+    return h->num_parallel_files;
+}
+
+
+int oskar_imager_num_read_buffers(const oskar_Imager* h)
+{
+    return h->num_read_buffers;
+}
+
+
 int oskar_imager_num_w_planes(const oskar_Imager* h)
 {
     return h->num_w_planes;
@@ -161,6 +179,12 @@ const char* oskar_imager_output_root(const oskar_Imager* h)
 }
 
 
+double oskar_imager_partial_grid_memory_mb(const oskar_Imager* h)
+{
+    return h->partial_grid_memory_mb;
+}
+
+
 int oskar_imager_plane_size(oskar_Imager* h)
 {
     if (h->grid_size == 0)
@@ -204,6 +228,12 @@ int oskar_imager_scale_norm_with_num_input_files(const oskar_Imager* h)
 }
 
 
+const char* oskar_imager_scratch_dir(const oskar_Imager* h)
+{
+    return h->scratch_dir;
+}
+
+
 void oskar_imager_set_algorithm(oskar_Imager* h, const char* type,
         int* status)
 {
@@ -566,6 +596,12 @@ void oskar_imager_set_ms_column(oskar_Imager* h, const char* column,
 }
 
 
+void oskar_imager_set_ms_rows_per_read(oskar_Imager* h, int value)
+{
+    h->ms_rows_per_read = (value < 0) ? 0 : value;
+}
+
+
 void oskar_imager_set_num_devices(oskar_Imager* h, int value)
 {
     int status = 0;
@@ -581,6 +617,18 @@ void oskar_imager_set_num_devices(oskar_Imager* h, int value)
 }
 
 
+void oskar_imager_set_num_parallel_files(oskar_Imager* h, int value)
+{
+    h->num_parallel_files = (value < 0) ? 0 : value;
+}
+
+
+void oskar_imager_set_num_read_buffers(oskar_Imager* h, int value)
+{
+    h->num_read_buffers = (value < 1) ? 1 : value;
+}
+
+
 void oskar_imager_set_output_root(oskar_Imager* h, const char* filename)
 {
     size_t len = 0;
@@ -601,6 +649,26 @@ void oskar_imager_set_oversample(oskar_Imager* h, int value)
 }
 
 
+void oskar_imager_set_partial_grid_memory_mb(oskar_Imager* h, double value)
+{
+    h->partial_grid_memory_mb = (value < 0.0) ? 0.0 : value;
+}
+
+
+void oskar_imager_set_performance_report(oskar_Imager* h, const char* filename)
+{
+    size_t len = 0;
+    free(h->perf_report_name);
+    h->perf_report_name = 0;
+    if (filename) len = strlen(filename);
+    if (len > 0)
+    {
+        h->perf_report_name = (char*) calloc(1 + len, 1);
+        if (h->perf_report_name) memcpy(h->perf_report_name, filename, len);
+    }
+}
+
+
 void oskar_imager_set_scale_norm_with_num_input_files(oskar_Imager* h,
         int value)
 {
@@ -608,6 +676,34 @@ void oskar_imager_set_scale_norm_with_num_input_files(oskar_Imager* h,
 }
 
 
+void oskar_imager_set_scratch_dir(oskar_Imager* h, const char* dir_path)
+{
+    size_t len = 0;
+    free(h->scratch_dir);
+    h->scratch_dir = 0;
+    if (dir_path) len = strlen(dir_path);
+    if (len > 0)
+    {
+        h->scratch_dir = (char*) calloc(1 + len, 1);
+        if (h->scratch_dir) memcpy(h->scratch_dir, dir_path, len);
+    }
+}
+
+
+void oskar_imager_set_settings_path(oskar_Imager* h, const char* filename)
+{
+    size_t len = 0;
+    free(h->settings_path);
+    h->settings_path = 0;
+    if (filename) len = strlen(filename);
+    if (len > 0)
+    {
+        h->settings_path = (char*) calloc(1 + len, 1);
+        if (h->settings_path) memcpy(h->settings_path, filename, len);
+    }
+}
+
+
 void oskar_imager_set_size(oskar_Imager* h, int size, int* status)
 {
     if (*status) return;
@@ -728,6 +824,9 @@ void oskar_imager_set_vis_frequency(oskar_Imager* h,
 void oskar_imager_set_vis_phase_centre(oskar_Imager* h,
         double ra_deg, double dec_deg)
 {
+    h->vis_centre_deg[0] = ra_deg;
+    h->vis_centre_deg[1] = dec_deg;
+
     /* If imaging away from the beam direction, evaluate l0-l, m0-m, n0-n
      * for the new pointing centre, and a rotation matrix to generate the
      * rotated baseline coordinates. */
@@ -53,6 +53,7 @@ oskar_Imager* oskar_imager_create(int imager_precision, int* status)
     h->tmr_rotate = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_filter = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_read = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    h->tmr_read_wait = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_write = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_overall = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_copy_convert = oskar_timer_create(OSKAR_TIMER_NATIVE);
@@ -94,6 +95,9 @@ oskar_Imager* oskar_imager_create(int imager_precision, int* status)
     oskar_imager_set_image_type(h, "I", status);
     oskar_imager_set_weighting(h, "Natural", status);
     oskar_imager_set_ms_column(h, "DATA", status);
+    oskar_imager_set_num_read_buffers(h, 3);
+    oskar_imager_set_num_parallel_files(h, 1);
+    oskar_imager_set_partial_grid_memory_mb(h, 2048.0);
     oskar_imager_set_default_direction(h);
     oskar_imager_set_generate_w_kernels_on_gpu(h, 1);
     oskar_imager_set_fov(h, 1.0);
@@ -11,11 +11,12 @@
 #include "imager/oskar_grid_functions_spheroidal.h"
 #include "imager/private_imager_free_device_data.h"
 #include "math/oskar_fft.h"
-#include "math/oskar_fftphase.h"
 #include "mem/oskar_mem.h"
 #include "utility/oskar_device.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_get_memory_usage.h"
+#include "utility/oskar_perf_report.h"
+#include "utility/oskar_thread.h"
 #include "utility/oskar_timer.h"
 
 #include <fitsio.h>
@@ -23,21 +24,45 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Stages of plane finalisation, for timing. */
+enum
+{
+    STAGE_NORMALISE,
+    STAGE_FFT,
+    STAGE_GRID_CORRECTION,
+    STAGE_EXTRACT,
+    STAGE_WRITE_WAIT,
+    NUM_STAGES
+};
+
+static void finalise_planes(oskar_Imager* h, double* t_stage, int* status);
+static void finalise_setup(oskar_Imager* h, int* status);
+static void finalise_plane(oskar_Imager* h, oskar_Mem* plane,
+        double plane_norm, oskar_Timer* tmr, double* t_stage, int* status);
+static void trim_image(oskar_Mem* plane, int plane_size, int image_size,
+        int* status);
 static void write_plane(oskar_Imager* h, oskar_Mem* plane,
         int c, int p, int* status);
+static void write_report(oskar_Imager* h, const double* t_stage);
 
 
 void oskar_imager_finalise(oskar_Imager* h,
         int num_output_images, oskar_Mem** output_images,
         int num_output_grids, oskar_Mem** output_grids, int* status)
 {
-    int c = 0, p = 0, i = 0;
+    int i = 0;
     size_t j = 0, log_size = 0, length = 0;
     char* log_data = 0;
+    double t_stage[NUM_STAGES];
+    memset(t_stage, 0, sizeof(t_stage));
 
     /* Report any error. */
     if (*status)
@@ -127,24 +152,8 @@ void oskar_imager_finalise(oskar_Imager* h,
     const size_t num_pix = (size_t)h->image_size * (size_t)h->image_size;
     if (h->fits_file[0] || output_images)
     {
-        /* Finalise all the planes. */
-        for (i = 0; i < h->num_planes; ++i)
-        {
-            oskar_Mem *plane = h->planes[i];
-            if (h->grid_on_gpu && h->num_gpus > 0 && !(
-                    h->algorithm == OSKAR_ALGORITHM_DFT_2D ||
-                    h->algorithm == OSKAR_ALGORITHM_DFT_3D))
-            {
-                plane = h->d[0].planes[i];
-            }
-            oskar_imager_finalise_plane(h, plane, h->plane_norm[i], status);
-            if (plane != h->planes[i])
-            {
-                oskar_mem_copy(h->planes[i], plane, status);
-            }
-            oskar_imager_trim_image(h, h->planes[i],
-                    oskar_imager_plane_size(h), h->image_size, status);
-        }
+        /* Finalise all the planes, writing them as they become ready. */
+        finalise_planes(h, t_stage, status);
 
         /* Copy images to output image planes if given. */
         for (i = 0; (i < h->num_planes) && (i < num_output_images); ++i)
@@ -159,17 +168,6 @@ void oskar_imager_finalise(oskar_Imager* h,
                     oskar_mem_void_const(h->planes[i]),
                     num_pix * oskar_mem_element_size(h->imager_prec));
         }
-
-        /* Write to files if required. */
-        oskar_timer_resume(h->tmr_write);
-        for (c = 0, i = 0; c < h->num_im_channels; ++c)
-        {
-            for (p = 0; p < h->num_im_pols; ++p, ++i)
-            {
-                write_plane(h, h->planes[i], c, p, status);
-            }
-        }
-        oskar_timer_pause(h->tmr_write);
     }
 
     /* Record memory usage. */
@@ -194,6 +192,7 @@ void oskar_imager_finalise(oskar_Imager* h,
     const double t_wt_lookup = oskar_timer_elapsed(h->tmr_weights_lookup);
     const double t_grid_finalise = oskar_timer_elapsed(h->tmr_grid_finalise);
     const double t_read = oskar_timer_elapsed(h->tmr_read);
+    const double t_read_wait = oskar_timer_elapsed(h->tmr_read_wait);
     const double t_write = oskar_timer_elapsed(h->tmr_write);
     if (t_scan > 0.0)
     {
@@ -244,16 +243,45 @@ void oskar_imager_finalise(oskar_Imager* h,
     {
         oskar_log_value(h->log, 'M', 0,
             "Grid finalise", "%.3f s", t_grid_finalise);
+
+        /* Stage times are summed over planes, which may run in parallel. */
+        if (t_stage[STAGE_NORMALISE] > 0.0)
+        {
+            oskar_log_value(h->log, 'M', 1,
+                "Normalise", "%.3f s", t_stage[STAGE_NORMALISE]);
+        }
+        if (t_stage[STAGE_FFT] > 0.0)
+        {
+            oskar_log_value(h->log, 'M', 1,
+                "FFT", "%.3f s", t_stage[STAGE_FFT]);
+            oskar_log_value(h->log, 'M', 1,
+                "Grid correction", "%.3f s", t_stage[STAGE_GRID_CORRECTION]);
+        }
+        if (t_stage[STAGE_EXTRACT] > 0.0)
+        {
+            oskar_log_value(h->log, 'M', 1,
+                "Extract image", "%.3f s", t_stage[STAGE_EXTRACT]);
+        }
     }
     if (t_read > 0.0)
     {
         oskar_log_value(h->log, 'M', 0,
             "Read visibility data", "%.3f s", t_read);
+        if (t_read_wait > 0.0)
+        {
+            oskar_log_value(h->log, 'M', 1,
+                "Gridding waited for data", "%.3f s", t_read_wait);
+        }
     }
     if (t_write > 0.0)
     {
         oskar_log_value(h->log, 'M', 0,
             "Write image data", "%.3f s", t_write);
+        if (t_stage[STAGE_WRITE_WAIT] > 0.0)
+        {
+            oskar_log_value(h->log, 'M', 1,
+                "Wait after finalise", "%.3f s", t_stage[STAGE_WRITE_WAIT]);
+        }
     }
 
     /* Record summary. */
@@ -309,8 +337,16 @@ void oskar_imager_finalise(oskar_Imager* h,
                         oskar_mem_element_size(h->imager_prec) / 1e6);
             }
         }
+        if (h->perf_report_name)
+        {
+            oskar_log_value(h->log, 'M', 0, "Performance report", "%s",
+                    h->perf_report_name);
+        }
         oskar_log_message(h->log, 'M', 0, "Run completed in %.3f sec.",
                 oskar_timer_elapsed(h->tmr_overall));
+
+        /* Write the performance report, if required. */
+        write_report(h, t_stage);
     }
     else
     {
@@ -352,58 +388,196 @@ void oskar_imager_finalise(oskar_Imager* h,
 }
 
 
-void oskar_imager_finalise_plane(oskar_Imager* h,
-        oskar_Mem* plane, double plane_norm, int* status)
+typedef struct
 {
-    if (*status) return;
+    oskar_Imager* h;
+    oskar_ConditionVar* cond;
+    int* plane_done; /* 1 when finalised, -1 if finalisation failed. */
+    int status;
+} WriterArgs;
 
-    /* Apply normalisation. */
-    if (plane_norm > 0.0 || plane_norm < 0.0)
+
+/* Writes planes to the FITS files in order, as they are finalised. */
+static void* write_planes(void* arg)
+{
+    int c = 0, p = 0, i = 0;
+    WriterArgs* args = (WriterArgs*) arg;
+    oskar_Imager* h = args->h;
+    for (c = 0, i = 0; c < h->num_im_channels; ++c)
     {
-        oskar_timer_resume(h->tmr_grid_finalise);
-        oskar_mem_scale_real(plane, 1.0 / plane_norm,
-                0, oskar_mem_length(plane), status);
-        oskar_timer_pause(h->tmr_grid_finalise);
+        for (p = 0; p < h->num_im_pols; ++p, ++i)
+        {
+            int done = 0;
+            oskar_condition_lock(args->cond);
+            while (!args->plane_done[i])
+            {
+                oskar_condition_wait(args->cond);
+            }
+            done = args->plane_done[i];
+            oskar_condition_unlock(args->cond);
+            if (done < 0 || args->status) return 0;
+            oskar_timer_resume(h->tmr_write);
+            write_plane(h, h->planes[i], c, p, &args->status);
+            oskar_timer_pause(h->tmr_write);
+        }
     }
+    return 0;
+}
 
-    /* If algorithm if DFT, we've finished here. */
-    if (h->algorithm == OSKAR_ALGORITHM_DFT_2D ||
-            h->algorithm == OSKAR_ALGORITHM_DFT_3D)
+
+static void set_plane_done(WriterArgs* args, int i, int status)
+{
+    oskar_condition_lock(args->cond);
+    args->plane_done[i] = status ? -1 : 1;
+    oskar_condition_notify_all(args->cond);
+    oskar_condition_unlock(args->cond);
+}
+
+
+/* Finalises plane i, leaving the trimmed image in h->planes[i]. */
+static void finalise_plane_index(oskar_Imager* h, int i, int planes_on_gpu,
+        oskar_Timer* tmr, double* t_stage, int* status)
+{
+    oskar_Mem* plane = planes_on_gpu ? h->d[0].planes[i] : h->planes[i];
+    finalise_plane(h, plane, h->plane_norm[i], tmr, t_stage, status);
+    oskar_timer_start(tmr);
+    if (plane != h->planes[i])
     {
-        return;
+        oskar_mem_copy(h->planes[i], plane, status);
     }
+    trim_image(h->planes[i], oskar_imager_plane_size(h), h->image_size,
+            status);
+    t_stage[STAGE_EXTRACT] += oskar_timer_elapsed(tmr);
+}
 
-    /* Check plane is complex type, as plane must be gridded visibilities. */
-    if (!oskar_mem_is_complex(plane))
+
+/*
+ * Finalises all the planes, while a separate thread writes the finished
+ * images to the FITS files.
+ *
+ * If the planes and the FFT are both on the host, whole planes are
+ * processed in parallel, as this scales better than the threads used
+ * within each transform. Otherwise, the planes are processed in order.
+ */
+static void finalise_planes(oskar_Imager* h, double* t_stage, int* status)
+{
+    int i = 0, use_threads = 0;
+    oskar_Thread* writer = 0;
+    oskar_Timer* tmr = 0;
+    WriterArgs args;
+    if (*status || h->num_planes == 0) return;
+    const int is_dft = (h->algorithm == OSKAR_ALGORITHM_DFT_2D ||
+            h->algorithm == OSKAR_ALGORITHM_DFT_3D);
+    const int planes_on_gpu = (h->grid_on_gpu && h->num_gpus > 0 && !is_dft);
+    const int fft_on_gpu = (h->fft_on_gpu && h->num_gpus > 0);
+
+    /* Create the FFT plan and the grid correction function up front,
+     * so they can be shared by all planes. */
+    oskar_timer_resume(h->tmr_grid_finalise);
+    if (!is_dft)
     {
-        *status = OSKAR_ERR_BAD_DATA_TYPE;
-        return;
+        finalise_setup(h, status);
     }
+    oskar_timer_pause(h->tmr_grid_finalise);
+    if (*status) return;
+#ifdef _OPENMP
+    use_threads = (!planes_on_gpu && !fft_on_gpu && h->num_planes > 1 &&
+            omp_get_max_threads() > 1);
+#endif
 
-    /* Check plane size is as expected. */
-    const int size = oskar_imager_plane_size(h);
-    if (oskar_mem_length(plane) != ((size_t)size * (size_t)size))
+    /* Start the writer thread. */
+    args.plane_done = (int*) calloc(h->num_planes, sizeof(int));
+    if (!args.plane_done)
     {
-        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
         return;
     }
+    args.h = h;
+    args.cond = oskar_condition_create();
+    args.status = 0;
+    for (i = 0; i < h->num_im_pols; ++i)
+    {
+        if (h->fits_file[i])
+        {
+            writer = oskar_thread_create(write_planes, (void*)&args, 0);
+            break;
+        }
+    }
 
-    /* Perform FFT shift of the input grid. */
+    /* Finalise the planes. */
     oskar_timer_resume(h->tmr_grid_finalise);
+    if (use_threads)
+    {
+        double t_norm = 0.0, t_fft = 0.0, t_corr = 0.0, t_extract = 0.0;
+#pragma omp parallel for schedule(dynamic, 1) \
+        reduction(+:t_norm, t_fft, t_corr, t_extract)
+        for (i = 0; i < h->num_planes; ++i)
+        {
+            int plane_status = 0;
+            double t[NUM_STAGES] = {0.0};
+            oskar_Timer* tmr_plane = oskar_timer_create(OSKAR_TIMER_NATIVE);
+            finalise_plane_index(h, i, 0, tmr_plane, t, &plane_status);
+            oskar_timer_free(tmr_plane);
+            set_plane_done(&args, i, plane_status);
+            t_norm += t[STAGE_NORMALISE];
+            t_fft += t[STAGE_FFT];
+            t_corr += t[STAGE_GRID_CORRECTION];
+            t_extract += t[STAGE_EXTRACT];
+            if (plane_status)
+            {
+#pragma omp critical (imager_finalise_status)
+                if (!*status) *status = plane_status;
+            }
+        }
+        t_stage[STAGE_NORMALISE] += t_norm;
+        t_stage[STAGE_FFT] += t_fft;
+        t_stage[STAGE_GRID_CORRECTION] += t_corr;
+        t_stage[STAGE_EXTRACT] += t_extract;
+    }
+    else
+    {
+        tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+        for (i = 0; i < h->num_planes; ++i)
+        {
+            finalise_plane_index(h, i, planes_on_gpu, tmr, t_stage, status);
+            set_plane_done(&args, i, *status);
+        }
+        oskar_timer_free(tmr);
+    }
+    oskar_timer_pause(h->tmr_grid_finalise);
+
+    /* Wait for the writer to finish. */
+    if (writer)
+    {
+        tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+        oskar_timer_start(tmr);
+        oskar_thread_join(writer);
+        oskar_thread_free(writer);
+        t_stage[STAGE_WRITE_WAIT] += oskar_timer_elapsed(tmr);
+        oskar_timer_free(tmr);
+    }
+    if (!*status) *status = args.status;
+    oskar_condition_free(args.cond);
+    free(args.plane_done);
+}
+
+
+/* Creates the FFT plan and grid correction function, if required. */
+static void finalise_setup(oskar_Imager* h, int* status)
+{
+    if (*status) return;
+    const int size = oskar_imager_plane_size(h);
     const int fft_loc = (h->fft_on_gpu && h->num_gpus > 0) ?
             h->dev_loc : OSKAR_CPU;
     if (fft_loc != OSKAR_CPU)
     {
         oskar_device_set(h->dev_loc, h->gpu_ids[0], status);
     }
-    oskar_fftphase(size, size, plane, status);
-
-    /* Call FFT. */
     if (!h->fft)
     {
         h->fft = oskar_fft_create(h->imager_prec, fft_loc, 2, size, 0, status);
+        oskar_fft_set_fftphase(h->fft, 1);
     }
-    oskar_fft_exec(h->fft, plane, status);
 
     /* Generate grid correction function if required. */
     if (!h->corr_func)
@@ -430,22 +604,94 @@ void oskar_imager_finalise_plane(oskar_Imager* h,
         }
         h->corr_func = oskar_mem_convert_precision(corr_func,
                 h->imager_prec, status);
+        oskar_mem_free(corr_func, status);
     }
+}
 
-    /* FFT shift again, and apply grid correction. */
-    oskar_fftphase(size, size, plane, status);
-    oskar_grid_correction(size, h->corr_func, plane, status);
+
+void oskar_imager_finalise_plane(oskar_Imager* h,
+        oskar_Mem* plane, double plane_norm, int* status)
+{
+    double t_stage[NUM_STAGES];
+    if (*status) return;
+    memset(t_stage, 0, sizeof(t_stage));
+    oskar_timer_resume(h->tmr_grid_finalise);
+    if (!(h->algorithm == OSKAR_ALGORITHM_DFT_2D ||
+            h->algorithm == OSKAR_ALGORITHM_DFT_3D))
+    {
+        finalise_setup(h, status);
+    }
+    oskar_Timer* tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    finalise_plane(h, plane, plane_norm, tmr, t_stage, status);
+    oskar_timer_free(tmr);
     oskar_timer_pause(h->tmr_grid_finalise);
 }
 
 
+/* Finalises a plane. The FFT and grid correction must already exist. */
+static void finalise_plane(oskar_Imager* h, oskar_Mem* plane,
+        double plane_norm, oskar_Timer* tmr, double* t_stage, int* status)
+{
+    if (*status) return;
+
+    /* Apply normalisation. */
+    if (plane_norm > 0.0 || plane_norm < 0.0)
+    {
+        oskar_timer_start(tmr);
+        oskar_mem_scale_real(plane, 1.0 / plane_norm,
+                0, oskar_mem_length(plane), status);
+        t_stage[STAGE_NORMALISE] += oskar_timer_elapsed(tmr);
+    }
+
+    /* If algorithm if DFT, we've finished here. */
+    if (h->algorithm == OSKAR_ALGORITHM_DFT_2D ||
+            h->algorithm == OSKAR_ALGORITHM_DFT_3D)
+    {
+        return;
+    }
+
+    /* Check plane is complex type, as plane must be gridded visibilities. */
+    if (!oskar_mem_is_complex(plane))
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+
+    /* Check plane size is as expected. */
+    const int size = oskar_imager_plane_size(h);
+    if (oskar_mem_length(plane) != ((size_t)size * (size_t)size))
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+
+    /* Call FFT, shifting the origin of the input and output grids. */
+    oskar_timer_start(tmr);
+    oskar_fft_exec(h->fft, plane, status);
+    t_stage[STAGE_FFT] += oskar_timer_elapsed(tmr);
+
+    /* Apply grid correction. */
+    oskar_timer_start(tmr);
+    oskar_grid_correction(size, h->corr_func, plane, status);
+    t_stage[STAGE_GRID_CORRECTION] += oskar_timer_elapsed(tmr);
+}
+
+
 void oskar_imager_trim_image(oskar_Imager* h, oskar_Mem* plane,
         int plane_size, int image_size, int* status)
+{
+    oskar_timer_resume(h->tmr_grid_finalise);
+    trim_image(plane, plane_size, image_size, status);
+    oskar_timer_pause(h->tmr_grid_finalise);
+}
+
+
+static void trim_image(oskar_Mem* plane, int plane_size, int image_size,
+        int* status)
 {
     if (*status) return;
 
     /* Get the real part only, if the plane is complex. */
-    oskar_timer_resume(h->tmr_grid_finalise);
     if (oskar_mem_is_complex(plane))
     {
         size_t i = 0;
@@ -481,7 +727,6 @@ void oskar_imager_trim_image(oskar_Imager* h, oskar_Mem* plane,
             out += copy_len;
         }
     }
-    oskar_timer_pause(h->tmr_grid_finalise);
 }
 
 
@@ -501,6 +746,99 @@ void write_plane(oskar_Imager* h, oskar_Mem* plane,
 }
 
 
+static void write_report(oskar_Imager* h, const double* t_stage)
+{
+    const double t_overall = oskar_timer_elapsed(h->tmr_overall);
+    const double t_grid_update = oskar_timer_elapsed(h->tmr_grid_update);
+    const double t_grid_finalise = oskar_timer_elapsed(h->tmr_grid_finalise);
+    const long long num_pixels = (long long) h->image_size *
+            (long long) h->image_size * h->num_planes;
+    int report_status = 0;
+    oskar_PerfReport* r = 0;
+    if (!h->perf_report_name) return;
+    r = oskar_perf_report_create(h->perf_report_name,
+            "oskar_imager", h->settings_path, &report_status);
+    if (!r)
+    {
+        oskar_log_warning(h->log, "Unable to write performance report "
+                "'%s'.", h->perf_report_name);
+        return;
+    }
+    oskar_perf_report_string(r, "precision",
+            h->imager_prec == OSKAR_DOUBLE ? "double" : "single");
+    oskar_perf_report_string(r, "algorithm", oskar_imager_algorithm(h));
+
+    /* Problem size. */
+    oskar_perf_report_begin_object(r, "counts");
+    oskar_perf_report_int(r, "input_files", h->num_files);
+    oskar_perf_report_int(r, "visibilities", (long long) h->num_vis_processed);
+    oskar_perf_report_int(r, "image_size", h->image_size);
+    oskar_perf_report_int(r, "grid_size", oskar_imager_plane_size(h));
+    oskar_perf_report_int(r, "planes", h->num_planes);
+    oskar_perf_report_int(r, "pixels", num_pixels);
+    oskar_perf_report_int(r, "w_planes", h->num_w_planes);
+    oskar_perf_report_end(r);
+
+    /* Devices used. */
+    oskar_perf_report_begin_object(r, "devices");
+    oskar_perf_report_int(r, "gpus", h->num_gpus);
+    oskar_perf_report_int(r, "grid_on_gpu", h->num_gpus > 0 && h->grid_on_gpu);
+    oskar_perf_report_int(r, "fft_on_gpu", h->num_gpus > 0 && h->fft_on_gpu);
+    oskar_perf_report_int(r, "parallel_files",
+            oskar_imager_num_parallel_files(h));
+    oskar_perf_report_int(r, "read_buffers", h->num_read_buffers);
+    oskar_perf_report_end(r);
+
+    /* Stage times. Finalise stages are summed over planes,
+     * which may be finalised in parallel. */
+    oskar_perf_report_double(r, "wall_time_sec", t_overall);
+    oskar_perf_report_begin_object(r, "stages");
+    oskar_perf_report_begin_object(r, "wall_time_sec");
+    oskar_perf_report_double(r, "coord_scan",
+            oskar_timer_elapsed(h->tmr_coord_scan));
+    oskar_perf_report_double(r, "initialise", oskar_timer_elapsed(h->tmr_init));
+    oskar_perf_report_double(r, "copy_convert",
+            oskar_timer_elapsed(h->tmr_copy_convert));
+    oskar_perf_report_double(r, "select_scale",
+            oskar_timer_elapsed(h->tmr_select_scale));
+    oskar_perf_report_double(r, "rotate", oskar_timer_elapsed(h->tmr_rotate));
+    oskar_perf_report_double(r, "filter", oskar_timer_elapsed(h->tmr_filter));
+    oskar_perf_report_double(r, "grid_update", t_grid_update);
+    oskar_perf_report_double(r, "weights_grid",
+            oskar_timer_elapsed(h->tmr_weights_grid));
+    oskar_perf_report_double(r, "weights_lookup",
+            oskar_timer_elapsed(h->tmr_weights_lookup));
+    oskar_perf_report_double(r, "grid_finalise", t_grid_finalise);
+    oskar_perf_report_double(r, "normalise", t_stage[STAGE_NORMALISE]);
+    oskar_perf_report_double(r, "fft", t_stage[STAGE_FFT]);
+    oskar_perf_report_double(r, "grid_correction",
+            t_stage[STAGE_GRID_CORRECTION]);
+    oskar_perf_report_double(r, "extract_image", t_stage[STAGE_EXTRACT]);
+    oskar_perf_report_double(r, "read", oskar_timer_elapsed(h->tmr_read));
+    oskar_perf_report_double(r, "read_wait",
+            oskar_timer_elapsed(h->tmr_read_wait));
+    oskar_perf_report_double(r, "write", oskar_timer_elapsed(h->tmr_write));
+    oskar_perf_report_double(r, "write_wait", t_stage[STAGE_WRITE_WAIT]);
+    oskar_perf_report_end(r);
+    oskar_perf_report_end(r);
+
+    /* Derived throughput. */
+    oskar_perf_report_begin_object(r, "throughput");
+    oskar_perf_report_double(r, "visibilities_gridded_per_sec",
+            h->num_vis_processed / t_grid_update);
+    oskar_perf_report_double(r, "pixels_finalised_per_sec",
+            num_pixels / t_grid_finalise);
+    oskar_perf_report_double(r, "visibilities_per_sec",
+            h->num_vis_processed / t_overall);
+    oskar_perf_report_end(r);
+    oskar_perf_report_close(r, &report_status);
+    if (report_status)
+    {
+        oskar_log_warning(h->log, "Error writing performance report '%s'.",
+                h->perf_report_name);
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,7 @@ void oskar_imager_free(oskar_Imager* h, int* status)
     oskar_timer_free(h->tmr_rotate);
     oskar_timer_free(h->tmr_filter);
     oskar_timer_free(h->tmr_read);
+    oskar_timer_free(h->tmr_read_wait);
     oskar_timer_free(h->tmr_write);
     oskar_timer_free(h->tmr_overall);
     oskar_timer_free(h->tmr_copy_convert);
@@ -55,6 +56,9 @@ void oskar_imager_free(oskar_Imager* h, int* status)
     free(h->input_root);
     free(h->output_root);
     free(h->ms_column);
+    free(h->scratch_dir);
+    free(h->perf_report_name);
+    free(h->settings_path);
     free(h->gpu_ids);
     free(h->d);
     free(h);
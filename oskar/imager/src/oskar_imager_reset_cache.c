@@ -6,6 +6,7 @@
 #include "imager/private_imager.h"
 #include "imager/oskar_imager_reset_cache.h"
 #include "imager/private_imager_free_device_data.h"
+#include "imager/private_imager_scratch.h"
 #include "log/oskar_log.h"
 #include "math/oskar_fft.h"
 #include <fitsio.h>
@@ -23,6 +24,9 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     /* Clear all device data. */
     oskar_imager_free_device_data(h, status);
 
+    /* Remove the visibility scratch cache. */
+    oskar_imager_scratch_close(h);
+
     /* Clear selected axes. */
     free(h->sel_freqs); h->sel_freqs = 0;
     free(h->im_freqs); h->im_freqs = 0;
@@ -99,6 +103,7 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     oskar_timer_reset(h->tmr_select_scale);
     oskar_timer_reset(h->tmr_filter);
     oskar_timer_reset(h->tmr_read);
+    oskar_timer_reset(h->tmr_read_wait);
     oskar_timer_reset(h->tmr_write);
     oskar_timer_start(h->tmr_overall);
     oskar_timer_reset(h->tmr_copy_convert);
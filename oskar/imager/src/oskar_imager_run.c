@@ -7,6 +7,8 @@
 #include "imager/private_imager_read_coords.h"
 #include "imager/private_imager_read_data.h"
 #include "imager/private_imager_read_dims.h"
+#include "imager/private_imager_read_parallel.h"
+#include "imager/private_imager_scratch.h"
 #include "imager/oskar_imager.h"
 #include "utility/oskar_get_error_string.h"
 
@@ -18,13 +20,17 @@ extern "C" {
 #endif
 
 static int oskar_imager_is_ms(const char* filename);
+static void oskar_imager_read_file(oskar_Imager* h, const char* filename,
+        int i_file, int num_files, int* percent_done, int* percent_next,
+        int* status);
 
 void oskar_imager_run(oskar_Imager* h,
         int num_output_images, oskar_Mem** output_images,
         int num_output_grids, oskar_Mem** output_grids, int* status)
 {
     const char* filename = 0;
-    int i = 0, num_files = 0, percent_done = 0, percent_next = 10;
+    int i = 0, num_files = 0, percent_done = 0, percent_next = 10, cached = 0;
+    int num_workers = 1;
     if (*status || !h) return;
     oskar_log_section(h->log, 'M', "Starting imager...");
 
@@ -79,16 +85,30 @@ void oskar_imager_run(oskar_Imager* h,
             h->algorithm == OSKAR_ALGORITHM_WPROJ)
     {
         oskar_imager_set_coords_only(h, 1);
-        oskar_log_section(h->log, 'M', "Reading coordinates...");
+        if (h->scratch_dir)
+        {
+            oskar_log_section(h->log, 'M', "Reading visibility data...");
+            oskar_imager_scratch_open(h, status);
+        }
+        else
+        {
+            oskar_log_section(h->log, 'M', "Reading coordinates...");
+        }
 
         /* Loop over input files. */
         for (i = 0; i < num_files; ++i)
         {
-            /* Read coordinates and weights. */
             if (*status) break;
             filename = h->input_files[i];
-            if (oskar_imager_is_ms(filename))
+            if (h->scratch_file)
+            {
+                /* Read all the data, which will be saved to the cache. */
+                oskar_imager_read_file(h, filename, i, num_files,
+                        &percent_done, &percent_next, status);
+            }
+            else if (oskar_imager_is_ms(filename))
             {
+                /* Read coordinates and weights. */
                 oskar_imager_read_coords_ms(h, filename, i, num_files,
                         &percent_done, &percent_next, status);
             }
@@ -110,28 +130,39 @@ void oskar_imager_run(oskar_Imager* h,
 
     /* Initialise the algorithm. */
     oskar_imager_check_init(h, status);
-    if (!*status)
+    if (!*status && h->scratch_file)
+    {
+        /* Grid the visibility data saved in the cache. */
+        oskar_log_section(h->log, 'M', "Gridding cached visibility data...");
+        oskar_imager_scratch_replay(h, status);
+        oskar_imager_scratch_close(h);
+        cached = 1;
+    }
+    else if (!*status)
     {
         oskar_log_section(h->log, 'M', "Reading visibility data...");
     }
 
-    /* Loop over input files. */
+    /* Grid the input files in parallel if possible. */
+    if (!*status && !cached)
+    {
+        num_workers = oskar_imager_num_file_workers(h);
+    }
+    if (num_workers > 1)
+    {
+        oskar_imager_read_files_parallel(h, oskar_imager_read_file,
+                num_workers, status);
+        cached = 1;
+    }
+
+    /* Loop over input files, unless the data have already been read. */
     percent_done = 0; percent_next = 10;
-    for (i = 0; i < num_files; ++i)
+    for (i = 0; i < num_files && !cached; ++i)
     {
         /* Read visibility data. */
         if (*status) break;
-        filename = h->input_files[i];
-        if (oskar_imager_is_ms(filename))
-        {
-            oskar_imager_read_data_ms(h, filename, i, num_files,
-                    &percent_done, &percent_next, status);
-        }
-        else
-        {
-            oskar_imager_read_data_vis(h, filename, i, num_files,
-                    &percent_done, &percent_next, status);
-        }
+        oskar_imager_read_file(h, h->input_files[i], i, num_files,
+                &percent_done, &percent_next, status);
     }
 
     /* Check for errors. */
@@ -147,6 +178,23 @@ void oskar_imager_run(oskar_Imager* h,
 }
 
 
+void oskar_imager_read_file(oskar_Imager* h, const char* filename,
+        int i_file, int num_files, int* percent_done, int* percent_next,
+        int* status)
+{
+    if (oskar_imager_is_ms(filename))
+    {
+        oskar_imager_read_data_ms(h, filename, i_file, num_files,
+                percent_done, percent_next, status);
+    }
+    else
+    {
+        oskar_imager_read_data_vis(h, filename, i_file, num_files,
+                percent_done, percent_next, status);
+    }
+}
+
+
 int oskar_imager_is_ms(const char* filename)
 {
     size_t len = 0;
@@ -7,9 +7,10 @@
 
 #include "imager/oskar_grid_weights.h"
 #include "imager/oskar_imager.h"
-#include "imager/private_imager_create_fits_files.h"
+#include "imager/private_imager_allocate_planes.h"
 #include "imager/private_imager_filter_time.h"
 #include "imager/private_imager_filter_uv.h"
+#include "imager/private_imager_scratch.h"
 #include "imager/private_imager_select_data.h"
 #include "imager/private_imager_set_num_planes.h"
 #include "imager/private_imager_taper_weights.h"
@@ -19,7 +20,6 @@
 #include "imager/private_imager_weight_radial.h"
 #include "imager/private_imager_weight_uniform.h"
 #include "log/oskar_log.h"
-#include "utility/oskar_device.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -29,7 +29,6 @@
 extern "C" {
 #endif
 
-static void oskar_imager_allocate_planes(oskar_Imager* h, int *status);
 static void oskar_imager_update_weights_grid(oskar_Imager* h,
         size_t num_points, const oskar_Mem* uu, const oskar_Mem* vv,
         const oskar_Mem* ww, const oskar_Mem* weight, oskar_Mem* weights_grid,
@@ -293,6 +292,13 @@ void oskar_imager_update(oskar_Imager* h, size_t num_rows, int start_chan,
         return;
     }
 
+    /* Save the data to the scratch cache if it is being written. */
+    if (h->coords_only && h->scratch_file)
+    {
+        oskar_imager_scratch_write(h, num_rows, start_chan, end_chan,
+                num_pols, uu, vv, ww, amps, weight, time_centroid, status);
+    }
+
     /* Ensure image/grid planes exist and algorithm has been initialised. */
     oskar_imager_set_num_planes(h, status);
     oskar_imager_check_init(h, status);
@@ -680,97 +686,6 @@ void oskar_imager_update_weights_grid(oskar_Imager* h, size_t num_points,
     }
 }
 
-void oskar_imager_allocate_planes(oskar_Imager* h, int *status)
-{
-    int i = 0;
-    if (*status) return;
-
-    /* Don't continue if we're in "coords only" mode or if planes are
-     * already allocated. */
-    if (h->coords_only || h->planes) return;
-
-    /* Record the plane size. */
-    const int num_planes = h->num_planes;
-    const int plane_size = oskar_imager_plane_size(h);
-    const int plane_type = oskar_imager_plane_type(h);
-    const size_t num_cells = ((size_t) plane_size) * ((size_t) plane_size);
-    const size_t plane_mem = num_cells * oskar_mem_element_size(plane_type);
-    oskar_log_message(h->log, 'M', 0, "Plane size is %d x %d.",
-            plane_size, plane_size);
-    oskar_log_message(h->log, 'M', 0, "Allocating %d plane(s) of size "
-            "%.1f MB (%.1f MB total).", num_planes, plane_mem * 1e-6,
-            num_planes * plane_mem * 1e-6);
-
-    /* Allocate the image or visibility planes on the host. */
-    h->planes = (oskar_Mem**) calloc(num_planes, sizeof(oskar_Mem*));
-    h->plane_norm = (double*) calloc(num_planes, sizeof(double));
-    for (i = 0; i < num_planes; ++i)
-    {
-        h->planes[i] = oskar_mem_create(plane_type, OSKAR_CPU,
-                num_cells, status);
-    }
-
-    /* Allocate visibility planes on the devices if required. */
-    if (h->grid_on_gpu && !(
-            h->algorithm == OSKAR_ALGORITHM_DFT_2D ||
-            h->algorithm == OSKAR_ALGORITHM_DFT_3D))
-    {
-        int j = 0, norm_type = 0;
-        const int loc = h->dev_loc;
-        for (j = 0; j < h->num_gpus; ++j)
-        {
-            if (*status) break;
-            DeviceData* d = &h->d[j];
-            d->num_planes = num_planes;
-            d->planes = (oskar_Mem**) calloc(num_planes, sizeof(oskar_Mem*));
-            oskar_log_message(h->log, 'M', 0,
-                    "Allocating memory on device %d for visibility grids.",
-                    h->gpu_ids[j]);
-            oskar_device_set(loc, h->gpu_ids[j], status);
-            for (i = 0; i < num_planes; ++i)
-            {
-                d->planes[i] = oskar_mem_create(plane_type, loc,
-                        num_cells, status);
-                oskar_mem_clear_contents(d->planes[i], status);
-            }
-
-            /* Get the normalisation type. */
-            if (oskar_device_supports_double(loc) &&
-                    oskar_device_supports_atomic64(loc))
-            {
-                norm_type = OSKAR_DOUBLE;
-            }
-            else
-            {
-                norm_type = OSKAR_SINGLE;
-            }
-
-            /* Define (empty) device arrays for scratch data. */
-            d->uu = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->vv = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->ww = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->vis = oskar_mem_create(plane_type, loc, 0, status);
-            d->weight = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->counter = oskar_mem_create(OSKAR_INT, loc, 1, status);
-            d->count_skipped = oskar_mem_create(OSKAR_INT, loc, 1, status);
-            d->norm = oskar_mem_create(norm_type, loc, 1, status);
-            d->num_points_in_tiles =
-                    oskar_mem_create(OSKAR_INT, loc, 0, status);
-            d->tile_offsets = oskar_mem_create(OSKAR_INT, loc, 0, status);
-            d->tile_locks = oskar_mem_create(OSKAR_INT, loc, 0, status);
-            d->sorted_uu = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->sorted_vv = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->sorted_ww = oskar_mem_create(OSKAR_INT, loc, 0, status);
-            d->sorted_wt = oskar_mem_create(h->imager_prec, loc, 0, status);
-            d->sorted_vis = oskar_mem_create(plane_type, loc, 0, status);
-            d->sorted_tile = oskar_mem_create(OSKAR_INT, loc, 0, status);
-        }
-    }
-
-    /* Create FITS files for the planes if required. */
-    oskar_imager_create_fits_files(h, status);
-}
-
 
 #ifdef __cplusplus
 }
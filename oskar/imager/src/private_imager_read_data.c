@@ -5,6 +5,7 @@
 
 #include "imager/private_imager.h"
 #include "imager/private_imager_read_data.h"
+#include "imager/private_imager_read_queue.h"
 #include "imager/oskar_imager.h"
 #include "binary/oskar_binary.h"
 #include "math/oskar_cmath.h"
@@ -23,116 +24,135 @@
 extern "C" {
 #endif
 
+#ifndef OSKAR_NO_MS
+/* Amount of visibility data read at once if the number of rows is auto. */
+#define AUTO_READ_BYTES (32 * 1024 * 1024)
+
+struct MsReader
+{
+    oskar_MeasurementSet* ms;
+    const char* column;
+    size_t start_row, num_rows, rows_per_read;
+    int num_channels, num_pols, amp_type;
+    oskar_Mem* uvw;
+};
+typedef struct MsReader MsReader;
+
+
+static int read_slab_ms(void* arg, oskar_ImagerSlab* slab, int* status)
+{
+    size_t allocated = 0, required = 0, i = 0;
+    MsReader* r = (MsReader*) arg;
+    if (*status || r->start_row >= r->num_rows) return 0;
+    size_t block_size = r->num_rows - r->start_row;
+    if (block_size > r->rows_per_read) block_size = r->rows_per_read;
+
+    /* Resize arrays if required. */
+    oskar_imager_slab_ensure(&r->uvw, OSKAR_DOUBLE, 3 * block_size, status);
+    oskar_imager_slab_ensure(&slab->uu, OSKAR_DOUBLE, block_size, status);
+    oskar_imager_slab_ensure(&slab->vv, OSKAR_DOUBLE, block_size, status);
+    oskar_imager_slab_ensure(&slab->ww, OSKAR_DOUBLE, block_size, status);
+    oskar_imager_slab_ensure(&slab->weight, OSKAR_SINGLE,
+            block_size * r->num_pols, status);
+    oskar_imager_slab_ensure(&slab->time_centroid, OSKAR_DOUBLE,
+            block_size, status);
+    oskar_imager_slab_ensure(&slab->amps, r->amp_type,
+            block_size * r->num_channels, status);
+    if (*status) return 0;
+
+    /* Read rows from Measurement Set. */
+    allocated = oskar_mem_length(r->uvw) *
+            oskar_mem_element_size(oskar_mem_type(r->uvw));
+    oskar_ms_read_column(r->ms, "UVW", r->start_row, block_size,
+            allocated, oskar_mem_void(r->uvw), &required, status);
+    allocated = oskar_mem_length(slab->weight) *
+            oskar_mem_element_size(oskar_mem_type(slab->weight));
+    oskar_ms_read_column(r->ms, "WEIGHT", r->start_row, block_size,
+            allocated, oskar_mem_void(slab->weight), &required, status);
+    allocated = oskar_mem_length(slab->time_centroid) *
+            oskar_mem_element_size(oskar_mem_type(slab->time_centroid));
+    oskar_ms_read_column(r->ms, "TIME_CENTROID", r->start_row, block_size,
+            allocated, oskar_mem_void(slab->time_centroid), &required, status);
+    allocated = oskar_mem_length(slab->amps) *
+            oskar_mem_element_size(oskar_mem_type(slab->amps));
+    oskar_ms_read_column(r->ms, r->column, r->start_row, block_size,
+            allocated, oskar_mem_void(slab->amps), &required, status);
+    if (*status) return 0;
+
+    /* Split up baseline coordinates. */
+    const double* uvw_ = oskar_mem_double_const(r->uvw, status);
+    double* u_ = oskar_mem_double(slab->uu, status);
+    double* v_ = oskar_mem_double(slab->vv, status);
+    double* w_ = oskar_mem_double(slab->ww, status);
+    for (i = 0; i < block_size; ++i)
+    {
+        u_[i] = uvw_[3*i + 0];
+        v_[i] = uvw_[3*i + 1];
+        w_[i] = uvw_[3*i + 2];
+    }
+    slab->num_rows = block_size;
+    slab->start_chan = 0;
+    slab->end_chan = r->num_channels - 1;
+    slab->num_pols = r->num_pols;
+    slab->has_time = 1;
+    r->start_row += block_size;
+    slab->fraction_done = r->start_row / (double) r->num_rows;
+    return 1;
+}
+#endif
+
+
 void oskar_imager_read_data_ms(oskar_Imager* h, const char* filename,
         int i_file, int num_files, int* percent_done, int* percent_next,
         int* status)
 {
 #ifndef OSKAR_NO_MS
-    oskar_MeasurementSet* ms = 0;
-    oskar_Mem *uvw = 0, *u = 0, *v = 0, *w = 0, *data = 0;
-    oskar_Mem *weight = 0, *time_centroid = 0;
-    int type = 0;
-    size_t start_row = 0;
-    double *uvw_ = 0, *u_ = 0, *v_ = 0, *w_ = 0;
+    MsReader r;
     if (*status) return;
 
     /* Read the header. */
     oskar_log_message(h->log, 'M', 0, "Opening Measurement Set '%s'", filename);
-    ms = oskar_ms_open_readonly(filename);
-    if (!ms)
+    memset(&r, 0, sizeof(MsReader));
+    r.ms = oskar_ms_open_readonly(filename);
+    if (!r.ms)
     {
         *status = OSKAR_ERR_FILE_IO;
         return;
     }
-    const size_t num_rows = (size_t) oskar_ms_num_rows(ms);
-    const size_t num_stations = (size_t) oskar_ms_num_stations(ms);
+    const size_t num_stations = (size_t) oskar_ms_num_stations(r.ms);
     const size_t num_baselines = num_stations * (num_stations - 1) / 2;
-    const int num_pols = (int) oskar_ms_num_pols(ms);
-    const int num_channels = (int) oskar_ms_num_channels(ms);
+    r.column = h->ms_column;
+    r.num_rows = (size_t) oskar_ms_num_rows(r.ms);
+    r.num_pols = (int) oskar_ms_num_pols(r.ms);
+    r.num_channels = (int) oskar_ms_num_channels(r.ms);
+    r.amp_type = OSKAR_SINGLE | OSKAR_COMPLEX;
+    if (r.num_pols == 4) r.amp_type |= OSKAR_MATRIX;
+
+    /* Set the number of rows to read at once. */
+    r.rows_per_read = (size_t) h->ms_rows_per_read;
+    if (r.rows_per_read == 0)
+    {
+        const size_t row_bytes = (size_t) r.num_channels *
+                oskar_mem_element_size(r.amp_type);
+        const size_t num_times = (row_bytes * num_baselines > 0) ?
+                AUTO_READ_BYTES / (row_bytes * num_baselines) : 0;
+        r.rows_per_read = (num_times > 1 ? num_times : 1) * num_baselines;
+    }
+    if (r.rows_per_read == 0) r.rows_per_read = 1;
 
     /* Set visibility meta-data. */
     oskar_imager_set_vis_frequency(h,
-            oskar_ms_freq_start_hz(ms),
-            oskar_ms_freq_inc_hz(ms), num_channels);
+            oskar_ms_freq_start_hz(r.ms),
+            oskar_ms_freq_inc_hz(r.ms), r.num_channels);
     oskar_imager_set_vis_phase_centre(h,
-            oskar_ms_phase_centre_ra_rad(ms) * 180/M_PI,
-            oskar_ms_phase_centre_dec_rad(ms) * 180/M_PI);
-
-    /* Create arrays. */
-    uvw = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 3 * num_baselines, status);
-    u = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    v = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    w = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    weight = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU,
-            num_baselines * num_pols, status);
-    time_centroid = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines,
-            status);
-    uvw_ = oskar_mem_double(uvw, status);
-    u_ = oskar_mem_double(u, status);
-    v_ = oskar_mem_double(v, status);
-    w_ = oskar_mem_double(w, status);
-    type = OSKAR_SINGLE | OSKAR_COMPLEX;
-    if (num_pols == 4) type |= OSKAR_MATRIX;
-    data = oskar_mem_create(type, OSKAR_CPU,
-            num_baselines * num_channels, status);
+            oskar_ms_phase_centre_ra_rad(r.ms) * 180/M_PI,
+            oskar_ms_phase_centre_dec_rad(r.ms) * 180/M_PI);
 
-    /* Loop over visibility blocks. */
-    for (start_row = 0; start_row < num_rows; start_row += num_baselines)
-    {
-        size_t allocated = 0, required = 0, block_size = 0, i = 0;
-        if (*status) break;
-
-        /* Read rows from Measurement Set. */
-        oskar_timer_resume(h->tmr_read);
-        block_size = num_rows - start_row;
-        if (block_size > num_baselines) block_size = num_baselines;
-        allocated = oskar_mem_length(uvw) *
-                oskar_mem_element_size(oskar_mem_type(uvw));
-        oskar_ms_read_column(ms, "UVW", start_row, block_size,
-                allocated, oskar_mem_void(uvw), &required, status);
-        allocated = oskar_mem_length(weight) *
-                oskar_mem_element_size(oskar_mem_type(weight));
-        oskar_ms_read_column(ms, "WEIGHT", start_row, block_size,
-                allocated, oskar_mem_void(weight), &required, status);
-        allocated = oskar_mem_length(time_centroid) *
-                oskar_mem_element_size(oskar_mem_type(time_centroid));
-        oskar_ms_read_column(ms, "TIME_CENTROID", start_row, block_size,
-                allocated, oskar_mem_void(time_centroid), &required, status);
-        allocated = oskar_mem_length(data) *
-                oskar_mem_element_size(oskar_mem_type(data));
-        oskar_ms_read_column(ms, h->ms_column, start_row, block_size,
-                allocated, oskar_mem_void(data), &required, status);
-        if (*status) break;
-
-        /* Split up baseline coordinates. */
-        for (i = 0; i < block_size; ++i)
-        {
-            u_[i] = uvw_[3*i + 0];
-            v_[i] = uvw_[3*i + 1];
-            w_[i] = uvw_[3*i + 2];
-        }
-
-        /* Update the imager with the data. */
-        oskar_timer_pause(h->tmr_read);
-        oskar_imager_update(h, block_size, 0, num_channels - 1,
-                num_pols, u, v, w, data, weight, time_centroid, status);
-        *percent_done = (int) round(100.0 * (
-                (start_row + block_size) / (double)(num_rows * num_files) +
-                i_file / (double)num_files));
-        if (percent_next && *percent_done >= *percent_next)
-        {
-            oskar_log_message(h->log, 'S', -2, "%3d%% ...", *percent_done);
-            *percent_next = 10 + 10 * (*percent_done / 10);
-        }
-    }
-    oskar_mem_free(uvw, status);
-    oskar_mem_free(u, status);
-    oskar_mem_free(v, status);
-    oskar_mem_free(w, status);
-    oskar_mem_free(data, status);
-    oskar_mem_free(weight, status);
-    oskar_mem_free(time_centroid, status);
-    oskar_ms_close(ms);
+    /* Read and grid the visibility data. */
+    oskar_imager_read_slabs(h, read_slab_ms, (void*)&r, i_file, num_files,
+            percent_done, percent_next, status);
+    oskar_mem_free(r.uvw, status);
+    oskar_ms_close(r.ms);
 #else
     (void) filename;
     (void) i_file;
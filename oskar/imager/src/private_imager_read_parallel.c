@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_allocate_planes.h"
+#include "imager/private_imager_read_parallel.h"
+#include "imager/private_imager_set_num_planes.h"
+#include "imager/oskar_imager.h"
+#include "log/oskar_log.h"
+#include "utility/oskar_get_num_procs.h"
+#include "utility/oskar_thread.h"
+#include "utility/oskar_timer.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_TIMERS 14
+
+struct ThreadArgs
+{
+    oskar_Imager* h; /* Imager used by this worker. */
+    oskar_Log* log; /* Log shared by all the workers. */
+    oskar_Mutex* mutex;
+    oskar_ImagerReadFile read_file;
+    const char* const* input_files;
+    int* num_files_done;
+    int* percent_next;
+    int num_files, num_workers, num_omp_threads, worker_id, status;
+};
+typedef struct ThreadArgs ThreadArgs;
+
+
+static oskar_Timer** timer(oskar_Imager* h, int i)
+{
+    oskar_Timer** t[NUM_TIMERS] = {
+            &h->tmr_overall, &h->tmr_grid_update, &h->tmr_grid_finalise,
+            &h->tmr_init, &h->tmr_select_scale, &h->tmr_filter,
+            &h->tmr_read, &h->tmr_write, &h->tmr_copy_convert,
+            &h->tmr_coord_scan, &h->tmr_rotate, &h->tmr_weights_grid,
+            &h->tmr_weights_lookup, &h->tmr_read_wait
+    };
+    return t[i];
+}
+
+
+/*
+ * Creates a worker imager that shares the settings, meta-data and
+ * read-only algorithm data of the parent, but has its own scratch arrays,
+ * timers, log and image planes.
+ */
+static oskar_Imager* worker_create(oskar_Imager* h, int* status)
+{
+    int i = 0;
+    const int prec = h->imager_prec;
+    const int plane_size = oskar_imager_plane_size(h);
+    const int plane_type = oskar_imager_plane_type(h);
+    const size_t num_cells = ((size_t) plane_size) * ((size_t) plane_size);
+    oskar_Imager* w = (oskar_Imager*) malloc(sizeof(oskar_Imager));
+    memcpy(w, h, sizeof(oskar_Imager));
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        *timer(w, i) = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    }
+    for (i = 0; i < 4; ++i) w->fits_file[i] = 0;
+    w->status = 0;
+    w->scratch_file = 0;
+    w->scratch_name = 0;
+    w->mutex = oskar_mutex_create();
+    w->log = oskar_log_create(OSKAR_LOG_NONE, OSKAR_LOG_NONE);
+    w->num_vis_processed = 0;
+    w->uu_im = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->vv_im = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->ww_im = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->uu_tmp = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->vv_tmp = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->ww_tmp = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->vis_im = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU, 0, status);
+    w->weight_im = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->weight_tmp = oskar_mem_create(prec, OSKAR_CPU, 0, status);
+    w->time_im = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 0, status);
+    w->stokes = 0;
+    w->plane_norm = (double*) calloc(h->num_planes, sizeof(double));
+    w->planes = (oskar_Mem**) calloc(h->num_planes, sizeof(oskar_Mem*));
+    for (i = 0; i < h->num_planes; ++i)
+    {
+        w->planes[i] = oskar_mem_create(plane_type, OSKAR_CPU,
+                num_cells, status);
+        oskar_mem_clear_contents(w->planes[i], status);
+    }
+    return w;
+}
+
+
+/* Frees only the data owned by a worker imager. */
+static void worker_free(oskar_Imager* w, int* status)
+{
+    int i = 0;
+    if (!w) return;
+    for (i = 0; i < NUM_TIMERS; ++i)
+    {
+        oskar_timer_free(*timer(w, i));
+    }
+    oskar_mutex_free(w->mutex);
+    oskar_log_free(w->log);
+    oskar_mem_free(w->uu_im, status);
+    oskar_mem_free(w->vv_im, status);
+    oskar_mem_free(w->ww_im, status);
+    oskar_mem_free(w->uu_tmp, status);
+    oskar_mem_free(w->vv_tmp, status);
+    oskar_mem_free(w->ww_tmp, status);
+    oskar_mem_free(w->vis_im, status);
+    oskar_mem_free(w->weight_im, status);
+    oskar_mem_free(w->weight_tmp, status);
+    oskar_mem_free(w->time_im, status);
+    oskar_mem_free(w->stokes, status);
+    for (i = 0; i < w->num_planes; ++i)
+    {
+        oskar_mem_free(w->planes[i], status);
+    }
+    free(w->planes);
+    free(w->plane_norm);
+    free(w);
+}
+
+
+static void* read_files(void* arg)
+{
+    int i = 0, percent_done = 0;
+    ThreadArgs* a = (ThreadArgs*) arg;
+#ifdef _OPENMP
+    /* Share the OpenMP threads used by the gridder among the workers. */
+    omp_set_num_threads(a->num_omp_threads);
+#endif
+    for (i = a->worker_id; i < a->num_files; i += a->num_workers)
+    {
+        const char* filename = a->input_files[i];
+        if (a->status) break;
+        oskar_mutex_lock(a->mutex);
+        oskar_log_message(a->log, 'M', 0, "Opening '%s'", filename);
+        oskar_mutex_unlock(a->mutex);
+
+        /* Read and grid the file. */
+        a->read_file(a->h, filename, i, a->num_files, &percent_done, 0,
+                &a->status);
+
+        /* Report progress. */
+        oskar_mutex_lock(a->mutex);
+        percent_done = (int) round(100.0 * ++(*a->num_files_done) /
+                (double) a->num_files);
+        if (!a->status && percent_done >= *a->percent_next)
+        {
+            oskar_log_message(a->log, 'S', -2, "%3d%% ...", percent_done);
+            *a->percent_next = 10 + 10 * (percent_done / 10);
+        }
+        oskar_mutex_unlock(a->mutex);
+    }
+    return 0;
+}
+
+
+int oskar_imager_num_file_workers(oskar_Imager* h)
+{
+    int num_workers = h->num_parallel_files;
+    if (num_workers == 1 || h->num_files < 2) return 1;
+    if (h->algorithm != OSKAR_ALGORITHM_FFT &&
+            h->algorithm != OSKAR_ALGORITHM_WPROJ) return 1;
+    if (h->grid_on_gpu && h->num_gpus > 0) return 1;
+    if (num_workers < 1) num_workers = oskar_get_num_procs();
+    if (num_workers > h->num_files) num_workers = h->num_files;
+
+    /* Limit the number of partial grids to fit in the memory allowed. */
+    const int num_planes = h->num_planes > 0 ? h->num_planes :
+            (h->chan_snaps ? h->num_sel_freqs : 1) * h->num_im_pols;
+    const int plane_size = oskar_imager_plane_size(h);
+    const double grid_mb = 1e-6 * num_planes * (double) plane_size *
+            (double) plane_size *
+            oskar_mem_element_size(oskar_imager_plane_type(h));
+    if (grid_mb > 0.0)
+    {
+        const double max_partial = floor(h->partial_grid_memory_mb / grid_mb);
+        if (max_partial < num_workers - 1)
+        {
+            num_workers = 1 + (int) max_partial;
+        }
+    }
+    return num_workers;
+}
+
+
+void oskar_imager_read_files_parallel(oskar_Imager* h,
+        oskar_ImagerReadFile read_file, int num_workers, int* status)
+{
+    int i = 0, j = 0, num_files_done = 0, percent_next = 10;
+    int num_omp_threads = 1;
+    oskar_Thread** threads = 0;
+    ThreadArgs* args = 0;
+    oskar_Log* log = h->log;
+    if (*status) return;
+
+    /* Make sure the planes exist before they are copied. */
+    oskar_imager_set_num_planes(h, status);
+    oskar_imager_check_init(h, status);
+    oskar_imager_allocate_planes(h, status);
+    if (*status) return;
+#ifdef _OPENMP
+    num_omp_threads = omp_get_max_threads() / num_workers;
+    if (num_omp_threads < 1) num_omp_threads = 1;
+#endif
+    oskar_log_message(log, 'M', 0, "Gridding %d files using %d workers, "
+            "with %d partial grid(s).", h->num_files, num_workers,
+            num_workers - 1);
+
+    /* Set up the workers. The first one uses the imager itself. */
+    threads = (oskar_Thread**) calloc(num_workers, sizeof(oskar_Thread*));
+    args = (ThreadArgs*) calloc(num_workers, sizeof(ThreadArgs));
+    for (i = 0; i < num_workers; ++i)
+    {
+        args[i].h = (i == 0) ? h : worker_create(h, status);
+        args[i].log = log;
+        args[i].mutex = h->mutex;
+        args[i].read_file = read_file;
+        args[i].input_files = (const char* const*) h->input_files;
+        args[i].num_files_done = &num_files_done;
+        args[i].percent_next = &percent_next;
+        args[i].num_files = h->num_files;
+        args[i].num_workers = num_workers;
+        args[i].num_omp_threads = num_omp_threads;
+        args[i].worker_id = i;
+    }
+
+    /* Start the worker threads and wait for them to finish.
+     * Messages from inside each worker are suppressed, as they would
+     * otherwise be interleaved. */
+    if (!*status)
+    {
+        h->log = oskar_log_create(OSKAR_LOG_NONE, OSKAR_LOG_NONE);
+        for (i = 0; i < num_workers; ++i)
+        {
+            threads[i] = oskar_thread_create(read_files, (void*)&args[i], 0);
+        }
+        for (i = 0; i < num_workers; ++i)
+        {
+            oskar_thread_join(threads[i]);
+            oskar_thread_free(threads[i]);
+            if (!*status) *status = args[i].status;
+        }
+        oskar_log_free(h->log);
+        h->log = log;
+    }
+
+    /* Add the partial grids to the imager's planes, in worker order.
+     * The time spent by each worker in each stage is added to the
+     * imager's timers, so they report the sum over all the workers,
+     * as for the devices used by the interferometer. The overall
+     * timer is not merged, as it measures the wall-clock time. */
+    oskar_timer_resume(h->tmr_grid_update);
+    for (i = 1; i < num_workers; ++i)
+    {
+        oskar_Imager* w = args[i].h;
+        if (!w) continue;
+        for (j = 1; j < NUM_TIMERS; ++j)
+        {
+            oskar_timer_add(*timer(h, j), oskar_timer_elapsed(*timer(w, j)));
+        }
+        for (j = 0; j < h->num_planes && !*status; ++j)
+        {
+            oskar_mem_add(h->planes[j], h->planes[j], w->planes[j],
+                    0, 0, 0, oskar_mem_length(h->planes[j]), status);
+            h->plane_norm[j] += w->plane_norm[j];
+        }
+        h->num_vis_processed += w->num_vis_processed;
+        worker_free(w, status);
+    }
+    oskar_timer_pause(h->tmr_grid_update);
+    free(threads);
+    free(args);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_read_queue.h"
+#include "imager/oskar_imager.h"
+#include "utility/oskar_thread.h"
+#include "utility/oskar_timer.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ReadQueue
+{
+    oskar_Imager* h;
+    oskar_ImagerReadSlab read_slab;
+    void* reader;
+    oskar_ConditionVar* cond;
+    oskar_ImagerSlab* slabs;
+    int num_slabs;
+    int num_read;  /* Number of slabs filled by the reader. */
+    int num_used;  /* Number of slabs gridded and released. */
+    int finished;  /* Set by the reader at the end of the data. */
+    int stop;      /* Set by the consumer to stop the reader early. */
+    int status;    /* Status of the reader. */
+};
+typedef struct ReadQueue ReadQueue;
+
+
+static void* read_ahead(void* arg)
+{
+    ReadQueue* q = (ReadQueue*) arg;
+    for (;;)
+    {
+        int filled = 0, stop = 0;
+
+        /* Wait for a free slab. */
+        oskar_condition_lock(q->cond);
+        while (!q->stop && q->num_read - q->num_used >= q->num_slabs)
+        {
+            oskar_condition_wait(q->cond);
+        }
+        stop = q->stop;
+        oskar_condition_unlock(q->cond);
+        if (stop) break;
+
+        /* Read into it. */
+        oskar_timer_resume(q->h->tmr_read);
+        filled = q->read_slab(q->reader,
+                &q->slabs[q->num_read % q->num_slabs], &q->status);
+        oskar_timer_pause(q->h->tmr_read);
+
+        /* Pass it on. */
+        oskar_condition_lock(q->cond);
+        if (filled && !q->status)
+        {
+            q->num_read++;
+        }
+        else
+        {
+            q->finished = 1;
+            stop = 1;
+        }
+        oskar_condition_notify_all(q->cond);
+        oskar_condition_unlock(q->cond);
+        if (stop) break;
+    }
+    return 0;
+}
+
+
+void oskar_imager_slab_ensure(oskar_Mem** mem, int type, size_t num,
+        int* status)
+{
+    if (*status) return;
+    if (!*mem || oskar_mem_type(*mem) != type)
+    {
+        oskar_mem_free(*mem, status);
+        *mem = oskar_mem_create(type, OSKAR_CPU, num, status);
+    }
+    oskar_mem_ensure(*mem, num, status);
+}
+
+
+void oskar_imager_read_slabs(oskar_Imager* h, oskar_ImagerReadSlab read_slab,
+        void* reader, int i_file, int num_files, int* percent_done,
+        int* percent_next, int* status)
+{
+    int i = 0, first = 1;
+    double freq_start_hz = 0.0, freq_inc_hz = 0.0, ra_deg = 0.0, dec_deg = 0.0;
+    oskar_Thread* thread = 0;
+    ReadQueue q;
+    if (*status) return;
+
+    /* Set up the queue, and start the reader if using read-ahead. */
+    memset(&q, 0, sizeof(ReadQueue));
+    q.h = h;
+    q.read_slab = read_slab;
+    q.reader = reader;
+    q.num_slabs = (h->num_read_buffers > 1) ? h->num_read_buffers : 1;
+    q.slabs = (oskar_ImagerSlab*) calloc(q.num_slabs,
+            sizeof(oskar_ImagerSlab));
+    if (!q.slabs)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    if (q.num_slabs > 1)
+    {
+        q.cond = oskar_condition_create();
+        if (q.cond) thread = oskar_thread_create(read_ahead, (void*)&q, 0);
+        if (!thread)
+        {
+            /* Read synchronously, into the first slab only. */
+            oskar_condition_free(q.cond);
+            q.cond = 0;
+            q.num_slabs = 1;
+        }
+    }
+
+    /* Grid the slabs in order. */
+    for (;;)
+    {
+        oskar_ImagerSlab* slab = 0;
+        if (thread)
+        {
+            int ready = 0;
+            oskar_condition_lock(q.cond);
+            oskar_timer_resume(h->tmr_read_wait);
+            while (q.num_used == q.num_read && !q.finished)
+            {
+                oskar_condition_wait(q.cond);
+            }
+            oskar_timer_pause(h->tmr_read_wait);
+            ready = (q.num_used < q.num_read);
+            oskar_condition_unlock(q.cond);
+            if (!ready) break;
+        }
+        else
+        {
+            int filled = 0;
+            oskar_timer_resume(h->tmr_read);
+            filled = read_slab(reader, &q.slabs[0], status);
+            oskar_timer_pause(h->tmr_read);
+            if (!filled || *status) break;
+        }
+        slab = &q.slabs[q.num_used % q.num_slabs];
+
+        /* Restore visibility meta-data if it changed. */
+        if (slab->has_meta)
+        {
+            if (first || slab->freq_start_hz != freq_start_hz ||
+                    slab->freq_inc_hz != freq_inc_hz)
+            {
+                freq_start_hz = slab->freq_start_hz;
+                freq_inc_hz = slab->freq_inc_hz;
+                oskar_imager_set_vis_frequency(h,
+                        freq_start_hz, freq_inc_hz, 0);
+            }
+            if (first || slab->ra_deg != ra_deg || slab->dec_deg != dec_deg)
+            {
+                ra_deg = slab->ra_deg;
+                dec_deg = slab->dec_deg;
+                oskar_imager_set_vis_phase_centre(h, ra_deg, dec_deg);
+            }
+            first = 0;
+        }
+
+        /* Update the imager with the data. */
+        oskar_imager_update(h, slab->num_rows, slab->start_chan,
+                slab->end_chan, slab->num_pols, slab->uu, slab->vv, slab->ww,
+                slab->amps, slab->weight,
+                slab->has_time ? slab->time_centroid : 0, status);
+        *percent_done = (int) round(100.0 *
+                (slab->fraction_done + i_file) / (double) num_files);
+        if (percent_next && *percent_done >= *percent_next)
+        {
+            oskar_log_message(h->log, 'S', -2, "%3d%% ...", *percent_done);
+            *percent_next = 10 + 10 * (*percent_done / 10);
+        }
+
+        /* Release the slab. */
+        if (thread)
+        {
+            oskar_condition_lock(q.cond);
+            q.num_used++;
+            oskar_condition_notify_all(q.cond);
+            oskar_condition_unlock(q.cond);
+        }
+        else
+        {
+            q.num_used++;
+        }
+        if (*status) break;
+    }
+
+    /* Stop the reader and check its status. */
+    if (thread)
+    {
+        oskar_condition_lock(q.cond);
+        q.stop = 1;
+        oskar_condition_notify_all(q.cond);
+        oskar_condition_unlock(q.cond);
+        oskar_thread_join(thread);
+        oskar_thread_free(thread);
+        oskar_condition_free(q.cond);
+        if (!*status) *status = q.status;
+    }
+    for (i = 0; i < q.num_slabs; ++i)
+    {
+        oskar_mem_free(q.slabs[i].uu, status);
+        oskar_mem_free(q.slabs[i].vv, status);
+        oskar_mem_free(q.slabs[i].ww, status);
+        oskar_mem_free(q.slabs[i].amps, status);
+        oskar_mem_free(q.slabs[i].weight, status);
+        oskar_mem_free(q.slabs[i].time_centroid, status);
+    }
+    free(q.slabs);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+/* Needed for fseeko() and ftello() with 64-bit offsets. */
+#ifndef _MSC_VER
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200808L
+#endif
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_read_queue.h"
+#include "imager/private_imager_scratch.h"
+#include "imager/oskar_imager.h"
+#include "utility/oskar_dir.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _MSC_VER
+#include <sys/types.h>
+#endif
+
+/* The cache can exceed 2 GB, so use 64-bit file offsets everywhere. */
+#ifdef _MSC_VER
+#define FSEEK _fseeki64
+#define FTELL _ftelli64
+#else
+#define FSEEK(S, O, W) fseeko(S, (off_t) (O), W)
+#define FTELL ftello
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Header written before each block of visibility data in the cache. */
+struct ScratchRecord
+{
+    double freq_start_hz, freq_inc_hz, ra_deg, dec_deg;
+    size_t num_rows, num_amps;
+    int start_chan, end_chan, num_pols;
+    int coord_type, amp_type, weight_type, has_time;
+};
+typedef struct ScratchRecord ScratchRecord;
+
+static void write_mem(FILE* file, const oskar_Mem* mem, size_t num_elements,
+        int* status)
+{
+    if (*status || num_elements == 0) return;
+    if (oskar_mem_location(mem) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (oskar_mem_length(mem) < num_elements)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+    if (fwrite(oskar_mem_void_const(mem),
+            oskar_mem_element_size(oskar_mem_type(mem)), num_elements, file) !=
+            num_elements)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+    }
+}
+
+
+static void read_mem(FILE* file, oskar_Mem** mem, int type,
+        size_t num_elements, int* status)
+{
+    oskar_imager_slab_ensure(mem, type, num_elements, status);
+    if (*status || num_elements == 0) return;
+    if (fread(oskar_mem_void(*mem), oskar_mem_element_size(type),
+            num_elements, file) != num_elements)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+    }
+}
+
+
+struct ScratchReader
+{
+    FILE* file;
+    int64_t total_bytes;
+};
+typedef struct ScratchReader ScratchReader;
+
+
+static int read_slab_scratch(void* arg, oskar_ImagerSlab* slab, int* status)
+{
+    ScratchRecord r;
+    ScratchReader* reader = (ScratchReader*) arg;
+    FILE* file = reader->file;
+    if (*status) return 0;
+
+    /* Read the next block of visibility data. */
+    if (fread(&r, sizeof(ScratchRecord), 1, file) != 1)
+    {
+        if (ferror(file)) *status = OSKAR_ERR_FILE_IO;
+        return 0;
+    }
+    read_mem(file, &slab->uu, r.coord_type, r.num_rows, status);
+    read_mem(file, &slab->vv, r.coord_type, r.num_rows, status);
+    read_mem(file, &slab->ww, r.coord_type, r.num_rows, status);
+    read_mem(file, &slab->amps, r.amp_type, r.num_amps, status);
+    read_mem(file, &slab->weight, r.weight_type,
+            r.num_rows * r.num_pols, status);
+    if (r.has_time)
+    {
+        read_mem(file, &slab->time_centroid, OSKAR_DOUBLE, r.num_rows, status);
+    }
+    if (*status) return 0;
+    slab->num_rows = r.num_rows;
+    slab->start_chan = r.start_chan;
+    slab->end_chan = r.end_chan;
+    slab->num_pols = r.num_pols;
+    slab->has_time = r.has_time;
+    slab->has_meta = 1;
+    slab->freq_start_hz = r.freq_start_hz;
+    slab->freq_inc_hz = r.freq_inc_hz;
+    slab->ra_deg = r.ra_deg;
+    slab->dec_deg = r.dec_deg;
+    slab->fraction_done = (reader->total_bytes > 0) ?
+            (double) FTELL(file) / (double) reader->total_bytes : 0.0;
+    return 1;
+}
+
+
+void oskar_imager_scratch_open(oskar_Imager* h, int* status)
+{
+    int i = 0;
+    char name[64];
+    if (*status) return;
+    oskar_imager_scratch_close(h);
+    if (!h->scratch_dir) return;
+
+    /* Find an unused file name in the scratch directory. */
+    for (i = 0; i < 1000; ++i)
+    {
+        (void) snprintf(name, sizeof(name), "oskar_imager_%lu_%d.cache",
+                (unsigned long) time(0), i);
+        if (!oskar_dir_file_exists(h->scratch_dir, name)) break;
+    }
+    h->scratch_name = oskar_dir_get_path(h->scratch_dir, name);
+    h->scratch_file = fopen(h->scratch_name, "w+b");
+    if (!h->scratch_file)
+    {
+        oskar_log_error(h->log, "Unable to create scratch file '%s'",
+                h->scratch_name);
+        free(h->scratch_name);
+        h->scratch_name = 0;
+        *status = OSKAR_ERR_FILE_IO;
+        return;
+    }
+    oskar_log_message(h->log, 'M', 0, "Caching visibility data in '%s'",
+            h->scratch_name);
+}
+
+
+void oskar_imager_scratch_write(oskar_Imager* h, size_t num_rows,
+        int start_chan, int end_chan, int num_pols, const oskar_Mem* uu,
+        const oskar_Mem* vv, const oskar_Mem* ww, const oskar_Mem* amps,
+        const oskar_Mem* weight, const oskar_Mem* time_centroid, int* status)
+{
+    ScratchRecord r;
+    if (*status || !h->scratch_file) return;
+    if (!amps)
+    {
+        *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
+        return;
+    }
+    memset(&r, 0, sizeof(ScratchRecord));
+    r.freq_start_hz = h->vis_freq_start_hz;
+    r.freq_inc_hz = h->freq_inc_hz;
+    r.ra_deg = h->vis_centre_deg[0];
+    r.dec_deg = h->vis_centre_deg[1];
+    r.num_rows = num_rows;
+    r.num_amps = num_rows * (size_t) (1 + end_chan - start_chan);
+    r.start_chan = start_chan;
+    r.end_chan = end_chan;
+    r.num_pols = num_pols;
+    r.coord_type = oskar_mem_type(uu);
+    r.amp_type = oskar_mem_type(amps);
+    r.weight_type = oskar_mem_type(weight);
+    r.has_time = time_centroid ? 1 : 0;
+    if (oskar_mem_type(vv) != r.coord_type ||
+            oskar_mem_type(ww) != r.coord_type)
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return;
+    }
+    oskar_timer_resume(h->tmr_write);
+    if (fwrite(&r, sizeof(ScratchRecord), 1, h->scratch_file) != 1)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+    }
+    write_mem(h->scratch_file, uu, num_rows, status);
+    write_mem(h->scratch_file, vv, num_rows, status);
+    write_mem(h->scratch_file, ww, num_rows, status);
+    write_mem(h->scratch_file, amps, r.num_amps, status);
+    write_mem(h->scratch_file, weight, num_rows * num_pols, status);
+    if (time_centroid)
+    {
+        write_mem(h->scratch_file, time_centroid, num_rows, status);
+    }
+    oskar_timer_pause(h->tmr_write);
+    if (*status)
+    {
+        oskar_log_error(h->log, "Error writing scratch file '%s'",
+                h->scratch_name);
+    }
+}
+
+
+void oskar_imager_scratch_replay(oskar_Imager* h, int* status)
+{
+    ScratchReader reader;
+    int percent_done = 0, percent_next = 10;
+    if (*status || !h->scratch_file) return;
+    reader.file = h->scratch_file;
+    reader.total_bytes = (int64_t) FTELL(h->scratch_file);
+    if (reader.total_bytes < 0 || FSEEK(h->scratch_file, 0, SEEK_SET))
+    {
+        *status = OSKAR_ERR_FILE_IO;
+    }
+    else
+    {
+        oskar_imager_read_slabs(h, read_slab_scratch, (void*)&reader, 0, 1,
+                &percent_done, &percent_next, status);
+    }
+    if (*status)
+    {
+        oskar_log_error(h->log, "Error reading scratch file '%s'",
+                h->scratch_name);
+    }
+}
+
+
+void oskar_imager_scratch_close(oskar_Imager* h)
+{
+    if (h->scratch_file)
+    {
+        (void) fclose(h->scratch_file);
+        h->scratch_file = 0;
+    }
+    if (h->scratch_name)
+    {
+        (void) remove(h->scratch_name);
+        free(h->scratch_name);
+        h->scratch_name = 0;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,8 +5,11 @@
 
 #include <gtest/gtest.h>
 #include "imager/oskar_imager.h"
+#include "binary/oskar_binary.h"
 #include "vis/oskar_vis_header.h"
 #include "vis/oskar_vis_block.h"
+#include <cmath>
+#include <cstdio>
 
 #define WRITE_FITS 1
 
@@ -93,3 +96,230 @@ TEST(imager, update_from_block)
     oskar_mem_free(image, &status);
     oskar_mem_free(grid, &status);
 }
+
+static void run_imager(int num_files, const char** filenames,
+        const char* scratch_dir, int num_read_buffers, int num_parallel_files,
+        double partial_grid_memory_mb, oskar_Mem* image)
+{
+    int status = 0;
+    oskar_Imager* im = oskar_imager_create(OSKAR_DOUBLE, &status);
+    oskar_imager_set_fov(im, 4.0);
+    oskar_imager_set_size(im, 128, &status);
+    oskar_imager_set_algorithm(im, "W-projection", &status);
+    oskar_imager_set_num_w_planes(im, 4);
+    oskar_imager_set_weighting(im, "Uniform", &status);
+    oskar_imager_set_input_files(im, num_files, filenames, &status);
+    oskar_imager_set_scratch_dir(im, scratch_dir);
+    oskar_imager_set_num_read_buffers(im, num_read_buffers);
+    oskar_imager_set_num_parallel_files(im, num_parallel_files);
+    oskar_imager_set_partial_grid_memory_mb(im, partial_grid_memory_mb);
+    oskar_log_set_term_priority(oskar_imager_log(im), OSKAR_LOG_NONE);
+    oskar_imager_run(im, 1, &image, 0, 0, &status);
+    ASSERT_EQ(0, status);
+    oskar_imager_free(im, &status);
+}
+
+// Writes a visibility data file with more than one block and channel.
+static void write_vis_file(const char* filename, int seed)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const int num_times = 8, times_per_block = 4;
+    const int num_channels = 2, num_stations = 32;
+    oskar_VisHeader* hdr = oskar_vis_header_create(type | OSKAR_COMPLEX, type,
+            times_per_block, num_times, num_channels, num_channels,
+            num_stations, 0, 1, &status);
+    ASSERT_EQ(0, status);
+    oskar_vis_header_set_freq_start_hz(hdr, 100e6);
+    oskar_vis_header_set_freq_inc_hz(hdr, 1e6);
+    oskar_vis_header_set_time_start_mjd_utc(hdr, 60000.0);
+    oskar_vis_header_set_time_inc_sec(hdr, 10.0);
+    oskar_vis_header_set_phase_centre(hdr, 0, 20.0, -30.0);
+    oskar_VisBlock* block = oskar_vis_block_create_from_header(
+            OSKAR_CPU, hdr, &status);
+    oskar_Binary* file = oskar_vis_header_write(hdr, filename, &status);
+    ASSERT_EQ(0, status);
+    for (int b = 0; b < num_times / times_per_block; ++b)
+    {
+        const int s = b + 100 * seed;
+        oskar_vis_block_set_start_time_index(block, b * times_per_block);
+        oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(block, 0),
+                s, 1, 2, 3, 500.0, &status);
+        oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(block, 1),
+                s, 4, 5, 6, 500.0, &status);
+        oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(block, 2),
+                s, 7, 8, 9, 50.0, &status);
+        oskar_mem_random_uniform(oskar_vis_block_cross_correlations(block),
+                s, 10, 11, 12, &status);
+        oskar_vis_block_write(block, file, b, &status);
+    }
+    oskar_binary_free(file);
+    ASSERT_EQ(0, status);
+    oskar_vis_block_free(block, &status);
+    oskar_vis_header_free(hdr, &status);
+}
+
+TEST(imager, scratch_cache)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const char* filename = "temp_test_imager_scratch_cache.vis";
+    write_vis_file(filename, 0);
+
+    // Image the file with and without the scratch cache.
+    // The cache is replayed both with and without a read-ahead thread.
+    const int num_pixels = 128 * 128;
+    oskar_Mem* image1 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    oskar_Mem* image2 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    oskar_Mem* image3 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    run_imager(1, &filename, 0, 1, 1, 0.0, image1);
+    run_imager(1, &filename, ".", 1, 1, 0.0, image2);
+    run_imager(1, &filename, ".", 3, 1, 0.0, image3);
+
+    // Check the images are the same.
+    EXPECT_EQ(0, oskar_mem_different(image1, image2, 0, &status));
+    EXPECT_EQ(0, oskar_mem_different(image1, image3, 0, &status));
+    EXPECT_GT(oskar_mem_get_element(image1, 128 * 64 + 64, &status), 0.0);
+
+    // Clean up.
+    oskar_mem_free(image1, &status);
+    oskar_mem_free(image2, &status);
+    oskar_mem_free(image3, &status);
+    remove(filename);
+}
+
+TEST(imager, read_files_in_parallel)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const int num_files = 5;
+    const char* filenames[] = {
+            "temp_test_imager_parallel_0.vis",
+            "temp_test_imager_parallel_1.vis",
+            "temp_test_imager_parallel_2.vis",
+            "temp_test_imager_parallel_3.vis",
+            "temp_test_imager_parallel_4.vis"
+    };
+    for (int i = 0; i < num_files; ++i) write_vis_file(filenames[i], i + 1);
+
+    // Image the files in turn, in parallel, and in parallel with
+    // too little memory for any partial grids.
+    const int num_pixels = 128 * 128;
+    oskar_Mem* image1 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    oskar_Mem* image2 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    oskar_Mem* image3 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    oskar_Mem* image4 = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    run_imager(num_files, filenames, 0, 1, 1, 2048.0, image1);
+    run_imager(num_files, filenames, 0, 1, 3, 2048.0, image2);
+    run_imager(num_files, filenames, 0, 1, 3, 2048.0, image3);
+    run_imager(num_files, filenames, 0, 1, 3, 0.0, image4);
+
+    // Partial grids are added in a fixed order, so repeated runs must match.
+    // The sum is done in a different order to the serial version,
+    // so allow for rounding errors.
+    EXPECT_EQ(0, oskar_mem_different(image2, image3, 0, &status));
+    EXPECT_EQ(0, oskar_mem_different(image1, image4, 0, &status));
+    const double* p1 = oskar_mem_double_const(image1, &status);
+    const double* p2 = oskar_mem_double_const(image2, &status);
+    double max_abs = 0.0, max_diff = 0.0;
+    for (int i = 0; i < num_pixels; ++i)
+    {
+        const double diff = fabs(p1[i] - p2[i]);
+        if (fabs(p1[i]) > max_abs) max_abs = fabs(p1[i]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    EXPECT_GT(max_abs, 0.0);
+    EXPECT_LT(max_diff, 1e-10 * max_abs);
+
+    // Clean up.
+    oskar_mem_free(image1, &status);
+    oskar_mem_free(image2, &status);
+    oskar_mem_free(image3, &status);
+    oskar_mem_free(image4, &status);
+    for (int i = 0; i < num_files; ++i) remove(filenames[i]);
+}
+
+#ifdef _OPENMP
+#include <omp.h>
+
+static void finalise_with_threads(int num_threads, int num_planes,
+        oskar_Mem** images)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const int num_times = 4, num_channels = 3, num_stations = 32;
+
+    // Create and set up an imager with one plane per channel and polarisation.
+    oskar_Imager* im = oskar_imager_create(type, &status);
+    oskar_imager_set_fov(im, 4.0);
+    oskar_imager_set_size(im, 200, &status);
+    oskar_imager_set_image_type(im, "Linear", &status);
+    oskar_imager_set_channel_snapshots(im, 1);
+    oskar_log_set_term_priority(oskar_imager_log(im), OSKAR_LOG_NONE);
+    ASSERT_EQ(0, status);
+
+    // Create visibility data.
+    oskar_VisHeader* hdr = oskar_vis_header_create(
+            type | OSKAR_COMPLEX | OSKAR_MATRIX, type,
+            num_times, num_times, num_channels, num_channels,
+            num_stations, 0, 1, &status);
+    oskar_vis_header_set_freq_start_hz(hdr, 100e6);
+    oskar_vis_header_set_freq_inc_hz(hdr, 1e6);
+    oskar_VisBlock* block = oskar_vis_block_create_from_header(
+            OSKAR_CPU, hdr, &status);
+    oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(block, 0),
+            0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(block, 1),
+            4, 5, 6, 7, 500.0, &status);
+    oskar_mem_clear_contents(
+            oskar_vis_block_station_uvw_metres(block, 2), &status);
+    oskar_mem_random_uniform(oskar_vis_block_cross_correlations(block),
+            1, 2, 3, 4, &status);
+    ASSERT_EQ(0, status);
+
+    // Grid the data and finalise all the planes.
+    omp_set_num_threads(num_threads);
+    oskar_imager_set_coords_only(im, 1);
+    oskar_imager_update_from_block(im, hdr, block, &status);
+    oskar_imager_set_coords_only(im, 0);
+    oskar_imager_check_init(im, &status);
+    ASSERT_EQ(num_planes, oskar_imager_num_image_planes(im));
+    oskar_imager_update_from_block(im, hdr, block, &status);
+    oskar_imager_finalise(im, num_planes, images, 0, 0, &status);
+    ASSERT_EQ(0, status);
+
+    // Clean up.
+    oskar_imager_free(im, &status);
+    oskar_vis_block_free(block, &status);
+    oskar_vis_header_free(hdr, &status);
+}
+
+TEST(imager, finalise_planes_in_parallel)
+{
+    int status = 0;
+    const int num_planes = 12;
+    const int max_threads = omp_get_max_threads();
+    oskar_Mem *images_serial[num_planes], *images_parallel[num_planes];
+    for (int i = 0; i < num_planes; ++i)
+    {
+        images_serial[i] = 0;
+        images_parallel[i] = 0;
+    }
+    finalise_with_threads(1, num_planes, images_serial);
+    finalise_with_threads(4, num_planes, images_parallel);
+    omp_set_num_threads(max_threads);
+
+    // Each plane is transformed in the same way, so the images must match.
+    for (int i = 0; i < num_planes; ++i)
+    {
+        ASSERT_TRUE(images_serial[i] != 0);
+        ASSERT_TRUE(images_parallel[i] != 0);
+        EXPECT_EQ(0, oskar_mem_different(images_serial[i],
+                images_parallel[i], 0, &status));
+        if (i > 0)
+        {
+            EXPECT_NE(0, oskar_mem_different(images_serial[i],
+                    images_serial[i - 1], 0, &status));
+        }
+        oskar_mem_free(images_serial[i], &status);
+        oskar_mem_free(images_parallel[i], &status);
+    }
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+#include "imager/oskar_imager.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+
+static void grid_with_threads(int num_threads, int prec, const char* algorithm,
+        oskar_Mem** grid, double* plane_norm)
+{
+    int status = 0;
+    const int num_vis = 20000;
+
+    // Create and set up the imager.
+    oskar_Imager* im = oskar_imager_create(prec, &status);
+    oskar_imager_set_algorithm(im, algorithm, &status);
+    oskar_imager_set_fov(im, 2.0);
+    oskar_imager_set_size(im, 256, &status);
+    if (!strncmp(algorithm, "W", 1))
+    {
+        oskar_imager_set_num_w_planes(im, 4);
+    }
+    oskar_imager_check_init(im, &status);
+    ASSERT_EQ(0, status);
+    const int plane_size = oskar_imager_plane_size(im);
+    *grid = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+            plane_size * plane_size, &status);
+    oskar_mem_clear_contents(*grid, &status);
+
+    // Create visibility data. Some points will fall outside the grid.
+    oskar_Mem* uu = oskar_mem_create(prec, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(prec, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(prec, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(prec, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 1500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 1500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_uniform(vis, 1, 2, 3, 4, &status);
+    oskar_mem_random_uniform(weight, 5, 6, 7, 8, &status);
+    ASSERT_EQ(0, status);
+
+    // Grid visibility data.
+    *plane_norm = 0.0;
+    omp_set_num_threads(num_threads);
+    oskar_imager_update_plane(im, num_vis, uu, vv, ww, vis, weight,
+            0, *grid, plane_norm, 0, &status);
+    ASSERT_EQ(0, status);
+
+    // Clean up.
+    oskar_imager_free(im, &status);
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+}
+
+static void compare_serial_and_tiled(int prec, const char* algorithm)
+{
+    int status = 0;
+    double norm_serial = 0.0, norm_tiled = 0.0;
+    oskar_Mem *grid_serial = 0, *grid_tiled = 0;
+    const int max_threads = omp_get_max_threads();
+    grid_with_threads(1, prec, algorithm, &grid_serial, &norm_serial);
+    grid_with_threads(4, prec, algorithm, &grid_tiled, &norm_tiled);
+    omp_set_num_threads(max_threads);
+    ASSERT_EQ(oskar_mem_length(grid_serial), oskar_mem_length(grid_tiled));
+
+    // Each grid cell is updated in the same order, so the grids must match.
+    EXPECT_EQ(0, oskar_mem_different(grid_serial, grid_tiled, 0, &status));
+    EXPECT_NEAR(norm_serial, norm_tiled, 1e-9 * norm_serial);
+    EXPECT_GT(norm_serial, 0.0);
+
+    oskar_mem_free(grid_serial, &status);
+    oskar_mem_free(grid_tiled, &status);
+}
+
+TEST(grid_tiles, simple_double)
+{
+    compare_serial_and_tiled(OSKAR_DOUBLE, "FFT");
+}
+
+TEST(grid_tiles, simple_single)
+{
+    compare_serial_and_tiled(OSKAR_SINGLE, "FFT");
+}
+
+TEST(grid_tiles, wproj_double)
+{
+    compare_serial_and_tiled(OSKAR_DOUBLE, "W-projection");
+}
+
+TEST(grid_tiles, wproj_single)
+{
+    compare_serial_and_tiled(OSKAR_SINGLE, "W-projection");
+}
+
+#endif
@@ -0,0 +1,60 @@
+/* Copyright (c) 2026, The OSKAR Developers. See LICENSE file. */
+
+/*
+ * The apparent flux of a source is the largest value over all stations
+ * of |E|^2 I, or for matrices, the larger of the squared norms of the two
+ * rows of E times I.
+ * NaN values propagate, so that such sources are never culled.
+ */
+
+#define OSKAR_JONES_CULL_MASK_C(NAME, FP, FP2) KERNEL(NAME) (\
+        const int        num_sources,\
+        const int        num_stations,\
+        GLOBAL_IN(FP2,   jones),\
+        GLOBAL_IN(FP,    flux_I),\
+        const FP         threshold,\
+        GLOBAL_OUT(int,  mask),\
+        GLOBAL_OUT(FP,   apparent_flux))\
+{\
+    KERNEL_LOOP_X(int, i_source, 0, num_sources)\
+    int i_station;\
+    FP peak = (FP)0;\
+    for (i_station = 0; i_station < num_stations; ++i_station) {\
+        const FP2 e = jones[num_sources * i_station + i_source];\
+        const FP p = e.x * e.x + e.y * e.y;\
+        if (p > peak || p != p) peak = p;\
+    }\
+    peak *= fabs(flux_I[i_source]);\
+    apparent_flux[i_source] = peak;\
+    mask[i_source] = !(peak < threshold);\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
+
+#define OSKAR_JONES_CULL_MASK_M(NAME, FP, FP4c) KERNEL(NAME) (\
+        const int        num_sources,\
+        const int        num_stations,\
+        GLOBAL_IN(FP4c,  jones),\
+        GLOBAL_IN(FP,    flux_I),\
+        const FP         threshold,\
+        GLOBAL_OUT(int,  mask),\
+        GLOBAL_OUT(FP,   apparent_flux))\
+{\
+    KERNEL_LOOP_X(int, i_source, 0, num_sources)\
+    int i_station;\
+    FP peak = (FP)0;\
+    for (i_station = 0; i_station < num_stations; ++i_station) {\
+        const FP4c e = jones[num_sources * i_station + i_source];\
+        const FP p_x = e.a.x * e.a.x + e.a.y * e.a.y +\
+                e.b.x * e.b.x + e.b.y * e.b.y;\
+        const FP p_y = e.c.x * e.c.x + e.c.y * e.c.y +\
+                e.d.x * e.d.x + e.d.y * e.d.y;\
+        const FP p = (p_y > p_x || p_y != p_y) ? p_y : p_x;\
+        if (p > peak || p != p) peak = p;\
+    }\
+    peak *= fabs(flux_I[i_source]);\
+    apparent_flux[i_source] = peak;\
+    mask[i_source] = !(peak < threshold);\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
@@ -0,0 +1,83 @@
+/* Copyright (c) 2026, The OSKAR Developers. See LICENSE file. */
+
+/* Interpolates amplitude and phase of a complex value between A and B. */
+#define OSKAR_JONES_INTERP_COMPLEX(FP, OUT, A, B, FRAC) {\
+    const FP amp_a_ = sqrt(A.x * A.x + A.y * A.y);\
+    const FP amp_b_ = sqrt(B.x * B.x + B.y * B.y);\
+    if (FRAC == (FP)0) {\
+        OUT = A;\
+    }\
+    else if (amp_a_ == (FP)0 || amp_b_ == (FP)0) {\
+        OUT.x = A.x + FRAC * (B.x - A.x);\
+        OUT.y = A.y + FRAC * (B.y - A.y);\
+    }\
+    else {\
+        FP sin_p_, cos_p_;\
+        const FP re_ = B.x * A.x + B.y * A.y;\
+        const FP im_ = B.y * A.x - B.x * A.y;\
+        const FP scale_ = (amp_a_ + FRAC * (amp_b_ - amp_a_)) / amp_a_;\
+        const FP phase_ = FRAC * atan2(im_, re_);\
+        SINCOS(phase_, sin_p_, cos_p_);\
+        OUT.x = scale_ * (A.x * cos_p_ - A.y * sin_p_);\
+        OUT.y = scale_ * (A.x * sin_p_ + A.y * cos_p_);\
+    }\
+    }\
+
+#define OSKAR_JONES_INTERPOLATE_C(NAME, FP, FP2) KERNEL(NAME) (\
+        const int        num_sources_in,\
+        const int        num_stations,\
+        const FP         frac,\
+        const int        use_mask,\
+        GLOBAL_IN(int,   mask),\
+        GLOBAL_IN(int,   indices),\
+        const int        num_sources_out,\
+        GLOBAL_IN(FP2,   jones_a),\
+        GLOBAL_IN(FP2,   jones_b),\
+        GLOBAL_OUT(FP2,  jones))\
+{\
+    KERNEL_LOOP_Y(int, i_station, 0, num_stations)\
+    KERNEL_LOOP_X(int, i_source, 0, num_sources_in)\
+    if (!use_mask || mask[i_source]) {\
+        const int i_in = num_sources_in * i_station + i_source;\
+        const int i_out = num_sources_out * i_station +\
+                (use_mask ? indices[i_source] : i_source);\
+        const FP2 a = jones_a[i_in], b = jones_b[i_in];\
+        FP2 out;\
+        OSKAR_JONES_INTERP_COMPLEX(FP, out, a, b, frac)\
+        jones[i_out] = out;\
+    }\
+    KERNEL_LOOP_END\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
+
+#define OSKAR_JONES_INTERPOLATE_M(NAME, FP, FP4c) KERNEL(NAME) (\
+        const int        num_sources_in,\
+        const int        num_stations,\
+        const FP         frac,\
+        const int        use_mask,\
+        GLOBAL_IN(int,   mask),\
+        GLOBAL_IN(int,   indices),\
+        const int        num_sources_out,\
+        GLOBAL_IN(FP4c,  jones_a),\
+        GLOBAL_IN(FP4c,  jones_b),\
+        GLOBAL_OUT(FP4c, jones))\
+{\
+    KERNEL_LOOP_Y(int, i_station, 0, num_stations)\
+    KERNEL_LOOP_X(int, i_source, 0, num_sources_in)\
+    if (!use_mask || mask[i_source]) {\
+        const int i_in = num_sources_in * i_station + i_source;\
+        const int i_out = num_sources_out * i_station +\
+                (use_mask ? indices[i_source] : i_source);\
+        const FP4c a = jones_a[i_in], b = jones_b[i_in];\
+        FP4c out;\
+        OSKAR_JONES_INTERP_COMPLEX(FP, out.a, a.a, b.a, frac)\
+        OSKAR_JONES_INTERP_COMPLEX(FP, out.b, a.b, b.b, frac)\
+        OSKAR_JONES_INTERP_COMPLEX(FP, out.c, a.c, b.c, frac)\
+        OSKAR_JONES_INTERP_COMPLEX(FP, out.d, a.d, b.d, frac)\
+        jones[i_out] = out;\
+    }\
+    KERNEL_LOOP_END\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
@@ -36,12 +36,23 @@ int oskar_interferometer_num_gpus(const oskar_Interferometer* h);
 OSKAR_EXPORT
 int oskar_interferometer_num_vis_blocks(const oskar_Interferometer* h);
 
+OSKAR_EXPORT
+int oskar_interferometer_num_vis_buffers(const oskar_Interferometer* h);
+
 OSKAR_EXPORT
 void oskar_interferometer_reset_cache(oskar_Interferometer* h, int* status);
 
 OSKAR_EXPORT
 void oskar_interferometer_reset_work_unit_index(oskar_Interferometer* h);
 
+OSKAR_EXPORT
+void oskar_interferometer_set_beam_cull_threshold(oskar_Interferometer* h,
+        double threshold_jy);
+
+OSKAR_EXPORT
+void oskar_interferometer_set_beam_interpolation(oskar_Interferometer* h,
+        double tolerance, int validate);
+
 OSKAR_EXPORT
 void oskar_interferometer_set_coords_only(oskar_Interferometer* h, int value,
         int* status);
@@ -80,6 +91,10 @@ void oskar_interferometer_set_max_times_per_block(oskar_Interferometer* h,
 OSKAR_EXPORT
 void oskar_interferometer_set_num_devices(oskar_Interferometer* h, int value);
 
+OSKAR_EXPORT
+void oskar_interferometer_set_num_vis_buffers(oskar_Interferometer* h,
+        int value, int* status);
+
 OSKAR_EXPORT
 void oskar_interferometer_set_observation_frequency(oskar_Interferometer* h,
         double start_hz, double inc_hz, int num_channels);
@@ -96,6 +111,10 @@ OSKAR_EXPORT
 void oskar_interferometer_set_output_vis_file(oskar_Interferometer* h,
         const char* filename);
 
+OSKAR_EXPORT
+void oskar_interferometer_set_performance_report(oskar_Interferometer* h,
+        const char* filename);
+
 OSKAR_EXPORT
 void oskar_interferometer_set_settings_path(oskar_Interferometer* h,
         const char* filename);
@@ -30,7 +30,9 @@ typedef struct oskar_Jones oskar_Jones;
 #include <interferometer/oskar_jones_apply_station_gains.h>
 #include <interferometer/oskar_jones_create.h>
 #include <interferometer/oskar_jones_create_copy.h>
+#include <interferometer/oskar_jones_cull_mask.h>
 #include <interferometer/oskar_jones_free.h>
+#include <interferometer/oskar_jones_interpolate.h>
 #include <interferometer/oskar_jones_join.h>
 #include <interferometer/oskar_jones_set_size.h>
 
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_JONES_CULL_MASK_H_
+#define OSKAR_JONES_CULL_MASK_H_
+
+/**
+ * @file oskar_jones_cull_mask.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Finds sources that are faint in the station beams of all stations.
+ *
+ * @details
+ * For each source, the apparent flux is the largest value over all stations
+ * of |E|^2 I, where E is the station beam in \p jones and I is the
+ * Stokes I flux of the source. For matrix beams, |E|^2 is the larger of
+ * the squared norms of the two rows of E, which is the auto-correlation
+ * of an unpolarised source in the brighter polarisation. The amplitude of
+ * any visibility due to an unpolarised source is no larger than this.
+ *
+ * Sources with an apparent flux below \p threshold_jy have \p mask set to 0,
+ * and all others have \p mask set to 1. The mask can be used with
+ * oskar_prefix_sum(), oskar_sky_copy_source_data() and
+ * oskar_jones_interpolate() to remove the faint sources.
+ *
+ * @param[in]     jones         Station beams for all sources.
+ * @param[in]     flux_I        Stokes I flux of each source, in Jy.
+ * @param[in]     threshold_jy  Minimum apparent flux to keep, in Jy.
+ * @param[out]    mask          Integer array set to 1 for sources to keep.
+ * @param[out]    apparent_flux Apparent flux of each source, in Jy.
+ * @param[out]    culled_flux   Sum of the apparent flux of culled sources.
+ * @param[in,out] status        Status return code.
+ *
+ * @return The number of sources with \p mask set to 0.
+ */
+OSKAR_EXPORT
+int oskar_jones_cull_mask(const oskar_Jones* jones, const oskar_Mem* flux_I,
+        double threshold_jy, oskar_Mem* mask, oskar_Mem* apparent_flux,
+        double* culled_flux, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
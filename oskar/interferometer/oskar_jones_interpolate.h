@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_JONES_INTERPOLATE_H_
+#define OSKAR_JONES_INTERPOLATE_H_
+
+/**
+ * @file oskar_jones_interpolate.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Interpolates between two sets of Jones matrices.
+ *
+ * @details
+ * Interpolates the amplitude and phase of each element of the Jones matrices
+ * in \p jones_a and \p jones_b, which must have the same dimensions.
+ * A fraction of 0 gives \p jones_a exactly, and 1 gives \p jones_b.
+ *
+ * If \p mask is not NULL, only the sources for which \p mask is non-zero
+ * are written to \p jones, at the positions given by \p indices
+ * (as generated by oskar_sky_horizon_clip()), so that \p jones can have
+ * fewer sources than the inputs.
+ *
+ * @param[in,out] jones   Output Jones matrix block.
+ * @param[in]     jones_a Jones matrices at the start of the interval.
+ * @param[in]     jones_b Jones matrices at the end of the interval.
+ * @param[in]     frac    Fractional position in the interval.
+ * @param[in]     mask    Optional source mask, or NULL.
+ * @param[in]     indices Output source index for each source in the mask.
+ * @param[in,out] status  Status return code.
+ */
+OSKAR_EXPORT
+void oskar_jones_interpolate(oskar_Jones* jones, const oskar_Jones* jones_a,
+        const oskar_Jones* jones_b, double frac, const oskar_Mem* mask,
+        const oskar_Mem* indices, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
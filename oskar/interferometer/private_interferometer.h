@@ -18,14 +18,25 @@
 #include <vis/oskar_vis_block.h>
 #include <vis/oskar_vis_header.h>
 
+/* Station beams evaluated at two anchor times, for one channel. */
+struct BeamAnchors
+{
+    int chunk_index;            /* Sky chunk used for the beams. */
+    int time_index[2];          /* Time index of each anchor, or -1. */
+    double freq_hz;             /* Frequency of the beams. */
+    oskar_Jones* E[2];          /* Station beams for all sources in chunk. */
+};
+typedef struct BeamAnchors BeamAnchors;
+
 /* Memory allocated per compute device (may be either CPU or GPU). */
 struct DeviceData
 {
     /* Host memory. */
-    oskar_VisBlock* vis_block_cpu[2]; /* On host, for copy back & write. */
+    oskar_VisBlock** vis_block_cpu; /* On host, for copy back & write. */
 
     /* Device memory. */
     int previous_chunk_index;
+    int num_blocks_done;        /* Number of blocks completed by device. */
     oskar_VisBlock* vis_block;  /* Device memory block. */
     oskar_Mem *lmn[3], *uvw[3];
     oskar_Sky* chunk;           /* The unmodified sky chunk being processed. */
@@ -34,6 +45,12 @@ struct DeviceData
     oskar_Jones *J, *R, *E, *K;
     oskar_Mem *gains;
     oskar_StationWork* station_work;
+    int num_beam_anchors;
+    BeamAnchors* beam_anchors;  /* Used if interpolating beams in time. */
+    oskar_Jones* E_check;       /* Directly-evaluated beams, for checking. */
+    oskar_Sky* chunk_cull;      /* Copy of the chunk after beam culling. */
+    oskar_Jones* E_cull;        /* Station beams after beam culling. */
+    oskar_Mem *cull_mask, *cull_indices, *cull_flux;
 
     /* Timers. */
     oskar_Timer* tmr_compute;   /* Total time spent filling vis blocks. */
@@ -43,9 +60,22 @@ struct DeviceData
     oskar_Timer* tmr_join;      /* Time spent combining Jones matrices. */
     oskar_Timer* tmr_E;         /* Time spent evaluating E-Jones. */
     oskar_Timer* tmr_K;         /* Time spent evaluating K-Jones. */
+    oskar_Timer* tmr_wait;      /* Time spent waiting for a host buffer. */
 };
 typedef struct DeviceData DeviceData;
 
+/* Work unit queues for one visibility block in flight.
+ * Each device owns a contiguous range of work unit indices [begin, end),
+ * packed into a single 64-bit integer so it can be updated atomically.
+ * Devices take work units from the front of their own range, and steal
+ * from the back of another device's range once their own is empty. */
+struct WorkQueues
+{
+    int block_index;            /* Block currently using these queues. */
+    long long* range;           /* Packed work unit range, per device. */
+};
+typedef struct WorkQueues WorkQueues;
+
 
 struct oskar_Interferometer
 {
@@ -54,20 +84,33 @@ struct oskar_Interferometer
     int num_channels, num_time_steps;
     int max_sources_per_chunk, max_times_per_block, max_channels_per_block;
     int apply_horizon_clip, force_polarised_ms, zero_failed_gaussians;
-    int coords_only, ignore_w_components;
+    int coords_only, ignore_w_components, beam_interp_validate;
+    double beam_interp_tolerance, beam_cull_threshold_jy;
     double freq_start_hz, freq_inc_hz, time_start_mjd_utc, time_inc_sec;
     double source_min_jy, source_max_jy;
     char correlation_type, *vis_name, *ms_name, *settings_path;
+    char *perf_report_name;
 
     /* State. */
-    int init_sky, work_unit_index;
+    int init_sky, num_blocks_written;
+    int num_vis_buffers;     /* Number of host buffers in the output queue. */
+    int max_blocks_queued;   /* Peak number of blocks waiting to be written. */
+    int beam_interp_steps;   /* Time steps between station beam anchors. */
+    int beam_interp_num_checks;     /* Number of interpolated beams checked. */
+    double beam_interp_max_error;   /* Largest error found when checking. */
+    int beam_cull;           /* True if culling sources using station beams. */
+    long long cull_num_tested;      /* Number of sources tested for culling. */
+    long long cull_num_culled;      /* Number of sources culled. */
+    double* cull_flux_error; /* Culled apparent flux, per time and channel. */
+    WorkQueues* work_queues; /* One set of queues per host buffer. */
     oskar_Mutex* mutex;
-    oskar_Barrier* barrier;
+    oskar_ConditionVar* cond;
     oskar_Log* log;
 
     /* Sky model and telescope model. */
     int num_sources_total, num_sky_chunks;
     oskar_Sky** sky_chunks;
+    double* sky_chunk_caps;  /* Bounding cap of each chunk (4 per chunk). */
     oskar_Telescope* tel;
 
     /* Output data and file handles. */
@@ -77,6 +120,8 @@ struct oskar_Interferometer
     oskar_Mem *temp;
     oskar_Timer* tmr_sim;   /* The total time for the simulation. */
     oskar_Timer* tmr_write; /* The time spent writing vis blocks. */
+    oskar_Timer* tmr_finalise;   /* The time spent combining vis blocks. */
+    oskar_Timer* tmr_write_wait; /* The time the writer waits for blocks. */
 
     /* Array of DeviceData structures, one per compute device. */
     DeviceData* d;
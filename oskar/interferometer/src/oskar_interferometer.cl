@@ -3,3 +3,7 @@
 OSKAR_JONES_R( M_CAT(evaluate_jones_R_, Real), Real, Real4c)
 OSKAR_JONES_APPLY_STATION_GAINS_C( M_CAT(jones_apply_station_gains_complex_, Real), Real2)
 OSKAR_JONES_APPLY_STATION_GAINS_M( M_CAT(jones_apply_station_gains_matrix_, Real), Real4c)
+OSKAR_JONES_INTERPOLATE_C( M_CAT(jones_interpolate_complex_, Real), Real, Real2)
+OSKAR_JONES_INTERPOLATE_M( M_CAT(jones_interpolate_matrix_, Real), Real, Real4c)
+OSKAR_JONES_CULL_MASK_C( M_CAT(jones_cull_mask_complex_, Real), Real, Real2)
+OSKAR_JONES_CULL_MASK_M( M_CAT(jones_cull_mask_matrix_, Real), Real, Real4c)
@@ -4,6 +4,8 @@
 #include "interferometer/define_jones_apply_station_gains.h"
 #include "interferometer/define_evaluate_jones_K.h"
 #include "interferometer/define_evaluate_jones_R.h"
+#include "interferometer/define_jones_cull_mask.h"
+#include "interferometer/define_jones_interpolate.h"
 #include "utility/oskar_cuda_registrar.h"
 #include "utility/oskar_kernel_macros.h"
 #include "utility/oskar_vector_types.h"
@@ -55,9 +55,32 @@ int oskar_interferometer_num_vis_blocks(const oskar_Interferometer* h)
     return t * c;
 }
 
+int oskar_interferometer_num_vis_buffers(const oskar_Interferometer* h)
+{
+    return h ? h->num_vis_buffers : 0;
+}
+
 void oskar_interferometer_reset_work_unit_index(oskar_Interferometer* h)
 {
-    h->work_unit_index = 0;
+    int i = 0;
+    if (!h->work_queues) return;
+    for (i = 0; i < h->num_vis_buffers; ++i)
+    {
+        h->work_queues[i].block_index = -1;
+    }
+}
+
+void oskar_interferometer_set_beam_cull_threshold(oskar_Interferometer* h,
+        double threshold_jy)
+{
+    h->beam_cull_threshold_jy = threshold_jy;
+}
+
+void oskar_interferometer_set_beam_interpolation(oskar_Interferometer* h,
+        double tolerance, int validate)
+{
+    h->beam_interp_tolerance = tolerance;
+    h->beam_interp_validate = validate;
 }
 
 void oskar_interferometer_set_coords_only(oskar_Interferometer* h, int value,
@@ -186,6 +209,14 @@ void oskar_interferometer_set_num_devices(oskar_Interferometer* h, int value)
     h->d = (DeviceData*) calloc(h->num_devices, sizeof(DeviceData));
 }
 
+void oskar_interferometer_set_num_vis_buffers(oskar_Interferometer* h,
+        int value, int* status)
+{
+    if (*status || !h) return;
+    oskar_interferometer_free_device_data(h, status);
+    h->num_vis_buffers = (value < 1) ? 1 : value;
+}
+
 void oskar_interferometer_set_observation_frequency(oskar_Interferometer* h,
         double start_hz, double inc_hz, int num_channels)
 {
@@ -210,6 +241,20 @@ void oskar_interferometer_set_observation_time(oskar_Interferometer* h,
     }
 }
 
+void oskar_interferometer_set_performance_report(oskar_Interferometer* h,
+        const char* filename)
+{
+    size_t len = 0;
+    free(h->perf_report_name);
+    h->perf_report_name = 0;
+    if (filename) len = strlen(filename);
+    if (len > 0)
+    {
+        h->perf_report_name = (char*) calloc(1 + len, 1);
+        if (h->perf_report_name) memcpy(h->perf_report_name, filename, len);
+    }
+}
+
 void oskar_interferometer_set_settings_path(oskar_Interferometer* h,
         const char* filename)
 {
@@ -236,9 +281,21 @@ void oskar_interferometer_set_sky_model(oskar_Interferometer* h,
     h->sky_chunks = 0;
     h->num_sky_chunks = 0;
 
-    /* Split up the sky model into chunks and store them. */
+    /* Split up the sky model into chunks and store them.
+     * If there is more than one chunk, the sources are sorted first,
+     * so that each chunk covers a small part of the sky and can usually
+     * be accepted or rejected as a whole by the horizon clip. */
     h->num_sources_total = oskar_sky_num_sources(sky);
-    if (h->num_sources_total > 0)
+    if (h->num_sources_total > h->max_sources_per_chunk &&
+            oskar_sky_mem_location(sky) == OSKAR_CPU)
+    {
+        oskar_Sky* sorted = oskar_sky_create_copy(sky, OSKAR_CPU, status);
+        oskar_sky_sort_spatially(sorted, status);
+        oskar_sky_append_to_set(&h->num_sky_chunks, &h->sky_chunks,
+                h->max_sources_per_chunk, sorted, status);
+        oskar_sky_free(sorted, status);
+    }
+    else if (h->num_sources_total > 0)
     {
         oskar_sky_append_to_set(&h->num_sky_chunks, &h->sky_chunks,
                 h->max_sources_per_chunk, sky, status);
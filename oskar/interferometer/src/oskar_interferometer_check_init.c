@@ -4,6 +4,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "interferometer/private_interferometer.h"
 #include "interferometer/oskar_interferometer.h"
@@ -15,6 +16,8 @@
 extern "C" {
 #endif
 
+static void set_up_beam_cull(oskar_Interferometer* h, int* status);
+static void set_up_beam_interp(oskar_Interferometer* h);
 static void set_up_device_data(oskar_Interferometer* h, int* status);
 static void set_up_vis_header(oskar_Interferometer* h, int* status);
 
@@ -58,6 +61,21 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
             oskar_sky_evaluate_gaussian_source_parameters(h->sky_chunks[i],
                     h->zero_failed_gaussians, ra0, dec0, &num_failed, status);
         }
+
+        /* Find the bounding cap of each chunk, for the horizon clip. */
+        double* caps = (double*) realloc(h->sky_chunk_caps,
+                4 * (h->num_sky_chunks + 1) * sizeof(double));
+        if (!caps)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return;
+        }
+        h->sky_chunk_caps = caps;
+        for (i = 0; i < h->num_sky_chunks; ++i)
+        {
+            oskar_sky_bounding_cap(h->sky_chunks[i],
+                    &h->sky_chunk_caps[4 * i], status);
+        }
         if (num_failed > 0)
         {
             if (h->zero_failed_gaussians)
@@ -77,6 +95,8 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
     }
 
     /* Check that each compute device has been set up. */
+    set_up_beam_cull(h, status);
+    set_up_beam_interp(h);
     set_up_device_data(h, status);
     if (!*status && !h->coords_only)
     {
@@ -89,6 +109,132 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
 
 
 
+static void set_up_beam_cull(oskar_Interferometer* h, int* status)
+{
+    double* flux_error = 0;
+    h->beam_cull = 0;
+    if (h->beam_cull_threshold_jy <= 0.0) return;
+
+    /* Culled sources would also have to be removed from the direction
+     * cosines evaluated for the array centre, so this is not supported. */
+    if (oskar_telescope_phase_centre_coord_type(h->tel) == OSKAR_COORDS_AZEL)
+    {
+        oskar_log_warning(h->log, "Station beam culling is not available "
+                "when the phase centre is fixed in (Az, El) coordinates.");
+        return;
+    }
+    const size_t num_slices = (size_t) h->num_time_steps * h->num_channels;
+    flux_error = (double*) realloc(h->cull_flux_error,
+            num_slices * sizeof(double));
+    if (!flux_error)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    memset(flux_error, 0, num_slices * sizeof(double));
+    h->cull_flux_error = flux_error;
+    h->beam_cull = 1;
+    h->cull_num_tested = 0;
+    h->cull_num_culled = 0;
+}
+
+
+static void set_up_beam_interp(oskar_Interferometer* h)
+{
+    int i = 0, j = 0, steps = 0;
+    double beam_width_rad = 0.0;
+    const double omega_earth = 7.2921150e-5; /* Rotation rate, in rad/s. */
+    const double freq_max_hz = h->freq_start_hz +
+            (h->num_channels - 1) * h->freq_inc_hz;
+    const double lambda_min = 299792458.0 / freq_max_hz;
+    h->beam_interp_steps = 1;
+    if (h->beam_interp_tolerance <= 0.0 || h->num_time_steps < 3 ||
+            h->time_inc_sec <= 0.0 || freq_max_hz <= 0.0)
+    {
+        return;
+    }
+
+    /* Find the smallest angular scale of any station beam, from the size
+     * of the station at the highest frequency. */
+    const int num_station_models = oskar_telescope_num_station_models(h->tel);
+    for (i = 0; i < num_station_models; ++i)
+    {
+        int status = 0;
+        double width = 0.0;
+        const oskar_Station* st = oskar_telescope_station_const(h->tel, i);
+        switch (oskar_station_type(st))
+        {
+        case OSKAR_STATION_TYPE_AA:
+        {
+            double r2 = 0.0, x0 = 0.0, y0 = 0.0;
+            const int n = oskar_station_num_elements(st);
+            oskar_Mem* x = oskar_mem_convert_precision(
+                    oskar_station_element_true_enu_metres_const(st, 0, 0),
+                    OSKAR_DOUBLE, &status);
+            oskar_Mem* y = oskar_mem_convert_precision(
+                    oskar_station_element_true_enu_metres_const(st, 0, 1),
+                    OSKAR_DOUBLE, &status);
+            const double* x_ = oskar_mem_double_const(x, &status);
+            const double* y_ = oskar_mem_double_const(y, &status);
+            for (j = 0; j < n && !status; ++j)
+            {
+                x0 += x_[j] / n;
+                y0 += y_[j] / n;
+            }
+            for (j = 0; j < n && !status; ++j)
+            {
+                const double dx = x_[j] - x0, dy = y_[j] - y0;
+                if (dx * dx + dy * dy > r2) r2 = dx * dx + dy * dy;
+            }
+            if (r2 > 0.0) width = lambda_min / (2.0 * sqrt(r2));
+            oskar_mem_free(x, &status);
+            oskar_mem_free(y, &status);
+            break;
+        }
+        case OSKAR_STATION_TYPE_GAUSSIAN_BEAM:
+            width = oskar_station_gaussian_beam_fwhm_rad(st) *
+                    oskar_station_gaussian_beam_reference_freq_hz(st) /
+                    freq_max_hz;
+            break;
+        case OSKAR_STATION_TYPE_VLA_PBCOR:
+            width = lambda_min / 25.0;
+            break;
+        default:
+            break;
+        }
+        if (width > 0.0 && (beam_width_rad == 0.0 || width < beam_width_rad))
+        {
+            beam_width_rad = width;
+        }
+    }
+
+    /* The error of linear interpolation over an interval dt is about
+     * (dt^2 / 8) times the second derivative, and the beam changes on a
+     * time scale of (beam width / (pi * Earth rotation rate)). */
+    if (beam_width_rad > 0.0)
+    {
+        const double dt_max = sqrt(8.0 * h->beam_interp_tolerance) *
+                beam_width_rad / (M_PI * omega_earth);
+        const double max_steps = floor(dt_max / h->time_inc_sec);
+        steps = (max_steps < h->num_time_steps) ?
+                (int) max_steps : h->num_time_steps;
+    }
+    else
+    {
+        /* Without a beam width, the interval cannot be bounded. */
+        oskar_log_warning(h->log, "Station beams will not be interpolated, "
+                "as no station beam width could be estimated.");
+    }
+    if (steps > 1)
+    {
+        h->beam_interp_steps = steps;
+        oskar_log_message(h->log, 'M', 0, "Station beams will be evaluated "
+                "every %d time steps and interpolated (tolerance %.3g).",
+                steps, h->beam_interp_tolerance);
+    }
+}
+
+
 static void set_up_vis_header(oskar_Interferometer* h, int* status)
 {
     int i = 0, j = 0, vis_type = 0;
@@ -188,7 +334,7 @@ typedef struct ThreadArgs ThreadArgs;
 
 static void* init_device(void* arg)
 {
-    int dev_loc = 0, vistype = 0, *status = 0;
+    int j = 0, dev_loc = 0, vistype = 0, *status = 0;
     ThreadArgs* a = (ThreadArgs*)arg;
     oskar_Interferometer* h = a->h;
     DeviceData* d = a->d;
@@ -226,6 +372,7 @@ static void* init_device(void* arg)
         d->tmr_K         = oskar_timer_create(dev_loc);
         d->tmr_join      = oskar_timer_create(dev_loc);
         d->tmr_correlate = oskar_timer_create(dev_loc);
+        d->tmr_wait      = oskar_timer_create(OSKAR_TIMER_NATIVE);
     }
 
     /* Visibility blocks. */
@@ -233,14 +380,19 @@ static void* init_device(void* arg)
     {
         d->vis_block = oskar_vis_block_create_from_header(dev_loc,
                 h->header, status);
-        d->vis_block_cpu[0] = oskar_vis_block_create_from_header(OSKAR_CPU,
-                h->header, status);
-        d->vis_block_cpu[1] = oskar_vis_block_create_from_header(OSKAR_CPU,
-                h->header, status);
+        d->vis_block_cpu = (oskar_VisBlock**) calloc(
+                h->num_vis_buffers, sizeof(oskar_VisBlock*));
+        for (j = 0; j < h->num_vis_buffers; ++j)
+        {
+            d->vis_block_cpu[j] = oskar_vis_block_create_from_header(
+                    OSKAR_CPU, h->header, status);
+        }
     }
     oskar_vis_block_clear(d->vis_block, status);
-    oskar_vis_block_clear(d->vis_block_cpu[0], status);
-    oskar_vis_block_clear(d->vis_block_cpu[1], status);
+    for (j = 0; j < h->num_vis_buffers; ++j)
+    {
+        oskar_vis_block_clear(d->vis_block_cpu[j], status);
+    }
 
     /* Device scratch memory. */
     if (!d->tel)
@@ -277,6 +429,56 @@ static void* init_device(void* arg)
                     oskar_telescope_tec_screen_path(d->tel));
         }
     }
+
+    /* Station beams at anchor times, if interpolating in time. */
+    if (h->beam_interp_steps > 1 &&
+            d->num_beam_anchors != h->max_channels_per_block)
+    {
+        for (j = 0; j < d->num_beam_anchors; ++j)
+        {
+            oskar_jones_free(d->beam_anchors[j].E[0], status);
+            oskar_jones_free(d->beam_anchors[j].E[1], status);
+        }
+        BeamAnchors* anchors = (BeamAnchors*) realloc(d->beam_anchors,
+                h->max_channels_per_block * sizeof(BeamAnchors));
+        if (!anchors)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            free(d->beam_anchors);
+        }
+        d->beam_anchors = anchors;
+        d->num_beam_anchors = anchors ? h->max_channels_per_block : 0;
+        for (j = 0; j < d->num_beam_anchors; ++j)
+        {
+            d->beam_anchors[j].E[0] = oskar_jones_create(vistype, dev_loc,
+                    num_stations, num_src, status);
+            d->beam_anchors[j].E[1] = oskar_jones_create(vistype, dev_loc,
+                    num_stations, num_src, status);
+        }
+    }
+    for (j = 0; j < d->num_beam_anchors; ++j)
+    {
+        d->beam_anchors[j].chunk_index = -1;
+        d->beam_anchors[j].time_index[0] = -1;
+        d->beam_anchors[j].time_index[1] = -1;
+    }
+    if (h->beam_interp_steps > 1 && h->beam_interp_validate && !d->E_check)
+    {
+        d->E_check = oskar_jones_create(vistype, dev_loc, num_stations,
+                num_src, status);
+    }
+
+    /* Buffers for sources remaining after culling by station beam. */
+    if (h->beam_cull && !d->chunk_cull)
+    {
+        d->chunk_cull = oskar_sky_create(h->prec, dev_loc, num_src, status);
+        d->E_cull = oskar_jones_create(vistype, dev_loc, num_stations,
+                num_src, status);
+        d->cull_mask = oskar_mem_create(OSKAR_INT, dev_loc, num_src, status);
+        d->cull_indices = oskar_mem_create(OSKAR_INT, dev_loc,
+                1 + num_src, status);
+        d->cull_flux = oskar_mem_create(h->prec, dev_loc, num_src, status);
+    }
     return 0;
 }
 
@@ -317,6 +519,19 @@ static void set_up_device_data(oskar_Interferometer* h, int* status)
     free(threads);
     free(args);
 
+    /* Allocate work unit queues for each block in flight. */
+    if (!h->work_queues)
+    {
+        h->work_queues = (WorkQueues*) calloc(
+                h->num_vis_buffers, sizeof(WorkQueues));
+        for (i = 0; i < h->num_vis_buffers; ++i)
+        {
+            h->work_queues[i].block_index = -1;
+            h->work_queues[i].range = (long long*) calloc(
+                    num_devices, sizeof(long long));
+        }
+    }
+
     /* Record memory usage. */
     if (!*status && init)
     {
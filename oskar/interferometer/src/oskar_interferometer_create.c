@@ -21,9 +21,11 @@ oskar_Interferometer* oskar_interferometer_create(int precision, int* status)
     h->prec      = precision;
     h->tmr_sim   = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_write = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    h->tmr_finalise = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    h->tmr_write_wait = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->temp      = oskar_mem_create(precision, OSKAR_CPU, 0, status);
     h->mutex     = oskar_mutex_create();
-    h->barrier   = oskar_barrier_create(0);
+    h->cond      = oskar_condition_create();
     h->log       = oskar_log_create(OSKAR_LOG_MESSAGE, OSKAR_LOG_WARNING);
 
     /* Get number of devices available, and device location. */
@@ -32,6 +34,7 @@ oskar_Interferometer* oskar_interferometer_create(int precision, int* status)
 
     /* Set sensible defaults. */
     h->max_sources_per_chunk = 16384;
+    h->num_vis_buffers = 3;
     oskar_interferometer_set_gpus(h, -1, 0, status);
     oskar_interferometer_set_num_devices(h, -1);
     oskar_interferometer_set_correlation_type(h, "Cross-correlations", status);
@@ -8,12 +8,14 @@
 #include "utility/oskar_device.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_get_memory_usage.h"
+#include "utility/oskar_perf_report.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 static void record_timing(oskar_Interferometer* h);
+static void write_report(oskar_Interferometer* h);
 
 void oskar_interferometer_finalise(oskar_Interferometer* h, int* status)
 {
@@ -67,6 +69,37 @@ void oskar_interferometer_finalise(oskar_Interferometer* h, int* status)
         }
         oskar_log_set_value_width(h->log, 25);
         record_timing(h);
+        if (h->beam_interp_steps > 1 && h->beam_interp_validate)
+        {
+            oskar_log_message(h->log, 'M', 0, "Station beam interpolation:");
+            oskar_log_value(h->log, 'M', 1, "Anchor spacing (steps)",
+                    "%d", h->beam_interp_steps);
+            oskar_log_value(h->log, 'M', 1, "Number of checks",
+                    "%d", h->beam_interp_num_checks);
+            oskar_log_value(h->log, 'M', 1, "Maximum error",
+                    "%.3e", h->beam_interp_max_error);
+        }
+        if (h->beam_cull)
+        {
+            size_t i = 0;
+            double max_error = 0.0;
+            const size_t num_slices =
+                    (size_t) h->num_time_steps * h->num_channels;
+            for (i = 0; i < num_slices; ++i)
+            {
+                if (h->cull_flux_error[i] > max_error)
+                {
+                    max_error = h->cull_flux_error[i];
+                }
+            }
+            oskar_log_message(h->log, 'M', 0, "Station beam culling:");
+            oskar_log_value(h->log, 'M', 1, "Threshold [Jy]",
+                    "%.3e", h->beam_cull_threshold_jy);
+            oskar_log_value(h->log, 'M', 1, "Sources culled", "%lld of %lld",
+                    h->cull_num_culled, h->cull_num_tested);
+            oskar_log_value(h->log, 'M', 1, "Maximum flux error [Jy]",
+                    "%.3e", max_error);
+        }
         oskar_log_section(h->log, 'M', "Simulation complete");
         oskar_log_message(h->log, 'M', 0, "Output(s):");
         if (h->vis_name)
@@ -79,9 +112,17 @@ void oskar_interferometer_finalise(oskar_Interferometer* h, int* status)
             oskar_log_value(h->log, 'M', 1,
                     "Measurement Set", "%s", h->ms_name);
         }
+        if (h->perf_report_name)
+        {
+            oskar_log_value(h->log, 'M', 1,
+                    "Performance report", "%s", h->perf_report_name);
+        }
         oskar_log_message(h->log, 'M', 0, "Run completed in %.3f sec.",
                 oskar_timer_elapsed(h->tmr_sim));
 
+        /* Write the performance report, if required. */
+        write_report(h);
+
         /* Write simulation log to the output files. */
         log_data = oskar_log_file_data(h->log, &log_size);
 #ifndef OSKAR_NO_MS
@@ -141,8 +182,21 @@ static void record_timing(oskar_Interferometer* h)
         oskar_log_value(h->log, 'M', 0, "Compute", "%.3f s [Device %i]",
                 compute_times[i], i);
     }
-    oskar_log_value(h->log, 'M', 0, "Write", "%.3f s",
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        oskar_log_value(h->log, 'M', 0, "Buffer wait",
+                "%.3f s [Device %i]", oskar_timer_elapsed(h->d[i].tmr_wait), i);
+    }
+    oskar_log_message(h->log, 'M', 0, "Output (%d host buffers):",
+            h->num_vis_buffers);
+    oskar_log_value(h->log, 'M', 1, "Combine", "%.3f s",
+            oskar_timer_elapsed(h->tmr_finalise));
+    oskar_log_value(h->log, 'M', 1, "Write", "%.3f s",
             oskar_timer_elapsed(h->tmr_write));
+    oskar_log_value(h->log, 'M', 1, "Wait for compute", "%.3f s",
+            oskar_timer_elapsed(h->tmr_write_wait));
+    oskar_log_value(h->log, 'M', 1, "Max. blocks queued", "%d",
+            h->max_blocks_queued);
     oskar_log_message(h->log, 'M', 0, "Compute components:");
     oskar_log_value(h->log, 'M', 1, "Copy", "%4.1f%%",
             (t_copy / t_compute) * 100.0);
@@ -161,6 +215,105 @@ static void record_timing(oskar_Interferometer* h)
     free(compute_times);
 }
 
+
+static void write_report(oskar_Interferometer* h)
+{
+    int i = 0;
+    const double t_sim = oskar_timer_elapsed(h->tmr_sim);
+    const int num_stations = oskar_telescope_num_stations(h->tel);
+    const int have_auto = (h->correlation_type != 'C');
+    const int have_cross = (h->correlation_type != 'A');
+    const long long num_slices =
+            (long long) h->num_time_steps * h->num_channels;
+    const long long num_baselines =
+            (long long) num_stations * (num_stations - 1) / 2;
+    const long long num_vis = num_slices * ((have_cross ? num_baselines : 0) +
+            (have_auto ? num_stations : 0));
+    int report_status = 0;
+    oskar_PerfReport* r = 0;
+    if (!h->perf_report_name) return;
+    r = oskar_perf_report_create(h->perf_report_name,
+            "oskar_sim_interferometer", h->settings_path, &report_status);
+    if (!r)
+    {
+        oskar_log_warning(h->log, "Unable to write performance report "
+                "'%s'.", h->perf_report_name);
+        return;
+    }
+    oskar_perf_report_string(r, "precision",
+            h->prec == OSKAR_DOUBLE ? "double" : "single");
+
+    /* Problem size. */
+    oskar_perf_report_begin_object(r, "counts");
+    oskar_perf_report_int(r, "sources", h->num_sources_total);
+    oskar_perf_report_int(r, "stations", num_stations);
+    oskar_perf_report_int(r, "baselines", num_baselines);
+    oskar_perf_report_int(r, "times", h->num_time_steps);
+    oskar_perf_report_int(r, "channels", h->num_channels);
+    oskar_perf_report_int(r, "visibilities", num_vis);
+    oskar_perf_report_int(r, "blocks", h->num_blocks_written);
+    oskar_perf_report_end(r);
+
+    /* Stage times for each device. */
+    oskar_perf_report_double(r, "wall_time_sec", t_sim);
+    oskar_perf_report_begin_array(r, "devices");
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        const DeviceData* d = &h->d[i];
+        const char* type = "cpu";
+        if (i < h->num_gpus)
+        {
+            type = (h->dev_loc == OSKAR_CL) ? "opencl" : "cuda";
+        }
+        oskar_perf_report_begin_object(r, 0);
+        oskar_perf_report_int(r, "index", i);
+        oskar_perf_report_string(r, "type", type);
+        oskar_perf_report_begin_object(r, "wall_time_sec");
+        oskar_perf_report_double(r, "compute",
+                oskar_timer_elapsed(d->tmr_compute));
+        oskar_perf_report_double(r, "copy", oskar_timer_elapsed(d->tmr_copy));
+        oskar_perf_report_double(r, "horizon_clip",
+                oskar_timer_elapsed(d->tmr_clip));
+        oskar_perf_report_double(r, "jones_E", oskar_timer_elapsed(d->tmr_E));
+        oskar_perf_report_double(r, "jones_K", oskar_timer_elapsed(d->tmr_K));
+        oskar_perf_report_double(r, "jones_join",
+                oskar_timer_elapsed(d->tmr_join));
+        oskar_perf_report_double(r, "correlate",
+                oskar_timer_elapsed(d->tmr_correlate));
+        oskar_perf_report_double(r, "buffer_wait",
+                oskar_timer_elapsed(d->tmr_wait));
+        oskar_perf_report_end(r);
+        oskar_perf_report_end(r);
+    }
+    oskar_perf_report_end(r);
+
+    /* Output stage. */
+    oskar_perf_report_begin_object(r, "output");
+    oskar_perf_report_int(r, "host_buffers", h->num_vis_buffers);
+    oskar_perf_report_int(r, "max_blocks_queued", h->max_blocks_queued);
+    oskar_perf_report_begin_object(r, "wall_time_sec");
+    oskar_perf_report_double(r, "combine",
+            oskar_timer_elapsed(h->tmr_finalise));
+    oskar_perf_report_double(r, "write", oskar_timer_elapsed(h->tmr_write));
+    oskar_perf_report_double(r, "wait_for_compute",
+            oskar_timer_elapsed(h->tmr_write_wait));
+    oskar_perf_report_end(r);
+    oskar_perf_report_end(r);
+
+    /* Derived throughput, using the total wall time. */
+    oskar_perf_report_begin_object(r, "throughput");
+    oskar_perf_report_double(r, "source_baselines_per_sec",
+            (double) h->num_sources_total * num_baselines * num_slices / t_sim);
+    oskar_perf_report_double(r, "visibilities_per_sec", num_vis / t_sim);
+    oskar_perf_report_end(r);
+    oskar_perf_report_close(r, &report_status);
+    if (report_status)
+    {
+        oskar_log_warning(h->log, "Error writing performance report '%s'.",
+                h->perf_report_name);
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
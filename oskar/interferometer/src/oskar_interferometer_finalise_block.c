@@ -20,7 +20,7 @@ static unsigned int disp_width(unsigned int v);
 oskar_VisBlock* oskar_interferometer_finalise_block(oskar_Interferometer* h,
         int block_index, int* status)
 {
-    int i = 0, i_active = 0;
+    int i = 0;
     oskar_VisBlock *b0 = 0, *b = 0;
     if (*status) return 0;
 
@@ -28,8 +28,8 @@ oskar_VisBlock* oskar_interferometer_finalise_block(oskar_Interferometer* h,
      * at the end of the block simulation. */
 
     /* Combine all vis blocks into the first one. */
-    i_active = (block_index + 1) % 2;
-    b0 = h->d[0].vis_block_cpu[!i_active];
+    const int i_buffer = block_index % h->num_vis_buffers;
+    b0 = h->d[0].vis_block_cpu[i_buffer];
     if (!h->coords_only)
     {
         oskar_Mem *xc0 = 0, *ac0 = 0;
@@ -37,7 +37,7 @@ oskar_VisBlock* oskar_interferometer_finalise_block(oskar_Interferometer* h,
         ac0 = oskar_vis_block_auto_correlations(b0);
         for (i = 1; i < h->num_devices; ++i)
         {
-            b = h->d[i].vis_block_cpu[!i_active];
+            b = h->d[i].vis_block_cpu[i_buffer];
             if (oskar_vis_block_has_cross_correlations(b))
             {
                 oskar_mem_add(xc0, xc0, oskar_vis_block_cross_correlations(b),
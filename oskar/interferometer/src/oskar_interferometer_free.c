@@ -27,21 +27,35 @@ void oskar_interferometer_free(oskar_Interferometer* h, int* status)
     oskar_mem_free(h->temp, status);
     oskar_timer_free(h->tmr_sim);
     oskar_timer_free(h->tmr_write);
+    oskar_timer_free(h->tmr_finalise);
+    oskar_timer_free(h->tmr_write_wait);
     oskar_mutex_free(h->mutex);
-    oskar_barrier_free(h->barrier);
+    oskar_condition_free(h->cond);
     oskar_log_free(h->log);
     free(h->sky_chunks);
+    free(h->sky_chunk_caps);
     free(h->gpu_ids);
     free(h->vis_name);
     free(h->ms_name);
     free(h->settings_path);
+    free(h->perf_report_name);
     free(h->d);
+    free(h->cull_flux_error);
     free(h);
 }
 
 void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
 {
-    int i = 0;
+    int i = 0, j = 0;
+    if (h->work_queues)
+    {
+        for (i = 0; i < h->num_vis_buffers; ++i)
+        {
+            free(h->work_queues[i].range);
+        }
+        free(h->work_queues);
+        h->work_queues = 0;
+    }
     if (!h->d) return;
     for (i = 0; i < h->num_devices; ++i)
     {
@@ -58,8 +72,15 @@ void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
         oskar_timer_free(d->tmr_K);
         oskar_timer_free(d->tmr_join);
         oskar_timer_free(d->tmr_correlate);
-        oskar_vis_block_free(d->vis_block_cpu[0], status);
-        oskar_vis_block_free(d->vis_block_cpu[1], status);
+        oskar_timer_free(d->tmr_wait);
+        if (d->vis_block_cpu)
+        {
+            for (j = 0; j < h->num_vis_buffers; ++j)
+            {
+                oskar_vis_block_free(d->vis_block_cpu[j], status);
+            }
+            free(d->vis_block_cpu);
+        }
         oskar_vis_block_free(d->vis_block, status);
         oskar_mem_free(d->lmn[0], status);
         oskar_mem_free(d->lmn[1], status);
@@ -75,6 +96,18 @@ void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
         oskar_jones_free(d->E, status);
         oskar_jones_free(d->K, status);
         oskar_jones_free(d->R, status);
+        oskar_jones_free(d->E_check, status);
+        for (j = 0; j < d->num_beam_anchors; ++j)
+        {
+            oskar_jones_free(d->beam_anchors[j].E[0], status);
+            oskar_jones_free(d->beam_anchors[j].E[1], status);
+        }
+        free(d->beam_anchors);
+        oskar_sky_free(d->chunk_cull, status);
+        oskar_jones_free(d->E_cull, status);
+        oskar_mem_free(d->cull_mask, status);
+        oskar_mem_free(d->cull_indices, status);
+        oskar_mem_free(d->cull_flux, status);
         oskar_mem_free(d->gains, status);
         memset(d, 0, sizeof(DeviceData));
     }
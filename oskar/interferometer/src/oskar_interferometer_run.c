@@ -27,7 +27,7 @@ typedef struct ThreadArgs ThreadArgs;
 static void* run_blocks(void* arg)
 {
     oskar_Interferometer* h = 0;
-    int b = 0, *status = 0;
+    int b = 0, i = 0, *status = 0;
 
     /* Get thread function arguments. */
     h = ((ThreadArgs*)arg)->h;
@@ -44,40 +44,96 @@ static void* run_blocks(void* arg)
 
     /* Loop over visibility blocks, running simulation and file
      * writing one block at a time. Simulation and file output are overlapped
-     * by using double buffering, and a dedicated thread is used for file
-     * output.
+     * by using multiple host buffers, and a dedicated thread is used for
+     * file output.
      *
      * Thread 0 is used for file writes.
      * Threads 1 to n (mapped to compute devices) do the simulation.
      *
-     * Note that no write is launched on the first loop counter (as no
-     * data are ready yet) and no simulation is performed for the last loop
-     * counter (which corresponds to the last block + 1) as this iteration
-     * simply writes the last block.
+     * There is no barrier between blocks: a device can start on the next
+     * block as soon as there are no more work units left in the current one,
+     * while other devices finish the work units they have already taken.
+     * The number of blocks in flight is bounded by the number of host
+     * buffers, as a device can only start a block once the previous block
+     * using the same buffer has been written.
      */
     const int num_blocks = oskar_interferometer_num_vis_blocks(h);
-    for (b = 0; b < num_blocks + 1; ++b)
+    if (num_threads == 1)
     {
-        if ((thread_id > 0 || num_threads == 1) && b < num_blocks)
+        for (b = 0; b < num_blocks; ++b)
         {
+            oskar_VisBlock* block = 0;
             oskar_interferometer_run_block(h, b, device_id, status);
+            block = oskar_interferometer_finalise_block(h, b, status);
+            oskar_interferometer_write_block(h, block, b, status);
         }
-        if (thread_id == 0 && b > 0)
+    }
+    else if (thread_id == 0)
+    {
+        for (b = 0; b < num_blocks; ++b)
         {
             oskar_VisBlock* block = 0;
-            block = oskar_interferometer_finalise_block(h, b - 1, status);
-            oskar_interferometer_write_block(h, block, b - 1, status);
+            int num_queued = num_blocks;
+
+            /* Wait for all devices to finish the block. */
+            oskar_condition_lock(h->cond);
+            oskar_timer_resume(h->tmr_write_wait);
+            for (i = 0; i < h->num_devices; ++i)
+            {
+                while (h->d[i].num_blocks_done <= b)
+                {
+                    oskar_condition_wait(h->cond);
+                }
+                if (h->d[i].num_blocks_done - b < num_queued)
+                {
+                    num_queued = h->d[i].num_blocks_done - b;
+                }
+            }
+            oskar_timer_pause(h->tmr_write_wait);
+            if (num_queued > h->max_blocks_queued)
+            {
+                h->max_blocks_queued = num_queued;
+            }
+            oskar_condition_unlock(h->cond);
+
+            /* Combine and write the block, then release its buffers. */
+            oskar_timer_resume(h->tmr_finalise);
+            block = oskar_interferometer_finalise_block(h, b, status);
+            oskar_timer_pause(h->tmr_finalise);
+            oskar_interferometer_write_block(h, block, b, status);
+            oskar_condition_lock(h->cond);
+            h->num_blocks_written = b + 1;
+            oskar_condition_notify_all(h->cond);
+            oskar_condition_unlock(h->cond);
         }
-
-        /* Barrier 1: Reset work unit index and print status. */
-        oskar_barrier_wait(h->barrier);
-        if (thread_id == 0)
+    }
+    else
+    {
+        DeviceData* d = &h->d[device_id];
+        for (b = 0; b < num_blocks; ++b)
         {
-            oskar_interferometer_reset_work_unit_index(h);
+            /* Wait until the host buffer for this block is free.
+             * This only happens if the writer has fallen behind by
+             * more blocks than there are host buffers. */
+            oskar_condition_lock(h->cond);
+            if (b - h->num_blocks_written >= h->num_vis_buffers)
+            {
+                oskar_timer_resume(d->tmr_wait);
+                while (b - h->num_blocks_written >= h->num_vis_buffers)
+                {
+                    oskar_condition_wait(h->cond);
+                }
+                oskar_timer_pause(d->tmr_wait);
+            }
+            oskar_condition_unlock(h->cond);
+
+            /* Run the simulation, then signal that the block is done. */
+            oskar_interferometer_run_block(h, b, device_id, status);
+            oskar_condition_lock(h->cond);
+            d->num_blocks_done = b + 1;
+            oskar_condition_notify_all(h->cond);
+            oskar_condition_unlock(h->cond);
         }
-
-        /* Barrier 2: Synchronise before moving to the next block. */
-        oskar_barrier_wait(h->barrier);
     }
     return 0;
 }
@@ -114,7 +170,6 @@ void oskar_interferometer_run(oskar_Interferometer* h, int* status)
 
     /* Set up worker threads. */
     const int num_threads = h->num_devices + 1;
-    oskar_barrier_set_num_threads(h->barrier, num_threads);
     threads = (oskar_Thread**) calloc(num_threads, sizeof(oskar_Thread*));
     args = (ThreadArgs*) calloc(num_threads, sizeof(ThreadArgs));
     for (i = 0; i < num_threads; ++i)
@@ -127,6 +182,18 @@ void oskar_interferometer_run(oskar_Interferometer* h, int* status)
 
     /* Start the worker threads. */
     oskar_interferometer_reset_work_unit_index(h);
+    oskar_timer_reset(h->tmr_write);
+    oskar_timer_reset(h->tmr_finalise);
+    oskar_timer_reset(h->tmr_write_wait);
+    h->num_blocks_written = 0;
+    h->max_blocks_queued = 0;
+    h->beam_interp_num_checks = 0;
+    h->beam_interp_max_error = 0.0;
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        h->d[i].num_blocks_done = 0;
+        if (h->d[i].tmr_wait) oskar_timer_reset(h->d[i].tmr_wait);
+    }
     for (i = 0; i < num_threads; ++i)
     {
         threads[i] = oskar_thread_create(run_blocks, (void*)&args[i], 0);
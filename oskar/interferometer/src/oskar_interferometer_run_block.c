@@ -15,15 +15,35 @@
 #include "interferometer/oskar_evaluate_jones_K.h"
 #include "interferometer/oskar_evaluate_jones_R.h"
 #include "interferometer/oskar_evaluate_jones_Z.h"
+#include "math/oskar_prefix_sum.h"
+#include "sky/oskar_sky_copy_source_data.h"
 #include "utility/oskar_device.h"
 
+#include <math.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define RANGE_PACK(BEGIN, END) \
+    ((long long) (((unsigned long long) (BEGIN) << 32) | (unsigned int) (END)))
+#define RANGE_BEGIN(R) ((int) ((unsigned long long) (R) >> 32))
+#define RANGE_END(R)   ((int) ((unsigned long long) (R) & 0xFFFFFFFFull))
+
+/* Maximum number of sources used to check interpolated station beams. */
+#define BEAM_CHECK_SOURCES 64
+
+static WorkQueues* get_work_queues(oskar_Interferometer* h, int block_index,
+        int num_work_units);
+static int next_work_unit(WorkQueues* q, int num_devices, int device_id);
+static int beam_is_frequency_independent(const oskar_Telescope* tel);
+static void sim_time(oskar_Interferometer* h, DeviceData* d,
+        oskar_Sky* sky, int chunk_index, int time_index_sim, int eval_beam,
+        int* status);
 static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
-        oskar_Sky* sky, int channel_index_block, int time_index_block,
-        int channel_index_sim, int time_index_sim, int* status);
+        oskar_Sky* sky, int chunk_index, int channel_index_block,
+        int time_index_block, int channel_index_sim, int time_index_sim,
+        int eval_beam, int* status);
 static unsigned int disp_width(unsigned int v);
 
 void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
@@ -88,21 +108,44 @@ void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
 
     /* Go though all possible work units in the block. A work unit is defined
      * as the simulation for one time and one sky chunk. */
+    WorkQueues* queues = get_work_queues(h, block_index,
+            num_times_block * total_chunks);
+    const int beam_fixed = beam_is_frequency_independent(d->tel);
     while (!h->coords_only)
     {
         oskar_Sky* sky = 0;
         int i_channel = 0;
 
-        oskar_mutex_lock(h->mutex);
-        const int i_work_unit = (h->work_unit_index)++;
-        oskar_mutex_unlock(h->mutex);
-        if ((i_work_unit >= num_times_block * total_chunks) || *status) break;
+        const int i_work_unit = next_work_unit(queues,
+                h->num_devices, device_id);
+        if (i_work_unit < 0 || *status) break;
 
         /* Convert slice index to chunk/time index. */
         const int i_chunk      = i_work_unit / num_times_block;
         const int i_time       = i_work_unit - i_chunk * num_times_block;
         const int sim_time_idx = time_index_start + i_time;
 
+        /* Test the bounding cap of the chunk against the horizon first,
+         * so only chunks that cross the horizon are clipped source by
+         * source, and chunks below the horizon are skipped. */
+        int clip = h->apply_horizon_clip;
+        double gast = 0.0;
+        if (clip)
+        {
+            const double mjd = obs_start_mjd +
+                    dt_dump_days * (sim_time_idx + 0.5);
+            gast = oskar_convert_mjd_to_gast_fast(mjd);
+            oskar_timer_resume(d->tmr_clip);
+            const int visible = oskar_sky_horizon_cap_test(
+                    &h->sky_chunk_caps[4 * i_chunk],
+                    oskar_sky_reference_ra_rad(h->sky_chunks[i_chunk]),
+                    oskar_sky_reference_dec_rad(h->sky_chunks[i_chunk]),
+                    d->tel, gast);
+            oskar_timer_pause(d->tmr_clip);
+            if (visible == 0) continue;
+            if (visible == 1) clip = 0;
+        }
+
         /* Copy sky chunk to device only if different from the previous one. */
         if (i_chunk != d->previous_chunk_index)
         {
@@ -110,20 +153,22 @@ void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
             oskar_sky_copy(d->chunk, h->sky_chunks[i_chunk], status);
             oskar_timer_pause(d->tmr_copy);
         }
-        sky = h->apply_horizon_clip ? d->chunk_clip : d->chunk;
+        d->previous_chunk_index = i_chunk;
+        sky = clip ? d->chunk_clip : d->chunk;
 
         /* Apply horizon clip if required. */
-        if (h->apply_horizon_clip)
+        if (clip)
         {
-            double gast = 0.0, mjd = 0.0;
-            mjd = obs_start_mjd + dt_dump_days * (sim_time_idx + 0.5);
-            gast = oskar_convert_mjd_to_gast_fast(mjd);
             oskar_timer_resume(d->tmr_clip);
             oskar_sky_horizon_clip(d->chunk_clip, d->chunk, d->tel, gast,
                     d->station_work, status);
             oskar_timer_pause(d->tmr_clip);
         }
 
+        /* Evaluate everything that depends only on time, including the
+         * station beam if it does not depend on frequency. */
+        sim_time(h, d, sky, i_chunk, sim_time_idx, beam_fixed, status);
+
         /* Simulate all baselines for all channels for this time and chunk. */
         for (i_channel = 0; i_channel < num_chans_block; ++i_channel)
         {
@@ -137,14 +182,13 @@ void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
                     disp_width(total_chans), sim_chan_idx + 1, total_chans,
                     device_id, oskar_sky_num_sources(sky));
             oskar_mutex_unlock(h->mutex);
-            sim_baselines(h, d, sky, i_channel, i_time,
-                    sim_chan_idx, sim_time_idx, status);
+            sim_baselines(h, d, sky, i_chunk, i_channel, i_time,
+                    sim_chan_idx, sim_time_idx, !beam_fixed, status);
         }
-        d->previous_chunk_index = i_chunk;
     }
 
     /* Copy the visibility block to host memory. */
-    const int i_active = block_index % 2; /* Index of the active buffer. */
+    const int i_active = block_index % h->num_vis_buffers; /* Active buffer. */
     oskar_timer_resume(d->tmr_copy);
     oskar_vis_block_copy(d->vis_block_cpu[i_active], d->vis_block, status);
     oskar_timer_pause(d->tmr_copy);
@@ -152,41 +196,408 @@ void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
 }
 
 
-static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
-        oskar_Sky* sky, int channel_index_block, int time_index_block,
-        int channel_index_sim, int time_index_sim, int* status)
+static WorkQueues* get_work_queues(oskar_Interferometer* h, int block_index,
+        int num_work_units)
+{
+    int i = 0;
+    WorkQueues* q = &h->work_queues[block_index % h->num_vis_buffers];
+
+    /* The first device to reach the block sets up its queues, by dividing
+     * the work units into contiguous ranges so that each device mostly
+     * works on its own sky chunks.
+     * The queues can only be re-used once the block has been written,
+     * so they are never reset while another device is still using them. */
+    oskar_mutex_lock(h->mutex);
+    if (q->block_index != block_index)
+    {
+        const int num_devices = h->num_devices;
+        for (i = 0; i < num_devices; ++i)
+        {
+            const int begin = (int) (((long long) num_work_units * i) /
+                    num_devices);
+            const int end = (int) (((long long) num_work_units * (i + 1)) /
+                    num_devices);
+            q->range[i] = RANGE_PACK(begin, end);
+        }
+        q->block_index = block_index;
+    }
+    oskar_mutex_unlock(h->mutex);
+    return q;
+}
+
+
+static int next_work_unit(WorkQueues* q, int num_devices, int device_id)
+{
+    int i = 0;
+    volatile long long* own = &q->range[device_id];
+
+    /* Take the next work unit from the front of this device's range. */
+    for (;;)
+    {
+        const long long r = oskar_atomic_load(own);
+        const int begin = RANGE_BEGIN(r), end = RANGE_END(r);
+        if (begin >= end) break;
+        if (oskar_atomic_compare_exchange(own, r, RANGE_PACK(begin + 1, end)))
+        {
+            return begin;
+        }
+    }
+
+    /* Range is empty, so steal half of the largest remaining range
+     * from the back of another device's queue. */
+    for (;;)
+    {
+        int victim = -1, max_remaining = 0;
+        long long r_victim = 0;
+        for (i = 1; i < num_devices; ++i)
+        {
+            const int j = (device_id + i) % num_devices;
+            const long long r = oskar_atomic_load(&q->range[j]);
+            const int remaining = RANGE_END(r) - RANGE_BEGIN(r);
+            if (remaining > max_remaining)
+            {
+                victim = j;
+                max_remaining = remaining;
+                r_victim = r;
+            }
+        }
+        if (victim < 0) return -1;
+        const int begin = RANGE_BEGIN(r_victim), end = RANGE_END(r_victim);
+        const int split = end - (max_remaining + 1) / 2;
+        if (oskar_atomic_compare_exchange(&q->range[victim], r_victim,
+                RANGE_PACK(begin, split)))
+        {
+            /* Keep the first stolen work unit, and put the rest into this
+             * device's own range, where it can be stolen in turn. */
+            long long r_own = 0;
+            do
+            {
+                r_own = oskar_atomic_load(own);
+            }
+            while (!oskar_atomic_compare_exchange(own, r_own,
+                    RANGE_PACK(split + 1, end)));
+            return split;
+        }
+    }
+}
+
+
+static int beam_is_frequency_independent(const oskar_Telescope* tel)
+{
+    int i = 0;
+    const int num_station_models = oskar_telescope_num_station_models(tel);
+
+    /* The station beam is the same at all frequencies only if every
+     * station is isotropic, and there is no ionosphere or HARP data. */
+    if (num_station_models == 0 ||
+            oskar_telescope_ionosphere_screen_type(tel) != 'N' ||
+            oskar_telescope_harp_data_const(tel, 0.0))
+    {
+        return 0;
+    }
+    for (i = 0; i < num_station_models; ++i)
+    {
+        if (oskar_station_type(oskar_telescope_station_const(tel, i)) !=
+                OSKAR_STATION_TYPE_ISOTROPIC)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+static void get_source_directions(const DeviceData* d, const oskar_Sky* sky,
+        const oskar_Mem* lmn[3])
+{
+    if (oskar_telescope_phase_centre_coord_type(d->tel) == OSKAR_COORDS_AZEL)
+    {
+        /* Reference direction cosine scratch arrays. */
+        lmn[0] = d->lmn[0];
+        lmn[1] = d->lmn[1];
+        lmn[2] = d->lmn[2];
+    }
+    else
+    {
+        /* Reference source direction cosines from sky model. */
+        lmn[0] = oskar_sky_l_const(sky);
+        lmn[1] = oskar_sky_m_const(sky);
+        lmn[2] = oskar_sky_n_const(sky);
+    }
+}
+
+
+static double gast_at(const oskar_Interferometer* h, int time_index_sim)
+{
+    const double dt_dump_days = h->time_inc_sec / 86400.0;
+    return oskar_convert_mjd_to_gast_fast(h->time_start_mjd_utc +
+            dt_dump_days * (time_index_sim + 0.5));
+}
+
+
+static void evaluate_jones_E(DeviceData* d, oskar_Jones* E,
+        const oskar_Sky* sky, int num_src, int time_index_sim,
+        double gast_rad, double freq, int* status)
+{
+    const oskar_Mem* const source_coords[] = {
+            oskar_sky_l_const(sky),
+            oskar_sky_m_const(sky),
+            oskar_sky_n_const(sky)
+    };
+    oskar_jones_set_size(E, oskar_telescope_num_stations(d->tel), num_src,
+            status);
+    oskar_evaluate_jones_E(E, OSKAR_COORDS_REL_DIR, num_src, source_coords,
+            oskar_sky_reference_ra_rad(sky), oskar_sky_reference_dec_rad(sky),
+            d->tel, time_index_sim, gast_rad, freq, d->station_work, status);
+}
+
+
+static void check_beam(oskar_Interferometer* h, DeviceData* d,
+        const oskar_Sky* sky, int time_index_sim, double gast_rad,
+        double freq, int* status)
+{
+    int i = 0, j = 0, k = 0;
+    double max_error = 0.0;
+    oskar_Mem *t = 0, *interp = 0, *direct = 0;
+    const int num_stations = oskar_telescope_num_stations(d->tel);
+    const int num_src = oskar_sky_num_sources(sky);
+    const int num_check = num_src < BEAM_CHECK_SOURCES ?
+            num_src : BEAM_CHECK_SOURCES;
+    const int num_real = oskar_mem_is_matrix(oskar_jones_mem(d->E)) ? 8 : 2;
+    if (*status || num_check == 0) return;
+
+    /* Evaluate the station beam directly for the first few sources. */
+    evaluate_jones_E(d, d->E_check, sky, num_check, time_index_sim,
+            gast_rad, freq, status);
+
+    /* Find the largest difference from the interpolated beam. */
+    t = oskar_mem_create_copy(oskar_jones_mem(d->E), OSKAR_CPU, status);
+    interp = oskar_mem_convert_precision(t, OSKAR_DOUBLE, status);
+    oskar_mem_free(t, status);
+    t = oskar_mem_create_copy(oskar_jones_mem(d->E_check), OSKAR_CPU, status);
+    direct = oskar_mem_convert_precision(t, OSKAR_DOUBLE, status);
+    oskar_mem_free(t, status);
+    if (!*status)
+    {
+        const double* a = oskar_mem_double_const(interp, status);
+        const double* b = oskar_mem_double_const(direct, status);
+        for (i = 0; i < num_stations; ++i)
+        {
+            for (j = 0; j < num_check; ++j)
+            {
+                const double* a_ = a + num_real * ((size_t) num_src * i + j);
+                const double* b_ = b + num_real * ((size_t) num_check * i + j);
+                for (k = 0; k < num_real; ++k)
+                {
+                    const double diff = fabs(a_[k] - b_[k]);
+                    if (diff > max_error) max_error = diff;
+                }
+            }
+        }
+        oskar_mutex_lock(h->mutex);
+        h->beam_interp_num_checks++;
+        if (max_error > h->beam_interp_max_error)
+        {
+            h->beam_interp_max_error = max_error;
+        }
+        oskar_mutex_unlock(h->mutex);
+    }
+    oskar_mem_free(interp, status);
+    oskar_mem_free(direct, status);
+}
+
+
+static void interpolate_beam(oskar_Interferometer* h, DeviceData* d,
+        oskar_Sky* sky, int chunk_index, int channel_index_block,
+        int time_index_sim, double gast_rad, double freq, int* status)
+{
+    int k = 0;
+    BeamAnchors* a = &d->beam_anchors[channel_index_block];
+    const oskar_Mem *mask = 0, *indices = 0;
+
+    /* Find the anchor times on either side of this one. */
+    const int steps = h->beam_interp_steps;
+    const int t0 = steps * (time_index_sim / steps);
+    const int t1 = (t0 + steps < h->num_time_steps) ?
+            t0 + steps : h->num_time_steps - 1;
+    const double frac = (t1 > t0) ?
+            (double) (time_index_sim - t0) / (t1 - t0) : 0.0;
+    const int anchors[] = {t0, t1};
+
+    /* The beams at the anchor times are evaluated for all sources in the
+     * chunk, and are re-used until the chunk or frequency changes. */
+    if (a->chunk_index != chunk_index || a->freq_hz != freq)
+    {
+        a->chunk_index = chunk_index;
+        a->freq_hz = freq;
+        a->time_index[0] = a->time_index[1] = -1;
+    }
+    if (a->time_index[0] != t0 && a->time_index[1] == t0)
+    {
+        oskar_Jones* t = a->E[0];
+        a->E[0] = a->E[1];
+        a->E[1] = t;
+        a->time_index[0] = t0;
+        a->time_index[1] = -1;
+    }
+    for (k = 0; k < 2; ++k)
+    {
+        if (a->time_index[k] == anchors[k] || (k == 1 && frac == 0.0))
+        {
+            continue;
+        }
+        evaluate_jones_E(d, a->E[k], d->chunk,
+                oskar_sky_num_sources(d->chunk), anchors[k],
+                gast_at(h, anchors[k]), freq, status);
+        a->time_index[k] = anchors[k];
+    }
+
+    /* Interpolate to this time, keeping only sources above the horizon
+     * if the chunk has been clipped. */
+    if (sky == d->chunk_clip)
+    {
+        mask = oskar_station_work_horizon_mask(d->station_work);
+        indices = oskar_station_work_source_indices(d->station_work);
+    }
+    oskar_jones_interpolate(d->E, a->E[0], frac > 0.0 ? a->E[1] : a->E[0],
+            frac, mask, indices, status);
+    if (h->beam_interp_validate && frac > 0.0)
+    {
+        check_beam(h, d, sky, time_index_sim, gast_rad, freq, status);
+    }
+}
+
+
+static void evaluate_beam(oskar_Interferometer* h, DeviceData* d,
+        oskar_Sky* sky, int chunk_index, int channel_index_block,
+        int time_index_sim, double gast_rad, double freq, int* status)
+{
+    /* Evaluate station beam (Jones E: may be matrix). */
+    oskar_timer_resume(d->tmr_E);
+    if (h->beam_interp_steps > 1)
+    {
+        interpolate_beam(h, d, sky, chunk_index, channel_index_block,
+                time_index_sim, gast_rad, freq, status);
+    }
+    else
+    {
+        evaluate_jones_E(d, d->E, sky, oskar_sky_num_sources(sky),
+                time_index_sim, gast_rad, freq, status);
+    }
+    oskar_timer_pause(d->tmr_E);
+
+    /* Join with parallactic angle (Jones R), if it has been evaluated.
+     * TODO Move this into station beam evaluation instead. */
+    if (d->R)
+    {
+        oskar_timer_resume(d->tmr_join);
+        oskar_jones_join(d->E, d->E, d->R, status);
+        oskar_timer_pause(d->tmr_join);
+    }
+}
+
+
+static oskar_Sky* cull_sources(oskar_Interferometer* h, DeviceData* d,
+        oskar_Sky* sky, int channel_index_sim, int time_index_sim,
+        oskar_Jones** E, int* status)
+{
+    double culled_flux = 0.0;
+    const int num_src = oskar_sky_num_sources(sky);
+    if (*status || num_src == 0) return sky;
+
+    /* Find sources that are faint in the beams of all stations. */
+    const int num_culled = oskar_jones_cull_mask(d->E, oskar_sky_I_const(sky),
+            h->beam_cull_threshold_jy, d->cull_mask, d->cull_flux,
+            &culled_flux, status);
+    oskar_mutex_lock(h->mutex);
+    h->cull_num_tested += num_src;
+    h->cull_num_culled += num_culled;
+    h->cull_flux_error[(size_t) h->num_channels * time_index_sim +
+            channel_index_sim] += culled_flux;
+    oskar_mutex_unlock(h->mutex);
+    if (num_culled == 0 || *status) return sky;
+
+    /* Copy the remaining sources and their station beams. */
+    if (oskar_sky_capacity(d->chunk_cull) < num_src)
+    {
+        oskar_sky_resize(d->chunk_cull, num_src, status);
+    }
+    oskar_mem_ensure(d->cull_indices, (size_t) num_src + 1, status);
+    oskar_prefix_sum(num_src, d->cull_mask, d->cull_indices, status);
+    oskar_sky_copy_source_data(sky, d->cull_mask, d->cull_indices,
+            d->chunk_cull, status);
+    oskar_jones_set_size(d->E_cull, oskar_jones_num_stations(d->E),
+            num_src - num_culled, status);
+    oskar_jones_interpolate(d->E_cull, d->E, d->E, 0.0,
+            d->cull_mask, d->cull_indices, status);
+    *E = d->E_cull;
+    return d->chunk_cull;
+}
+
+
+static int use_fused_correlator(const oskar_Interferometer* h,
+        const DeviceData* d, const oskar_Mem* src_flux_I, int num_src,
+        int* status)
+{
+    int i = 0;
+
+    /* The interferometer phase can be applied by the correlator
+     * if there are no station gains, and if no sources would be
+     * removed by the flux filter in oskar_evaluate_jones_K(). */
+    if (*status || oskar_jones_mem_location(d->E) != OSKAR_CPU ||
+            !oskar_type_is_matrix(oskar_jones_type(d->E)) ||
+            oskar_gains_defined(oskar_telescope_gains(d->tel)))
+    {
+        return 0;
+    }
+    if (oskar_mem_is_double(src_flux_I))
+    {
+        const double* flux = oskar_mem_double_const(src_flux_I, status);
+        for (i = 0; i < num_src; ++i)
+        {
+            if (!(flux[i] > h->source_min_jy && flux[i] <= h->source_max_jy))
+            {
+                return 0;
+            }
+        }
+    }
+    else
+    {
+        const float* flux = oskar_mem_float_const(src_flux_I, status);
+        const float min_jy = (float) h->source_min_jy;
+        const float max_jy = (float) h->source_max_jy;
+        for (i = 0; i < num_src; ++i)
+        {
+            if (!(flux[i] > min_jy && flux[i] <= max_jy)) return 0;
+        }
+    }
+    return 1;
+}
+
+
+static void sim_time(oskar_Interferometer* h, DeviceData* d,
+        oskar_Sky* sky, int chunk_index, int time_index_sim, int eval_beam,
+        int* status)
 {
     /* Get dimensions. */
-    const int num_baselines   = oskar_telescope_num_baselines(d->tel);
     const int num_stations    = oskar_telescope_num_stations(d->tel);
     const int num_src         = oskar_sky_num_sources(sky);
     const int num_times_block = oskar_vis_block_num_times(d->vis_block);
-    const int num_chans_block = oskar_vis_block_num_channels(d->vis_block);
+    const int time_index_block =
+            time_index_sim - oskar_vis_block_start_time_index(d->vis_block);
 
     /* Return if there are no sources in the chunk,
-     * or if block indices requested are outside the block dimensions. */
-    if (num_src == 0 ||
-            time_index_block >= num_times_block ||
-            channel_index_block >= num_chans_block)
+     * or if the time requested is outside the block dimensions. */
+    if (*status || num_src == 0 || time_index_block >= num_times_block)
     {
         return;
     }
 
-    /* Get the time and frequency of the visibility slice being simulated. */
+    /* Get the time of the visibility slice being simulated. */
     const double dt_dump_days = h->time_inc_sec / 86400.0;
     const double t_start = h->time_start_mjd_utc;
     const double t_dump = t_start + dt_dump_days * (time_index_sim + 0.5);
     const double gast_rad = oskar_convert_mjd_to_gast_fast(t_dump);
-    const double freq = h->freq_start_hz + channel_index_sim * h->freq_inc_hz;
-
-    /* Scale source fluxes with spectral index and rotation measure. */
-    oskar_sky_scale_flux_with_frequency(sky, freq, status);
-    const oskar_Mem* const src_flux[] = {
-            oskar_sky_I_const(sky),
-            oskar_sky_Q_const(sky),
-            oskar_sky_U_const(sky),
-            oskar_sky_V_const(sky)
-    };
 
     /* Get true station (u,v,w) coordinates. */
     oskar_telescope_uvw(d->tel,
@@ -195,30 +606,15 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
             1, /* Single time sample. */
             t_start, dt_dump_days, time_index_sim,
             d->uvw[0], d->uvw[1], d->uvw[2], 0, 0, 0, status);
-    const oskar_Mem* const uvw[] = { d->uvw[0], d->uvw[1], d->uvw[2] };
 
-    /* Get source direction cosines. */
-    const oskar_Mem* lmn[3];
+    /* Calculate ENU source direction cosines for array centre, if needed. */
     if (oskar_telescope_phase_centre_coord_type(d->tel) == OSKAR_COORDS_AZEL)
     {
-        /* Calculate ENU source direction cosines for array centre. */
         const double lst_rad = gast_rad + oskar_telescope_lon_rad(d->tel);
         oskar_convert_apparent_ra_dec_to_enu_directions(num_src,
                 oskar_sky_ra_rad_const(sky), oskar_sky_dec_rad_const(sky),
                 lst_rad, oskar_telescope_lat_rad(d->tel),
                 0, d->lmn[0], d->lmn[1], d->lmn[2], status);
-
-        /* Reference direction cosine scratch arrays. */
-        lmn[0] = d->lmn[0];
-        lmn[1] = d->lmn[1];
-        lmn[2] = d->lmn[2];
-    }
-    else
-    {
-        /* Reference source direction cosines from sky model. */
-        lmn[0] = oskar_sky_l_const(sky);
-        lmn[1] = oskar_sky_m_const(sky);
-        lmn[2] = oskar_sky_n_const(sky);
     }
 
     /* Set dimensions of Jones matrices. */
@@ -226,24 +622,9 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
     {
         oskar_jones_set_size(d->R, num_stations, num_src, status);
     }
-    oskar_jones_set_size(d->J, num_stations, num_src, status);
     oskar_jones_set_size(d->E, num_stations, num_src, status);
-    oskar_jones_set_size(d->K, num_stations, num_src, status);
-
-    /* Evaluate station beam (Jones E: may be matrix). */
-    const oskar_Mem* const source_coords[] = {
-            oskar_sky_l_const(sky),
-            oskar_sky_m_const(sky),
-            oskar_sky_n_const(sky)
-    };
-    oskar_timer_resume(d->tmr_E);
-    oskar_evaluate_jones_E(d->E, OSKAR_COORDS_REL_DIR, num_src, source_coords,
-            oskar_sky_reference_ra_rad(sky), oskar_sky_reference_dec_rad(sky),
-            d->tel, time_index_sim, gast_rad, freq, d->station_work, status);
-    oskar_timer_pause(d->tmr_E);
 
-    /* Evaluate parallactic angle (Jones R: matrix), and join with Jones E.
-     * TODO Move this into station beam evaluation instead. */
+    /* Evaluate parallactic angle (Jones R: matrix). */
     if (d->R)
     {
         oskar_timer_resume(d->tmr_E);
@@ -252,41 +633,117 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
                 oskar_sky_dec_rad_const(sky),
                 d->tel, gast_rad, status);
         oskar_timer_pause(d->tmr_E);
-        oskar_timer_resume(d->tmr_join);
-        oskar_jones_join(d->R, d->E, d->R, status);
-        oskar_timer_pause(d->tmr_join);
     }
 
-    /* Evaluate interferometer phase (Jones K: scalar). */
-    oskar_timer_resume(d->tmr_K);
-    oskar_evaluate_jones_K(d->K, num_src,
-            lmn[0], lmn[1], lmn[2], uvw[0], uvw[1], uvw[2],
-            freq, src_flux[0], h->source_min_jy, h->source_max_jy,
-            h->ignore_w_components, status);
-    oskar_timer_pause(d->tmr_K);
+    /* Evaluate the station beam now, if it is the same for all channels. */
+    if (eval_beam)
+    {
+        evaluate_beam(h, d, sky, chunk_index, 0, time_index_sim, gast_rad,
+                h->freq_start_hz, status);
+    }
+}
 
-    /* Multiply Jones matrix chain to get a single block. */
-    oskar_timer_resume(d->tmr_join);
-    oskar_jones_join(d->J, d->K, d->R ? d->R : d->E, status);
-    oskar_timer_pause(d->tmr_join);
 
-    /* Check whether gain model exists.
-     * If so, evaluate gains and apply them. */
-    if (oskar_gains_defined(oskar_telescope_gains(d->tel)))
+static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
+        oskar_Sky* sky, int chunk_index, int channel_index_block,
+        int time_index_block, int channel_index_sim, int time_index_sim,
+        int eval_beam, int* status)
+{
+    /* Get dimensions. */
+    oskar_Jones* E = d->E;
+    const int num_baselines   = oskar_telescope_num_baselines(d->tel);
+    const int num_stations    = oskar_telescope_num_stations(d->tel);
+    const int num_times_block = oskar_vis_block_num_times(d->vis_block);
+    const int num_chans_block = oskar_vis_block_num_channels(d->vis_block);
+
+    /* Return if there are no sources in the chunk,
+     * or if block indices requested are outside the block dimensions. */
+    if (oskar_sky_num_sources(sky) == 0 ||
+            time_index_block >= num_times_block ||
+            channel_index_block >= num_chans_block)
     {
-        oskar_gains_evaluate(oskar_telescope_gains(d->tel),
-                time_index_sim, freq, d->gains, 0, status);
-        oskar_jones_apply_station_gains(d->J, d->gains, status);
+        return;
+    }
+
+    /* Get the time and frequency of the visibility slice being simulated.
+     * Station (u,v,w) coordinates, source direction cosines and
+     * parallactic angles have already been evaluated for this time. */
+    const double dt_dump_days = h->time_inc_sec / 86400.0;
+    const double t_start = h->time_start_mjd_utc;
+    const double t_dump = t_start + dt_dump_days * (time_index_sim + 0.5);
+    const double gast_rad = oskar_convert_mjd_to_gast_fast(t_dump);
+    const double freq = h->freq_start_hz + channel_index_sim * h->freq_inc_hz;
+    const oskar_Mem* const uvw[] = { d->uvw[0], d->uvw[1], d->uvw[2] };
+    const oskar_Mem* lmn[3];
+
+    /* Scale source fluxes with spectral index and rotation measure. */
+    oskar_sky_scale_flux_with_frequency(sky, freq, status);
+
+    /* Evaluate station beam, if not already done for this time. */
+    if (eval_beam)
+    {
+        evaluate_beam(h, d, sky, chunk_index, channel_index_block,
+                time_index_sim, gast_rad, freq, status);
+    }
+
+    /* Remove sources that are too faint to matter, if required. */
+    if (h->beam_cull)
+    {
+        sky = cull_sources(h, d, sky, channel_index_sim, time_index_sim,
+                &E, status);
+    }
+    const int num_src = oskar_sky_num_sources(sky);
+    const oskar_Mem* const src_flux[] = {
+            oskar_sky_I_const(sky),
+            oskar_sky_Q_const(sky),
+            oskar_sky_U_const(sky),
+            oskar_sky_V_const(sky)
+    };
+    get_source_directions(d, sky, lmn);
+
+    /* If possible, the correlator applies the interferometer phase
+     * directly to the station beams, and Jones K and J are not needed. */
+    const int fused = use_fused_correlator(h, d, src_flux[0], num_src, status);
+    if (!fused)
+    {
+        /* Size Jones K and J to match E, which is smaller if sources
+         * were culled. */
+        oskar_jones_set_size(d->J, num_stations, num_src, status);
+        oskar_jones_set_size(d->K, num_stations, num_src, status);
+
+        /* Evaluate interferometer phase (Jones K: scalar). */
+        oskar_timer_resume(d->tmr_K);
+        oskar_evaluate_jones_K(d->K, num_src,
+                lmn[0], lmn[1], lmn[2], uvw[0], uvw[1], uvw[2],
+                freq, src_flux[0], h->source_min_jy, h->source_max_jy,
+                h->ignore_w_components, status);
+        oskar_timer_pause(d->tmr_K);
+
+        /* Multiply Jones matrix chain to get a single block. */
+        oskar_timer_resume(d->tmr_join);
+        oskar_jones_join(d->J, d->K, E, status);
+        oskar_timer_pause(d->tmr_join);
+
+        /* Check whether gain model exists.
+         * If so, evaluate gains and apply them. */
+        if (oskar_gains_defined(oskar_telescope_gains(d->tel)))
+        {
+            oskar_gains_evaluate(oskar_telescope_gains(d->tel),
+                    time_index_sim, freq, d->gains, 0, status);
+            oskar_jones_apply_station_gains(d->J, d->gains, status);
+        }
     }
 
     /* Calculate output offset. */
     const int offset = num_chans_block * time_index_block + channel_index_block;
     oskar_timer_resume(d->tmr_correlate);
 
-    /* Auto-correlate for this time and channel. */
+    /* Auto-correlate for this time and channel.
+     * The interferometer phase has unit amplitude, so is not needed here. */
     if (oskar_vis_block_has_auto_correlations(d->vis_block))
     {
-        oskar_auto_correlate(num_src, d->J, src_flux, num_stations * offset,
+        oskar_auto_correlate(num_src, fused ? E : d->J, src_flux,
+                num_stations * offset,
                 oskar_vis_block_auto_correlations(d->vis_block), status);
     }
 
@@ -299,12 +756,25 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
             oskar_sky_gaussian_b_const(sky),
             oskar_sky_gaussian_c_const(sky)
         };
-        oskar_cross_correlate(
-                source_type, num_src, d->J,
-                src_flux, lmn, src_extended,
-                d->tel, uvw,
-                gast_rad, freq, num_baselines * offset,
-                oskar_vis_block_cross_correlations(d->vis_block), status);
+        if (fused)
+        {
+            oskar_cross_correlate_phase(
+                    source_type, num_src, E,
+                    src_flux, lmn, src_extended,
+                    d->tel, uvw,
+                    gast_rad, freq, h->ignore_w_components,
+                    num_baselines * offset,
+                    oskar_vis_block_cross_correlations(d->vis_block), status);
+        }
+        else
+        {
+            oskar_cross_correlate(
+                    source_type, num_src, d->J,
+                    src_flux, lmn, src_extended,
+                    d->tel, uvw,
+                    gast_rad, freq, num_baselines * offset,
+                    oskar_vis_block_cross_correlations(d->vis_block), status);
+        }
     }
     oskar_timer_pause(d->tmr_correlate);
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "interferometer/define_jones_cull_mask.h"
+#include "interferometer/private_jones.h"
+#include "interferometer/oskar_jones.h"
+#include "math/oskar_cmath.h"
+#include "utility/oskar_device.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+OSKAR_JONES_CULL_MASK_C(jones_cull_mask_complex_float, float, float2)
+OSKAR_JONES_CULL_MASK_C(jones_cull_mask_complex_double, double, double2)
+OSKAR_JONES_CULL_MASK_M(jones_cull_mask_matrix_float, float, float4c)
+OSKAR_JONES_CULL_MASK_M(jones_cull_mask_matrix_double, double, double4c)
+
+int oskar_jones_cull_mask(const oskar_Jones* jones, const oskar_Mem* flux_I,
+        double threshold_jy, oskar_Mem* mask, oskar_Mem* apparent_flux,
+        double* culled_flux, int* status)
+{
+    int i = 0, num_culled = 0;
+    oskar_Mem *mask_cpu = 0, *flux_cpu = 0;
+    *culled_flux = 0.0;
+    if (*status) return 0;
+    const int type = oskar_mem_type(jones->data);
+    const int location = oskar_mem_location(jones->data);
+    const int num_sources = jones->num_sources;
+    const int num_stations = jones->num_stations;
+    const float threshold_f = (float) threshold_jy;
+    if (oskar_mem_precision(flux_I) != oskar_type_precision(type) ||
+            oskar_mem_type(apparent_flux) != oskar_type_precision(type) ||
+            oskar_mem_type(mask) != OSKAR_INT)
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return 0;
+    }
+    if (oskar_mem_location(flux_I) != location ||
+            oskar_mem_location(mask) != location ||
+            oskar_mem_location(apparent_flux) != location)
+    {
+        *status = OSKAR_ERR_LOCATION_MISMATCH;
+        return 0;
+    }
+    if ((int) oskar_mem_length(flux_I) < num_sources)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return 0;
+    }
+    oskar_mem_ensure(mask, (size_t) num_sources, status);
+    oskar_mem_ensure(apparent_flux, (size_t) num_sources, status);
+    if (*status) return 0;
+    if (location == OSKAR_CPU)
+    {
+        int* mask_ = oskar_mem_int(mask, status);
+        switch (type)
+        {
+        case OSKAR_SINGLE_COMPLEX:
+            jones_cull_mask_complex_float(num_sources, num_stations,
+                    oskar_mem_float2_const(jones->data, status),
+                    oskar_mem_float_const(flux_I, status), threshold_f,
+                    mask_, oskar_mem_float(apparent_flux, status));
+            break;
+        case OSKAR_DOUBLE_COMPLEX:
+            jones_cull_mask_complex_double(num_sources, num_stations,
+                    oskar_mem_double2_const(jones->data, status),
+                    oskar_mem_double_const(flux_I, status), threshold_jy,
+                    mask_, oskar_mem_double(apparent_flux, status));
+            break;
+        case OSKAR_SINGLE_COMPLEX_MATRIX:
+            jones_cull_mask_matrix_float(num_sources, num_stations,
+                    oskar_mem_float4c_const(jones->data, status),
+                    oskar_mem_float_const(flux_I, status), threshold_f,
+                    mask_, oskar_mem_float(apparent_flux, status));
+            break;
+        case OSKAR_DOUBLE_COMPLEX_MATRIX:
+            jones_cull_mask_matrix_double(num_sources, num_stations,
+                    oskar_mem_double4c_const(jones->data, status),
+                    oskar_mem_double_const(flux_I, status), threshold_jy,
+                    mask_, oskar_mem_double(apparent_flux, status));
+            break;
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return 0;
+        }
+    }
+    else
+    {
+        size_t local_size[] = {256, 1, 1}, global_size[] = {1, 1, 1};
+        const char* k = 0;
+        const int is_dbl = oskar_mem_is_double(jones->data);
+        switch (type)
+        {
+        case OSKAR_SINGLE_COMPLEX:
+            k = "jones_cull_mask_complex_float"; break;
+        case OSKAR_DOUBLE_COMPLEX:
+            k = "jones_cull_mask_complex_double"; break;
+        case OSKAR_SINGLE_COMPLEX_MATRIX:
+            k = "jones_cull_mask_matrix_float"; break;
+        case OSKAR_DOUBLE_COMPLEX_MATRIX:
+            k = "jones_cull_mask_matrix_double"; break;
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return 0;
+        }
+        oskar_device_check_local_size(location, 0, local_size);
+        global_size[0] = oskar_device_global_size(
+                (size_t) num_sources, local_size[0]);
+        const oskar_Arg args[] = {
+                {INT_SZ, &num_sources},
+                {INT_SZ, &num_stations},
+                {PTR_SZ, oskar_mem_buffer_const(jones->data)},
+                {PTR_SZ, oskar_mem_buffer_const(flux_I)},
+                {is_dbl ? DBL_SZ : FLT_SZ, is_dbl ?
+                        (const void*)&threshold_jy : (const void*)&threshold_f},
+                {PTR_SZ, oskar_mem_buffer(mask)},
+                {PTR_SZ, oskar_mem_buffer(apparent_flux)}
+        };
+        oskar_device_launch_kernel(k, location, 1, local_size, global_size,
+                sizeof(args) / sizeof(oskar_Arg), args, 0, 0, status);
+
+        /* Copy the results back to count the culled sources. */
+        mask_cpu = oskar_mem_create_copy(mask, OSKAR_CPU, status);
+        flux_cpu = oskar_mem_create_copy(apparent_flux, OSKAR_CPU, status);
+    }
+
+    /* Count the culled sources, and sum their apparent flux. */
+    if (!*status)
+    {
+        const oskar_Mem* m = mask_cpu ? mask_cpu : mask;
+        const oskar_Mem* f = flux_cpu ? flux_cpu : apparent_flux;
+        const int* mask_ = oskar_mem_int_const(m, status);
+        const int is_dbl = oskar_mem_is_double(f);
+        const double* flux_d = is_dbl ? oskar_mem_double_const(f, status) : 0;
+        const float* flux_f = is_dbl ? 0 : oskar_mem_float_const(f, status);
+        for (i = 0; i < num_sources; ++i)
+        {
+            if (mask_[i]) continue;
+            num_culled++;
+            *culled_flux += is_dbl ? flux_d[i] : (double) flux_f[i];
+        }
+    }
+    oskar_mem_free(mask_cpu, status);
+    oskar_mem_free(flux_cpu, status);
+    return num_culled;
+}
+
+#ifdef __cplusplus
+}
+#endif
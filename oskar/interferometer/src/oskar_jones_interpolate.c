@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "interferometer/define_jones_interpolate.h"
+#include "interferometer/private_jones.h"
+#include "interferometer/oskar_jones.h"
+#include "math/oskar_cmath.h"
+#include "utility/oskar_device.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+OSKAR_JONES_INTERPOLATE_C(jones_interpolate_complex_float, float, float2)
+OSKAR_JONES_INTERPOLATE_C(jones_interpolate_complex_double, double, double2)
+OSKAR_JONES_INTERPOLATE_M(jones_interpolate_matrix_float, float, float4c)
+OSKAR_JONES_INTERPOLATE_M(jones_interpolate_matrix_double, double, double4c)
+
+void oskar_jones_interpolate(oskar_Jones* jones, const oskar_Jones* jones_a,
+        const oskar_Jones* jones_b, double frac, const oskar_Mem* mask,
+        const oskar_Mem* indices, int* status)
+{
+    if (*status) return;
+    const int type = oskar_mem_type(jones->data);
+    const int location = oskar_mem_location(jones->data);
+    const int num_sources_in = jones_a->num_sources;
+    const int num_sources_out = jones->num_sources;
+    const int num_stations = jones->num_stations;
+    const int use_mask = mask ? 1 : 0;
+    const float frac_f = (float) frac;
+    if (jones_b->num_sources != num_sources_in ||
+            jones_a->num_stations != num_stations ||
+            jones_b->num_stations != num_stations ||
+            (!mask && num_sources_out != num_sources_in))
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+    if (oskar_mem_type(jones_a->data) != type ||
+            oskar_mem_type(jones_b->data) != type)
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return;
+    }
+    if (oskar_mem_location(jones_a->data) != location ||
+            oskar_mem_location(jones_b->data) != location ||
+            (mask && (oskar_mem_location(mask) != location ||
+                    oskar_mem_location(indices) != location)))
+    {
+        *status = OSKAR_ERR_LOCATION_MISMATCH;
+        return;
+    }
+
+    /* The mask and indices are not used if there is no mask,
+     * but the kernels still need valid pointers. */
+    if (!mask)
+    {
+        mask = indices = jones_a->data;
+    }
+    if (location == OSKAR_CPU)
+    {
+        const int* mask_ = (const int*) oskar_mem_void_const(mask);
+        const int* indices_ = (const int*) oskar_mem_void_const(indices);
+        switch (type)
+        {
+        case OSKAR_SINGLE_COMPLEX:
+            jones_interpolate_complex_float(num_sources_in, num_stations,
+                    frac_f, use_mask, mask_, indices_, num_sources_out,
+                    oskar_mem_float2_const(jones_a->data, status),
+                    oskar_mem_float2_const(jones_b->data, status),
+                    oskar_mem_float2(jones->data, status));
+            break;
+        case OSKAR_DOUBLE_COMPLEX:
+            jones_interpolate_complex_double(num_sources_in, num_stations,
+                    frac, use_mask, mask_, indices_, num_sources_out,
+                    oskar_mem_double2_const(jones_a->data, status),
+                    oskar_mem_double2_const(jones_b->data, status),
+                    oskar_mem_double2(jones->data, status));
+            break;
+        case OSKAR_SINGLE_COMPLEX_MATRIX:
+            jones_interpolate_matrix_float(num_sources_in, num_stations,
+                    frac_f, use_mask, mask_, indices_, num_sources_out,
+                    oskar_mem_float4c_const(jones_a->data, status),
+                    oskar_mem_float4c_const(jones_b->data, status),
+                    oskar_mem_float4c(jones->data, status));
+            break;
+        case OSKAR_DOUBLE_COMPLEX_MATRIX:
+            jones_interpolate_matrix_double(num_sources_in, num_stations,
+                    frac, use_mask, mask_, indices_, num_sources_out,
+                    oskar_mem_double4c_const(jones_a->data, status),
+                    oskar_mem_double4c_const(jones_b->data, status),
+                    oskar_mem_double4c(jones->data, status));
+            break;
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+    }
+    else
+    {
+        size_t local_size[] = {64, 4, 1}, global_size[] = {1, 1, 1};
+        const char* k = 0;
+        const int is_dbl = oskar_mem_is_double(jones->data);
+        switch (type)
+        {
+        case OSKAR_SINGLE_COMPLEX:
+            k = "jones_interpolate_complex_float"; break;
+        case OSKAR_DOUBLE_COMPLEX:
+            k = "jones_interpolate_complex_double"; break;
+        case OSKAR_SINGLE_COMPLEX_MATRIX:
+            k = "jones_interpolate_matrix_float"; break;
+        case OSKAR_DOUBLE_COMPLEX_MATRIX:
+            k = "jones_interpolate_matrix_double"; break;
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        oskar_device_check_local_size(location, 0, local_size);
+        oskar_device_check_local_size(location, 1, local_size);
+        global_size[0] = oskar_device_global_size(
+                (size_t) num_sources_in, local_size[0]);
+        global_size[1] = oskar_device_global_size(
+                (size_t) num_stations, local_size[1]);
+        const oskar_Arg args[] = {
+                {INT_SZ, &num_sources_in},
+                {INT_SZ, &num_stations},
+                {is_dbl ? DBL_SZ : FLT_SZ,
+                        is_dbl ? (const void*)&frac : (const void*)&frac_f},
+                {INT_SZ, &use_mask},
+                {PTR_SZ, oskar_mem_buffer_const(mask)},
+                {PTR_SZ, oskar_mem_buffer_const(indices)},
+                {INT_SZ, &num_sources_out},
+                {PTR_SZ, oskar_mem_buffer_const(jones_a->data)},
+                {PTR_SZ, oskar_mem_buffer_const(jones_b->data)},
+                {PTR_SZ, oskar_mem_buffer(jones->data)}
+        };
+        oskar_device_launch_kernel(k, location, 2, local_size, global_size,
+                sizeof(args) / sizeof(oskar_Arg), args, 0, 0, status);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "interferometer/oskar_jones.h"
+#include "mem/oskar_mem.h"
+#include "utility/oskar_get_error_string.h"
+
+#include <cmath>
+
+static void check_cull_mask(int type, double tol)
+{
+    int status = 0;
+    const int sources = 40, stations = 3;
+    const int prec = oskar_type_precision(type);
+    const int num_comp = oskar_type_is_matrix(type) ? 4 : 1;
+    const double threshold = 0.5;
+    oskar_Jones* jones = oskar_jones_create(type, OSKAR_CPU,
+            stations, sources, &status);
+    oskar_Mem* flux = oskar_mem_create(prec, OSKAR_CPU, sources, &status);
+    oskar_Mem* mask = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, &status);
+    oskar_Mem* apparent = oskar_mem_create(prec, OSKAR_CPU, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Each element of the beam of station s for source i has amplitude
+    // 0.03 (i + s), with a phase, and the flux alternates in sign.
+    for (int s = 0; s < stations; ++s)
+    {
+        for (int i = 0; i < sources; ++i)
+        {
+            const double amp = 0.03 * (i + s);
+            for (int c = 0; c < num_comp; ++c)
+            {
+                const size_t k = 2 * ((size_t) num_comp *
+                        (s * sources + i) + c);
+                const double v[] = {amp * cos(0.1 * c), amp * sin(0.1 * c)};
+                for (int j = 0; j < 2; ++j)
+                {
+                    oskar_mem_set_element_real(oskar_jones_mem(jones),
+                            k + j, v[j], &status);
+                }
+            }
+        }
+    }
+    for (int i = 0; i < sources; ++i)
+    {
+        oskar_mem_set_element_real(flux, i, (i % 2) ? -3.0 : 3.0, &status);
+    }
+
+    // Source 0 has a NaN in one station, so must not be culled.
+    oskar_mem_set_element_real(oskar_jones_mem(jones),
+            2 * num_comp * sources, NAN, &status);
+
+    double culled_flux = 0.0, expected_flux = 0.0;
+    int expected_culled = 0;
+    const int num_culled = oskar_jones_cull_mask(jones, flux, threshold,
+            mask, apparent, &culled_flux, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    const int* m = oskar_mem_int_const(mask, &status);
+    EXPECT_EQ(1, m[0]);
+    for (int i = 1; i < sources; ++i)
+    {
+        // The largest beam is at the last station.
+        const double amp = 0.03 * (i + stations - 1);
+        const double expected = amp * amp * 3.0 * (num_comp == 4 ? 2 : 1);
+        const double value = oskar_mem_get_element(apparent, i, &status);
+        EXPECT_NEAR(expected, value, tol * expected);
+        EXPECT_EQ(value < threshold ? 0 : 1, m[i]);
+        if (!m[i])
+        {
+            expected_culled++;
+            expected_flux += value;
+        }
+    }
+    EXPECT_GT(expected_culled, 0);
+    EXPECT_LT(expected_culled, sources - 1);
+    EXPECT_EQ(expected_culled, num_culled);
+    EXPECT_NEAR(expected_flux, culled_flux, tol * expected_flux);
+
+    // A threshold of zero keeps everything.
+    EXPECT_EQ(0, oskar_jones_cull_mask(jones, flux, 0.0,
+            mask, apparent, &culled_flux, &status));
+    EXPECT_EQ(0.0, culled_flux);
+
+    oskar_mem_free(flux, &status);
+    oskar_mem_free(mask, &status);
+    oskar_mem_free(apparent, &status);
+    oskar_jones_free(jones, &status);
+}
+
+TEST(Jones, cull_mask_scalar_double)
+{
+    check_cull_mask(OSKAR_DOUBLE_COMPLEX, 1e-12);
+}
+
+TEST(Jones, cull_mask_matrix_double)
+{
+    check_cull_mask(OSKAR_DOUBLE_COMPLEX_MATRIX, 1e-12);
+}
+
+TEST(Jones, cull_mask_scalar_single)
+{
+    check_cull_mask(OSKAR_SINGLE_COMPLEX, 1e-5);
+}
+
+TEST(Jones, cull_mask_matrix_single)
+{
+    check_cull_mask(OSKAR_SINGLE_COMPLEX_MATRIX, 1e-5);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "interferometer/oskar_jones.h"
+#include "mem/oskar_mem.h"
+#include "utility/oskar_get_error_string.h"
+
+#include <cmath>
+
+static const int sources = 50;
+static const int stations = 3;
+
+static void check_interpolate(int type, double tol)
+{
+    int status = 0;
+    const int num_real = oskar_type_is_matrix(type) ? 8 : 2;
+    const int num_values = num_real * sources * stations;
+    oskar_Jones* a = oskar_jones_create(type, OSKAR_CPU,
+            stations, sources, &status);
+    oskar_Jones* b = oskar_jones_create(type, OSKAR_CPU,
+            stations, sources, &status);
+    oskar_Jones* out = oskar_jones_create(type, OSKAR_CPU,
+            stations, sources, &status);
+    oskar_Mem* mask = oskar_mem_create(OSKAR_INT, OSKAR_CPU,
+            sources, &status);
+    oskar_Mem* indices = oskar_mem_create(OSKAR_INT, OSKAR_CPU,
+            sources, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Element k of A has amplitude 1 and phase 0.01 k. B has amplitude 3
+    // and is rotated by a further 1 radian.
+    void* pa = oskar_mem_void(oskar_jones_mem(a));
+    void* pb = oskar_mem_void(oskar_jones_mem(b));
+    const int is_dbl = oskar_type_is_double(type);
+    for (int k = 0; k < num_values / 2; ++k)
+    {
+        const double v[] = {
+                cos(0.01 * k), sin(0.01 * k),
+                3.0 * cos(0.01 * k + 1.0), 3.0 * sin(0.01 * k + 1.0)
+        };
+        for (int j = 0; j < 2; ++j)
+        {
+            if (is_dbl)
+            {
+                ((double*) pa)[2 * k + j] = v[j];
+                ((double*) pb)[2 * k + j] = v[j + 2];
+            }
+            else
+            {
+                ((float*) pa)[2 * k + j] = (float) v[j];
+                ((float*) pb)[2 * k + j] = (float) v[j + 2];
+            }
+        }
+    }
+
+    // Check a fraction of 0 returns A exactly.
+    oskar_jones_interpolate(out, a, b, 0.0, 0, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_EQ(0, memcmp(oskar_mem_void_const(oskar_jones_mem(out)),
+            oskar_mem_void_const(oskar_jones_mem(a)),
+            num_values * oskar_mem_element_size(
+                    oskar_type_precision(type))));
+
+    // Check the amplitude and phase half way through the interval.
+    oskar_jones_interpolate(out, a, b, 0.5, 0, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    oskar_Mem* out_d = oskar_mem_convert_precision(oskar_jones_mem(out),
+            OSKAR_DOUBLE, &status);
+    const double* p = oskar_mem_double_const(out_d, &status);
+    for (int k = 0; k < num_values / 2; ++k)
+    {
+        EXPECT_NEAR(2.0 * cos(0.01 * k + 0.5), p[2 * k], tol);
+        EXPECT_NEAR(2.0 * sin(0.01 * k + 0.5), p[2 * k + 1], tol);
+    }
+    oskar_mem_free(out_d, &status);
+
+    // Keep only every third source, as if clipped by the horizon.
+    int* m = oskar_mem_int(mask, &status);
+    int* idx = oskar_mem_int(indices, &status);
+    int num_out = 0;
+    for (int i = 0; i < sources; ++i)
+    {
+        m[i] = (i % 3 == 0);
+        idx[i] = num_out;
+        num_out += m[i];
+    }
+    oskar_jones_set_size(out, stations, num_out, &status);
+    oskar_jones_interpolate(out, a, b, 0.5, mask, indices, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    out_d = oskar_mem_convert_precision(oskar_jones_mem(out),
+            OSKAR_DOUBLE, &status);
+    p = oskar_mem_double_const(out_d, &status);
+    const int per_source = num_real / 2;
+    for (int s = 0; s < stations; ++s)
+    {
+        for (int i = 0; i < sources; i += 3)
+        {
+            for (int e = 0; e < per_source; ++e)
+            {
+                const int k_in = (s * sources + i) * per_source + e;
+                const int k_out = (s * num_out + idx[i]) * per_source + e;
+                EXPECT_NEAR(2.0 * cos(0.01 * k_in + 0.5), p[2 * k_out], tol);
+                EXPECT_NEAR(2.0 * sin(0.01 * k_in + 0.5),
+                        p[2 * k_out + 1], tol);
+            }
+        }
+    }
+    oskar_mem_free(out_d, &status);
+
+    oskar_mem_free(mask, &status);
+    oskar_mem_free(indices, &status);
+    oskar_jones_free(a, &status);
+    oskar_jones_free(b, &status);
+    oskar_jones_free(out, &status);
+}
+
+TEST(Jones, interpolate_scalar_double)
+{
+    check_interpolate(OSKAR_DOUBLE_COMPLEX, 1e-12);
+}
+
+TEST(Jones, interpolate_matrix_double)
+{
+    check_interpolate(OSKAR_DOUBLE_COMPLEX_MATRIX, 1e-12);
+}
+
+TEST(Jones, interpolate_scalar_single)
+{
+    check_interpolate(OSKAR_SINGLE_COMPLEX, 1e-5);
+}
+
+TEST(Jones, interpolate_matrix_single)
+{
+    check_interpolate(OSKAR_SINGLE_COMPLEX_MATRIX, 1e-5);
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2026, The OSKAR Developers. See LICENSE file. */
+
+/*
+ * Host-only versions of the DFT kernels in define_dftw_c2c.h and
+ * define_dftw_m2m.h, for use without an OpenCL CPU runtime.
+ *
+ * Each thread evaluates a block of output points, and the input elements
+ * are copied in chunks into local arrays so they stay in cache.
+ * The inner loops run over the outputs in the block, which are contiguous
+ * in both the data and output arrays, and are vectorised using the
+ * branch-free sine and cosine in private_sincos_fast.h.
+ * If any phase in a chunk could be outside the range of the fast
+ * functions, the chunk uses sin() and cos() instead.
+ */
+
+#define OSKAR_DFTW_SIMD_BLOCK_OUT 64
+#define OSKAR_DFTW_SIMD_CHUNK_IN 256
+
+#define OSKAR_DFTW_SIMD(NAME, IS_3D, IS_MATRIX, FP, FP2, SINCOS, MAX_ARG)\
+static void NAME(OSKAR_DFTW_C2C_ARGS(FP, FP2))\
+{\
+    int b;\
+    const int num_comp = IS_MATRIX ? 4 : 1;\
+    const int c_start = (IS_MATRIX && !eval_x) ? 2 : 0;\
+    const int c_end = (IS_MATRIX && !eval_y) ? 2 : num_comp;\
+    const int num_blocks = (num_out + OSKAR_DFTW_SIMD_BLOCK_OUT - 1) /\
+            OSKAR_DFTW_SIMD_BLOCK_OUT;\
+    (void) max_in_chunk;\
+    DO_PRAGMA(omp parallel for private(b))\
+    for (b = 0; b < num_blocks; ++b) {\
+        int c, i, j, k;\
+        FP xo[OSKAR_DFTW_SIMD_BLOCK_OUT], yo[OSKAR_DFTW_SIMD_BLOCK_OUT];\
+        FP zo[OSKAR_DFTW_SIMD_BLOCK_OUT];\
+        FP p_re[OSKAR_DFTW_SIMD_BLOCK_OUT], p_im[OSKAR_DFTW_SIMD_BLOCK_OUT];\
+        FP a_re[4][OSKAR_DFTW_SIMD_BLOCK_OUT];\
+        FP a_im[4][OSKAR_DFTW_SIMD_BLOCK_OUT];\
+        FP c_x[OSKAR_DFTW_SIMD_CHUNK_IN], c_y[OSKAR_DFTW_SIMD_CHUNK_IN];\
+        FP c_z[OSKAR_DFTW_SIMD_CHUNK_IN];\
+        FP2 c_w[OSKAR_DFTW_SIMD_CHUNK_IN];\
+        int c_index[OSKAR_DFTW_SIMD_CHUNK_IN];\
+        FP max_out = (FP) 0;\
+        const int o = b * OSKAR_DFTW_SIMD_BLOCK_OUT;\
+        const int n = (num_out - o < OSKAR_DFTW_SIMD_BLOCK_OUT) ?\
+                num_out - o : OSKAR_DFTW_SIMD_BLOCK_OUT;\
+        for (j = 0; j < n; ++j) {\
+            xo[j] = wavenumber * x_out[o + j + offset_coord_out];\
+            yo[j] = wavenumber * y_out[o + j + offset_coord_out];\
+            zo[j] = IS_3D ? wavenumber * z_out[o + j + offset_coord_out] : 0;\
+            const FP r = fabs(xo[j]) + fabs(yo[j]) + fabs(zo[j]);\
+            if (r > max_out) max_out = r;\
+        }\
+        for (c = c_start; c < c_end; ++c) {\
+            for (j = 0; j < n; ++j) a_re[c][j] = a_im[c][j] = (FP) 0;\
+        }\
+        for (k = 0; k < num_in; k += OSKAR_DFTW_SIMD_CHUNK_IN) {\
+            FP max_in = (FP) 0;\
+            const int chunk_size = (num_in - k < OSKAR_DFTW_SIMD_CHUNK_IN) ?\
+                    num_in - k : OSKAR_DFTW_SIMD_CHUNK_IN;\
+            for (i = 0; i < chunk_size; ++i) {\
+                c_w[i] = weights_in[k + i];\
+                c_x[i] = x_in[k + i];\
+                c_y[i] = y_in[k + i];\
+                c_z[i] = IS_3D ? z_in[k + i] : 0;\
+                c_index[i] = data_idx ? data_idx[k + i] : k + i;\
+                if (fabs(c_x[i]) > max_in) max_in = fabs(c_x[i]);\
+                if (fabs(c_y[i]) > max_in) max_in = fabs(c_y[i]);\
+                if (fabs(c_z[i]) > max_in) max_in = fabs(c_z[i]);\
+            }\
+            const int use_libm = !(max_out * max_in <= MAX_ARG);\
+            for (i = 0; i < chunk_size; ++i) {\
+                const FP xi = c_x[i], yi = c_y[i], zi = c_z[i];\
+                const FP2 w = c_w[i];\
+                const FP2* in = data + (size_t) num_comp *\
+                        ((size_t) c_index[i] * num_out + o);\
+                if (use_libm) {\
+                    for (j = 0; j < n; ++j) {\
+                        FP t = xo[j] * xi + yo[j] * yi;\
+                        if (IS_3D) t += zo[j] * zi;\
+                        const FP s = sin(t), co = cos(t);\
+                        p_re[j] = co * w.x - s * w.y;\
+                        p_im[j] = s * w.x + co * w.y;\
+                    }\
+                } else {\
+                    DO_PRAGMA(omp simd)\
+                    for (j = 0; j < n; ++j) {\
+                        FP s, co, t = xo[j] * xi + yo[j] * yi;\
+                        if (IS_3D) t += zo[j] * zi;\
+                        SINCOS(t, &s, &co);\
+                        p_re[j] = co * w.x - s * w.y;\
+                        p_im[j] = s * w.x + co * w.y;\
+                    }\
+                }\
+                for (c = c_start; c < c_end; ++c) {\
+                    FP* RESTRICT acc_re = a_re[c];\
+                    FP* RESTRICT acc_im = a_im[c];\
+                    DO_PRAGMA(omp simd)\
+                    for (j = 0; j < n; ++j) {\
+                        const FP2 d = in[num_comp * j + c];\
+                        acc_re[j] += d.x * p_re[j] - d.y * p_im[j];\
+                        acc_im[j] += d.y * p_re[j] + d.x * p_im[j];\
+                    }\
+                }\
+            }\
+        }\
+        for (c = c_start; c < c_end; ++c) {\
+            for (j = 0; j < n; ++j) {\
+                FP2 t;\
+                t.x = a_re[c][j] * norm_factor;\
+                t.y = a_im[c][j] * norm_factor;\
+                output[num_comp * (o + j + offset_out) + c] = t;\
+            }\
+        }\
+    }\
+}
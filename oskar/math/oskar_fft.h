@@ -97,6 +97,21 @@ void oskar_fft_free(oskar_FFT* h);
 OSKAR_EXPORT
 void oskar_fft_set_ensure_consistent_norm(oskar_FFT* h, int value);
 
+/**
+ * @brief Sets whether the transform is centred on the middle of the grid.
+ *
+ * @details
+ * If set, the data are multiplied by the checkerboard pattern used by
+ * oskar_fftphase() both before and after the transform, so the origin
+ * of both the input and output grids is at the centre.
+ * On the CPU, this is done as part of the transform.
+ *
+ * @param[in] h     Handle to FFT plan.
+ * @param[in] value If true, apply the phase before and after the transform.
+ */
+OSKAR_EXPORT
+void oskar_fft_set_fftphase(oskar_FFT* h, int value);
+
 #ifdef __cplusplus
 }
 #endif
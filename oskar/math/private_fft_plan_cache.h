@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_FFT_PLAN_CACHE_H_
+#define OSKAR_PRIVATE_FFT_PLAN_CACHE_H_
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Returns the FFTPACK twiddle factors and factorisation for a 1D transform
+ * of length n, in the given precision.
+ *
+ * The table is computed on first use, and is then shared by all FFT plans
+ * of the same size and precision, in any thread.
+ * It is owned by the cache, and remains valid until the program exits.
+ * The table must not be modified.
+ */
+void* oskar_fft_plan_cache_wsave(int precision, int n, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
@@ -5,8 +5,11 @@
 
 #include "math/define_dftw_c2c.h"
 #include "math/define_dftw_m2m.h"
+#include "math/define_dftw_simd.h"
 #include "math/define_multiply.h"
+#include "math/oskar_cmath.h"
 #include "math/oskar_dftw.h"
+#include "math/private_sincos_fast.h"
 #include "utility/oskar_device.h"
 #include "utility/oskar_kernel_macros.h"
 #include "utility/oskar_vector_types.h"
@@ -17,15 +20,23 @@
 #define D2  (0 << 1)
 #define MAT (1 << 2)
 
-OSKAR_DFTW_C2C_CPU(dftw_c2c_2d_float, 0, float, float2)
-OSKAR_DFTW_C2C_CPU(dftw_c2c_3d_float, 1, float, float2)
-OSKAR_DFTW_M2M_CPU(dftw_m2m_2d_float, 0, float, float2)
-OSKAR_DFTW_M2M_CPU(dftw_m2m_3d_float, 1, float, float2)
+OSKAR_DFTW_SIMD(dftw_c2c_2d_float, 0, 0, float, float2,
+        oskar_sincos_fast_f, OSKAR_SINCOS_FAST_MAX_ARG_F)
+OSKAR_DFTW_SIMD(dftw_c2c_3d_float, 1, 0, float, float2,
+        oskar_sincos_fast_f, OSKAR_SINCOS_FAST_MAX_ARG_F)
+OSKAR_DFTW_SIMD(dftw_m2m_2d_float, 0, 1, float, float2,
+        oskar_sincos_fast_f, OSKAR_SINCOS_FAST_MAX_ARG_F)
+OSKAR_DFTW_SIMD(dftw_m2m_3d_float, 1, 1, float, float2,
+        oskar_sincos_fast_f, OSKAR_SINCOS_FAST_MAX_ARG_F)
 
-OSKAR_DFTW_C2C_CPU(dftw_c2c_2d_double, 0, double, double2)
-OSKAR_DFTW_C2C_CPU(dftw_c2c_3d_double, 1, double, double2)
-OSKAR_DFTW_M2M_CPU(dftw_m2m_2d_double, 0, double, double2)
-OSKAR_DFTW_M2M_CPU(dftw_m2m_3d_double, 1, double, double2)
+OSKAR_DFTW_SIMD(dftw_c2c_2d_double, 0, 0, double, double2,
+        oskar_sincos_fast_d, OSKAR_SINCOS_FAST_MAX_ARG_D)
+OSKAR_DFTW_SIMD(dftw_c2c_3d_double, 1, 0, double, double2,
+        oskar_sincos_fast_d, OSKAR_SINCOS_FAST_MAX_ARG_D)
+OSKAR_DFTW_SIMD(dftw_m2m_2d_double, 0, 1, double, double2,
+        oskar_sincos_fast_d, OSKAR_SINCOS_FAST_MAX_ARG_D)
+OSKAR_DFTW_SIMD(dftw_m2m_3d_double, 1, 1, double, double2,
+        oskar_sincos_fast_d, OSKAR_SINCOS_FAST_MAX_ARG_D)
 
 static int get_block_size(int num_total)
 {
@@ -11,6 +11,9 @@
 #include "math/oskar_fft.h"
 #include "math/oskar_fftpack_cfft.h"
 #include "math/oskar_fftpack_cfft_f.h"
+#include "math/oskar_fftphase.h"
+#include "math/private_fft_plan_cache.h"
+#include "utility/oskar_kernel_macros.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -19,11 +22,15 @@
 extern "C" {
 #endif
 
+/* Number of adjacent columns transformed together on the CPU. */
+#define COLUMN_BLOCK 16
+
 struct oskar_FFT
 {
     size_t num_cells_total;
-    oskar_Mem *fftpack_work, *fftpack_wsave;
+    void* fftpack_wsave; /* Shared 1D table, owned by the plan cache. */
     int precision, location, num_dim, dim_size, ensure_consistent_norm;
+    int fftphase;
 #ifdef OSKAR_HAVE_CUDA
     cufftHandle cufft_plan;
 #endif
@@ -68,6 +75,88 @@ static void print_cufft_error(cufftResult code)
 }
 #endif
 
+/*
+ * 2D forward transform of a square grid on the CPU, using FFTPACK for
+ * the 1D transforms, which are shared between threads.
+ *
+ * Columns are transformed first, in blocks of adjacent columns, so that
+ * each pass over the block reads contiguous memory. Rows are then
+ * transformed one at a time while they are in cache, and the scaling and
+ * the checkerboard of oskar_fftphase() are applied to each row
+ * straight afterwards. The checkerboard needed before the transform is
+ * applied to each column block just before it is transformed.
+ * Each transform is done in exactly the same way as by
+ * oskar_fftpack_cfft2f(), so the results do not depend on the number
+ * of threads.
+ */
+#define FFT2_CPU(NAME, FP, CFFTMF) \
+static void NAME(const int n, FP* data, FP* wsave, const FP scale,\
+        const int fftphase, int* status)\
+{\
+    int b = 0, iy = 0, num_failed = 0;\
+    const int num_blocks = (n + COLUMN_BLOCK - 1) / COLUMN_BLOCK;\
+    DO_PRAGMA(omp parallel private(b, iy))\
+    {\
+        FP* work = (FP*) malloc(2 * COLUMN_BLOCK * (size_t) n * sizeof(FP));\
+        if (!work)\
+        {\
+            DO_PRAGMA(omp atomic)\
+            num_failed++;\
+        }\
+        /* All threads must agree whether to skip the work-sharing loops. */\
+        DO_PRAGMA(omp barrier)\
+        if (!num_failed)\
+        {\
+            DO_PRAGMA(omp for schedule(static))\
+            for (b = 0; b < num_blocks; ++b)\
+            {\
+                const int x0 = b * COLUMN_BLOCK;\
+                const int lot = (n - x0 < COLUMN_BLOCK) ?\
+                        n - x0 : COLUMN_BLOCK;\
+                if (fftphase)\
+                {\
+                    int ix = 0;\
+                    for (iy = 0; iy < n; ++iy)\
+                    {\
+                        FP* row = data + 2 * ((size_t) iy * n);\
+                        const int ix0 = x0 + ((x0 + iy + 1) & 1);\
+                        for (ix = ix0; ix < x0 + lot; ix += 2)\
+                        {\
+                            row[2 * ix] = -row[2 * ix];\
+                            row[2 * ix + 1] = -row[2 * ix + 1];\
+                        }\
+                    }\
+                }\
+                CFFTMF(lot, 1, n, n, data + 2 * x0, wsave, work);\
+            }\
+            DO_PRAGMA(omp for schedule(static))\
+            for (iy = 0; iy < n; ++iy)\
+            {\
+                int ix = 0;\
+                FP* row = data + 2 * ((size_t) iy * n);\
+                CFFTMF(1, n, n, 1, row, wsave, work);\
+                if (scale != (FP) 1)\
+                {\
+                    for (ix = 0; ix < 2 * n; ++ix) row[ix] *= scale;\
+                }\
+                if (fftphase)\
+                {\
+                    for (ix = (iy + 1) & 1; ix < n; ix += 2)\
+                    {\
+                        row[2 * ix] = -row[2 * ix];\
+                        row[2 * ix + 1] = -row[2 * ix + 1];\
+                    }\
+                }\
+            }\
+        }\
+        free(work);\
+    }\
+    if (num_failed) *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;\
+}
+
+FFT2_CPU(fft2_cpu_double, double, oskar_fftpack_cfftmf)
+FFT2_CPU(fft2_cpu_float, float, oskar_fftpack_cfftmf_f)
+
 oskar_FFT* oskar_fft_create(int precision, int location, int num_dim,
         int dim_size, int batch_size_1d, int* status)
 {
@@ -88,15 +177,12 @@ oskar_FFT* oskar_fft_create(int precision, int location, int num_dim,
     for (i = 1; i < num_dim; ++i) h->num_cells_total *= (size_t) dim_size;
     if (location == OSKAR_CPU || (location & OSKAR_CL))
     {
-        int len = 4 * dim_size +
-                2 * (int)(log((double)dim_size) / log(2.0)) + 8;
         if (location & OSKAR_CL)
         {
             h->location = OSKAR_CPU;
             oskar_log_warning(0,
                     "OpenCL FFT not implemented; using CPU version instead.");
         }
-        h->fftpack_wsave = oskar_mem_create(precision, OSKAR_CPU, len, status);
         if (num_dim == 1)
         {
             (void) batch_size_1d;
@@ -104,23 +190,13 @@ oskar_FFT* oskar_fft_create(int precision, int location, int num_dim,
         }
         else if (num_dim == 2)
         {
-            if (precision == OSKAR_DOUBLE)
-            {
-                oskar_fftpack_cfft2i(dim_size, dim_size,
-                        oskar_mem_double(h->fftpack_wsave, status));
-            }
-            else
-            {
-                oskar_fftpack_cfft2i_f(dim_size, dim_size,
-                        oskar_mem_float(h->fftpack_wsave, status));
-            }
+            h->fftpack_wsave = oskar_fft_plan_cache_wsave(precision,
+                    dim_size, status);
         }
         else
         {
             *status = OSKAR_ERR_INVALID_ARGUMENT;
         }
-        h->fftpack_work = oskar_mem_create(precision, OSKAR_CPU,
-                2 * h->num_cells_total, status);
     }
     else if (location == OSKAR_GPU)
     {
@@ -172,26 +248,21 @@ void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
         }
         else if (h->num_dim == 2)
         {
+            /* This step not needed for W-kernel generation, so turn it off. */
+            const double scale = h->ensure_consistent_norm ?
+                    (double) h->num_cells_total : 1.0;
             if (h->precision == OSKAR_DOUBLE)
             {
-                oskar_fftpack_cfft2f(h->dim_size, h->dim_size, h->dim_size,
+                fft2_cpu_double(h->dim_size,
                         oskar_mem_double(data_ptr, status),
-                        oskar_mem_double(h->fftpack_wsave, status),
-                        oskar_mem_double(h->fftpack_work, status));
+                        (double*) h->fftpack_wsave, scale, h->fftphase, status);
             }
             else
             {
-                oskar_fftpack_cfft2f_f(h->dim_size, h->dim_size, h->dim_size,
+                fft2_cpu_float(h->dim_size,
                         oskar_mem_float(data_ptr, status),
-                        oskar_mem_float(h->fftpack_wsave, status),
-                        oskar_mem_float(h->fftpack_work, status));
-            }
-
-            /* This step not needed for W-kernel generation, so turn it off. */
-            if (h->ensure_consistent_norm)
-            {
-                oskar_mem_scale_real(data_ptr, (double)h->num_cells_total,
-                        0, h->num_cells_total, status);
+                        (float*) h->fftpack_wsave, (float) scale,
+                        h->fftphase, status);
             }
         }
     }
@@ -199,6 +270,10 @@ void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
     {
 #ifdef OSKAR_HAVE_CUDA
         cufftResult cufft_error_code = CUFFT_SUCCESS;
+        if (h->fftphase)
+        {
+            oskar_fftphase(h->dim_size, h->dim_size, data_ptr, status);
+        }
         if (h->precision == OSKAR_DOUBLE)
         {
             cufft_error_code = cufftExecZ2Z(h->cufft_plan,
@@ -218,6 +293,10 @@ void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
             *status = OSKAR_ERR_FFT_FAILED;
             print_cufft_error(cufft_error_code);
         }
+        if (h->fftphase)
+        {
+            oskar_fftphase(h->dim_size, h->dim_size, data_ptr, status);
+        }
 #endif
     }
     else
@@ -233,10 +312,7 @@ void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
 
 void oskar_fft_free(oskar_FFT* h)
 {
-    int status = 0;
     if (!h) return;
-    oskar_mem_free(h->fftpack_work, &status);
-    oskar_mem_free(h->fftpack_wsave, &status);
 #ifdef OSKAR_HAVE_CUDA
     if (h->location == OSKAR_GPU)
     {
@@ -251,6 +327,11 @@ void oskar_fft_set_ensure_consistent_norm(oskar_FFT* h, int value)
     h->ensure_consistent_norm = value;
 }
 
+void oskar_fft_set_fftphase(oskar_FFT* h, int value)
+{
+    h->fftphase = value;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -167,6 +167,19 @@ void oskar_fftpack_cfft2i_f(const int l, const int m, float *wsave)
 }
 
 
+void oskar_fftpack_cfftmf_f(const int lot, const int jump, const int n,
+        const int inc, float *c, float *wsave, float *work)
+{
+    cfftmf(lot, jump, n, inc, c, wsave, work);
+}
+
+
+void oskar_fftpack_cfftmi_f(const int n, float *wsave)
+{
+    cfftmi(n, wsave);
+}
+
+
 void cfftmb(const int lot, const int jump, const int n, const int inc,
         float *c, float *wsave, float *work)
 {
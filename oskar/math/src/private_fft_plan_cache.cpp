@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "math/private_fft_plan_cache.h"
+#include "math/oskar_fftpack_cfft.h"
+#include "math/oskar_fftpack_cfft_f.h"
+#include "mem/oskar_mem.h"
+#include "utility/oskar_thread.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+typedef std::map<std::pair<int, int>, void*> WsaveMap;
+
+struct oskar_FFTPlanCache
+{
+    oskar_Mutex* m;
+    WsaveMap wsave;
+    oskar_FFTPlanCache()  { this->m = oskar_mutex_create(); }
+    ~oskar_FFTPlanCache()
+    {
+        for (WsaveMap::iterator i = wsave.begin(); i != wsave.end(); ++i)
+        {
+            free(i->second);
+        }
+        oskar_mutex_free(this->m);
+    }
+    void lock() const   { oskar_mutex_lock(this->m); }
+    void unlock() const { oskar_mutex_unlock(this->m); }
+};
+static oskar_FFTPlanCache cache_; // NOLINT: This constructor will not throw.
+
+void* oskar_fft_plan_cache_wsave(int precision, int n, int* status)
+{
+    void* wsave = 0;
+    if (*status) return 0;
+    if (n < 1 || (precision != OSKAR_DOUBLE && precision != OSKAR_SINGLE))
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        return 0;
+    }
+    const std::pair<int, int> key(precision, n);
+    cache_.lock();
+    WsaveMap::iterator i = cache_.wsave.find(key);
+    if (i != cache_.wsave.end())
+    {
+        wsave = i->second;
+    }
+    else
+    {
+        /* Twiddle factors, followed by the number of factors and the
+         * factors themselves. */
+        const size_t len = 2 * (size_t) n +
+                (size_t) (log((double) n) / log(2.0)) + 4;
+        if (precision == OSKAR_DOUBLE)
+        {
+            wsave = calloc(len, sizeof(double));
+            if (wsave) oskar_fftpack_cfftmi(n, (double*) wsave);
+        }
+        else
+        {
+            wsave = calloc(len, sizeof(float));
+            if (wsave) oskar_fftpack_cfftmi_f(n, (float*) wsave);
+        }
+        if (wsave)
+        {
+            cache_.wsave[key] = wsave;
+        }
+        else
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        }
+    }
+    cache_.unlock();
+    return wsave;
+}
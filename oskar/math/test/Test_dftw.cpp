@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/define_dftw_c2c.h"
+#include "math/define_dftw_m2m.h"
+#include "math/oskar_cmath.h"
+#include "math/oskar_dftw.h"
+#include "math/private_sincos_fast.h"
+#include "utility/oskar_get_error_string.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+
+#include <algorithm>
+
+// The original CPU kernels, which use sin() and cos().
+OSKAR_DFTW_C2C_CPU(ref_c2c_2d_double, 0, double, double2)
+OSKAR_DFTW_C2C_CPU(ref_c2c_3d_double, 1, double, double2)
+OSKAR_DFTW_M2M_CPU(ref_m2m_2d_double, 0, double, double2)
+OSKAR_DFTW_M2M_CPU(ref_m2m_3d_double, 1, double, double2)
+
+static void check_sincos(double max_arg, double tol_d, double tol_f)
+{
+    const int num = 200001;
+    double max_err_d = 0.0, max_err_f = 0.0;
+    for (int i = 0; i < num; ++i)
+    {
+        double s_d = 0.0, c_d = 0.0;
+        float s_f = 0.0f, c_f = 0.0f;
+        const double x = max_arg * (2.0 * i / (num - 1) - 1.0);
+        oskar_sincos_fast_d(x, &s_d, &c_d);
+        max_err_d = std::max(max_err_d, fabs(s_d - sin(x)));
+        max_err_d = std::max(max_err_d, fabs(c_d - cos(x)));
+        if (max_arg <= OSKAR_SINCOS_FAST_MAX_ARG_F)
+        {
+            const float x_f = (float) x;
+            oskar_sincos_fast_f(x_f, &s_f, &c_f);
+            max_err_f = std::max(max_err_f, fabs(s_f - sin((double) x_f)));
+            max_err_f = std::max(max_err_f, fabs(c_f - cos((double) x_f)));
+        }
+    }
+    EXPECT_LT(max_err_d, tol_d);
+    EXPECT_LE(max_err_f, tol_f);
+}
+
+TEST(dftw, sincos_fast)
+{
+    check_sincos(2.0 * M_PI, 4e-16, 2e-7);
+    check_sincos(OSKAR_SINCOS_FAST_MAX_ARG_F, 4e-16, 2e-7);
+    check_sincos(OSKAR_SINCOS_FAST_MAX_ARG_D, 4e-16, 0.0);
+}
+
+static double max_rel_diff(const oskar_Mem* a, const oskar_Mem* b)
+{
+    int status = 0;
+    double max_diff = 0.0, max_val = 0.0;
+    oskar_Mem* a_ = oskar_mem_convert_precision(a, OSKAR_DOUBLE, &status);
+    oskar_Mem* b_ = oskar_mem_convert_precision(b, OSKAR_DOUBLE, &status);
+    const double* pa = oskar_mem_double_const(a_, &status);
+    const double* pb = oskar_mem_double_const(b_, &status);
+    const size_t n = oskar_mem_length(a) * (oskar_mem_is_matrix(a) ? 8 : 2);
+    for (size_t i = 0; i < n; ++i)
+    {
+        max_diff = std::max(max_diff, fabs(pa[i] - pb[i]));
+        max_val = std::max(max_val, fabs(pb[i]));
+    }
+    oskar_mem_free(a_, &status);
+    oskar_mem_free(b_, &status);
+    return max_diff / max_val;
+}
+
+static void check_dftw(int prec, int matrix, int is_3d, int eval_y,
+        double scale, double tol)
+{
+    int status = 0;
+    const int num_in = 300, num_out = 1000, num_data = 150;
+    const int offset_coord = 7, offset_out = 3;
+    const double wavenumber = 2.0 * M_PI * 100e6 / 299792458.0;
+    const int type = OSKAR_DOUBLE | OSKAR_COMPLEX |
+            (matrix ? OSKAR_MATRIX : 0);
+    oskar_Mem *coords[6], *weights, *data, *idx, *expected, *out;
+    for (int i = 0; i < 6; ++i)
+    {
+        const int num = (i < 3) ? num_in : offset_coord + num_out;
+        coords[i] = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num, &status);
+        oskar_mem_random_uniform(coords[i], i, 1, 2, 3, &status);
+        oskar_mem_add_real(coords[i], -0.5, &status);
+        if (i < 3)
+        {
+            oskar_mem_scale_real(coords[i], scale, 0, num, &status);
+        }
+    }
+    weights = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            num_in, &status);
+    data = oskar_mem_create(type, OSKAR_CPU, num_data * num_out, &status);
+    idx = oskar_mem_create(OSKAR_INT, OSKAR_CPU, num_in, &status);
+    expected = oskar_mem_create(type, OSKAR_CPU,
+            offset_out + num_out, &status);
+    oskar_mem_random_uniform(weights, 4, 5, 6, 7, &status);
+    oskar_mem_random_uniform(data, 8, 9, 10, 11, &status);
+    oskar_mem_clear_contents(expected, &status);
+    int* p_idx = oskar_mem_int(idx, &status);
+    for (int i = 0; i < num_in; ++i) p_idx[i] = (7 * i) % num_data;
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Evaluate the reference in double precision, using the original kernel.
+    const double* c[6];
+    for (int i = 0; i < 6; ++i)
+    {
+        c[i] = oskar_mem_double_const(coords[i], &status);
+    }
+    void (*ref)(OSKAR_DFTW_C2C_ARGS(double, double2)) = matrix ?
+            (is_3d ? ref_m2m_3d_double : ref_m2m_2d_double) :
+            (is_3d ? ref_c2c_3d_double : ref_c2c_2d_double);
+    ref(num_in, wavenumber, oskar_mem_double2_const(weights, &status),
+            c[0], c[1], is_3d ? c[2] : 0, offset_coord, num_out,
+            c[3], c[4], is_3d ? c[5] : 0, p_idx,
+            oskar_mem_double2_const(data, &status), 1, eval_y, offset_out,
+            oskar_mem_double2(expected, &status), 1.0 / num_in, 0);
+
+    // Evaluate using the CPU implementation, at the requested precision.
+    oskar_Mem *coords_p[6], *weights_p, *data_p;
+    for (int i = 0; i < 6; ++i)
+    {
+        coords_p[i] = oskar_mem_convert_precision(coords[i], prec, &status);
+    }
+    weights_p = oskar_mem_convert_precision(weights, prec, &status);
+    data_p = oskar_mem_convert_precision(data, prec, &status);
+    out = oskar_mem_create(oskar_mem_type(data_p), OSKAR_CPU,
+            offset_out + num_out, &status);
+    oskar_mem_clear_contents(out, &status);
+    oskar_dftw(1, num_in, wavenumber, weights_p,
+            coords_p[0], coords_p[1], is_3d ? coords_p[2] : 0,
+            offset_coord, num_out, coords_p[3], coords_p[4],
+            is_3d ? coords_p[5] : 0, idx, data_p, 1, eval_y, offset_out,
+            out, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_LT(max_rel_diff(out, expected), tol);
+
+    for (int i = 0; i < 6; ++i)
+    {
+        oskar_mem_free(coords[i], &status);
+        oskar_mem_free(coords_p[i], &status);
+    }
+    oskar_mem_free(weights, &status);
+    oskar_mem_free(weights_p, &status);
+    oskar_mem_free(data, &status);
+    oskar_mem_free(data_p, &status);
+    oskar_mem_free(idx, &status);
+    oskar_mem_free(expected, &status);
+    oskar_mem_free(out, &status);
+}
+
+TEST(dftw, cpu_scalar_2d)
+{
+    check_dftw(OSKAR_DOUBLE, 0, 0, 1, 40.0, 1e-13);
+    check_dftw(OSKAR_SINGLE, 0, 0, 1, 40.0, 1e-4);
+}
+
+TEST(dftw, cpu_scalar_3d)
+{
+    check_dftw(OSKAR_DOUBLE, 0, 1, 1, 40.0, 1e-13);
+    check_dftw(OSKAR_SINGLE, 0, 1, 1, 40.0, 1e-4);
+}
+
+TEST(dftw, cpu_matrix_2d)
+{
+    check_dftw(OSKAR_DOUBLE, 1, 0, 1, 40.0, 1e-13);
+    check_dftw(OSKAR_SINGLE, 1, 0, 1, 40.0, 1e-4);
+    check_dftw(OSKAR_DOUBLE, 1, 0, 0, 40.0, 1e-13);
+}
+
+TEST(dftw, cpu_matrix_3d)
+{
+    check_dftw(OSKAR_DOUBLE, 1, 1, 1, 40.0, 1e-13);
+    check_dftw(OSKAR_SINGLE, 1, 1, 1, 40.0, 1e-4);
+}
+
+TEST(dftw, cpu_large_phase)
+{
+    // Phases beyond the range of the fast functions use sin() and cos().
+    check_dftw(OSKAR_DOUBLE, 0, 1, 1, 1e6, 1e-12);
+    check_dftw(OSKAR_DOUBLE, 1, 0, 1, 1e6, 1e-12);
+}
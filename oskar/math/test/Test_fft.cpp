@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/oskar_fft.h"
+#include "math/oskar_fftpack_cfft.h"
+#include "math/oskar_fftpack_cfft_f.h"
+#include "math/oskar_fftphase.h"
+#include "utility/oskar_get_error_string.h"
+
+#include <algorithm>
+#include <cmath>
+
+// The original CPU version, which uses separate passes over the grid.
+static void fft_serial(int n, int fftphase, int norm, oskar_Mem* data)
+{
+    int status = 0;
+    const int prec = oskar_mem_precision(data);
+    const int len = 4 * n + 2 * (int)(log((double)n) / log(2.0)) + 8;
+    oskar_Mem* wsave = oskar_mem_create(prec, OSKAR_CPU, len, &status);
+    oskar_Mem* work = oskar_mem_create(prec, OSKAR_CPU,
+            2 * (size_t) n * n, &status);
+    if (fftphase) oskar_fftphase(n, n, data, &status);
+    if (prec == OSKAR_DOUBLE)
+    {
+        oskar_fftpack_cfft2i(n, n, oskar_mem_double(wsave, &status));
+        oskar_fftpack_cfft2f(n, n, n, oskar_mem_double(data, &status),
+                oskar_mem_double(wsave, &status),
+                oskar_mem_double(work, &status));
+    }
+    else
+    {
+        oskar_fftpack_cfft2i_f(n, n, oskar_mem_float(wsave, &status));
+        oskar_fftpack_cfft2f_f(n, n, n, oskar_mem_float(data, &status),
+                oskar_mem_float(wsave, &status),
+                oskar_mem_float(work, &status));
+    }
+    if (norm)
+    {
+        oskar_mem_scale_real(data, (double) n * n, 0, (size_t) n * n,
+                &status);
+    }
+    if (fftphase) oskar_fftphase(n, n, data, &status);
+    oskar_mem_free(wsave, &status);
+    oskar_mem_free(work, &status);
+}
+
+static void check_fft(int prec, int n, int fftphase, int norm)
+{
+    int status = 0;
+    oskar_Mem* data = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+            (size_t) n * n, &status);
+    oskar_mem_random_uniform(data, 1, 2, 3, 4, &status);
+    oskar_Mem* expected = oskar_mem_create_copy(data, OSKAR_CPU, &status);
+    fft_serial(n, fftphase, norm, expected);
+    oskar_FFT* fft = oskar_fft_create(prec, OSKAR_CPU, 2, n, 0, &status);
+    oskar_fft_set_fftphase(fft, fftphase);
+    oskar_fft_set_ensure_consistent_norm(fft, norm);
+    oskar_fft_exec(fft, data, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_EQ(0, oskar_mem_different(data, expected, 0, &status))
+            << "n = " << n;
+    oskar_fft_free(fft);
+    oskar_mem_free(data, &status);
+    oskar_mem_free(expected, &status);
+}
+
+TEST(fft, cpu_matches_serial)
+{
+    const int sizes[] = {16, 17, 64, 90, 100, 256};
+    for (int i = 0; i < (int) (sizeof(sizes) / sizeof(int)); ++i)
+    {
+        check_fft(OSKAR_DOUBLE, sizes[i], 1, 1);
+        check_fft(OSKAR_DOUBLE, sizes[i], 0, 1);
+        check_fft(OSKAR_DOUBLE, sizes[i], 0, 0);
+        check_fft(OSKAR_SINGLE, sizes[i], 1, 1);
+        check_fft(OSKAR_SINGLE, sizes[i], 0, 0);
+    }
+}
+
+TEST(fft, centred_delta)
+{
+    // With the phase applied, a delta function at the centre of the grid
+    // transforms to a constant.
+    int status = 0;
+    const int n = 128;
+    oskar_Mem* data = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            (size_t) n * n, &status);
+    oskar_mem_clear_contents(data, &status);
+    double* d = oskar_mem_double(data, &status);
+    d[2 * (n / 2 * n + n / 2)] = 1.0;
+    oskar_FFT* fft = oskar_fft_create(OSKAR_DOUBLE, OSKAR_CPU, 2, n, 0,
+            &status);
+    oskar_fft_set_fftphase(fft, 1);
+    oskar_fft_exec(fft, data, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    double max_err = 0.0;
+    for (int i = 0; i < n * n; ++i)
+    {
+        max_err = std::max(max_err, fabs(d[2 * i] - 1.0));
+        max_err = std::max(max_err, fabs(d[2 * i + 1]));
+    }
+    EXPECT_LT(max_err, 1e-12);
+    oskar_fft_free(fft);
+    oskar_mem_free(data, &status);
+}
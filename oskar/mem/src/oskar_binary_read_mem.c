@@ -5,6 +5,7 @@
 
 #include "mem/oskar_binary_read_mem.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
@@ -17,9 +18,10 @@ void oskar_binary_read_mem(oskar_Binary* handle, oskar_Mem* mem,
         unsigned char id_group, unsigned char id_tag, int user_index,
         int* status)
 {
-    int type = 0;
+    int type = 0, chunk_index = 0;
     oskar_Mem *temp = 0, *data = 0;
     size_t size_bytes = 0, element_size = 0;
+    const void* view = 0;
 
     /* Check if safe to proceed. */
     if (*status) return;
@@ -35,15 +37,30 @@ void oskar_binary_read_mem(oskar_Binary* handle, oskar_Mem* mem,
 
     /* Query the tag index to find out how big the block is. */
     element_size = oskar_mem_element_size(type);
-    oskar_binary_query(handle, (unsigned char)type,
+    chunk_index = oskar_binary_query(handle, (unsigned char)type,
             id_group, id_tag, user_index, &size_bytes, status);
 
-    /* Resize memory block if necessary, so that it can hold the data. */
-    oskar_mem_realloc(data, size_bytes / element_size, status);
+    /* If copying to GPU memory, try to copy straight from the file. */
+    if (data == temp)
+    {
+        view = oskar_binary_read_block_view(handle, chunk_index, status);
+    }
+    if (view)
+    {
+        /* The alias is only used as the source of the copy. */
+        oskar_mem_free(temp, status);
+        temp = oskar_mem_create_alias_from_raw((void*) (uintptr_t) view, type,
+                OSKAR_CPU, size_bytes / element_size, status);
+    }
+    else
+    {
+        /* Resize memory block if necessary, so that it can hold the data. */
+        oskar_mem_realloc(data, size_bytes / element_size, status);
 
-    /* Load the memory. */
-    oskar_binary_read(handle, (unsigned char)type, id_group, id_tag,
-            user_index, size_bytes, oskar_mem_void(data), status);
+        /* Load the memory. */
+        oskar_binary_read_block(handle, chunk_index,
+                size_bytes, oskar_mem_void(data), status);
+    }
 
     /* Copy to GPU memory if required. */
     if (oskar_mem_location(mem) != OSKAR_CPU)
@@ -18,14 +18,18 @@ extern "C" {
 
 void oskar_mem_free(oskar_Mem* mem, int* status)
 {
+    int ref_count = 0;
+
     /* Will be safe to call with null pointers. */
     if (!mem) return;
 
-    /* Decrement reference count and return if there are still references. */
+    /* Decrement reference count and return if there are still references.
+     * The count must be read while locked, as another thread may be
+     * releasing the last reference at the same time. */
     oskar_mutex_lock(mem->mutex);
-    mem->ref_count--;
+    ref_count = --mem->ref_count;
     oskar_mutex_unlock(mem->mutex);
-    if (mem->ref_count > 0)
+    if (ref_count > 0)
     {
         return;
     }
@@ -173,6 +173,78 @@ void oskar_ms_write_vis_f(oskar_MeasurementSet* p,
         unsigned int num_channels, unsigned int num_baselines,
         const float* vis);
 
+/**
+ * @details
+ * Returns a staging buffer for baseline coordinates.
+ *
+ * @details
+ * Returns a buffer owned by the Measurement Set, large enough to hold
+ * three double-precision values for each of \p num_rows rows.
+ * The buffer is reused and enlarged as required by later calls, so it
+ * does not need to be allocated for each block of data written.
+ * It can be used to assemble the \p uu, \p vv and \p ww arrays passed to
+ * oskar_ms_write_coords_d().
+ *
+ * Returns NULL if the buffer could not be allocated.
+ *
+ * @param[in] num_rows      Number of rows required.
+ */
+OSKAR_MS_EXPORT
+double* oskar_ms_coord_buffer(oskar_MeasurementSet* p, unsigned int num_rows);
+
+/**
+ * @details
+ * Returns a staging buffer for visibility data in Measurement Set order.
+ *
+ * @details
+ * Returns a buffer owned by the Measurement Set, large enough to hold
+ * the single-precision complex visibility data for \p num_rows rows
+ * and \p num_channels channels, for all polarisations in the
+ * Measurement Set. The buffer is reused and enlarged as required by
+ * later calls, so it does not need to be allocated for each block of
+ * data written.
+ *
+ * Data in the buffer can be written using oskar_ms_write_vis_rows_f().
+ * The buffer is also used by oskar_ms_write_vis_d() and
+ * oskar_ms_write_vis_f().
+ *
+ * Returns NULL if the buffer could not be allocated.
+ *
+ * @param[in] num_rows      Number of rows required.
+ * @param[in] num_channels  Number of channels required.
+ */
+OSKAR_MS_EXPORT
+float* oskar_ms_vis_buffer(oskar_MeasurementSet* p, unsigned int num_rows,
+        unsigned int num_channels);
+
+/**
+ * @details
+ * Writes visibility data in Measurement Set order to the main table.
+ *
+ * @details
+ * This function writes the given block of visibility data to the
+ * data column of the Measurement Set, extending it if necessary.
+ * The data are written in place, with a single call to casacore,
+ * so any number of rows (for example, all the baselines for a block
+ * of time samples) can be written at once.
+ *
+ * The dimensionality of the complex \p vis data block is:
+ * (num_rows * num_channels * num_pols),
+ * with num_pols the fastest varying dimension, then num_channels,
+ * and num_rows the slowest. This is the order used by the Measurement Set,
+ * so the data do not need to be transposed.
+ *
+ * @param[in] start_row     The start row index to write (zero-based).
+ * @param[in] start_channel The start channel index of the visibility block.
+ * @param[in] num_channels  The number of channels in the visibility block.
+ * @param[in] num_rows      The number of rows in the visibility block.
+ * @param[in] vis           Pointer to complex visibility block.
+ */
+OSKAR_MS_EXPORT
+void oskar_ms_write_vis_rows_f(oskar_MeasurementSet* p,
+        unsigned int start_row, unsigned int start_channel,
+        unsigned int num_channels, unsigned int num_rows, const float* vis);
+
 #ifdef __cplusplus
 }
 #endif
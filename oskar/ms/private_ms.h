@@ -32,6 +32,10 @@ struct oskar_MeasurementSet
 #endif
     char* app_name;
     unsigned int *a1, *a2;
+    float* vis_buffer;     // Staging buffer for visibility data.
+    double* coord_buffer;  // Staging buffer for baseline coordinates.
+    double* uvw_buffer;    // Interleaved coordinates, used when writing.
+    size_t vis_buffer_size, coord_buffer_size, uvw_buffer_size;
     unsigned int num_pols, num_channels, num_stations, num_receptors;
     int data_written;
     int phase_centre_type;
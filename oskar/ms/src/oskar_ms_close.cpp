@@ -27,6 +27,9 @@ void oskar_ms_close(oskar_MeasurementSet* p)
     }
     free(p->a1);
     free(p->a2);
+    free(p->vis_buffer);
+    free(p->coord_buffer);
+    free(p->uvw_buffer);
     free(p->app_name);
     free(p);
 }
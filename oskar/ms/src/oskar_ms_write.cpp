@@ -9,6 +9,8 @@
 #include <tables/Tables.h>
 #include <casa/Arrays/Vector.h>
 
+#include <cstdlib>
+
 using namespace casacore;
 
 static void oskar_ms_create_baseline_indices(oskar_MeasurementSet* p,
@@ -61,16 +63,42 @@ static void oskar_ms_create_baseline_indices(oskar_MeasurementSet* p,
     }
 }
 
+static void* oskar_ms_buffer(void* buffer, size_t* size, size_t required)
+{
+    if (required > *size)
+    {
+        void* t = realloc(buffer, required);
+        if (!t) return 0;
+        buffer = t;
+        *size = required;
+    }
+    return buffer;
+}
+
+double* oskar_ms_coord_buffer(oskar_MeasurementSet* p, unsigned int num_rows)
+{
+    void* t = oskar_ms_buffer(p->coord_buffer, &p->coord_buffer_size,
+            3 * (size_t) num_rows * sizeof(double));
+    if (t) p->coord_buffer = (double*) t;
+    return (double*) t;
+}
+
+float* oskar_ms_vis_buffer(oskar_MeasurementSet* p, unsigned int num_rows,
+        unsigned int num_channels)
+{
+    void* t = oskar_ms_buffer(p->vis_buffer, &p->vis_buffer_size,
+            2 * (size_t) p->num_pols * num_channels * num_rows *
+            sizeof(float));
+    if (t) p->vis_buffer = (float*) t;
+    return (float*) t;
+}
+
 template <typename T>
 void oskar_ms_write_coords(oskar_MeasurementSet* p,
         unsigned int start_row, unsigned int num_baselines,
         const T* uu, const T* vv, const T* ww,
         double exposure_sec, double interval_sec, double time_stamp)
 {
-    // Allocate storage for a (u,v,w) coordinate and a visibility weight.
-    Vector<Double> uvw(3);
-    Vector<Float> weight(p->num_pols, 1.0), sigma(p->num_pols, 1.0);
-
     // Get references to columns.
 #ifdef OSKAR_MS_NEW
     ArrayColumn<Double>& col_uvw = p->msmc.uvw;
@@ -105,22 +133,40 @@ void oskar_ms_write_coords(oskar_MeasurementSet* p,
         oskar_ms_create_baseline_indices(p, num_baselines);
     }
 
-    // Loop over rows to add.
+    // Interleave the (u,v,w) coordinates in a buffer that is kept
+    // between calls, and use it in place when writing the column.
+    // The antenna indices are also used in place.
+    double* uvw_data = (double*) oskar_ms_buffer(p->uvw_buffer,
+            &p->uvw_buffer_size, 3 * (size_t) num_baselines * sizeof(double));
+    if (!uvw_data) return;
+    p->uvw_buffer = uvw_data;
     for (unsigned int r = 0; r < num_baselines; ++r)
     {
-        // Write the data to the Measurement Set.
-        unsigned int row = r + start_row;
-        uvw(0) = uu[r]; uvw(1) = vv[r]; uvw(2) = ww[r];
-        col_uvw.put(row, uvw);
-        col_antenna1.put(row, p->a1[r]);
-        col_antenna2.put(row, p->a2[r]);
-        col_weight.put(row, weight);
-        col_sigma.put(row, sigma);
-        col_exposure.put(row, exposure_sec);
-        col_interval.put(row, interval_sec);
-        col_time.put(row, time_stamp);
-        col_timeCentroid.put(row, time_stamp);
+        uvw_data[3 * r + 0] = uu[r];
+        uvw_data[3 * r + 1] = vv[r];
+        uvw_data[3 * r + 2] = ww[r];
     }
+    Array<Double> uvw(IPosition(2, 3, num_baselines), uvw_data, SHARE);
+    Vector<Int> antenna1(IPosition(1, num_baselines),
+            reinterpret_cast<Int*>(p->a1), SHARE);
+    Vector<Int> antenna2(IPosition(1, num_baselines),
+            reinterpret_cast<Int*>(p->a2), SHARE);
+    Array<Float> weight(IPosition(2, p->num_pols, num_baselines), 1.0f);
+    Vector<Double> exposure(num_baselines, exposure_sec);
+    Vector<Double> interval(num_baselines, interval_sec);
+    Vector<Double> time(num_baselines, time_stamp);
+
+    // Write all the rows with one call per column.
+    Slicer row_range(IPosition(1, start_row), IPosition(1, num_baselines));
+    col_uvw.putColumnRange(row_range, uvw);
+    col_antenna1.putColumnRange(row_range, antenna1);
+    col_antenna2.putColumnRange(row_range, antenna2);
+    col_weight.putColumnRange(row_range, weight);
+    col_sigma.putColumnRange(row_range, weight);
+    col_exposure.putColumnRange(row_range, exposure);
+    col_interval.putColumnRange(row_range, interval);
+    col_time.putColumnRange(row_range, time);
+    col_timeCentroid.putColumnRange(row_range, time);
 
     // Update time range if required.
     if (time_stamp < p->start_time)
@@ -158,47 +204,35 @@ void oskar_ms_write_vis(oskar_MeasurementSet* p,
         unsigned int start_row, unsigned int start_channel,
         unsigned int num_channels, unsigned int num_baselines, const T* vis)
 {
-    // Allocate storage for the block of visibility data.
-    unsigned int num_pols = p->num_pols;
-    IPosition shape(3, num_pols, num_channels, num_baselines);
-    Array<Complex> vis_data(shape);
-
-    // Copy visibility data into the array,
+    // Copy visibility data into the staging buffer,
     // swapping baseline and channel dimensions.
-    float* out = (float*) vis_data.data();
-    for (unsigned int c = 0; c < num_channels; ++c)
+    // Baselines are done in tiles so that the output stays in cache.
+    const unsigned int tile_size = 64;
+    const unsigned int num_pols = p->num_pols;
+    float* out = oskar_ms_vis_buffer(p, num_baselines, num_channels);
+    if (!out) return;
+    for (unsigned int b0 = 0; b0 < num_baselines; b0 += tile_size)
     {
-        for (unsigned int b = 0; b < num_baselines; ++b)
+        const unsigned int b1 = (b0 + tile_size < num_baselines) ?
+                b0 + tile_size : num_baselines;
+        for (unsigned int c = 0; c < num_channels; ++c)
         {
-            for (unsigned int p = 0; p < num_pols; ++p)
+            for (unsigned int b = b0; b < b1; ++b)
             {
-                unsigned int i = (num_pols * (c * num_baselines + b) + p) << 1;
-                unsigned int j = (num_pols * (b * num_channels + c) + p) << 1;
-                out[j]     = vis[i];
-                out[j + 1] = vis[i + 1];
+                for (unsigned int pol = 0; pol < num_pols; ++pol)
+                {
+                    size_t i = (num_pols * ((size_t) c * num_baselines + b)
+                            + pol) << 1;
+                    size_t j = (num_pols * ((size_t) b * num_channels + c)
+                            + pol) << 1;
+                    out[j]     = vis[i];
+                    out[j + 1] = vis[i + 1];
+                }
             }
         }
     }
-
-    // Add new rows if required.
-    oskar_ms_ensure_num_rows(p, start_row + num_baselines);
-
-    // Create the slicers for the column.
-    IPosition start1(1, start_row);
-    IPosition length1(1, num_baselines);
-    Slicer row_range(start1, length1);
-    IPosition start2(2, 0, start_channel);
-    IPosition length2(2, num_pols, num_channels);
-    Slicer array_section(start2, length2);
-
-    // Write visibilities to DATA column.
-#ifdef OSKAR_MS_NEW
-    ArrayColumn<Complex>& col_data = p->msmc.data;
-#else
-    ArrayColumn<Complex>& col_data = p->msmc->data();
-#endif
-    col_data.putColumnRange(row_range, array_section, vis_data);
-    p->data_written = 1;
+    oskar_ms_write_vis_rows_f(p, start_row, start_channel,
+            num_channels, num_baselines, out);
 }
 
 void oskar_ms_write_vis_d(oskar_MeasurementSet* p,
@@ -218,3 +252,33 @@ void oskar_ms_write_vis_f(oskar_MeasurementSet* p,
     oskar_ms_write_vis(p, start_row, start_channel,
             num_channels, num_baselines, vis);
 }
+
+void oskar_ms_write_vis_rows_f(oskar_MeasurementSet* p,
+        unsigned int start_row, unsigned int start_channel,
+        unsigned int num_channels, unsigned int num_rows, const float* vis)
+{
+    // Use the visibility data in place, without copying it.
+    IPosition shape(3, p->num_pols, num_channels, num_rows);
+    const Array<Complex> vis_data(shape,
+            reinterpret_cast<Complex*>(const_cast<float*>(vis)), SHARE);
+
+    // Add new rows if required.
+    oskar_ms_ensure_num_rows(p, start_row + num_rows);
+
+    // Create the slicers for the column.
+    IPosition start1(1, start_row);
+    IPosition length1(1, num_rows);
+    Slicer row_range(start1, length1);
+    IPosition start2(2, 0, start_channel);
+    IPosition length2(2, p->num_pols, num_channels);
+    Slicer array_section(start2, length2);
+
+    // Write visibilities to DATA column.
+#ifdef OSKAR_MS_NEW
+    ArrayColumn<Complex>& col_data = p->msmc.data;
+#else
+    ArrayColumn<Complex>& col_data = p->msmc->data();
+#endif
+    col_data.putColumnRange(row_range, array_section, vis_data);
+    p->data_written = 1;
+}
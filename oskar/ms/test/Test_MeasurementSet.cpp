@@ -161,3 +161,213 @@ TEST(MeasurementSet, test_multi_channel)
     free(uvw);
     oskar_ms_close(ms);
 }
+
+
+template <typename T>
+static std::vector<T> read_column(const oskar_MeasurementSet* ms,
+        const char* column, unsigned int num_rows, size_t values_per_row,
+        int* status)
+{
+    // The vector is shrunk to the size actually returned.
+    std::vector<T> data(num_rows * values_per_row);
+    size_t required_size = 0;
+    oskar_ms_read_column(ms, column, 0, num_rows, data.size() * sizeof(T),
+            &data[0], &required_size, status);
+    if (required_size < data.size() * sizeof(T))
+    {
+        data.resize(required_size / sizeof(T));
+    }
+    return data;
+}
+
+
+TEST(MeasurementSet, test_write_vis_rows)
+{
+    int status = 0;
+
+    // Define the data dimensions.
+    // Blocks have different numbers of time samples,
+    // so the staging buffers must grow and then be reused.
+    const int n_ant = 4;
+    const int n_pol = 4;
+    const int n_chan = 3;
+    const int n_baselines = n_ant * (n_ant - 1) / 2;
+    const int block_times[] = {2, 5, 1, 3};
+    const int n_blocks = sizeof(block_times) / sizeof(int);
+    int n_times = 0;
+    for (int i = 0; i < n_blocks; ++i) n_times += block_times[i];
+    const unsigned int n_rows = n_times * n_baselines;
+    const double exposure = 90.0, interval = 90.0;
+
+    // Create one Measurement Set written a block at a time using the
+    // staging buffers, and one written a time step at a time
+    // with the data in channel order, as before.
+    std::vector<double> ax(n_ant), ay(n_ant), az(n_ant);
+    for (int i = 0; i < n_ant; ++i)
+    {
+        ax[i] = i / 10.0;
+        ay[i] = i / 20.0;
+        az[i] = i / 30.0;
+    }
+    oskar_MeasurementSet* ms = oskar_ms_create("write_vis_rows.ms", "test",
+            n_ant, n_chan, n_pol, 400e6, 25e3, 0, 1);
+    oskar_MeasurementSet* ms_ref = oskar_ms_create("write_vis_ref.ms",
+            "test", n_ant, n_chan, n_pol, 400e6, 25e3, 0, 1);
+    ASSERT_TRUE(ms);
+    ASSERT_TRUE(ms_ref);
+    oskar_ms_set_phase_centre(ms, 0, 0.0, 1.570796);
+    oskar_ms_set_phase_centre(ms_ref, 0, 0.0, 1.570796);
+    oskar_ms_set_station_coords_d(ms, n_ant, &ax[0], &ay[0], &az[0]);
+    oskar_ms_set_station_coords_d(ms_ref, n_ant, &ax[0], &ay[0], &az[0]);
+
+    // Write the blocks.
+    float* largest_vis_buffer = 0;
+    double* largest_coord_buffer = 0;
+    std::vector<float> vis_ref(2 * n_pol * n_chan * n_baselines);
+    for (int i = 0, t0 = 0; i < n_blocks; t0 += block_times[i++])
+    {
+        // Get the staging buffers.
+        const unsigned int num_rows = block_times[i] * n_baselines;
+        float* vis = oskar_ms_vis_buffer(ms, num_rows, n_chan);
+        double* coords = oskar_ms_coord_buffer(ms, n_baselines);
+        ASSERT_TRUE(vis != NULL);
+        ASSERT_TRUE(coords != NULL);
+        if (i == 1)
+        {
+            largest_vis_buffer = vis;
+            largest_coord_buffer = coords;
+        }
+        else if (i > 1)
+        {
+            // Smaller blocks must reuse the largest buffers.
+            EXPECT_EQ(largest_vis_buffer, vis);
+            EXPECT_EQ(largest_coord_buffer, coords);
+        }
+
+        // Fill the visibility data in Measurement Set order,
+        // and write the whole block with one call.
+        for (unsigned int r = 0; r < num_rows; ++r)
+        {
+            const int row = t0 * n_baselines + r;
+            for (int c = 0; c < n_chan; ++c)
+            {
+                for (int p = 0; p < n_pol; ++p)
+                {
+                    const int vi = (r * n_chan + c) * n_pol + p;
+                    vis[2 * vi] = (float) ((p + 1) * (c + 1));
+                    vis[2 * vi + 1] = (float) row;
+                }
+            }
+        }
+        oskar_ms_write_vis_rows_f(ms, t0 * n_baselines, 0, n_chan,
+                num_rows, vis);
+
+        // Write the coordinates for each time step in the block.
+        for (int t = t0; t < t0 + block_times[i]; ++t)
+        {
+            double *uu = coords, *vv = coords + n_baselines;
+            double *ww = coords + 2 * n_baselines;
+            for (int b = 0; b < n_baselines; ++b)
+            {
+                uu[b] = 10.0 * (t + 1) + b;
+                vv[b] = 100.0 * (t + 1) + b;
+                ww[b] = 1000.0 * (t + 1) + b;
+            }
+            oskar_ms_write_coords_d(ms, t * n_baselines, n_baselines,
+                    uu, vv, ww, exposure, interval, (double) t);
+            oskar_ms_write_coords_d(ms_ref, t * n_baselines, n_baselines,
+                    uu, vv, ww, exposure, interval, (double) t);
+
+            // Write the same data a time step at a time, in channel order.
+            for (int c = 0; c < n_chan; ++c)
+            {
+                for (int b = 0; b < n_baselines; ++b)
+                {
+                    for (int p = 0; p < n_pol; ++p)
+                    {
+                        const int vi = (c * n_baselines + b) * n_pol + p;
+                        vis_ref[2 * vi] = (float) ((p + 1) * (c + 1));
+                        vis_ref[2 * vi + 1] = (float) (t * n_baselines + b);
+                    }
+                }
+            }
+            oskar_ms_write_vis_f(ms_ref, t * n_baselines, 0, n_chan,
+                    n_baselines, &vis_ref[0]);
+        }
+    }
+    ASSERT_EQ(n_rows, oskar_ms_num_rows(ms));
+    ASSERT_EQ(n_rows, oskar_ms_num_rows(ms_ref));
+
+    // Read the columns back from both Measurement Sets.
+    std::vector<float> data = read_column<float>(ms, "DATA", n_rows,
+            2 * n_pol * n_chan, &status);
+    std::vector<float> data_ref = read_column<float>(ms_ref, "DATA", n_rows,
+            2 * n_pol * n_chan, &status);
+    std::vector<double> uvw = read_column<double>(ms, "UVW", n_rows,
+            3, &status);
+    std::vector<double> uvw_ref = read_column<double>(ms_ref, "UVW", n_rows,
+            3, &status);
+    std::vector<int> ant1 = read_column<int>(ms, "ANTENNA1", n_rows,
+            1, &status);
+    std::vector<int> ant1_ref = read_column<int>(ms_ref, "ANTENNA1", n_rows,
+            1, &status);
+    std::vector<int> ant2 = read_column<int>(ms, "ANTENNA2", n_rows,
+            1, &status);
+    std::vector<int> ant2_ref = read_column<int>(ms_ref, "ANTENNA2", n_rows,
+            1, &status);
+    std::vector<double> time = read_column<double>(ms, "TIME", n_rows,
+            1, &status);
+    std::vector<double> time_ref = read_column<double>(ms_ref, "TIME", n_rows,
+            1, &status);
+    std::vector<float> sigma = read_column<float>(ms, "SIGMA", n_rows,
+            n_pol, &status);
+    std::vector<float> sigma_ref = read_column<float>(ms_ref, "SIGMA",
+            n_rows, n_pol, &status);
+    ASSERT_EQ(0, status);
+
+    // Check that both are the same.
+    EXPECT_TRUE(data == data_ref);
+    EXPECT_TRUE(uvw == uvw_ref);
+    EXPECT_TRUE(ant1 == ant1_ref);
+    EXPECT_TRUE(ant2 == ant2_ref);
+    EXPECT_TRUE(time == time_ref);
+    EXPECT_TRUE(sigma == sigma_ref);
+
+    // Check the values.
+    ASSERT_EQ(2 * n_pol * n_chan * n_rows, data.size());
+    ASSERT_EQ(3 * n_rows, uvw.size());
+    ASSERT_EQ(n_rows, ant1.size());
+    ASSERT_EQ(n_rows, ant2.size());
+    ASSERT_EQ(n_rows, time.size());
+    ASSERT_EQ(n_pol * n_rows, sigma.size());
+    for (int t = 0, r = 0; t < n_times; ++t)
+    {
+        for (int ai = 0, b = 0; ai < n_ant; ++ai)
+        {
+            for (int aj = ai + 1; aj < n_ant; ++b, ++aj, ++r)
+            {
+                ASSERT_EQ(10.0 * (t + 1) + b, uvw[3 * r + 0]);
+                ASSERT_EQ(100.0 * (t + 1) + b, uvw[3 * r + 1]);
+                ASSERT_EQ(1000.0 * (t + 1) + b, uvw[3 * r + 2]);
+                ASSERT_EQ(ai, ant1[r]);
+                ASSERT_EQ(aj, ant2[r]);
+                ASSERT_EQ((double) t, time[r]);
+                for (int c = 0; c < n_chan; ++c)
+                {
+                    for (int p = 0; p < n_pol; ++p)
+                    {
+                        const int vi = (r * n_chan + c) * n_pol + p;
+                        ASSERT_EQ((float) ((p + 1) * (c + 1)), data[2 * vi]);
+                        ASSERT_EQ((float) r, data[2 * vi + 1]);
+                    }
+                }
+                for (int p = 0; p < n_pol; ++p)
+                {
+                    ASSERT_EQ(1.0f, sigma[r * n_pol + p]);
+                }
+            }
+        }
+    }
+    oskar_ms_close(ms);
+    oskar_ms_close(ms_ref);
+}
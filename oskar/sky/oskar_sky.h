@@ -62,9 +62,16 @@ enum OSKAR_SKY_TAGS
     OSKAR_SKY_TAG_FWHM_MAJOR = 11,
     OSKAR_SKY_TAG_FWHM_MINOR = 12,
     OSKAR_SKY_TAG_POSITION_ANGLE = 13,
-    OSKAR_SKY_TAG_ROTATION_MEASURE = 14
+    OSKAR_SKY_TAG_ROTATION_MEASURE = 14,
+    OSKAR_SKY_TAG_FORMAT_VERSION = 15,
+    OSKAR_SKY_TAG_COLUMNS = 16,
+    OSKAR_SKY_TAG_COLUMN_RANGE = 17
 };
 
+/* Bit flag used to select a column by its tag, in a column mask. */
+#define OSKAR_SKY_COLUMN(TAG) (1 << (TAG))
+#define OSKAR_SKY_COLUMNS_ALL (-1)
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,6 +104,7 @@ enum OSKAR_SKY_TAGS
 #include <sky/oskar_sky_set_gaussian_parameters.h>
 #include <sky/oskar_sky_set_source.h>
 #include <sky/oskar_sky_set_spectral_index.h>
+#include <sky/oskar_sky_sort_spatially.h>
 #include <sky/oskar_sky_write.h>
 
 
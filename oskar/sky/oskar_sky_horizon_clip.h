@@ -60,6 +60,52 @@ void oskar_sky_horizon_clip(oskar_Sky* out, const oskar_Sky* in,
         const oskar_Telescope* telescope, double gast,
         oskar_StationWork* work, int* status);
 
+/**
+ * @brief
+ * Finds a cap on the sky that contains all the sources in a sky model.
+ *
+ * @details
+ * The first three elements of \p cap are set to the unit vector at the
+ * centre of the cap, in the frame of the relative direction cosines
+ * (l, m, n) of the sky model, and the last element is set to the angular
+ * radius of the cap in radians. The relative directions of the sources
+ * must already have been evaluated.
+ *
+ * The radius is negative if the sky model is empty.
+ *
+ * @param[in]  sky          The sky model, in CPU memory.
+ * @param[out] cap          The bounding cap (four elements).
+ * @param[in,out]  status   Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_bounding_cap(const oskar_Sky* sky, double cap[4], int* status);
+
+/**
+ * @brief
+ * Tests whether a bounding cap is above or below the horizon.
+ *
+ * @details
+ * Uses a cap from oskar_sky_bounding_cap() to find whether
+ * oskar_sky_horizon_clip() would keep all or none of the sources in the sky
+ * model, without testing each source.
+ *
+ * The test is conservative: sources within a small margin of the horizon
+ * of any station always need to be tested individually.
+ *
+ * @param[in]  cap          The bounding cap of the sky model.
+ * @param[in]  ra0_rad      Reference right ascension of the sky model.
+ * @param[in]  dec0_rad     Reference declination of the sky model.
+ * @param[in]  telescope    The telescope model.
+ * @param[in]  gast         The Greenwich apparent sidereal time, in radians.
+ *
+ * @return 1 if the whole cap is above the horizon of at least one station,
+ * 0 if the whole cap is below the horizon of every station,
+ * or -1 otherwise.
+ */
+OSKAR_EXPORT
+int oskar_sky_horizon_cap_test(const double cap[4], double ra0_rad,
+        double dec0_rad, const oskar_Telescope* telescope, double gast);
+
 #ifdef __cplusplus
 }
 #endif
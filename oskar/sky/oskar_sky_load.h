@@ -81,8 +81,14 @@ extern "C" {
  * - Lines containing 11 columns set the first 8 parameters and the Gaussian
  *   source data (old file format).
  * - Lines containing 12 columns set all source parameters (new file format).
- * - Lines containing 10 or 13 or more columns set the status flag to
- *   indicate an error, and abort the load.
+ * - Lines containing 10 columns, or fewer than 3, are skipped.
+ *
+ * Lines that are skipped but are not blank or comments are reported in a
+ * single warning message, which gives the number of these lines and the
+ * line number of the first one.
+ *
+ * The file is mapped into memory and split into blocks of complete lines,
+ * which are parsed in parallel using all available OpenMP threads.
  *
  * @param[in]  filename  Path to a source list text file.
  * @param[in]  type      Required data type (OSKAR_SINGLE or OSKAR_DOUBLE).
@@ -54,6 +54,36 @@ extern "C" {
 OSKAR_EXPORT
 oskar_Sky* oskar_sky_read(const char* filename, int location, int* status);
 
+/**
+ * @brief Reads selected columns of an OSKAR sky model from a binary file.
+ *
+ * @details
+ * Creates an OSKAR sky model from the specified binary file, reading only
+ * the source parameters selected in the \p columns bit mask.
+ * Bits in the mask are given by OSKAR_SKY_COLUMN(tag) for each of the
+ * OSKAR_SKY_TAG_* values of the required parameters, or the mask can be set
+ * to OSKAR_SKY_COLUMNS_ALL. Parameters that are not selected are set to zero
+ * without being read from the file.
+ *
+ * For example, to read only positions and Stokes I values, use:
+ * @code
+   int columns = OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_RA) |
+           OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_DEC) |
+           OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_STOKES_I);
+   sky = oskar_sky_read_columns(filename, OSKAR_CPU, columns, &status);
+   @endcode
+ *
+ * @param[in] filename    Input filename.
+ * @param[in] location    Location of required sky model data (CPU or GPU).
+ * @param[in] columns     Bit mask of source parameters to read.
+ * @param[in,out] status  Status return code.
+ *
+ * @return A handle to the sky model structure, or NULL if an error occurred.
+ */
+OSKAR_EXPORT
+oskar_Sky* oskar_sky_read_columns(const char* filename, int location,
+        int columns, int* status);
+
 #ifdef __cplusplus
 }
 #endif
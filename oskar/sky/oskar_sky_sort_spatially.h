@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_SKY_SORT_SPATIALLY_H_
+#define OSKAR_SKY_SORT_SPATIALLY_H_
+
+/**
+ * @file oskar_sky_sort_spatially.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Sorts the sources in a sky model so that nearby sources are adjacent.
+ *
+ * @details
+ * This function re-orders the sources in a sky model by the index of the
+ * HEALPix pixel that contains them, in the NESTED scheme with
+ * nside = 8192. Any contiguous range of sources is then grouped on the sky,
+ * so when the sky model is split into chunks, each chunk covers
+ * a small area.
+ *
+ * Sources in the same pixel keep their original order.
+ *
+ * @param[in,out] sky          Pointer to sky model, in CPU memory.
+ * @param[in,out] status       Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_sort_spatially(oskar_Sky* sky, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
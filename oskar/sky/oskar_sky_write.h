@@ -22,6 +22,11 @@ extern "C" {
  * @details
  * Writes the specified OSKAR sky model to a binary file.
  *
+ * Each source parameter is stored as a separate contiguous array, together
+ * with its minimum and maximum value. All arrays are written at the
+ * precision of the sky model, so that the file can be read by older
+ * versions of OSKAR.
+ *
  * @param[in] sky         Sky model to write.
  * @param[in] filename    Output filename.
  * @param[in,out] status  Status return code.
@@ -29,6 +34,34 @@ extern "C" {
 OSKAR_EXPORT
 void oskar_sky_write(const oskar_Sky* sky, const char* filename, int* status);
 
+/**
+ * @brief Writes an OSKAR sky model to a compact binary file.
+ *
+ * @details
+ * Writes the specified OSKAR sky model to a binary file, in the same way
+ * as oskar_sky_write(), except that:
+ *
+ * - Arrays in which every value is the same (for example, Stokes Q, U and V
+ *   for an unpolarised sky model) are not stored, and are restored from
+ *   their minimum value when the file is read.
+ * - The flux arrays (Stokes I, Q, U and V) can be stored at reduced
+ *   precision, using 32-bit or 16-bit (IEEE 754 half precision)
+ *   floating-point values. Half-precision values are stored as
+ *   little-endian byte arrays, and have only 11 significant bits.
+ *
+ * Files written by this function can only be read by oskar_sky_read()
+ * or oskar_sky_read_columns() in this or later versions of OSKAR.
+ *
+ * @param[in] sky         Sky model to write.
+ * @param[in] filename    Output filename.
+ * @param[in] flux_bits   Bits per flux value: 32 or 16, or 0 to use the
+ *                        sky model precision.
+ * @param[in,out] status  Status return code.
+ */
+OSKAR_EXPORT
+void oskar_sky_write_compact(const oskar_Sky* sky, const char* filename,
+        int flux_bits, int* status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_SKY_COLUMNS_H_
+#define OSKAR_PRIVATE_SKY_COLUMNS_H_
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <sky/oskar_sky.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of source parameter columns stored in sky model binary files. */
+#define OSKAR_SKY_NUM_COLUMNS 12
+
+/* Returns the binary file tag ID of column i. */
+int oskar_sky_column_tag(int i);
+
+/* Returns true if column i holds flux values (Stokes I, Q, U or V). */
+int oskar_sky_column_is_flux(int i);
+
+/* Returns the sky model array holding column i. */
+oskar_Mem* oskar_sky_column(oskar_Sky* sky, int i);
+const oskar_Mem* oskar_sky_column_const(const oskar_Sky* sky, int i);
+
+/* Converts between single precision and little-endian IEEE 754 binary16. */
+void oskar_sky_column_to_half(const float* in, unsigned char* out, size_t n);
+void oskar_sky_column_from_half(const unsigned char* in, float* out,
+        size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_SKY_COLUMNS_H_ */
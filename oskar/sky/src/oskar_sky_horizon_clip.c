@@ -7,11 +7,16 @@
 #include "sky/oskar_sky.h"
 #include "sky/oskar_sky_copy_source_data.h"
 #include "sky/oskar_update_horizon_mask.h"
+#include "math/oskar_cmath.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Margin used when testing bounding caps against the horizon, in radians.
+ * This is much larger than the rounding errors in the horizon mask. */
+#define CAP_MARGIN 1e-5
+
 static double ha0(double longitude, double ra0, double gast);
 
 void oskar_sky_horizon_clip(oskar_Sky* out, const oskar_Sky* in,
@@ -71,16 +76,102 @@ void oskar_sky_horizon_clip(oskar_Sky* out, const oskar_Sky* in,
     }
 
     /* Apply exclusive prefix sum to mask to get source output indices.
-     * Last element of index array is total number to copy. */
-    if (location != OSKAR_CPU)
-    {
-        oskar_prefix_sum(num_in, horizon_mask, source_indices, status);
-    }
+     * Last element of index array is total number to copy.
+     * (The indices are also used to interpolate station beams in time.) */
+    oskar_prefix_sum(num_in, horizon_mask, source_indices, status);
 
     /* Copy sources above horizon. */
     oskar_sky_copy_source_data(in, horizon_mask, source_indices, out, status);
 }
 
+void oskar_sky_bounding_cap(const oskar_Sky* sky, double cap[4], int* status)
+{
+    int i = 0;
+    double x = 0.0, y = 0.0, z = 0.0, max_angle = 0.0;
+    cap[0] = cap[1] = 0.0;
+    cap[2] = 1.0;
+    cap[3] = -1.0;
+    if (*status) return;
+    const int num_sources = oskar_sky_num_sources(sky);
+    if (num_sources == 0) return;
+    if (oskar_sky_mem_location(sky) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    const int is_dbl = oskar_sky_precision(sky) == OSKAR_DOUBLE;
+    const oskar_Mem *l = oskar_sky_l_const(sky), *m = oskar_sky_m_const(sky);
+    const oskar_Mem *n = oskar_sky_n_const(sky);
+    const double *l_d = 0, *m_d = 0, *n_d = 0;
+    const float *l_f = 0, *m_f = 0, *n_f = 0;
+    if (is_dbl)
+    {
+        l_d = oskar_mem_double_const(l, status);
+        m_d = oskar_mem_double_const(m, status);
+        n_d = oskar_mem_double_const(n, status);
+    }
+    else
+    {
+        l_f = oskar_mem_float_const(l, status);
+        m_f = oskar_mem_float_const(m, status);
+        n_f = oskar_mem_float_const(n, status);
+    }
+
+    /* The centre of the cap is the mean direction of the sources. */
+    for (i = 0; i < num_sources; ++i)
+    {
+        x += is_dbl ? l_d[i] : l_f[i];
+        y += is_dbl ? m_d[i] : m_f[i];
+        z += is_dbl ? n_d[i] : n_f[i];
+    }
+    const double norm = sqrt(x * x + y * y + z * z);
+    if (norm > 0.0)
+    {
+        cap[0] = x / norm;
+        cap[1] = y / norm;
+        cap[2] = z / norm;
+    }
+
+    /* The radius is the largest angle from the centre to any source. */
+    for (i = 0; i < num_sources; ++i)
+    {
+        const double dot = cap[0] * (is_dbl ? l_d[i] : l_f[i]) +
+                cap[1] * (is_dbl ? m_d[i] : m_f[i]) +
+                cap[2] * (is_dbl ? n_d[i] : n_f[i]);
+        const double angle = acos(dot > 1.0 ? 1.0 : (dot < -1.0 ? -1.0 : dot));
+        if (!(angle <= max_angle)) max_angle = angle;
+    }
+    cap[3] = (max_angle == max_angle) ? max_angle : M_PI;
+}
+
+int oskar_sky_horizon_cap_test(const double cap[4], double ra0_rad,
+        double dec0_rad, const oskar_Telescope* telescope, double gast)
+{
+    int i = 0, all_below = 1;
+    if (cap[3] < 0.0) return 0;
+    const double sin_dec0 = sin(dec0_rad), cos_dec0 = cos(dec0_rad);
+    const int num_station_models = oskar_telescope_num_station_models(telescope);
+    for (i = 0; i < num_station_models; ++i)
+    {
+        /* Direction of the zenith, in the same frame as the sources.
+         * This is the same as in oskar_update_horizon_mask(). */
+        const oskar_Station* s = oskar_telescope_station_const(telescope, i);
+        const double ha0_rad = ha0(oskar_station_lon_rad(s), ra0_rad, gast);
+        const double sin_lat = sin(oskar_station_lat_rad(s));
+        const double cos_lat = cos(oskar_station_lat_rad(s));
+        const double cos_ha0 = cos(ha0_rad);
+        const double ll = cos_lat * sin(ha0_rad);
+        const double mm = sin_lat * cos_dec0 - cos_lat * cos_ha0 * sin_dec0;
+        const double nn = sin_lat * sin_dec0 + cos_lat * cos_ha0 * cos_dec0;
+        const double dot = cap[0] * ll + cap[1] * mm + cap[2] * nn;
+        const double zenith_angle =
+                acos(dot > 1.0 ? 1.0 : (dot < -1.0 ? -1.0 : dot));
+        if (zenith_angle + cap[3] < 0.5 * M_PI - CAP_MARGIN) return 1;
+        if (zenith_angle - cap[3] <= 0.5 * M_PI + CAP_MARGIN) all_below = 0;
+    }
+    return all_below ? 0 : -1;
+}
+
 static double ha0(double longitude, double ra0, double gast)
 {
     return (gast + longitude) - ra0;
@@ -3,23 +3,234 @@
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
+#include "sky/private_sky.h"
 #include "sky/oskar_sky.h"
-#include "utility/oskar_getline.h"
+#include "log/oskar_log.h"
+#include "utility/oskar_string_to_array.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define NUM_COLUMNS 12
+#define MIN_CHUNK_BYTES 65536
+
+static const double deg2rad = 1.74532925199432957692369e-2;
+static const double arcsec2rad = 4.84813681109535993589914e-6;
+
+/* A range of complete lines in the file, parsed by a single thread. */
+struct Chunk
+{
+    size_t start, end;        /* Byte range in the file. */
+    int first_line;           /* Line number (and row) of the first line. */
+    int num_lines;            /* Number of lines in the chunk. */
+    int num_sources;          /* Number of sources successfully parsed. */
+    int num_malformed;        /* Number of lines that could not be parsed. */
+    int first_malformed;      /* Line number of the first malformed line. */
+};
+typedef struct Chunk Chunk;
+
+static char* map_file(FILE* file, size_t* size, int* mapped, int* status)
+{
+    char* data = 0;
+    *size = 0;
+    *mapped = 0;
+#ifndef _WIN32
+    {
+        struct stat buf;
+        if (fstat(fileno(file), &buf) != 0)
+        {
+            *status = OSKAR_ERR_FILE_IO;
+            return 0;
+        }
+        *size = (size_t) buf.st_size;
+        if (*size == 0) return 0;
+        data = (char*) mmap(0, *size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if (data != (char*) MAP_FAILED)
+        {
+            *mapped = 1;
+            return data;
+        }
+        data = 0;
+    }
+#endif
+
+    /* Fall back to reading the whole file. */
+    if (fseek(file, 0, SEEK_END) != 0)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        return 0;
+    }
+    *size = (size_t) ftell(file);
+    rewind(file);
+    if (*size == 0) return 0;
+    data = (char*) malloc(*size);
+    if (!data)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+    if (fread(data, 1, *size, file) != *size)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        free(data);
+        return 0;
+    }
+    return data;
+}
+
+
+static void unmap_file(char* data, size_t size, int mapped)
+{
+    if (!data) return;
+#ifndef _WIN32
+    if (mapped)
+    {
+        munmap(data, size);
+        return;
+    }
+#else
+    (void) mapped;
+#endif
+    (void) size;
+    free(data);
+}
+
+
+static int is_blank(const char* str, size_t len)
+{
+    size_t i = 0;
+    for (i = 0; i < len; ++i)
+    {
+        const char c = str[i];
+        if (c == '#') return 1;
+        if (c != ' ' && c != '\t' && c != ',' && c != '\r') return 0;
+    }
+    return 1;
+}
+
+
+static void store_source(int type, void* const* col, int row,
+        const double* par, size_t num_read)
+{
+    int i = 0;
+    double v[NUM_COLUMNS];
+
+    /* RA, Dec, I, Q, U, V, freq0, spix, RM, FWHM maj, FWHM min, PA */
+    for (i = 0; i < NUM_COLUMNS; ++i) v[i] = par[i];
+    v[0] *= deg2rad;
+    v[1] *= deg2rad;
+    if (num_read == 11)
+    {
+        /* Old format, with no rotation measure. */
+        v[8] = 0.0;
+        v[9] = par[8] * arcsec2rad;
+        v[10] = par[9] * arcsec2rad;
+        v[11] = par[10] * deg2rad;
+    }
+    else if (num_read == 12)
+    {
+        v[9] *= arcsec2rad;
+        v[10] *= arcsec2rad;
+        v[11] *= deg2rad;
+    }
+    else
+    {
+        v[9] = v[10] = v[11] = 0.0;
+    }
+    if (type == OSKAR_DOUBLE)
+    {
+        for (i = 0; i < NUM_COLUMNS; ++i)
+        {
+            ((double*) col[i])[row] = v[i];
+        }
+    }
+    else
+    {
+        for (i = 0; i < NUM_COLUMNS; ++i)
+        {
+            ((float*) col[i])[row] = (float) v[i];
+        }
+    }
+}
+
+
+static void parse_chunk(const char* data, Chunk* chunk, int type,
+        void* const* col, int* status)
+{
+    char local[1024];
+    char* line = local;
+    size_t line_capacity = sizeof(local), pos = chunk->start;
+    int line_number = chunk->first_line, row = chunk->first_line;
+    while (pos < chunk->end)
+    {
+        size_t num_read = 0, len = chunk->end - pos;
+        double par[NUM_COLUMNS];
+        const char* str = data + pos;
+        const char* eol = (const char*) memchr(str, '\n', len);
+        if (eol) len = (size_t) (eol - str);
+        pos += len + 1;
+        line_number++;
+
+        /* Copy the line so it can be terminated and tokenised. */
+        if (len >= line_capacity)
+        {
+            char* t = (char*) realloc(line == local ? 0 : line, len + 1);
+            if (!t)
+            {
+                *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+                break;
+            }
+            line = t;
+            line_capacity = len + 1;
+        }
+        memcpy(line, str, len);
+        line[len] = '\0';
+
+        /* Parse the line (require at least RA, Dec, Stokes I). */
+        memset(par, 0, sizeof(par));
+        num_read = oskar_string_to_array_d(line, NUM_COLUMNS, par);
+        if (num_read >= 3 && num_read != 10)
+        {
+            store_source(type, col, row++, par, num_read);
+        }
+        else if (!is_blank(str, len))
+        {
+            if (chunk->num_malformed++ == 0)
+            {
+                chunk->first_malformed = line_number;
+            }
+        }
+    }
+    chunk->num_sources = row - chunk->first_line;
+    if (line != local) free(line);
+}
+
+
 oskar_Sky* oskar_sky_load(const char* filename, int type, int* status)
 {
-    int n = 0;
+    int c = 0, i = 0, n = 0, mapped = 0, num_chunks = 0, num_threads = 1;
+    int num_malformed = 0, first_malformed = 0;
+    size_t size = 0, chunk_bytes = 0, total_lines = 0;
     FILE* file = 0;
-    char* line = 0;
-    size_t bufsize = 0;
+    char* data = 0;
+    Chunk* chunks = 0;
     oskar_Sky* sky = 0;
+    void* col[NUM_COLUMNS];
     if (*status) return 0;
 
     /* Get the data type. */
@@ -29,43 +240,141 @@ oskar_Sky* oskar_sky_load(const char* filename, int type, int* status)
         return 0;
     }
 
-    /* Open the file. */
-    file = fopen(filename, "r");
+    /* Open the file and map it into memory. */
+    file = fopen(filename, "rb");
     if (!file)
     {
         *status = OSKAR_ERR_FILE_IO;
         return 0;
     }
+    data = map_file(file, &size, &mapped, status);
+    fclose(file);
 
     /* Initialise the sky model. */
     sky = oskar_sky_create(type, OSKAR_CPU, 0, status);
+    if (*status || size == 0)
+    {
+        unmap_file(data, size, mapped);
+        if (*status)
+        {
+            oskar_sky_free(sky, status);
+            sky = 0;
+        }
+        return sky;
+    }
 
-    /* Loop over lines in file. */
-    while (oskar_getline(&line, &bufsize, file) != OSKAR_ERR_EOF)
+    /* Split the file into chunks of complete lines. */
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    chunk_bytes = size / (4 * (size_t) num_threads) + 1;
+    if (chunk_bytes < MIN_CHUNK_BYTES) chunk_bytes = MIN_CHUNK_BYTES;
+    num_chunks = (int) ((size + chunk_bytes - 1) / chunk_bytes);
+    chunks = (Chunk*) calloc(num_chunks, sizeof(Chunk));
+    if (!chunks)
     {
-        int str_error = 0;
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        unmap_file(data, size, mapped);
+        oskar_sky_free(sky, status);
+        return 0;
+    }
+    for (c = 0; c < num_chunks; ++c)
+    {
+        size_t end = (c + 1) * chunk_bytes;
+        chunks[c].start = (c > 0) ? chunks[c - 1].end : 0;
+        if (end > size || c == num_chunks - 1) end = size;
+        if (end < chunks[c].start) end = chunks[c].start;
+        while (end < size && data[end - 1] != '\n') end++;
+        chunks[c].end = end;
+    }
 
-        /* Ensure enough space in arrays. */
-        if (oskar_sky_num_sources(sky) <= n)
+    /* Count the lines in each chunk, to find where each chunk starts. */
+#pragma omp parallel for schedule(dynamic)
+    for (c = 0; c < num_chunks; ++c)
+    {
+        size_t pos = chunks[c].start;
+        while (pos < chunks[c].end)
+        {
+            const char* eol = (const char*) memchr(data + pos, '\n',
+                    chunks[c].end - pos);
+            pos = eol ? (size_t) (eol - data) + 1 : chunks[c].end;
+            chunks[c].num_lines++;
+        }
+    }
+    for (c = 0; c < num_chunks; ++c)
+    {
+        if (total_lines + chunks[c].num_lines >= INT_MAX)
         {
-            const int new_size = ((2 * n) < 100) ? 100 : (2 * n);
-            oskar_sky_resize(sky, new_size, status);
-            if (*status) break;
+            *status = OSKAR_ERR_OUT_OF_RANGE;
+            break;
         }
+        chunks[c].first_line = (int) total_lines;
+        total_lines += chunks[c].num_lines;
+    }
 
-        /* Try to set source data from the string. */
-        oskar_sky_set_source_str(sky, n, line, &str_error);
+    /* Allocate space for one source per line, and parse all chunks. */
+    oskar_sky_resize(sky, (int) total_lines, status);
+    col[0] = oskar_mem_void(sky->ra_rad);
+    col[1] = oskar_mem_void(sky->dec_rad);
+    col[2] = oskar_mem_void(sky->I);
+    col[3] = oskar_mem_void(sky->Q);
+    col[4] = oskar_mem_void(sky->U);
+    col[5] = oskar_mem_void(sky->V);
+    col[6] = oskar_mem_void(sky->reference_freq_hz);
+    col[7] = oskar_mem_void(sky->spectral_index);
+    col[8] = oskar_mem_void(sky->rm_rad);
+    col[9] = oskar_mem_void(sky->fwhm_major_rad);
+    col[10] = oskar_mem_void(sky->fwhm_minor_rad);
+    col[11] = oskar_mem_void(sky->pa_rad);
+    if (!*status)
+    {
+        int parse_error = 0;
+#pragma omp parallel for schedule(dynamic)
+        for (c = 0; c < num_chunks; ++c)
+        {
+            int chunk_error = 0;
+            parse_chunk(data, &chunks[c], type, col, &chunk_error);
+            if (chunk_error)
+            {
+#pragma omp critical (oskar_sky_load)
+                parse_error = chunk_error;
+            }
+        }
+        *status = parse_error;
+    }
+    unmap_file(data, size, mapped);
 
-        /* Increment source count only if successful. */
-        if (!str_error) n++;
+    /* Remove the gaps left by comments and malformed lines. */
+    n = 0;
+    for (c = 0; c < num_chunks && !*status; ++c)
+    {
+        const size_t element_size = oskar_mem_element_size(type);
+        if (n != chunks[c].first_line)
+        {
+            for (i = 0; i < NUM_COLUMNS; ++i)
+            {
+                memmove((char*) col[i] + n * element_size,
+                        (char*) col[i] + chunks[c].first_line * element_size,
+                        chunks[c].num_sources * element_size);
+            }
+        }
+        n += chunks[c].num_sources;
+        if (chunks[c].num_malformed > 0 && num_malformed == 0)
+        {
+            first_malformed = chunks[c].first_malformed;
+        }
+        num_malformed += chunks[c].num_malformed;
     }
+    free(chunks);
 
     /* Set the size to be the actual number of elements loaded. */
     oskar_sky_resize(sky, n, status);
-
-    /* Free the line buffer and close the file. */
-    free(line);
-    fclose(file);
+    if (num_malformed > 0 && !*status)
+    {
+        oskar_log_warning(0, "Skipped %d malformed line(s) in sky model "
+                "file '%s' (the first is line %d).",
+                num_malformed, filename, first_malformed);
+    }
 
     /* Check if an error occurred. */
     if (*status)
@@ -1,32 +1,10 @@
 /*
- * Copyright (c) 2012-2015, The University of Oxford
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions are met:
- * 1. Redistributions of source code must retain the above copyright notice,
- *    this list of conditions and the following disclaimer.
- * 2. Redistributions in binary form must reproduce the above copyright notice,
- *    this list of conditions and the following disclaimer in the documentation
- *    and/or other materials provided with the distribution.
- * 3. Neither the name of the University of Oxford nor the names of its
- *    contributors may be used to endorse or promote products derived from this
- *    software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
- * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
- * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
- * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
- * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
- * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
- * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- * POSSIBILITY OF SUCH DAMAGE.
+ * Copyright (c) 2012-2021, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "sky/oskar_sky.h"
+#include "sky/private_sky_columns.h"
 #include "binary/oskar_binary.h"
 #include "mem/oskar_binary_read_mem.h"
 
@@ -34,9 +12,85 @@
 extern "C" {
 #endif
 
-oskar_Sky* oskar_sky_read(const char* filename, int location, int* status)
+static void read_column(oskar_Binary* h, oskar_Mem* column, int tag,
+        int num_sources, int* status)
+{
+    int err = 0;
+    size_t bytes = 0;
+    oskar_Mem* temp = 0;
+    double range[2] = {0.0, 0.0};
+    const unsigned char group = OSKAR_TAG_GROUP_SKY_MODEL;
+    const int type = oskar_mem_precision(column);
+    const int other = (type == OSKAR_DOUBLE) ? OSKAR_SINGLE : OSKAR_DOUBLE;
+    if (*status) return;
+
+    /* Array stored at the same precision as the sky model. */
+    (void) oskar_binary_query(h, (unsigned char) type, group,
+            (unsigned char) tag, 0, &bytes, &err);
+    if (!err)
+    {
+        oskar_binary_read_mem(h, column, group, (unsigned char) tag, 0,
+                status);
+        return;
+    }
+
+    /* Array stored at a different precision. */
+    err = 0;
+    (void) oskar_binary_query(h, (unsigned char) other, group,
+            (unsigned char) tag, 0, &bytes, &err);
+    if (!err)
+    {
+        temp = oskar_mem_create(other, OSKAR_CPU, 0, status);
+        oskar_binary_read_mem(h, temp, group, (unsigned char) tag, 0,
+                status);
+    }
+
+    /* Array stored as half-precision values. */
+    if (!temp)
+    {
+        err = 0;
+        (void) oskar_binary_query(h, OSKAR_CHAR, group,
+                (unsigned char) tag, 0, &bytes, &err);
+    }
+    if (!temp && !err)
+    {
+        oskar_Mem* half = oskar_mem_create(OSKAR_CHAR, OSKAR_CPU, 0, status);
+        oskar_binary_read_mem(h, half, group, (unsigned char) tag, 0,
+                status);
+        if (!*status && oskar_mem_length(half) != 2 * (size_t) num_sources)
+        {
+            *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        }
+        temp = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU, num_sources, status);
+        if (!*status)
+        {
+            oskar_sky_column_from_half(
+                    (const unsigned char*) oskar_mem_void_const(half),
+                    oskar_mem_float(temp, status), (size_t) num_sources);
+        }
+        oskar_mem_free(half, status);
+    }
+    if (temp)
+    {
+        oskar_Mem* converted = oskar_mem_convert_precision(temp, type, status);
+        oskar_mem_realloc(column, num_sources, status);
+        oskar_mem_copy_contents(column, converted, 0, 0, num_sources, status);
+        oskar_mem_free(converted, status);
+        oskar_mem_free(temp, status);
+        return;
+    }
+
+    /* Array not stored: all values are the same. */
+    oskar_binary_read(h, OSKAR_DOUBLE, group, OSKAR_SKY_TAG_COLUMN_RANGE,
+            tag, sizeof(range), range, status);
+    oskar_mem_set_value_real(column, range[0], 0, num_sources, status);
+}
+
+
+oskar_Sky* oskar_sky_read_columns(const char* filename, int location,
+        int columns, int* status)
 {
-    int type = 0, num_sources = 0, idx = 0;
+    int i = 0, type = 0, num_sources = 0, idx = 0;
     oskar_Binary* h = 0;
     unsigned char group = OSKAR_TAG_GROUP_SKY_MODEL;
     oskar_Sky* sky = 0;
@@ -64,31 +118,20 @@ oskar_Sky* oskar_sky_read(const char* filename, int location, int* status)
     /* Create the sky model structure. */
     sky = oskar_sky_create(type, location, num_sources, status);
 
-    /* Read the arrays. */
-    oskar_binary_read_mem(h, oskar_sky_ra_rad(sky),
-            group, OSKAR_SKY_TAG_RA, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_dec_rad(sky),
-            group, OSKAR_SKY_TAG_DEC, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_I(sky),
-            group, OSKAR_SKY_TAG_STOKES_I, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_Q(sky),
-            group, OSKAR_SKY_TAG_STOKES_Q, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_U(sky),
-            group, OSKAR_SKY_TAG_STOKES_U, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_V(sky),
-            group, OSKAR_SKY_TAG_STOKES_V, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_reference_freq_hz(sky),
-            group, OSKAR_SKY_TAG_REF_FREQ, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_spectral_index(sky),
-            group, OSKAR_SKY_TAG_SPECTRAL_INDEX, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_fwhm_major_rad(sky),
-            group, OSKAR_SKY_TAG_FWHM_MAJOR, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_fwhm_minor_rad(sky),
-            group, OSKAR_SKY_TAG_FWHM_MINOR, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_position_angle_rad(sky),
-            group, OSKAR_SKY_TAG_POSITION_ANGLE, idx, status);
-    oskar_binary_read_mem(h, oskar_sky_rotation_measure_rad(sky),
-            group, OSKAR_SKY_TAG_ROTATION_MEASURE, idx, status);
+    /* Read the required arrays, and set the others to zero. */
+    for (i = 0; i < OSKAR_SKY_NUM_COLUMNS; ++i)
+    {
+        oskar_Mem* column = oskar_sky_column(sky, i);
+        if (columns & OSKAR_SKY_COLUMN(oskar_sky_column_tag(i)))
+        {
+            read_column(h, column, oskar_sky_column_tag(i),
+                    num_sources, status);
+        }
+        else
+        {
+            oskar_mem_clear_contents(column, status);
+        }
+    }
 
     /* Release the handle. */
     oskar_binary_free(h);
@@ -102,6 +145,13 @@ oskar_Sky* oskar_sky_read(const char* filename, int location, int* status)
     return sky;
 }
 
+
+oskar_Sky* oskar_sky_read(const char* filename, int location, int* status)
+{
+    return oskar_sky_read_columns(filename, location,
+            OSKAR_SKY_COLUMNS_ALL, status);
+}
+
 #ifdef __cplusplus
 }
 #endif
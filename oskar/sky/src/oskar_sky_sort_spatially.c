@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
+#include "math/oskar_cmath.h"
+#include "sky/private_sky.h"
+#include "sky/oskar_sky.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SORT_NSIDE 8192
+
+typedef struct
+{
+    unsigned int pixel;
+    int index;
+} SortKey;
+
+static int compare_keys(const void* a, const void* b)
+{
+    const SortKey* ka = (const SortKey*) a;
+    const SortKey* kb = (const SortKey*) b;
+    if (ka->pixel != kb->pixel) return (ka->pixel < kb->pixel) ? -1 : 1;
+    return (ka->index < kb->index) ? -1 : (ka->index > kb->index);
+}
+
+static void permute(oskar_Mem* mem, int num, const SortKey* keys,
+        char* temp, int* status)
+{
+    int i = 0;
+    char* data = (char*) oskar_mem_void(mem);
+    const size_t size = oskar_mem_element_size(oskar_mem_type(mem));
+    if (*status || !data) return;
+    for (i = 0; i < num; ++i)
+    {
+        memcpy(temp + size * i, data + size * keys[i].index, size);
+    }
+    memcpy(data, temp, size * num);
+}
+
+void oskar_sky_sort_spatially(oskar_Sky* sky, int* status)
+{
+    int i = 0;
+    if (*status) return;
+    const int num = sky->num_sources;
+    if (sky->mem_location != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (num < 2) return;
+
+    /* Find the pixel containing each source. */
+    SortKey* keys = (SortKey*) malloc(num * sizeof(SortKey));
+    char* temp = (char*) malloc(num * sizeof(double));
+    if (!keys || !temp)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        free(keys);
+        free(temp);
+        return;
+    }
+    for (i = 0; i < num; ++i)
+    {
+        const double ra = oskar_mem_get_element(sky->ra_rad, i, status);
+        const double dec = oskar_mem_get_element(sky->dec_rad, i, status);
+        keys[i].pixel = oskar_convert_theta_phi_to_healpix_nest_pixel(
+                SORT_NSIDE, 0.5 * M_PI - dec, ra);
+        keys[i].index = i;
+    }
+    qsort(keys, num, sizeof(SortKey), compare_keys);
+
+    /* Re-order all the source parameters. */
+    permute(sky->ra_rad, num, keys, temp, status);
+    permute(sky->dec_rad, num, keys, temp, status);
+    permute(sky->I, num, keys, temp, status);
+    permute(sky->Q, num, keys, temp, status);
+    permute(sky->U, num, keys, temp, status);
+    permute(sky->V, num, keys, temp, status);
+    permute(sky->reference_freq_hz, num, keys, temp, status);
+    permute(sky->spectral_index, num, keys, temp, status);
+    permute(sky->rm_rad, num, keys, temp, status);
+    permute(sky->l, num, keys, temp, status);
+    permute(sky->m, num, keys, temp, status);
+    permute(sky->n, num, keys, temp, status);
+    permute(sky->fwhm_major_rad, num, keys, temp, status);
+    permute(sky->fwhm_minor_rad, num, keys, temp, status);
+    permute(sky->pa_rad, num, keys, temp, status);
+    permute(sky->gaussian_a, num, keys, temp, status);
+    permute(sky->gaussian_b, num, keys, temp, status);
+    permute(sky->gaussian_c, num, keys, temp, status);
+    free(keys);
+    free(temp);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,22 +4,80 @@
  */
 
 #include "sky/oskar_sky.h"
+#include "sky/private_sky_columns.h"
 #include "binary/oskar_binary.h"
 #include "mem/oskar_binary_write_mem.h"
 
+#include <stdlib.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void oskar_sky_write(const oskar_Sky* sky, const char* filename, int* status)
+#define FORMAT_VERSION 2
+
+/* Returns true if all values in the column are the same (and not NaN). */
+static int column_range(const oskar_Mem* data, int n, double* range,
+        int* status)
 {
-    const int idx = 0;
+    int i = 0, constant = 1;
+    range[0] = range[1] = 0.0;
+    if (*status || n == 0) return 1;
+    if (oskar_mem_precision(data) == OSKAR_DOUBLE)
+    {
+        const double* v = oskar_mem_double_const(data, status);
+        range[0] = range[1] = v[0];
+        for (i = 0; i < n; ++i)
+        {
+            if (v[i] != v[i]) constant = 0;
+            if (v[i] < range[0]) range[0] = v[i];
+            if (v[i] > range[1]) range[1] = v[i];
+        }
+    }
+    else
+    {
+        const float* v = oskar_mem_float_const(data, status);
+        range[0] = range[1] = v[0];
+        for (i = 0; i < n; ++i)
+        {
+            if (v[i] != v[i]) constant = 0;
+            if (v[i] < range[0]) range[0] = v[i];
+            if (v[i] > range[1]) range[1] = v[i];
+        }
+    }
+    return constant && range[0] == range[1];
+}
+
+
+static void write_sky(const oskar_Sky* sky, const char* filename,
+        int compact, int flux_bits, int* status)
+{
+    int i = 0, columns = 0;
+    const int idx = 0, version = FORMAT_VERSION;
     const int type = oskar_sky_precision(sky);
     const int num_sources = oskar_sky_num_sources(sky);
     const unsigned char group = OSKAR_TAG_GROUP_SKY_MODEL;
+    oskar_Mem* copy[OSKAR_SKY_NUM_COLUMNS];
+    double range[OSKAR_SKY_NUM_COLUMNS][2];
     oskar_Binary* h = 0;
     if (*status) return;
 
+    /* Find the range of each column, and which columns need to be stored. */
+    for (i = 0; i < OSKAR_SKY_NUM_COLUMNS; ++i)
+    {
+        const oskar_Mem* data = oskar_sky_column_const(sky, i);
+        copy[i] = 0;
+        if (oskar_mem_location(data) != OSKAR_CPU)
+        {
+            copy[i] = oskar_mem_create_copy(data, OSKAR_CPU, status);
+            data = copy[i];
+        }
+        if (!column_range(data, num_sources, range[i], status) || !compact)
+        {
+            columns |= OSKAR_SKY_COLUMN(oskar_sky_column_tag(i));
+        }
+    }
+
     /* Create the file handle. */
     h = oskar_binary_create(filename, 'w', status);
 
@@ -28,35 +86,82 @@ void oskar_sky_write(const oskar_Sky* sky, const char* filename, int* status)
             OSKAR_SKY_TAG_NUM_SOURCES, idx, num_sources, status);
     oskar_binary_write_int(h, group,
             OSKAR_SKY_TAG_DATA_TYPE, idx, type, status);
+    oskar_binary_write_int(h, group,
+            OSKAR_SKY_TAG_FORMAT_VERSION, idx, version, status);
+    oskar_binary_write_int(h, group,
+            OSKAR_SKY_TAG_COLUMNS, idx, columns, status);
+
+    /* Write the range of each column, then the columns that are needed. */
+    for (i = 0; i < OSKAR_SKY_NUM_COLUMNS; ++i)
+    {
+        const int tag = oskar_sky_column_tag(i);
+        const oskar_Mem* data = copy[i] ? copy[i] :
+                oskar_sky_column_const(sky, i);
+        oskar_binary_write(h, OSKAR_DOUBLE, group, OSKAR_SKY_TAG_COLUMN_RANGE,
+                tag, sizeof(range[i]), range[i], status);
+        if (!(columns & OSKAR_SKY_COLUMN(tag))) continue;
+        if (!oskar_sky_column_is_flux(i) || flux_bits <= 0 ||
+                (flux_bits == 32 && type == OSKAR_SINGLE))
+        {
+            oskar_binary_write_mem(h, data, group, tag, idx,
+                    num_sources, status);
+        }
+        else
+        {
+            oskar_Mem* temp = oskar_mem_convert_precision(data,
+                    OSKAR_SINGLE, status);
+            if (flux_bits == 16)
+            {
+                unsigned char* half = (unsigned char*) calloc(
+                        2 * (size_t) num_sources + 1, 1);
+                if (!half && !*status)
+                {
+                    *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+                }
+                if (!*status)
+                {
+                    oskar_sky_column_to_half(
+                            oskar_mem_float_const(temp, status), half,
+                            (size_t) num_sources);
+                    oskar_binary_write(h, OSKAR_CHAR, group, tag, idx,
+                            2 * (size_t) num_sources, half, status);
+                }
+                free(half);
+            }
+            else
+            {
+                oskar_binary_write_mem(h, temp, group, tag, idx,
+                        num_sources, status);
+            }
+            oskar_mem_free(temp, status);
+        }
+    }
 
-    /* Write the arrays. */
-    oskar_binary_write_mem(h, oskar_sky_ra_rad_const(sky),
-            group, OSKAR_SKY_TAG_RA, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_dec_rad_const(sky),
-            group, OSKAR_SKY_TAG_DEC, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_I_const(sky),
-            group, OSKAR_SKY_TAG_STOKES_I, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_Q_const(sky),
-            group, OSKAR_SKY_TAG_STOKES_Q, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_U_const(sky),
-            group, OSKAR_SKY_TAG_STOKES_U, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_V_const(sky),
-            group, OSKAR_SKY_TAG_STOKES_V, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_reference_freq_hz_const(sky),
-            group, OSKAR_SKY_TAG_REF_FREQ, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_spectral_index_const(sky),
-            group, OSKAR_SKY_TAG_SPECTRAL_INDEX, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_fwhm_major_rad_const(sky),
-            group, OSKAR_SKY_TAG_FWHM_MAJOR, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_fwhm_minor_rad_const(sky),
-            group, OSKAR_SKY_TAG_FWHM_MINOR, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_position_angle_rad_const(sky),
-            group, OSKAR_SKY_TAG_POSITION_ANGLE, idx, num_sources, status);
-    oskar_binary_write_mem(h, oskar_sky_rotation_measure_rad_const(sky),
-            group, OSKAR_SKY_TAG_ROTATION_MEASURE, idx, num_sources, status);
-
-    /* Release the handle. */
+    /* Release the handle and any copies. */
     oskar_binary_free(h);
+    for (i = 0; i < OSKAR_SKY_NUM_COLUMNS; ++i)
+    {
+        oskar_mem_free(copy[i], status);
+    }
+}
+
+
+void oskar_sky_write(const oskar_Sky* sky, const char* filename, int* status)
+{
+    write_sky(sky, filename, 0, 0, status);
+}
+
+
+void oskar_sky_write_compact(const oskar_Sky* sky, const char* filename,
+        int flux_bits, int* status)
+{
+    if (*status) return;
+    if (flux_bits != 0 && flux_bits != 16 && flux_bits != 32)
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        return;
+    }
+    write_sky(sky, filename, 1, flux_bits, status);
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "sky/private_sky_columns.h"
+#include "sky/oskar_sky.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static const int column_tags[OSKAR_SKY_NUM_COLUMNS] = {
+        OSKAR_SKY_TAG_RA,
+        OSKAR_SKY_TAG_DEC,
+        OSKAR_SKY_TAG_STOKES_I,
+        OSKAR_SKY_TAG_STOKES_Q,
+        OSKAR_SKY_TAG_STOKES_U,
+        OSKAR_SKY_TAG_STOKES_V,
+        OSKAR_SKY_TAG_REF_FREQ,
+        OSKAR_SKY_TAG_SPECTRAL_INDEX,
+        OSKAR_SKY_TAG_FWHM_MAJOR,
+        OSKAR_SKY_TAG_FWHM_MINOR,
+        OSKAR_SKY_TAG_POSITION_ANGLE,
+        OSKAR_SKY_TAG_ROTATION_MEASURE
+};
+
+int oskar_sky_column_tag(int i)
+{
+    return column_tags[i];
+}
+
+int oskar_sky_column_is_flux(int i)
+{
+    return i >= 2 && i <= 5;
+}
+
+oskar_Mem* oskar_sky_column(oskar_Sky* sky, int i)
+{
+    switch (column_tags[i])
+    {
+    case OSKAR_SKY_TAG_RA:
+        return oskar_sky_ra_rad(sky);
+    case OSKAR_SKY_TAG_DEC:
+        return oskar_sky_dec_rad(sky);
+    case OSKAR_SKY_TAG_STOKES_I:
+        return oskar_sky_I(sky);
+    case OSKAR_SKY_TAG_STOKES_Q:
+        return oskar_sky_Q(sky);
+    case OSKAR_SKY_TAG_STOKES_U:
+        return oskar_sky_U(sky);
+    case OSKAR_SKY_TAG_STOKES_V:
+        return oskar_sky_V(sky);
+    case OSKAR_SKY_TAG_REF_FREQ:
+        return oskar_sky_reference_freq_hz(sky);
+    case OSKAR_SKY_TAG_SPECTRAL_INDEX:
+        return oskar_sky_spectral_index(sky);
+    case OSKAR_SKY_TAG_FWHM_MAJOR:
+        return oskar_sky_fwhm_major_rad(sky);
+    case OSKAR_SKY_TAG_FWHM_MINOR:
+        return oskar_sky_fwhm_minor_rad(sky);
+    case OSKAR_SKY_TAG_POSITION_ANGLE:
+        return oskar_sky_position_angle_rad(sky);
+    case OSKAR_SKY_TAG_ROTATION_MEASURE:
+        return oskar_sky_rotation_measure_rad(sky);
+    default:
+        return 0;
+    }
+}
+
+const oskar_Mem* oskar_sky_column_const(const oskar_Sky* sky, int i)
+{
+    switch (column_tags[i])
+    {
+    case OSKAR_SKY_TAG_RA:
+        return oskar_sky_ra_rad_const(sky);
+    case OSKAR_SKY_TAG_DEC:
+        return oskar_sky_dec_rad_const(sky);
+    case OSKAR_SKY_TAG_STOKES_I:
+        return oskar_sky_I_const(sky);
+    case OSKAR_SKY_TAG_STOKES_Q:
+        return oskar_sky_Q_const(sky);
+    case OSKAR_SKY_TAG_STOKES_U:
+        return oskar_sky_U_const(sky);
+    case OSKAR_SKY_TAG_STOKES_V:
+        return oskar_sky_V_const(sky);
+    case OSKAR_SKY_TAG_REF_FREQ:
+        return oskar_sky_reference_freq_hz_const(sky);
+    case OSKAR_SKY_TAG_SPECTRAL_INDEX:
+        return oskar_sky_spectral_index_const(sky);
+    case OSKAR_SKY_TAG_FWHM_MAJOR:
+        return oskar_sky_fwhm_major_rad_const(sky);
+    case OSKAR_SKY_TAG_FWHM_MINOR:
+        return oskar_sky_fwhm_minor_rad_const(sky);
+    case OSKAR_SKY_TAG_POSITION_ANGLE:
+        return oskar_sky_position_angle_rad_const(sky);
+    case OSKAR_SKY_TAG_ROTATION_MEASURE:
+        return oskar_sky_rotation_measure_rad_const(sky);
+    default:
+        return 0;
+    }
+}
+
+static uint16_t float_to_half(float value)
+{
+    uint32_t x = 0, h = 0, rem = 0, half_ulp = 0;
+    memcpy(&x, &value, sizeof(x));
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    uint32_t mant = x & 0x7FFFFFu;
+    int exp = (int) ((x >> 23) & 0xFF);
+    if (exp == 255)
+    {
+        /* Infinity or NaN. */
+        return (uint16_t) (sign | 0x7C00u | (mant ? 0x200u : 0u));
+    }
+    exp = exp - 127 + 15;
+    if (exp >= 31) return (uint16_t) (sign | 0x7C00u); /* Overflow. */
+    if (exp <= 0)
+    {
+        /* Subnormal half, or zero. */
+        int shift = 0;
+        if (exp < -10) return (uint16_t) sign;
+        mant |= 0x800000u;
+        shift = 14 - exp;
+        h = mant >> shift;
+        rem = mant & ((1u << shift) - 1u);
+        half_ulp = 1u << (shift - 1);
+    }
+    else
+    {
+        h = ((uint32_t) exp << 10) | (mant >> 13);
+        rem = mant & 0x1FFFu;
+        half_ulp = 0x1000u;
+    }
+
+    /* Round to nearest, ties to even. A carry into the exponent is correct. */
+    if (rem > half_ulp || (rem == half_ulp && (h & 1u))) h++;
+    return (uint16_t) (sign | h);
+}
+
+static float half_to_float(uint16_t h)
+{
+    float value = 0.0f;
+    uint32_t x = 0;
+    const uint32_t sign = ((uint32_t) h & 0x8000u) << 16;
+    uint32_t mant = h & 0x3FFu;
+    int exp = (h >> 10) & 0x1F;
+    if (exp == 0)
+    {
+        if (mant == 0)
+        {
+            x = sign;
+        }
+        else
+        {
+            /* Normalise a subnormal half. */
+            exp = 1;
+            while (!(mant & 0x400u))
+            {
+                mant <<= 1;
+                exp--;
+            }
+            mant &= 0x3FFu;
+            x = sign | ((uint32_t) (exp + 112) << 23) | (mant << 13);
+        }
+    }
+    else if (exp == 31)
+    {
+        x = sign | 0x7F800000u | (mant << 13);
+    }
+    else
+    {
+        x = sign | ((uint32_t) (exp + 112) << 23) | (mant << 13);
+    }
+    memcpy(&value, &x, sizeof(value));
+    return value;
+}
+
+void oskar_sky_column_to_half(const float* in, unsigned char* out, size_t n)
+{
+    size_t i = 0;
+    for (i = 0; i < n; ++i)
+    {
+        const uint16_t h = float_to_half(in[i]);
+        out[2 * i] = (unsigned char) (h & 0xFF);
+        out[2 * i + 1] = (unsigned char) (h >> 8);
+    }
+}
+
+void oskar_sky_column_from_half(const unsigned char* in, float* out, size_t n)
+{
+    size_t i = 0;
+    for (i = 0; i < n; ++i)
+    {
+        out[i] = half_to_float((uint16_t) (in[2 * i] | (in[2 * i + 1] << 8)));
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
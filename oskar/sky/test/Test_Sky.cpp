@@ -31,6 +31,7 @@
 #include "telescope/oskar_telescope.h"
 #include "sky/oskar_sky.h"
 #include "convert/oskar_convert_lon_lat_to_relative_directions.h"
+#include "convert/oskar_convert_theta_phi_to_healpix_nest.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_timer.h"
 #include "utility/oskar_device.h"
@@ -571,6 +572,121 @@ TEST(SkyModel, horizon_clip)
 }
 
 
+TEST(SkyModel, horizon_cap_test)
+{
+    int status = 0, num_chunks = 0, num_above = 0, num_below = 0;
+    int num_small = 0;
+    const int type = OSKAR_DOUBLE, n_lat = 90, n_lon = 180;
+    const double deg2rad = M_PI / 180.0;
+    oskar_Sky** chunks = 0;
+
+    // Generate an all-sky grid, and sort it.
+    oskar_Sky* sky = oskar_sky_create(type, OSKAR_CPU, n_lat * n_lon, &status);
+    for (int i = 0, k = 0; i < n_lat; ++i)
+    {
+        for (int j = 0; j < n_lon; ++j, ++k)
+        {
+            const double ra = (j * 2.0 + 0.5) * deg2rad;
+            const double dec = (-89.0 + i * 2.0) * deg2rad;
+            oskar_sky_set_source(sky, k, ra, dec, double(k), double(2 * k),
+                    0.0, 0.0, 100e6, 0.0, 0.0, 0.0, 0.0, 0.0, &status);
+        }
+    }
+    oskar_sky_sort_spatially(sky, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Check that all source parameters have been moved together,
+    // and that the sources are in HEALPix order.
+    const double* ra = oskar_mem_double_const(oskar_sky_ra_rad(sky), &status);
+    const double* dec = oskar_mem_double_const(oskar_sky_dec_rad(sky), &status);
+    const double* I = oskar_mem_double_const(oskar_sky_I(sky), &status);
+    const double* Q = oskar_mem_double_const(oskar_sky_Q(sky), &status);
+    unsigned int previous = 0;
+    double sum_I = 0.0;
+    for (int i = 0; i < n_lat * n_lon; ++i)
+    {
+        const int k = (int) I[i];
+        const unsigned int pixel =
+                oskar_convert_theta_phi_to_healpix_nest_pixel(
+                        8192, M_PI / 2 - dec[i], ra[i]);
+        EXPECT_DOUBLE_EQ(2.0 * k, Q[i]);
+        EXPECT_DOUBLE_EQ((-89.0 + (k / n_lon) * 2.0) * deg2rad, dec[i]);
+        EXPECT_DOUBLE_EQ(((k % n_lon) * 2.0 + 0.5) * deg2rad, ra[i]);
+        EXPECT_GE(pixel, previous);
+        previous = pixel;
+        sum_I += I[i];
+    }
+    EXPECT_DOUBLE_EQ(0.5 * (n_lat * n_lon - 1) * n_lat * n_lon, sum_I);
+
+    // Split the sky into chunks.
+    oskar_sky_append_to_set(&num_chunks, &chunks, 64, sky, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create a telescope with stations at different longitudes.
+    const int n_stations = 3;
+    oskar_Telescope* telescope = oskar_telescope_create(type,
+            OSKAR_CPU, n_stations, &status);
+    oskar_telescope_resize_station_array(telescope, n_stations, &status);
+    for (int i = 0; i < n_stations; ++i)
+    {
+        oskar_station_set_position(oskar_telescope_station(telescope, i),
+                i * 20.0 * deg2rad, -30.0 * deg2rad, 0.0, 0.0, 0.0, 0.0);
+    }
+
+    // Check that the cap test agrees with the horizon clip.
+    oskar_StationWork* work = oskar_station_work_create(type, OSKAR_CPU,
+            &status);
+    oskar_Sky* sky_out = oskar_sky_create(type, OSKAR_CPU, 0, &status);
+    for (int i = 0; i < num_chunks; ++i)
+    {
+        double cap[4];
+        oskar_sky_evaluate_relative_directions(chunks[i],
+                0.3, -0.5, &status);
+        oskar_sky_bounding_cap(chunks[i], cap, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        if (cap[3] < 0.4) num_small++;
+        for (int t = 0; t < 8; ++t)
+        {
+            const double gast = t * M_PI / 4.0;
+            const int visible = oskar_sky_horizon_cap_test(cap, 0.3, -0.5,
+                    telescope, gast);
+            oskar_sky_horizon_clip(sky_out, chunks[i], telescope, gast,
+                    work, &status);
+            ASSERT_EQ(0, status) << oskar_get_error_string(status);
+            const int n_in = oskar_sky_num_sources(chunks[i]);
+            const int n_out = oskar_sky_num_sources(sky_out);
+            if (visible == 1)
+            {
+                EXPECT_EQ(n_in, n_out);
+                num_above++;
+            }
+            else if (visible == 0)
+            {
+                EXPECT_EQ(0, n_out);
+                num_below++;
+            }
+        }
+    }
+
+    // Most chunks should be compact, and should not need to be clipped
+    // source by source.
+    EXPECT_GT(num_small, num_chunks * 3 / 4);
+    EXPECT_GT(num_above + num_below, num_chunks * 8 * 2 / 3);
+    EXPECT_GT(num_above, 0);
+    EXPECT_GT(num_below, 0);
+
+    for (int i = 0; i < num_chunks; ++i)
+    {
+        oskar_sky_free(chunks[i], &status);
+    }
+    free(chunks);
+    oskar_sky_free(sky, &status);
+    oskar_sky_free(sky_out, &status);
+    oskar_station_work_free(work, &status);
+    oskar_telescope_free(telescope, &status);
+}
+
+
 TEST(SkyModel, resize)
 {
     int status = 0;
@@ -1152,6 +1268,113 @@ TEST(SkyModel, load_ascii)
 }
 
 
+TEST(SkyModel, load_ascii_parallel)
+{
+    int status = 0;
+    const char* filename = "temp_sources_parallel.osm";
+    const int num_lines = 40000;
+
+    // Write a large file with a mixture of formats, comments and errors.
+    FILE* file = fopen(filename, "wb");
+    if (!file) FAIL() << "Unable to create test file";
+    for (int i = 0; i < num_lines; ++i)
+    {
+        const double ra = i / 100.0, dec = -i / 1000.0;
+        switch (i % 10)
+        {
+        case 0:
+            fprintf(file, "# Comment %d\n", i);
+            break;
+        case 1:
+            fprintf(file, "%.6f %.6f %.3f\n", ra, dec, i * 0.5);
+            break;
+        case 2:
+            fprintf(file, "%.6f,%.6f,%.3f,1,2,3,150e6,-0.7,0.5\r\n",
+                    ra, dec, i * 0.5);
+            break;
+        case 3:
+            fprintf(file, "%.6f %.6f %.3f 0 0 0 100e6 -0.8 60 30 %d\n",
+                    ra, dec, i * 0.5, i % 180);
+            break;
+        case 4:
+            fprintf(file, "%.6f %.6f %.3f 0 0 0 100e6 -0.8 1.5 60 30 %d "
+                    "# Gaussian\n", ra, dec, i * 0.5, i % 180);
+            break;
+        case 5:
+            fprintf(file, "%.6f %.6f\n", ra, dec); // Malformed.
+            break;
+        case 6:
+            fprintf(file, "   \t \n");
+            break;
+        case 7:
+            fprintf(file, "1 2 3 4 5 6 7 8 9 10\n"); // Malformed.
+            break;
+        default:
+            fprintf(file, "\t%.6f  %.6f  %.3f", ra, dec, i * 0.25);
+            if (i < num_lines - 1) fprintf(file, "\n"); // Last line has none.
+            break;
+        }
+    }
+    fclose(file);
+
+    // Load the file.
+    oskar_Sky* sky = oskar_sky_load(filename, OSKAR_DOUBLE, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create the expected sky model by setting sources one line at a time.
+    char line[256];
+    int num_sources = 0;
+    oskar_Sky* ref = oskar_sky_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_lines, &status);
+    file = fopen(filename, "rb");
+    if (!file) FAIL() << "Unable to open test file";
+    while (fgets(line, sizeof(line), file))
+    {
+        int str_error = 0;
+        oskar_sky_set_source_str(ref, num_sources, line, &str_error);
+        if (!str_error) num_sources++;
+    }
+    fclose(file);
+    oskar_sky_resize(ref, num_sources, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    ASSERT_EQ(num_lines / 10 * 6, num_sources);
+    ASSERT_EQ(num_sources, oskar_sky_num_sources(sky));
+
+    // Check the data are identical.
+    // (The arrays have one spare element at the end, which is not set.)
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_ra_rad(ref),
+            oskar_sky_ra_rad(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_dec_rad(ref),
+            oskar_sky_dec_rad(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_I(ref),
+            oskar_sky_I(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_Q(ref),
+            oskar_sky_Q(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_U(ref),
+            oskar_sky_U(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_V(ref),
+            oskar_sky_V(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_reference_freq_hz(ref),
+            oskar_sky_reference_freq_hz(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_spectral_index(ref),
+            oskar_sky_spectral_index(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_rotation_measure_rad(ref),
+            oskar_sky_rotation_measure_rad(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_fwhm_major_rad(ref),
+            oskar_sky_fwhm_major_rad(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_fwhm_minor_rad(ref),
+            oskar_sky_fwhm_minor_rad(sky), num_sources, &status));
+    EXPECT_FALSE(oskar_mem_different(oskar_sky_position_angle_rad(ref),
+            oskar_sky_position_angle_rad(sky), num_sources, &status));
+    EXPECT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Cleanup.
+    oskar_sky_free(sky, &status);
+    oskar_sky_free(ref, &status);
+    remove(filename);
+}
+
+
 TEST(SkyModel, read_write)
 {
     oskar_Sky *sky = 0, *sky2 = 0;
@@ -1251,3 +1474,82 @@ TEST(SkyModel, read_write)
     // Remove the data file.
     remove(filename);
 }
+
+
+static void check_column(const oskar_Mem* expected, const oskar_Mem* actual,
+        double tol)
+{
+    int status = 0;
+    double max_ = 0.0, avg_ = 0.0;
+    ASSERT_EQ(OSKAR_CPU, oskar_mem_location(actual));
+    ASSERT_EQ(oskar_mem_type(expected), oskar_mem_type(actual));
+    oskar_mem_evaluate_relative_error(expected, actual, 0, &max_, &avg_,
+            0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_LE(max_, tol);
+}
+
+
+TEST(SkyModel, read_write_compact)
+{
+    int status = 0;
+    const int num_sources = 2345;
+    const char* filename = "test_sky_model_write_compact.osm";
+    oskar_Sky* sky = oskar_sky_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_sources, &status);
+
+    // Create an unpolarised sky model with a fixed reference frequency.
+    for (int i = 0; i < num_sources; ++i)
+    {
+        oskar_sky_set_source(sky, i, 0.001 * i, -0.0002 * i,
+                0.01 + 0.37 * i, 0.0, 0.0, 0.0, 150e6, -0.7 + 1e-4 * i,
+                0.0, 0.0, 0.0, 0.0, &status);
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Check the data are the same for each flux precision.
+    const int flux_bits[] = {0, 32, 16};
+    const double flux_tol[] = {1e-15, 1e-7, 1e-3};
+    for (int k = 0; k < 3; ++k)
+    {
+        oskar_sky_write_compact(sky, filename, flux_bits[k], &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        oskar_Sky* sky2 = oskar_sky_read(filename, OSKAR_CPU, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ(num_sources, oskar_sky_num_sources(sky2));
+        check_column(oskar_sky_ra_rad_const(sky),
+                oskar_sky_ra_rad_const(sky2), 1e-15);
+        check_column(oskar_sky_dec_rad_const(sky),
+                oskar_sky_dec_rad_const(sky2), 1e-15);
+        check_column(oskar_sky_I_const(sky),
+                oskar_sky_I_const(sky2), flux_tol[k]);
+        check_column(oskar_sky_Q_const(sky),
+                oskar_sky_Q_const(sky2), 0.0);
+        check_column(oskar_sky_reference_freq_hz_const(sky),
+                oskar_sky_reference_freq_hz_const(sky2), 0.0);
+        check_column(oskar_sky_spectral_index_const(sky),
+                oskar_sky_spectral_index_const(sky2), 1e-15);
+        check_column(oskar_sky_fwhm_major_rad_const(sky),
+                oskar_sky_fwhm_major_rad_const(sky2), 0.0);
+        oskar_sky_free(sky2, &status);
+    }
+
+    // Check that only the requested columns are read.
+    const int columns = OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_RA) |
+            OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_DEC) |
+            OSKAR_SKY_COLUMN(OSKAR_SKY_TAG_STOKES_I);
+    oskar_Sky* sky3 = oskar_sky_read_columns(filename, OSKAR_CPU,
+            columns, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    check_column(oskar_sky_dec_rad_const(sky),
+            oskar_sky_dec_rad_const(sky3), 1e-15);
+    EXPECT_DOUBLE_EQ(0.0, oskar_mem_double(
+            oskar_sky_reference_freq_hz(sky3), &status)[10]);
+    EXPECT_DOUBLE_EQ(0.0, oskar_mem_double(
+            oskar_sky_spectral_index(sky3), &status)[10]);
+
+    // Cleanup.
+    oskar_sky_free(sky, &status);
+    oskar_sky_free(sky3, &status);
+    remove(filename);
+}
@@ -31,6 +31,7 @@
 
 #include <mem/oskar_mem.h>
 #include <splines/oskar_splines.h>
+#include <telescope/station/element/private_spherical_wave_cache.h>
 
 struct oskar_Element
 {
@@ -70,6 +71,7 @@ struct oskar_Element
     int *common_phi_coords;
     int *l_max;
     oskar_Mem **sph_wave;
+    oskar_SphericalWaveCache* sph_wave_cache;
 };
 
 #ifndef OSKAR_ELEMENT_TYPEDEF_
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_SPHERICAL_WAVE_CACHE_H_
+#define OSKAR_PRIVATE_SPHERICAL_WAVE_CACHE_H_
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+
+/*
+ * The spherical wave basis functions depend only on the coordinates and
+ * on l_max, so they are stored for the last set of coordinates evaluated.
+ * If the same coordinates are used again (for example, at another
+ * frequency), the sum reduces to a dense complex matrix-vector product
+ * with the coefficients.
+ *
+ * Basis data are only stored for CPU arrays. Every element model has its
+ * own cache, so OSKAR_SPH_WAVE_CACHE_MAX_BYTES limits the total size of
+ * the basis data stored by all the caches in the process.
+ */
+#define OSKAR_SPH_WAVE_CACHE_MAX_BYTES (512 * 1024 * 1024)
+
+struct oskar_SphericalWaveCache;
+#ifndef OSKAR_SPHERICAL_WAVE_CACHE_TYPEDEF_
+#define OSKAR_SPHERICAL_WAVE_CACHE_TYPEDEF_
+typedef struct oskar_SphericalWaveCache oskar_SphericalWaveCache;
+#endif /* OSKAR_SPHERICAL_WAVE_CACHE_TYPEDEF_ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Creates an empty cache. */
+OSKAR_EXPORT
+oskar_SphericalWaveCache* oskar_spherical_wave_cache_create(void);
+
+/* Computes the normalisation factors needed up to the given l_max. */
+OSKAR_EXPORT
+void oskar_spherical_wave_cache_set_l_max(oskar_SphericalWaveCache* cache,
+        int l_max);
+
+/*
+ * Evaluates the spherical wave sum in the same way as
+ * oskar_evaluate_spherical_wave_sum(), using cached basis functions.
+ * Returns 0 without doing anything if the cache cannot be used, in which
+ * case oskar_evaluate_spherical_wave_sum() should be called instead.
+ */
+OSKAR_EXPORT
+int oskar_spherical_wave_cache_evaluate(oskar_SphericalWaveCache* cache,
+        int num_points, const oskar_Mem* theta, const oskar_Mem* phi_x,
+        const oskar_Mem* phi_y, int l_max, const oskar_Mem* alpha,
+        int offset, oskar_Mem* pattern, int* status);
+
+/* Returns the number of times the cached basis functions were reused. */
+OSKAR_EXPORT
+int oskar_spherical_wave_cache_num_hits(const oskar_SphericalWaveCache* cache);
+
+/* Frees the cache. */
+OSKAR_EXPORT
+void oskar_spherical_wave_cache_free(oskar_SphericalWaveCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_SPHERICAL_WAVE_CACHE_H_ */
@@ -68,6 +68,15 @@ void oskar_element_copy(oskar_Element* dst, const oskar_Element* src,
             dst->sph_wave[i] = oskar_mem_create(sph_wave_type, loc, 0, status);
         }
         oskar_mem_copy(dst->sph_wave[i], src->sph_wave[i], status);
+        if (src->sph_wave_cache && dst->mem_location == OSKAR_CPU)
+        {
+            if (!dst->sph_wave_cache)
+            {
+                dst->sph_wave_cache = oskar_spherical_wave_cache_create();
+            }
+            oskar_spherical_wave_cache_set_l_max(dst->sph_wave_cache,
+                    dst->l_max[i]);
+        }
     }
 }
 
@@ -85,10 +85,16 @@ void oskar_element_evaluate(
     {
         if (oskar_element_has_spherical_wave_data(model, id))
         {
-            oskar_evaluate_spherical_wave_sum(num_points_norm, theta, phi_x,
-                    (model->common_phi_coords[id] ? phi_x : phi_y),
-                    model->l_max[id], model->sph_wave[id],
-                    offset_out, output, status);
+            const oskar_Mem* phi_y_ =
+                    model->common_phi_coords[id] ? phi_x : phi_y;
+            if (!oskar_spherical_wave_cache_evaluate(model->sph_wave_cache,
+                    num_points_norm, theta, phi_x, phi_y_, model->l_max[id],
+                    model->sph_wave[id], offset_out, output, status))
+            {
+                oskar_evaluate_spherical_wave_sum(num_points_norm, theta,
+                        phi_x, phi_y_, model->l_max[id], model->sph_wave[id],
+                        offset_out, output, status);
+            }
         }
         else
         {
@@ -50,6 +50,7 @@ void oskar_element_free(oskar_Element* data, int* status)
     free(data->scalar_re);
     free(data->scalar_im);
     free(data->sph_wave);
+    oskar_spherical_wave_cache_free(data->sph_wave_cache);
 
     /* Free the structure itself. */
     free(data);
@@ -226,6 +226,17 @@ void oskar_element_load_spherical_wave_coeff(oskar_Element* data,
         if (data->l_max[i] == 0 || data->l_max[i] == l_max)
         {
             data->l_max[i] = l_max;
+
+            /* Compute normalisation factors for the basis function cache. */
+            if (data->mem_location == OSKAR_CPU)
+            {
+                if (!data->sph_wave_cache)
+                {
+                    data->sph_wave_cache = oskar_spherical_wave_cache_create();
+                }
+                oskar_spherical_wave_cache_set_l_max(data->sph_wave_cache,
+                        l_max);
+            }
             const size_t fname_len = 1 + strlen(filename);
             if (!data->filename_x[i])
             {
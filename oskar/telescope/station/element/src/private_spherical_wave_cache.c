@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "telescope/station/element/private_spherical_wave_cache.h"
+#include "math/define_legendre_polynomial.h"
+#include "math/oskar_cmath.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_SphericalWaveCache
+{
+    oskar_Mutex* mutex;
+    int norm_l_max;     /* Maximum order of normalisation factors. */
+    double* norm;       /* Normalisation factors, indexed like alpha. */
+
+    /* Key for the stored basis functions. */
+    int type, num_points, l_max, common_phi;
+    void *theta, *phi_x, *phi_y;
+
+    /* For each point and coefficient, the complex factors (qq, dd) that
+     * multiply the TM and TE coefficients. */
+    void *basis_x, *basis_y;
+    long long basis_bytes; /* Bytes reserved from the shared budget. */
+    int num_hits;
+};
+
+/* Total size of the basis functions stored by all caches. */
+static volatile long long total_basis_bytes = 0;
+
+/* Reserves bytes from the shared budget, returning 1 if successful. */
+static int reserve(oskar_SphericalWaveCache* cache, size_t bytes)
+{
+    const long long n = (long long) bytes;
+    if (oskar_atomic_add(&total_basis_bytes, n) >
+            (long long) OSKAR_SPH_WAVE_CACHE_MAX_BYTES)
+    {
+        oskar_atomic_add(&total_basis_bytes, -n);
+        return 0;
+    }
+    cache->basis_bytes = n;
+    return 1;
+}
+
+
+/* Frees the basis functions and returns their bytes to the budget. */
+static void release(oskar_SphericalWaveCache* cache)
+{
+    free(cache->basis_x);
+    free(cache->basis_y);
+    cache->basis_x = cache->basis_y = 0;
+    oskar_atomic_add(&total_basis_bytes, -cache->basis_bytes);
+    cache->basis_bytes = 0;
+}
+
+/* Returns the number of coefficients needed for l_max. */
+static int num_coeff(int l_max)
+{
+    return (l_max + 1) * (l_max + 1) - 1;
+}
+
+
+/* Evaluates the basis functions for one point, in the same order as the
+ * coefficients. Based on OSKAR_EVALUATE_SPHERICAL_WAVE_SUM. */
+static void basis_point(const double* norm, int l_max, double theta,
+        double phi, double* out)
+{
+    int l = 0, abs_m = 0;
+    double sin_t = 0.0, cos_t = 0.0;
+    if (theta < 1e-5) theta = 1e-5;
+    sin_t = sin(theta);
+    cos_t = cos(theta);
+    for (l = 1; l <= l_max; ++l)
+    {
+        const int ind0 = l * l - 1 + l;
+        for (abs_m = l; abs_m >= 0; --abs_m)
+        {
+            double p = 0.0, pds = 0.0, dpms = 0.0, sin_p = 0.0, cos_p = 0.0;
+            double* b = 0;
+            OSKAR_LEGENDRE2(double, l, abs_m, cos_t, sin_t, p, pds, dpms)
+            (void) p;
+            if (abs_m == 0)
+            {
+                b = out + 4 * ind0;
+                b[0] = -norm[ind0] * dpms;
+                b[1] = 0.0;
+                b[2] = 0.0;
+                b[3] = 0.0;
+            }
+            else
+            {
+                const double nf = norm[ind0 + abs_m];
+                sin_p = nf * sin(-abs_m * phi);
+                cos_p = nf * cos(-abs_m * phi);
+                b = out + 4 * (ind0 - abs_m);
+                b[0] = -cos_p * dpms;
+                b[1] = -sin_p * dpms;
+                b[2] = sin_p * pds * abs_m;
+                b[3] = -cos_p * pds * abs_m;
+                b = out + 4 * (ind0 + abs_m);
+                b[0] = -cos_p * dpms;
+                b[1] = sin_p * dpms;
+                b[2] = sin_p * pds * abs_m;
+                b[3] = cos_p * pds * abs_m;
+            }
+        }
+    }
+}
+
+
+static double coord(const void* ptr, int type, int i)
+{
+    return (type == OSKAR_DOUBLE) ?
+            ((const double*) ptr)[i] : (double) ((const float*) ptr)[i];
+}
+
+
+/* Returns 0 if a thread could not allocate its scratch row. */
+static int build_basis(const double* norm, int l_max, int type,
+        int num_points, const void* theta, const void* phi, void* basis)
+{
+    int num_failed = 0;
+    const int n_coeff = num_coeff(l_max);
+#pragma omp parallel
+    {
+        int i = 0, j = 0;
+        double* row = (double*) malloc(4 * n_coeff * sizeof(double));
+        if (!row)
+        {
+#pragma omp atomic
+            num_failed++;
+        }
+
+        /* All threads must agree whether to skip the work-sharing loop. */
+#pragma omp barrier
+#pragma omp for
+        for (i = 0; i < num_points; ++i)
+        {
+            if (num_failed) continue;
+            const size_t start = 4 * (size_t) n_coeff * i;
+            basis_point(norm, l_max,
+                    coord(theta, type, i), coord(phi, type, i), row);
+            if (type == OSKAR_DOUBLE)
+            {
+                memcpy((double*) basis + start, row,
+                        4 * n_coeff * sizeof(double));
+            }
+            else
+            {
+                float* out = (float*) basis + start;
+                for (j = 0; j < 4 * n_coeff; ++j) out[j] = (float) row[j];
+            }
+        }
+        free(row);
+    }
+    return !num_failed;
+}
+
+
+/* Sums the cached basis functions for X and Y, weighted by alpha. */
+#define OSKAR_SPH_WAVE_CACHE_SUM(NAME, FP, FP4c)\
+static void NAME(int num_points, const FP* phi_x, const FP* basis_x,\
+        const FP* basis_y, int stride, int n_coeff, const FP4c* alpha,\
+        int offset, FP4c* pattern)\
+{\
+    int i = 0;\
+    DO_PRAGMA(omp parallel for)\
+    for (i = 0; i < num_points; ++i) {\
+        int j = 0;\
+        FP4c out;\
+        const FP* bx = basis_x + 4 * (size_t) stride * i;\
+        const FP* by = basis_y + 4 * (size_t) stride * i;\
+        memset(&out, 0, sizeof(FP4c));\
+        if (phi_x[i] != phi_x[i]) {\
+            out.a.x = out.a.y = out.b.x = out.b.y = phi_x[i];\
+            out.c.x = out.c.y = out.d.x = out.d.y = phi_x[i];\
+        }\
+        else {\
+            for (j = 0; j < n_coeff; ++j) {\
+                const FP4c a = alpha[j];\
+                const FP qx_re = bx[4 * j + 0], qx_im = bx[4 * j + 1];\
+                const FP dx_re = bx[4 * j + 2], dx_im = bx[4 * j + 3];\
+                const FP qy_re = by[4 * j + 0], qy_im = by[4 * j + 1];\
+                const FP dy_re = by[4 * j + 2], dy_im = by[4 * j + 3];\
+                out.a.x += qx_re * a.b.x - qx_im * a.b.y;\
+                out.a.y += qx_re * a.b.y + qx_im * a.b.x;\
+                out.a.x -= dx_re * a.a.x - dx_im * a.a.y;\
+                out.a.y -= dx_re * a.a.y + dx_im * a.a.x;\
+                out.b.x += dx_re * a.b.x - dx_im * a.b.y;\
+                out.b.y += dx_re * a.b.y + dx_im * a.b.x;\
+                out.b.x += qx_re * a.a.x - qx_im * a.a.y;\
+                out.b.y += qx_re * a.a.y + qx_im * a.a.x;\
+                out.c.x += qy_re * a.d.x - qy_im * a.d.y;\
+                out.c.y += qy_re * a.d.y + qy_im * a.d.x;\
+                out.c.x -= dy_re * a.c.x - dy_im * a.c.y;\
+                out.c.y -= dy_re * a.c.y + dy_im * a.c.x;\
+                out.d.x += dy_re * a.d.x - dy_im * a.d.y;\
+                out.d.y += dy_re * a.d.y + dy_im * a.d.x;\
+                out.d.x += qy_re * a.c.x - qy_im * a.c.y;\
+                out.d.y += qy_re * a.c.y + qy_im * a.c.x;\
+            }\
+        }\
+        pattern[i + offset] = out;\
+    }\
+}
+
+OSKAR_SPH_WAVE_CACHE_SUM(sph_wave_cache_sum_float, float, float4c)
+OSKAR_SPH_WAVE_CACHE_SUM(sph_wave_cache_sum_double, double, double4c)
+
+
+static int same_coords(const void* cached, const oskar_Mem* mem, size_t bytes)
+{
+    return cached && !memcmp(cached, oskar_mem_void_const(mem), bytes);
+}
+
+
+/* Resizes a cached array, and copies the contents of mem into it if given. */
+static int store(void** cached, const oskar_Mem* mem, size_t bytes)
+{
+    void* t = realloc(*cached, bytes);
+    if (!t) return 0;
+    *cached = t;
+    if (mem) memcpy(*cached, oskar_mem_void_const(mem), bytes);
+    return 1;
+}
+
+
+oskar_SphericalWaveCache* oskar_spherical_wave_cache_create(void)
+{
+    oskar_SphericalWaveCache* cache = (oskar_SphericalWaveCache*)
+            calloc(1, sizeof(oskar_SphericalWaveCache));
+    if (!cache) return 0;
+    cache->mutex = oskar_mutex_create();
+    return cache;
+}
+
+
+void oskar_spherical_wave_cache_set_l_max(oskar_SphericalWaveCache* cache,
+        int l_max)
+{
+    int l = 0, m = 0;
+    double* t = 0;
+    if (!cache || l_max <= cache->norm_l_max) return;
+    t = (double*) realloc(cache->norm, num_coeff(l_max) * sizeof(double));
+    if (!t) return;
+    cache->norm = t;
+    cache->norm_l_max = l_max;
+    for (l = 1; l <= l_max; ++l)
+    {
+        const int ind0 = l * l - 1 + l;
+        const double f = (2 * l + 1) / (4.0 * M_PI * l * (l + 1));
+        double ratio = 1.0; /* (l - m)! / (l + m)! */
+        cache->norm[ind0] = sqrt(f);
+        for (m = 1; m <= l; ++m)
+        {
+            ratio /= (double) (l - m + 1) * (l + m);
+            cache->norm[ind0 - m] = cache->norm[ind0 + m] = sqrt(f * ratio);
+        }
+    }
+}
+
+
+int oskar_spherical_wave_cache_evaluate(oskar_SphericalWaveCache* cache,
+        int num_points, const oskar_Mem* theta, const oskar_Mem* phi_x,
+        const oskar_Mem* phi_y, int l_max, const oskar_Mem* alpha,
+        int offset, oskar_Mem* pattern, int* status)
+{
+    int hit = 0, l_max_store = l_max;
+    if (*status || !cache || num_points <= 0 || l_max <= 0) return 0;
+    const int prec = oskar_mem_precision(pattern);
+    const int common_phi = (phi_x == phi_y);
+    const size_t coord_bytes = num_points * oskar_mem_element_size(prec);
+    if (oskar_mem_location(pattern) != OSKAR_CPU ||
+            oskar_mem_location(theta) != OSKAR_CPU ||
+            oskar_mem_location(phi_x) != OSKAR_CPU ||
+            oskar_mem_location(phi_y) != OSKAR_CPU ||
+            oskar_mem_location(alpha) != OSKAR_CPU ||
+            !oskar_mem_is_matrix(pattern) ||
+            oskar_mem_type(alpha) != oskar_mem_type(pattern) ||
+            oskar_mem_type(theta) != prec ||
+            oskar_mem_type(phi_x) != prec ||
+            oskar_mem_type(phi_y) != prec ||
+            oskar_mem_length(theta) < (size_t) num_points ||
+            oskar_mem_length(phi_x) < (size_t) num_points ||
+            oskar_mem_length(phi_y) < (size_t) num_points ||
+            oskar_mem_length(alpha) < (size_t) num_coeff(l_max) ||
+            oskar_mem_length(pattern) < (size_t) (num_points + offset))
+    {
+        return 0;
+    }
+    oskar_mutex_lock(cache->mutex);
+
+    /* Check if the stored basis functions can be used. */
+    hit = (cache->type == prec && cache->num_points == num_points &&
+            cache->l_max >= l_max && cache->common_phi == common_phi &&
+            same_coords(cache->theta, theta, coord_bytes) &&
+            same_coords(cache->phi_x, phi_x, coord_bytes) &&
+            (common_phi || same_coords(cache->phi_y, phi_y, coord_bytes)));
+    if (hit)
+    {
+        cache->num_hits++;
+    }
+    else
+    {
+        /* Store basis functions up to the largest order that will be used,
+         * if there is room in the budget shared by all caches. */
+        int reserved = 0;
+        size_t bytes = 0;
+        const size_t coeff_bytes = 4 * oskar_mem_element_size(prec) *
+                (common_phi ? 1 : 2) * (size_t) num_points;
+        oskar_spherical_wave_cache_set_l_max(cache, l_max);
+        cache->num_points = 0;
+        release(cache);
+        if (cache->norm_l_max > l_max)
+        {
+            l_max_store = cache->norm_l_max;
+            bytes = coeff_bytes * num_coeff(l_max_store);
+            reserved = reserve(cache, bytes);
+        }
+        if (!reserved && cache->norm_l_max >= l_max)
+        {
+            l_max_store = l_max;
+            bytes = coeff_bytes * num_coeff(l_max_store);
+            reserved = reserve(cache, bytes);
+        }
+        if (reserved && store(&cache->basis_x, 0,
+                        bytes / (common_phi ? 1 : 2)) &&
+                (common_phi || store(&cache->basis_y, 0, bytes / 2)) &&
+                store(&cache->theta, theta, coord_bytes) &&
+                store(&cache->phi_x, phi_x, coord_bytes) &&
+                (common_phi || store(&cache->phi_y, phi_y, coord_bytes)))
+        {
+            hit = build_basis(cache->norm, l_max_store, prec, num_points,
+                    cache->theta, cache->phi_x, cache->basis_x) &&
+                    (common_phi || build_basis(cache->norm, l_max_store,
+                            prec, num_points, cache->theta, cache->phi_y,
+                            cache->basis_y));
+        }
+        if (hit)
+        {
+            cache->type = prec;
+            cache->num_points = num_points;
+            cache->l_max = l_max_store;
+            cache->common_phi = common_phi;
+        }
+        else
+        {
+            release(cache);
+        }
+    }
+
+    /* Evaluate the sum using the stored basis functions. */
+    if (hit)
+    {
+        const void* basis_y = common_phi ? cache->basis_x : cache->basis_y;
+        const int stride = num_coeff(cache->l_max);
+        if (prec == OSKAR_DOUBLE)
+        {
+            sph_wave_cache_sum_double(num_points,
+                    (const double*) cache->phi_x,
+                    (const double*) cache->basis_x, (const double*) basis_y,
+                    stride, num_coeff(l_max),
+                    oskar_mem_double4c_const(alpha, status), offset,
+                    oskar_mem_double4c(pattern, status));
+        }
+        else
+        {
+            sph_wave_cache_sum_float(num_points,
+                    (const float*) cache->phi_x,
+                    (const float*) cache->basis_x, (const float*) basis_y,
+                    stride, num_coeff(l_max),
+                    oskar_mem_float4c_const(alpha, status), offset,
+                    oskar_mem_float4c(pattern, status));
+        }
+    }
+    oskar_mutex_unlock(cache->mutex);
+    return hit;
+}
+
+
+int oskar_spherical_wave_cache_num_hits(const oskar_SphericalWaveCache* cache)
+{
+    return cache ? cache->num_hits : 0;
+}
+
+
+void oskar_spherical_wave_cache_free(oskar_SphericalWaveCache* cache)
+{
+    if (!cache) return;
+    release(cache);
+    oskar_mutex_free(cache->mutex);
+    free(cache->norm);
+    free(cache->theta);
+    free(cache->phi_x);
+    free(cache->phi_y);
+    free(cache);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_EVALUATE_ARRAY_FACTOR_FFT_H_
+#define OSKAR_EVALUATE_ARRAY_FACTOR_FFT_H_
+
+/**
+ * @file oskar_evaluate_array_factor_fft.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <telescope/station/oskar_station.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Evaluates the array factor of a station on a lattice using an FFT.
+ *
+ * @details
+ * This function evaluates the same sum as oskar_dftw(), for a station
+ * with elements on a regular lattice in the horizontal plane
+ * (as found by oskar_station_analyse()), where the same values in
+ * \p data apply to all elements.
+ *
+ * The weights are gridded onto the lattice and transformed using an
+ * oversampled 2D FFT, which is interpolated to each direction.
+ * The transformed grid is kept in the work buffer, and is re-used while
+ * the weights and the frequency do not change. One grid is kept for each
+ * depth of a hierarchical station and each feed.
+ *
+ * The FFT is only used if it has been enabled using
+ * oskar_station_work_set_array_factor_fft(), if all arrays are in CPU
+ * memory, and if it would be faster than the direct sum.
+ * Otherwise, this function returns 0 without doing anything, and the
+ * array factor should be evaluated using oskar_dftw() instead.
+ *
+ * @param[in]     station       Station model.
+ * @param[in]     work          Station beam workspace.
+ * @param[in]     depth         Depth of the station in the hierarchy.
+ * @param[in]     feed          Feed index (0 or 1) of the element positions.
+ * @param[in]     normalise     If true, normalise by the number of elements.
+ * @param[in]     wavenumber    Wavenumber, in radians per metre.
+ * @param[in]     weights       Complex element weights.
+ * @param[in]     offset_coord  Start offset into direction cosine arrays.
+ * @param[in]     num_points    Number of directions.
+ * @param[in]     x             Horizontal x direction cosines.
+ * @param[in]     y             Horizontal y direction cosines.
+ * @param[in]     data          Values (e.g. element patterns) at each point.
+ * @param[in]     eval_x        If true, evaluate the X polarisation rows.
+ * @param[in]     eval_y        If true, evaluate the Y polarisation rows.
+ * @param[in]     offset_out    Start offset into output array.
+ * @param[in,out] output        Output array.
+ * @param[in,out] status        Status return code.
+ *
+ * @return 1 if the array factor was evaluated, or 0 if not.
+ */
+OSKAR_EXPORT
+int oskar_evaluate_array_factor_fft(
+        const oskar_Station* station,
+        oskar_StationWork* work,
+        int depth,
+        int feed,
+        int normalise,
+        double wavenumber,
+        const oskar_Mem* weights,
+        int offset_coord,
+        int num_points,
+        const oskar_Mem* x,
+        const oskar_Mem* y,
+        const oskar_Mem* data,
+        int eval_x,
+        int eval_y,
+        int offset_out,
+        oskar_Mem* output,
+        int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
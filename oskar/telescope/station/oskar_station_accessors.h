@@ -152,6 +152,9 @@ int oskar_station_common_pol_beams(const oskar_Station* model);
 OSKAR_EXPORT
 int oskar_station_array_is_3d(const oskar_Station* model);
 
+OSKAR_EXPORT
+int oskar_station_lattice_size(const oskar_Station* model, int dim);
+
 OSKAR_EXPORT
 int oskar_station_apply_element_errors(const oskar_Station* model);
 
@@ -72,6 +72,11 @@ OSKAR_EXPORT
 void oskar_station_work_set_isoplanatic_screen(oskar_StationWork* work,
         int flag);
 
+/* Allows array factors of stations on a lattice to be evaluated by FFT. */
+OSKAR_EXPORT
+void oskar_station_work_set_array_factor_fft(oskar_StationWork* work,
+        int flag);
+
 OSKAR_EXPORT
 void oskar_station_work_set_tec_screen_common_params(oskar_StationWork* work,
         char screen_type, double screen_height_km, double screen_pixel_size_m,
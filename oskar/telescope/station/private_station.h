@@ -58,6 +58,9 @@ struct oskar_Station
     int array_is_3d;              /* True if array is 3-dimensional (auto determined; default false). */
     int apply_element_errors;     /* True if element gain and phase errors should be applied (auto determined; default false). */
     int apply_element_weight;     /* True if weights should be modified by user-supplied complex beamforming weights (auto determined; default false). */
+    int lattice_size[2];          /* Number of lattice cells in x and y, if elements are on a regular grid (auto determined; default 0). */
+    double lattice_origin[2];     /* Position of the first lattice cell in x and y, in metres. */
+    double lattice_spacing[2];    /* Lattice spacing in x and y, in metres. */
     unsigned int seed_time_variable_errors;       /* Seed for time variable errors. */
     oskar_Mem* element_true_enu_metres[2][3];     /* True horizon element ENU coordinates, in metres. */
     oskar_Mem* element_measured_enu_metres[2][3]; /* Measured horizon element ENU coordinates, in metres. */
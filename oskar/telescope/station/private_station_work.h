@@ -6,8 +6,20 @@
 #ifndef OSKAR_PRIVATE_STATION_WORK_H_
 #define OSKAR_PRIVATE_STATION_WORK_H_
 
+#include <math/oskar_fft.h>
 #include <mem/oskar_mem.h>
 
+/* Transformed weights of one station, for the FFT array factor. */
+struct oskar_StationWorkArrayFactor
+{
+    int grid_size;               /* Side length of the FFT grid. */
+    double wavenumber;           /* Wavenumber of the gridded weights. */
+    const void* station;         /* Station of the gridded weights. */
+    oskar_Mem* grid;             /* Complex double. Transformed weights. */
+    oskar_Mem* weights;          /* Copy of the gridded weights. */
+};
+typedef struct oskar_StationWorkArrayFactor oskar_StationWorkArrayFactor;
+
 struct oskar_StationWork
 {
     oskar_Mem* weights;          /* Complex scalar. */
@@ -39,6 +51,16 @@ struct oskar_StationWork
 
     /* HARP data. */
     oskar_Mem *poly, *ee, *qq, *dd, *phase_fac, *beam_coeffs, *pth, *pph;
+
+    /* Array factors evaluated using an FFT, for stations on a lattice. */
+    /* One grid is kept for each depth and feed, so the levels of a
+     * hierarchical station do not replace each other's grids. */
+    int array_factor_fft;        /* True if the FFT may be used. */
+    int af_fft_size;             /* Side length of the FFT plan. */
+    int num_af;                  /* Number of cached grids. */
+    oskar_FFT* af_fft;
+    oskar_StationWorkArrayFactor* af; /* Cached grids, by depth and feed. */
+    oskar_Mem* af_values;        /* Complex double. Array factor at points. */
 };
 
 #ifndef OSKAR_STATION_WORK_TYPEDEF_
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "telescope/station/oskar_evaluate_array_factor_fft.h"
+#include "telescope/station/private_station.h"
+#include "telescope/station/private_station_work.h"
+#include "math/oskar_cmath.h"
+#include "math/oskar_fft.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Oversampling factor of the FFT grid relative to the lattice.
+ * With cubic interpolation, the error relative to the peak of the array
+ * factor is bounded by about (2 pi / OVERSAMPLE)^4 / 40, or 4e-5.
+ */
+#define OVERSAMPLE 32
+
+static void cubic_weights(double t, double w[4])
+{
+    const double tm1 = t - 1.0, tm2 = t - 2.0, tp1 = t + 1.0;
+    w[0] = -t * tm1 * tm2 / 6.0;
+    w[1] = tp1 * tm1 * tm2 / 2.0;
+    w[2] = -tp1 * t * tm2 / 2.0;
+    w[3] = tp1 * t * tm1 / 6.0;
+}
+
+
+static void grid_weights(const oskar_Station* s, int feed,
+        const oskar_Mem* weights, int n, double* grid, int* status)
+{
+    int i = 0;
+    const int num_elements = s->num_elements;
+    const oskar_Mem* x = s->element_true_enu_metres[feed][0];
+    const oskar_Mem* y = s->element_true_enu_metres[feed][1];
+    if (!x) x = s->element_true_enu_metres[0][0];
+    if (!y) y = s->element_true_enu_metres[0][1];
+    memset(grid, 0, 2 * sizeof(double) * n * n);
+    for (i = 0; i < num_elements; ++i)
+    {
+        double w[2];
+        const double xi = oskar_mem_get_element(x, i, status);
+        const double yi = oskar_mem_get_element(y, i, status);
+        const int p = (int) floor((xi - s->lattice_origin[0]) /
+                s->lattice_spacing[0] + 0.5);
+        const int q = (int) floor((yi - s->lattice_origin[1]) /
+                s->lattice_spacing[1] + 0.5);
+
+        /* Reverse the grid, so the forward FFT gives a positive exponent. */
+        const size_t a = (size_t) ((n - p) % n) + (size_t) n * ((n - q) % n);
+        if (oskar_mem_is_double(weights))
+        {
+            const double* t = oskar_mem_double_const(weights, status);
+            w[0] = t[2 * i];
+            w[1] = t[2 * i + 1];
+        }
+        else
+        {
+            const float* t = oskar_mem_float_const(weights, status);
+            w[0] = t[2 * i];
+            w[1] = t[2 * i + 1];
+        }
+        grid[2 * a] += w[0];
+        grid[2 * a + 1] += w[1];
+    }
+}
+
+
+static oskar_StationWorkArrayFactor* get_cache(oskar_StationWork* work,
+        int depth, int feed, int* status)
+{
+    const int i = 2 * depth + feed;
+    if (i >= work->num_af)
+    {
+        oskar_StationWorkArrayFactor* t = (oskar_StationWorkArrayFactor*)
+                realloc(work->af, (i + 1) * sizeof(*t));
+        if (!t)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return 0;
+        }
+        memset(t + work->num_af, 0, (i + 1 - work->num_af) * sizeof(*t));
+        work->af = t;
+        work->num_af = i + 1;
+    }
+    return &work->af[i];
+}
+
+
+static int grid_is_current(const oskar_StationWorkArrayFactor* c,
+        const oskar_Station* s, double wavenumber,
+        const oskar_Mem* weights, int n, int* status)
+{
+    return c->grid_size == n && c->station == (const void*) s &&
+            c->wavenumber == wavenumber && c->weights &&
+            oskar_mem_type(c->weights) == oskar_mem_type(weights) &&
+            oskar_mem_length(c->weights) >= (size_t) s->num_elements &&
+            !oskar_mem_different(c->weights, weights,
+                    (size_t) s->num_elements, status);
+}
+
+
+static void update_grid(oskar_StationWork* work,
+        oskar_StationWorkArrayFactor* c, const oskar_Station* s,
+        int feed, double wavenumber, const oskar_Mem* weights, int n,
+        int* status)
+{
+    if (work->af_fft_size != n)
+    {
+        oskar_fft_free(work->af_fft);
+        work->af_fft = oskar_fft_create(OSKAR_DOUBLE, OSKAR_CPU, 2, n, 0,
+                status);
+        work->af_fft_size = n;
+    }
+    if (c->grid_size != n)
+    {
+        oskar_mem_free(c->grid, status);
+        c->grid = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+                (size_t) n * n, status);
+        c->grid_size = n;
+    }
+    if (!c->weights)
+    {
+        c->weights = oskar_mem_create(oskar_mem_type(weights),
+                OSKAR_CPU, 0, status);
+    }
+    c->station = 0;
+    if (*status) return;
+    grid_weights(s, feed, weights, n, oskar_mem_double(c->grid, status),
+            status);
+    oskar_fft_exec(work->af_fft, c->grid, status);
+    oskar_mem_copy(c->weights, weights, status);
+    if (*status) return;
+    c->station = (const void*) s;
+    c->wavenumber = wavenumber;
+}
+
+
+static void interpolate(const oskar_Station* s, const double* grid, int n,
+        double wavenumber, double norm, int offset_coord, int num_points,
+        const oskar_Mem* x, const oskar_Mem* y, double* af, int* status)
+{
+    int j = 0;
+    const int is_dbl = oskar_mem_is_double(x);
+    const double* x_d = is_dbl ? oskar_mem_double_const(x, status) : 0;
+    const double* y_d = is_dbl ? oskar_mem_double_const(y, status) : 0;
+    const float* x_f = is_dbl ? 0 : oskar_mem_float_const(x, status);
+    const float* y_f = is_dbl ? 0 : oskar_mem_float_const(y, status);
+    const double scale_x = wavenumber * s->lattice_spacing[0] * n / (2 * M_PI);
+    const double scale_y = wavenumber * s->lattice_spacing[1] * n / (2 * M_PI);
+#pragma omp parallel for private(j)
+    for (j = 0; j < num_points; ++j)
+    {
+        int a = 0, b = 0;
+        double wa[4], wb[4], re = 0.0, im = 0.0, sin_p = 0.0, cos_p = 0.0;
+        const int k = j + offset_coord;
+        const double xo = is_dbl ? x_d[k] : (double) x_f[k];
+        const double yo = is_dbl ? y_d[k] : (double) y_f[k];
+
+        /* Find the position in the grid, which is periodic. */
+        double u = xo * scale_x, v = yo * scale_y;
+        if (u != u || v != v)
+        {
+            /* Not a valid direction (for example, outside the sky). */
+            af[2 * j] = af[2 * j + 1] = u + v;
+            continue;
+        }
+        u -= n * floor(u / n);
+        v -= n * floor(v / n);
+        const int a0 = (int) floor(u), b0 = (int) floor(v);
+        cubic_weights(u - a0, wa);
+        cubic_weights(v - b0, wb);
+        for (b = 0; b < 4; ++b)
+        {
+            double row_re = 0.0, row_im = 0.0;
+            const size_t row = (size_t) n * ((b0 + b - 1 + n) % n);
+            for (a = 0; a < 4; ++a)
+            {
+                const double* g = grid + 2 * (row + (a0 + a - 1 + n) % n);
+                row_re += wa[a] * g[0];
+                row_im += wa[a] * g[1];
+            }
+            re += wb[b] * row_re;
+            im += wb[b] * row_im;
+        }
+
+        /* Apply the phase of the lattice origin. */
+        const double phase = wavenumber * (xo * s->lattice_origin[0] +
+                yo * s->lattice_origin[1]);
+        sin_p = sin(phase);
+        cos_p = cos(phase);
+        af[2 * j]     = norm * (re * cos_p - im * sin_p);
+        af[2 * j + 1] = norm * (re * sin_p + im * cos_p);
+    }
+}
+
+
+static void apply(int num_points, const double* af, const oskar_Mem* data,
+        int eval_x, int eval_y, int offset_out, oskar_Mem* output,
+        int* status)
+{
+    int j = 0;
+    const int is_dbl = oskar_mem_is_double(output);
+    const int num_comp = oskar_mem_is_matrix(output) ? 4 : 1;
+    const int c_start = (num_comp == 4 && !eval_x) ? 2 : 0;
+    const int c_end = (num_comp == 4 && !eval_y) ? 2 : num_comp;
+    const double* in_d = is_dbl ? oskar_mem_double_const(data, status) : 0;
+    const float* in_f = is_dbl ? 0 : oskar_mem_float_const(data, status);
+    double* out_d = is_dbl ? oskar_mem_double(output, status) : 0;
+    float* out_f = is_dbl ? 0 : oskar_mem_float(output, status);
+#pragma omp parallel for private(j)
+    for (j = 0; j < num_points; ++j)
+    {
+        int c = 0;
+        const double af_re = af[2 * j], af_im = af[2 * j + 1];
+        for (c = c_start; c < c_end; ++c)
+        {
+            const size_t i_in = 2 * ((size_t) num_comp * j + c);
+            const size_t i_out = 2 * ((size_t) num_comp * (j + offset_out) + c);
+            const double d_re = is_dbl ? in_d[i_in] : in_f[i_in];
+            const double d_im = is_dbl ? in_d[i_in + 1] : in_f[i_in + 1];
+            const double re = d_re * af_re - d_im * af_im;
+            const double im = d_re * af_im + d_im * af_re;
+            if (is_dbl)
+            {
+                out_d[i_out] = re;
+                out_d[i_out + 1] = im;
+            }
+            else
+            {
+                out_f[i_out] = (float) re;
+                out_f[i_out + 1] = (float) im;
+            }
+        }
+    }
+}
+
+
+int oskar_evaluate_array_factor_fft(
+        const oskar_Station* station,
+        oskar_StationWork* work,
+        int depth,
+        int feed,
+        int normalise,
+        double wavenumber,
+        const oskar_Mem* weights,
+        int offset_coord,
+        int num_points,
+        const oskar_Mem* x,
+        const oskar_Mem* y,
+        const oskar_Mem* data,
+        int eval_x,
+        int eval_y,
+        int offset_out,
+        oskar_Mem* output,
+        int* status)
+{
+    int n = 16;
+    oskar_StationWorkArrayFactor* cache = 0;
+    if (*status || !work->array_factor_fft) return 0;
+    const int num_elements = station->num_elements;
+    const int size_max = station->lattice_size[0] > station->lattice_size[1] ?
+            station->lattice_size[0] : station->lattice_size[1];
+    if (size_max == 0 || station->array_is_3d || num_points == 0 ||
+            oskar_mem_location(output) != OSKAR_CPU ||
+            oskar_mem_location(data) != OSKAR_CPU ||
+            oskar_mem_location(weights) != OSKAR_CPU ||
+            oskar_mem_location(x) != OSKAR_CPU ||
+            oskar_mem_location(y) != OSKAR_CPU ||
+            oskar_mem_type(data) != oskar_mem_type(output))
+    {
+        return 0;
+    }
+
+    /* Only use the FFT if it would be faster than the direct sum. */
+    while (n < OVERSAMPLE * size_max) n *= 2;
+    cache = get_cache(work, depth, feed, status);
+    if (!cache) return 0;
+    const int current = grid_is_current(cache, station, wavenumber,
+            weights, n, status);
+    const double cost_dft = (double) num_points * num_elements;
+    const double cost_fft = 4.0 * num_points + (current ? 0.0 :
+            (double) n * n * log((double) n) / log(2.0) / 4.0);
+    if (cost_fft >= cost_dft) return 0;
+
+    /* Transform the weights, if not already done. */
+    if (!current)
+    {
+        update_grid(work, cache, station, feed, wavenumber, weights, n,
+                status);
+    }
+    if (!work->af_values)
+    {
+        work->af_values = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+                0, status);
+    }
+    oskar_mem_ensure(work->af_values, (size_t) num_points, status);
+    oskar_mem_ensure(output, (size_t) offset_out + num_points, status);
+    if (*status) return 1;
+
+    /* Interpolate the array factor, and multiply it with the data. */
+    double* af = oskar_mem_double(work->af_values, status);
+    interpolate(station, oskar_mem_double_const(cache->grid, status), n,
+            wavenumber, normalise ? 1.0 / num_elements : 1.0,
+            offset_coord, num_points, x, y, af, status);
+    apply(num_points, af, data, eval_x, eval_y, offset_out, output, status);
+    return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
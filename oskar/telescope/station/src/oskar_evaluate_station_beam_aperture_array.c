@@ -7,6 +7,7 @@
 
 #include "convert/oskar_convert_enu_directions_to_theta_phi.h"
 #include "convert/oskar_convert_theta_phi_to_ludwig3_components.h"
+#include "telescope/station/oskar_evaluate_array_factor_fft.h"
 #include "telescope/station/oskar_station_evaluate_element_weights.h"
 #include "telescope/station/element/oskar_element_evaluate.h"
 #include "telescope/station/oskar_blank_below_horizon.h"
@@ -207,6 +208,16 @@ static void oskar_evaluate_station_beam_aperture_array_private(
                 oskar_station_evaluate_element_weights(s, i, frequency_hz,
                         beam_x, beam_y, beam_z, time_index,
                         work->weights, work->weights_scratch, status);
+
+                /* Use an FFT if all elements have the same pattern. */
+                if (element_types_ptr && num_element_types == 1 &&
+                        oskar_evaluate_array_factor_fft(s, work, depth, i,
+                                norm_array, wavenumber, work->weights,
+                                offset_points, num_points, x, y, signal,
+                                eval_x, eval_y, offset_out, beam, status))
+                {
+                    continue;
+                }
                 oskar_dftw(norm_array, num_elements, wavenumber, work->weights,
                         oskar_station_element_true_enu_metres_const(s, i, 0),
                         oskar_station_element_true_enu_metres_const(s, i, 1),
@@ -271,6 +282,14 @@ static void oskar_evaluate_station_beam_aperture_array_private(
             oskar_station_evaluate_element_weights(s, i, frequency_hz,
                     beam_x, beam_y, beam_z, time_index,
                     work->weights, work->weights_scratch, status);
+            if (oskar_station_identical_children(s) &&
+                    oskar_evaluate_array_factor_fft(s, work, depth, i,
+                            norm_array, wavenumber, work->weights,
+                            offset_points, num_points, x, y, signal,
+                            eval_x, eval_y, offset_out, beam, status))
+            {
+                continue;
+            }
             oskar_dftw(norm_array, num_elements, wavenumber, work->weights,
                     oskar_station_element_true_enu_metres_const(s, i, 0),
                     oskar_station_element_true_enu_metres_const(s, i, 1),
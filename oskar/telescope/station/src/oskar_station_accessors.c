@@ -173,6 +173,11 @@ int oskar_station_array_is_3d(const oskar_Station* model)
     return model ? model->array_is_3d : 0;
 }
 
+int oskar_station_lattice_size(const oskar_Station* model, int dim)
+{
+    return model ? model->lattice_size[dim] : 0;
+}
+
 int oskar_station_apply_element_errors(const oskar_Station* model)
 {
     return model ? model->apply_element_errors : 0;
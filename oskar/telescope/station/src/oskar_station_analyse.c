@@ -6,12 +6,18 @@
 #include "telescope/station/private_station.h"
 #include "telescope/station/oskar_station.h"
 
+#include <math.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Largest lattice dimension that will be recognised. */
+#define MAX_LATTICE_SIZE 64
+
+static void analyse_lattice(oskar_Station* station, int* status);
+
 void oskar_station_analyse(oskar_Station* station,
         int* finished_identical_station_check, int* status)
 {
@@ -189,6 +195,9 @@ void oskar_station_analyse(oskar_Station* station,
         }
     }
 
+    /* Check if the elements are on a regular grid. */
+    analyse_lattice(station, status);
+
     /* Check if station has child stations. */
     if (oskar_station_has_child(station))
     {
@@ -221,6 +230,92 @@ void oskar_station_analyse(oskar_Station* station,
     }
 }
 
+static int find_lattice(int num, const double* v, double tol,
+        double* origin, double* spacing)
+{
+    int i = 0, size = 0;
+    double min_v = v[0], max_v = v[0], d = 0.0;
+    for (i = 1; i < num; ++i)
+    {
+        if (v[i] < min_v) min_v = v[i];
+        if (v[i] > max_v) max_v = v[i];
+    }
+    *origin = min_v;
+    *spacing = 1.0;
+    if (max_v - min_v <= tol) return 1;
+
+    /* Use the smallest non-zero offset from the minimum as the spacing. */
+    d = max_v - min_v;
+    for (i = 0; i < num; ++i)
+    {
+        const double t = v[i] - min_v;
+        if (t > tol && t < d) d = t;
+    }
+    size = 1 + (int) floor((max_v - min_v) / d + 0.5);
+    if (size > MAX_LATTICE_SIZE) return 0;
+    for (i = 0; i < num; ++i)
+    {
+        const double t = (v[i] - min_v) / d;
+        if (fabs(t - floor(t + 0.5)) * d > tol) return 0;
+    }
+    *spacing = d;
+    return size;
+}
+
+
+static void analyse_lattice(oskar_Station* station, int* status)
+{
+    int i = 0, dim = 0, size[2] = {0, 0};
+    char* used = 0;
+    oskar_Mem* coords[2] = {0, 0};
+    const int num_elements = station->num_elements;
+    station->lattice_size[0] = station->lattice_size[1] = 0;
+    if (*status || num_elements < 4 || station->array_is_3d ||
+            station->element_true_enu_metres[1][0]) return;
+
+    /* The tolerance allows for rounding of single-precision coordinates. */
+    const double tol = (station->precision == OSKAR_DOUBLE) ? 1e-9 : 1e-5;
+    for (dim = 0; dim < 2; ++dim)
+    {
+        coords[dim] = oskar_mem_convert_precision(
+                station->element_true_enu_metres[0][dim], OSKAR_DOUBLE,
+                status);
+        if (*status) break;
+        size[dim] = find_lattice(num_elements,
+                oskar_mem_double_const(coords[dim], status), tol,
+                &station->lattice_origin[dim],
+                &station->lattice_spacing[dim]);
+        if (size[dim] == 0) break;
+    }
+
+    /* Check that no two elements share a cell. */
+    if (size[0] > 0 && size[1] > 0)
+    {
+        const double* x = oskar_mem_double_const(coords[0], status);
+        const double* y = oskar_mem_double_const(coords[1], status);
+        used = (char*) calloc((size_t) size[0] * size[1], 1);
+
+        /* If there is not enough memory, do not use the lattice. */
+        for (i = 0; used && i < num_elements; ++i)
+        {
+            const int p = (int) floor((x[i] - station->lattice_origin[0]) /
+                    station->lattice_spacing[0] + 0.5);
+            const int q = (int) floor((y[i] - station->lattice_origin[1]) /
+                    station->lattice_spacing[1] + 0.5);
+            if (used[p + q * size[0]]) break;
+            used[p + q * size[0]] = 1;
+        }
+        if (used && i == num_elements)
+        {
+            station->lattice_size[0] = size[0];
+            station->lattice_size[1] = size[1];
+        }
+        free(used);
+    }
+    oskar_mem_free(coords[0], status);
+    oskar_mem_free(coords[1], status);
+}
+
 #ifdef __cplusplus
 }
 #endif
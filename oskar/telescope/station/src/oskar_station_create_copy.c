@@ -66,6 +66,12 @@ oskar_Station* oskar_station_create_copy(const oskar_Station* src,
     dst->array_is_3d = src->array_is_3d;
     dst->apply_element_errors = src->apply_element_errors;
     dst->apply_element_weight = src->apply_element_weight;
+    for (dim = 0; dim < 2; dim++)
+    {
+        dst->lattice_size[dim] = src->lattice_size[dim];
+        dst->lattice_origin[dim] = src->lattice_origin[dim];
+        dst->lattice_spacing[dim] = src->lattice_spacing[dim];
+    }
     dst->seed_time_variable_errors = src->seed_time_variable_errors;
     dst->swap_xy = src->swap_xy;
     dst->num_permitted_beams = src->num_permitted_beams;
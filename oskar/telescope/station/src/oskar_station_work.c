@@ -95,6 +95,14 @@ void oskar_station_work_free(oskar_StationWork* work, int* status)
     oskar_mem_free(work->beam_coeffs, status);
     oskar_mem_free(work->pth, status);
     oskar_mem_free(work->pph, status);
+    for (i = 0; i < work->num_af; ++i)
+    {
+        oskar_mem_free(work->af[i].grid, status);
+        oskar_mem_free(work->af[i].weights, status);
+    }
+    free(work->af);
+    oskar_fft_free(work->af_fft);
+    oskar_mem_free(work->af_values, status);
     free(work);
 }
 
@@ -128,6 +136,12 @@ void oskar_station_work_set_isoplanatic_screen(oskar_StationWork* work,
     work->isoplanatic_screen = flag;
 }
 
+void oskar_station_work_set_array_factor_fft(oskar_StationWork* work,
+        int flag)
+{
+    work->array_factor_fft = flag;
+}
+
 void oskar_station_work_set_tec_screen_common_params(oskar_StationWork* work,
         char screen_type, double screen_height_km, double screen_pixel_size_m,
         double screen_time_interval_sec)
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/oskar_cmath.h"
+#include "math/oskar_dftw.h"
+#include "telescope/station/oskar_evaluate_array_factor_fft.h"
+#include "telescope/station/oskar_station.h"
+#include "telescope/station/test/test_max_error.h"
+#include "utility/oskar_get_error_string.h"
+
+static oskar_Station* create_lattice(int type, int num_x, int num_y,
+        int* status)
+{
+    int dummy = 0;
+    oskar_Station* station = oskar_station_create(type, OSKAR_CPU,
+            num_x * num_y, status);
+    for (int iy = 0, i = 0; iy < num_y; ++iy)
+    {
+        for (int ix = 0; ix < num_x; ++ix, ++i)
+        {
+            const double xyz[] = {1.25 * ix - 7.0, 1.5 * iy + 3.0, 0.0};
+            oskar_station_set_element_coords(station, 0, i, xyz, xyz, status);
+        }
+    }
+    oskar_station_analyse(station, &dummy, status);
+    return station;
+}
+
+static void check_fft(int precision, int matrix, double tol)
+{
+    int status = 0;
+    const int num_points = 20000, num_x = 16, num_y = 12;
+    const int num_elements = num_x * num_y;
+    const double wavenumber = 2.0 * M_PI * 150e6 / 299792458.0;
+    const int type = precision | OSKAR_COMPLEX | (matrix ? OSKAR_MATRIX : 0);
+    oskar_Station* station = create_lattice(precision, num_x, num_y, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    EXPECT_EQ(num_x, oskar_station_lattice_size(station, 0));
+    EXPECT_EQ(num_y, oskar_station_lattice_size(station, 1));
+
+    // Create random weights, directions and element patterns.
+    oskar_Mem* weights = oskar_mem_create(precision | OSKAR_COMPLEX,
+            OSKAR_CPU, num_elements, &status);
+    oskar_Mem* x = oskar_mem_create(precision, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* y = oskar_mem_create(precision, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* data = oskar_mem_create(type, OSKAR_CPU, num_points, &status);
+    oskar_Mem* expected = oskar_mem_create(type, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* beam = oskar_mem_create(type, OSKAR_CPU, num_points, &status);
+    oskar_mem_random_uniform(weights, 1, 2, 3, 4, &status);
+    oskar_mem_random_uniform(x, 5, 6, 7, 8, &status);
+    oskar_mem_random_uniform(y, 9, 10, 11, 12, &status);
+    oskar_mem_random_uniform(data, 13, 14, 15, 16, &status);
+    oskar_mem_add_real(x, -0.5, &status);
+    oskar_mem_add_real(y, -0.5, &status);
+    oskar_mem_scale_real(x, 1.4, 0, num_points, &status);
+    oskar_mem_scale_real(y, 1.4, 0, num_points, &status);
+    oskar_mem_clear_contents(expected, &status);
+    oskar_mem_clear_contents(beam, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // The FFT must be enabled explicitly.
+    oskar_StationWork* work = oskar_station_work_create(precision,
+            OSKAR_CPU, &status);
+    EXPECT_EQ(0, oskar_evaluate_array_factor_fft(station, work, 1, 0, 1,
+            wavenumber, weights, 0, num_points, x, y, data, 1, 0, 0,
+            beam, &status));
+    oskar_station_work_set_array_factor_fft(work, 1);
+
+    // Compare against the direct sum, for the X rows only.
+    oskar_Mem* data_idx = oskar_mem_create(OSKAR_INT, OSKAR_CPU,
+            num_elements, &status);
+    oskar_mem_clear_contents(data_idx, &status);
+    oskar_dftw(1, num_elements, wavenumber, weights,
+            oskar_station_element_true_enu_metres_const(station, 0, 0),
+            oskar_station_element_true_enu_metres_const(station, 0, 1),
+            0, 0, num_points, x, y, 0, data_idx, data, 1, 0, 0, expected,
+            &status);
+    for (int trial = 0; trial < 2; ++trial)
+    {
+        // The second evaluation re-uses the transformed grid.
+        EXPECT_EQ(1, oskar_evaluate_array_factor_fft(station, work, 1, 0, 1,
+                wavenumber, weights, 0, num_points, x, y, data, 1, 0, 0,
+                beam, &status));
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        EXPECT_LT(max_error(beam, expected), tol);
+    }
+
+    // Check that an irregular layout is not detected as a lattice.
+    int dummy = 0;
+    const double xyz[] = {0.1, 0.2, 0.0};
+    oskar_station_set_element_coords(station, 0, 5, xyz, xyz, &status);
+    oskar_station_analyse(station, &dummy, &status);
+    EXPECT_EQ(0, oskar_station_lattice_size(station, 0));
+    EXPECT_EQ(0, oskar_evaluate_array_factor_fft(station, work, 1, 0, 1,
+            wavenumber, weights, 0, num_points, x, y, data, 1, 0, 0,
+            beam, &status));
+
+    oskar_station_work_free(work, &status);
+    oskar_station_free(station, &status);
+    oskar_mem_free(data_idx, &status);
+    oskar_mem_free(weights, &status);
+    oskar_mem_free(x, &status);
+    oskar_mem_free(y, &status);
+    oskar_mem_free(data, &status);
+    oskar_mem_free(expected, &status);
+    oskar_mem_free(beam, &status);
+}
+
+TEST(evaluate_array_factor_fft, scalar_double)
+{
+    check_fft(OSKAR_DOUBLE, 0, 5e-5);
+}
+
+TEST(evaluate_array_factor_fft, matrix_double)
+{
+    check_fft(OSKAR_DOUBLE, 1, 5e-5);
+}
+
+TEST(evaluate_array_factor_fft, scalar_single)
+{
+    check_fft(OSKAR_SINGLE, 0, 1e-4);
+}
+
+TEST(evaluate_array_factor_fft, matrix_single)
+{
+    check_fft(OSKAR_SINGLE, 1, 1e-4);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "telescope/station/element/oskar_evaluate_spherical_wave_sum.h"
+#include "telescope/station/element/private_spherical_wave_cache.h"
+#include "telescope/station/test/test_max_error.h"
+#include "mem/oskar_mem.h"
+#include "utility/oskar_get_error_string.h"
+
+#include "math/oskar_cmath.h"
+
+static void check_cache(int precision, int common_phi, double tol)
+{
+    int status = 0;
+    const int num_points = 1000, l_max = 8, l_max_low = 5;
+    const int num_coeff = (l_max + 1) * (l_max + 1) - 1;
+    const int type = precision | OSKAR_COMPLEX | OSKAR_MATRIX;
+    oskar_Mem* theta = oskar_mem_create(precision, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* phi_x = oskar_mem_create(precision, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* phi_y = oskar_mem_create(precision, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* alpha = oskar_mem_create(type, OSKAR_CPU, num_coeff, &status);
+    oskar_Mem* expected = oskar_mem_create(type, OSKAR_CPU,
+            num_points, &status);
+    oskar_Mem* pattern = oskar_mem_create(type, OSKAR_CPU,
+            num_points, &status);
+    const oskar_Mem* phi_y_ = common_phi ? phi_x : phi_y;
+    oskar_mem_random_uniform(theta, 1, 2, 3, 4, &status);
+    oskar_mem_random_uniform(phi_x, 5, 6, 7, 8, &status);
+    oskar_mem_random_uniform(phi_y, 9, 10, 11, 12, &status);
+    oskar_mem_scale_real(theta, M_PI / 2.0, 0, num_points, &status);
+    oskar_mem_scale_real(phi_x, 2.0 * M_PI, 0, num_points, &status);
+    oskar_mem_scale_real(phi_y, 2.0 * M_PI, 0, num_points, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    oskar_SphericalWaveCache* cache = oskar_spherical_wave_cache_create();
+    oskar_spherical_wave_cache_set_l_max(cache, l_max);
+
+    // Evaluate with different coefficients, at the same coordinates.
+    for (int trial = 0; trial < 3; ++trial)
+    {
+        const int l = (trial == 2) ? l_max_low : l_max;
+        oskar_mem_random_uniform(alpha, trial, 1, 2, 3, &status);
+        oskar_evaluate_spherical_wave_sum(num_points, theta, phi_x, phi_y_,
+                l, alpha, 0, expected, &status);
+        ASSERT_EQ(1, oskar_spherical_wave_cache_evaluate(cache, num_points,
+                theta, phi_x, phi_y_, l, alpha, 0, pattern, &status));
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        ASSERT_EQ(trial, oskar_spherical_wave_cache_num_hits(cache));
+        EXPECT_LT(max_error(pattern, expected), tol);
+    }
+
+    // Check that new coordinates are detected.
+    oskar_mem_scale_real(theta, 0.5, 0, num_points, &status);
+    oskar_evaluate_spherical_wave_sum(num_points, theta, phi_x, phi_y_,
+            l_max, alpha, 0, expected, &status);
+    ASSERT_EQ(1, oskar_spherical_wave_cache_evaluate(cache, num_points,
+            theta, phi_x, phi_y_, l_max, alpha, 0, pattern, &status));
+    EXPECT_EQ(2, oskar_spherical_wave_cache_num_hits(cache));
+    EXPECT_LT(max_error(pattern, expected), tol);
+
+    oskar_spherical_wave_cache_free(cache);
+    oskar_mem_free(theta, &status);
+    oskar_mem_free(phi_x, &status);
+    oskar_mem_free(phi_y, &status);
+    oskar_mem_free(alpha, &status);
+    oskar_mem_free(expected, &status);
+    oskar_mem_free(pattern, &status);
+}
+
+TEST(evaluate_spherical_wave_sum, cache_double)
+{
+    check_cache(OSKAR_DOUBLE, 1, 1e-12);
+    check_cache(OSKAR_DOUBLE, 0, 1e-12);
+}
+
+TEST(evaluate_spherical_wave_sum, cache_single)
+{
+    check_cache(OSKAR_SINGLE, 1, 1e-4);
+    check_cache(OSKAR_SINGLE, 0, 1e-4);
+}
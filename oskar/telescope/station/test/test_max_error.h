@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_TEST_MAX_ERROR_H_
+#define OSKAR_TEST_MAX_ERROR_H_
+
+#include "mem/oskar_mem.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Returns the largest difference between two complex arrays,
+// relative to the largest value in the second.
+static inline double max_error(const oskar_Mem* a, const oskar_Mem* b)
+{
+    int status = 0;
+    double max_diff = 0.0, max_val = 0.0;
+    oskar_Mem* a_ = oskar_mem_convert_precision(a, OSKAR_DOUBLE, &status);
+    oskar_Mem* b_ = oskar_mem_convert_precision(b, OSKAR_DOUBLE, &status);
+    const double* pa = oskar_mem_double_const(a_, &status);
+    const double* pb = oskar_mem_double_const(b_, &status);
+    const size_t n = oskar_mem_length(a) *
+            (oskar_mem_is_matrix(a) ? 8 : 2);
+    for (size_t i = 0; i < n; ++i)
+    {
+        max_diff = std::max(max_diff, std::fabs(pa[i] - pb[i]));
+        max_val = std::max(max_val, std::fabs(pb[i]));
+    }
+    oskar_mem_free(a_, &status);
+    oskar_mem_free(b_, &status);
+    return max_diff / max_val;
+}
+
+#endif /* include guard */
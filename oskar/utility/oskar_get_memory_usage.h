@@ -36,6 +36,22 @@ size_t oskar_get_free_physical_memory(void);
 OSKAR_EXPORT
 size_t oskar_get_memory_usage(void);
 
+/**
+ * @brief Returns the peak memory used by the current process, in bytes.
+ */
+OSKAR_EXPORT
+size_t oskar_get_peak_memory_usage(void);
+
+/**
+ * @brief Returns the CPU time used by the current process, in seconds.
+ *
+ * @details
+ * Returns the sum of the user and system CPU time used by all threads
+ * in the current process, or 0 if it is not known on this platform.
+ */
+OSKAR_EXPORT
+double oskar_get_cpu_time(void);
+
 /**
  * @brief Writes current memory usage to the log.
  */
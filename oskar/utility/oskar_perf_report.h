@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PERF_REPORT_H_
+#define OSKAR_PERF_REPORT_H_
+
+/**
+ * @file oskar_perf_report.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_PerfReport;
+#ifndef OSKAR_PERF_REPORT_TYPEDEF_
+#define OSKAR_PERF_REPORT_TYPEDEF_
+typedef struct oskar_PerfReport oskar_PerfReport;
+#endif /* OSKAR_PERF_REPORT_TYPEDEF_ */
+
+/**
+ * @brief Creates a machine-readable performance report.
+ *
+ * @details
+ * Opens a file to hold a performance report in JSON format, and writes
+ * the items common to all reports:
+ *
+ * - "report_version": The version of the report format.
+ * - "application": The name of the application.
+ * - "oskar_version": The OSKAR version string.
+ * - "date": The UTC date and time, in ISO 8601 format.
+ * - "num_cpu_cores": The number of CPU cores available.
+ * - "settings_file": The path of the settings file, if given.
+ * - "settings_hash": The CRC-32C checksum of the settings file contents,
+ *   as 8 hexadecimal digits, if given.
+ *
+ * Other items are added by the caller, and the report must be closed
+ * using oskar_perf_report_close().
+ *
+ * All the functions that add items do nothing if the report is NULL.
+ *
+ * @param[in] filename       Path of the file to write.
+ * @param[in] application    Name of the application.
+ * @param[in] settings_path  Path of the settings file used, or NULL.
+ * @param[in,out] status     Status return code.
+ *
+ * @return A handle to the report, or NULL if the file could not be opened.
+ */
+OSKAR_EXPORT
+oskar_PerfReport* oskar_perf_report_create(const char* filename,
+        const char* application, const char* settings_path, int* status);
+
+/**
+ * @brief Writes the process summary and closes the report.
+ *
+ * @details
+ * Closes any objects and arrays that are still open, then adds a "process"
+ * object containing the total CPU time used by the process
+ * ("cpu_time_sec"), its peak resident memory ("peak_memory_bytes"), and its
+ * current resident memory ("memory_bytes"), before closing the file and
+ * freeing the handle.
+ *
+ * @param[in] report         Handle to report.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_close(oskar_PerfReport* report, int* status);
+
+/**
+ * @brief Starts a JSON object.
+ *
+ * @details
+ * Starts a new object, which holds all the items added until the matching
+ * call to oskar_perf_report_end().
+ *
+ * @param[in] report  Handle to report.
+ * @param[in] key     Name of the object, or NULL if inside an array.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_begin_object(oskar_PerfReport* report, const char* key);
+
+/**
+ * @brief Starts a JSON array.
+ *
+ * @details
+ * Starts a new array, which holds all the items added until the matching
+ * call to oskar_perf_report_end(). Items in the array have no key.
+ *
+ * @param[in] report  Handle to report.
+ * @param[in] key     Name of the array, or NULL if inside an array.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_begin_array(oskar_PerfReport* report, const char* key);
+
+/**
+ * @brief Ends the innermost open JSON object or array.
+ *
+ * @param[in] report  Handle to report.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_end(oskar_PerfReport* report);
+
+/**
+ * @brief Adds a floating-point value.
+ *
+ * @details
+ * Values that are not finite (for example, a rate computed from a zero
+ * time) are written as null.
+ *
+ * @param[in] report  Handle to report.
+ * @param[in] key     Name of the item, or NULL if inside an array.
+ * @param[in] value   Value to write.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_double(oskar_PerfReport* report, const char* key,
+        double value);
+
+/**
+ * @brief Adds an integer value.
+ *
+ * @param[in] report  Handle to report.
+ * @param[in] key     Name of the item, or NULL if inside an array.
+ * @param[in] value   Value to write.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_int(oskar_PerfReport* report, const char* key,
+        long long value);
+
+/**
+ * @brief Adds a string value.
+ *
+ * @param[in] report  Handle to report.
+ * @param[in] key     Name of the item, or NULL if inside an array.
+ * @param[in] value   String to write, or NULL to write null.
+ */
+OSKAR_EXPORT
+void oskar_perf_report_string(oskar_PerfReport* report, const char* key,
+        const char* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
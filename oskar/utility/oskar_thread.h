@@ -42,9 +42,11 @@ extern "C" {
 struct oskar_Mutex;
 struct oskar_Thread;
 struct oskar_Barrier;
+struct oskar_ConditionVar;
 typedef struct oskar_Mutex oskar_Mutex;
 typedef struct oskar_Thread oskar_Thread;
 typedef struct oskar_Barrier oskar_Barrier;
+typedef struct oskar_ConditionVar oskar_ConditionVar;
 
 /**
  * @brief Creates a mutex.
@@ -90,6 +92,113 @@ void oskar_mutex_lock(oskar_Mutex* mutex);
 OSKAR_EXPORT
 void oskar_mutex_unlock(oskar_Mutex* mutex);
 
+/**
+ * @brief Creates a condition variable.
+ *
+ * @details
+ * Creates a condition variable, together with the mutex used to guard it.
+ */
+OSKAR_EXPORT
+oskar_ConditionVar* oskar_condition_create(void);
+
+/**
+ * @brief Destroys the condition variable.
+ *
+ * @details
+ * Destroys the condition variable.
+ *
+ * @param[in,out] var Pointer to condition variable.
+ */
+OSKAR_EXPORT
+void oskar_condition_free(oskar_ConditionVar* var);
+
+/**
+ * @brief Locks the mutex associated with the condition variable.
+ *
+ * @details
+ * Locks the mutex associated with the condition variable.
+ *
+ * @param[in,out] var Pointer to condition variable.
+ */
+OSKAR_EXPORT
+void oskar_condition_lock(oskar_ConditionVar* var);
+
+/**
+ * @brief Unlocks the mutex associated with the condition variable.
+ *
+ * @details
+ * Unlocks the mutex associated with the condition variable.
+ *
+ * @param[in,out] var Pointer to condition variable.
+ */
+OSKAR_EXPORT
+void oskar_condition_unlock(oskar_ConditionVar* var);
+
+/**
+ * @brief Wakes all threads waiting on the condition variable.
+ *
+ * @details
+ * Wakes all threads waiting on the condition variable.
+ *
+ * @param[in,out] var Pointer to condition variable.
+ */
+OSKAR_EXPORT
+void oskar_condition_notify_all(oskar_ConditionVar* var);
+
+/**
+ * @brief Waits on the condition variable.
+ *
+ * @details
+ * Atomically releases the mutex and blocks the calling thread until
+ * notified. The mutex must be locked by the caller, and is locked again
+ * on return. Spurious wake-ups are possible, so the caller must re-check
+ * the predicate in a loop.
+ *
+ * @param[in,out] var Pointer to condition variable.
+ */
+OSKAR_EXPORT
+void oskar_condition_wait(oskar_ConditionVar* var);
+
+/**
+ * @brief Atomically loads a 64-bit integer.
+ *
+ * @details
+ * Atomically loads a 64-bit integer, with sequentially-consistent ordering.
+ *
+ * @param[in] ptr Pointer to value.
+ */
+OSKAR_EXPORT
+long long oskar_atomic_load(volatile long long* ptr);
+
+/**
+ * @brief Atomically adds to a 64-bit integer.
+ *
+ * @details
+ * Atomically adds \p value to the integer at \p ptr,
+ * and returns the new value.
+ *
+ * @param[in,out] ptr Pointer to value.
+ * @param[in] value   Value to add.
+ */
+OSKAR_EXPORT
+long long oskar_atomic_add(volatile long long* ptr, long long value);
+
+/**
+ * @brief Atomic compare-and-swap on a 64-bit integer.
+ *
+ * @details
+ * If the integer at \p ptr is equal to \p expected, it is replaced
+ * by \p desired and 1 is returned. Otherwise, 0 is returned and
+ * the integer is unchanged.
+ *
+ * @param[in,out] ptr  Pointer to value.
+ * @param[in] expected Expected current value.
+ * @param[in] desired  Value to store if the current value is as expected.
+ */
+OSKAR_EXPORT
+int oskar_atomic_compare_exchange(volatile long long* ptr,
+        long long expected, long long desired);
+
 /**
  * @brief Creates and starts a thread.
  *
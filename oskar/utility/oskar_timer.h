@@ -97,6 +97,20 @@ void oskar_timer_free(oskar_Timer* timer);
 OSKAR_EXPORT
 double oskar_timer_elapsed(oskar_Timer* timer);
 
+/**
+ * @brief Adds time to the elapsed time of the timer.
+ *
+ * @details
+ * Adds a number of seconds to the elapsed time of the timer,
+ * for example to merge the time recorded by another timer.
+ * The timer can be running or paused.
+ *
+ * @param[in,out] timer   Pointer to timer.
+ * @param[in]     seconds The number of seconds to add.
+ */
+OSKAR_EXPORT
+void oskar_timer_add(oskar_Timer* timer, double seconds);
+
 /**
  * @brief Pauses the timer.
  *
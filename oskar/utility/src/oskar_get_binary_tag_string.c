@@ -56,6 +56,16 @@ const char* oskar_get_binary_tag_string(char group, char tag)
         }
         break;
     }
+    case OSKAR_TAG_GROUP_INDEX:
+    {
+        switch (tag)
+        {
+        case OSKAR_TAG_INDEX_TAGS:          return "Tag index";
+        default:
+            return "Unknown index group tag";
+        }
+        break;
+    }
     case OSKAR_TAG_GROUP_SKY_MODEL:
     {
         switch (tag)
@@ -80,6 +90,12 @@ const char* oskar_get_binary_tag_string(char group, char tag)
             return "Gaussian FWHM (minor) values";
         case OSKAR_SKY_TAG_POSITION_ANGLE:
             return "Gaussian position angle values";
+        case OSKAR_SKY_TAG_FORMAT_VERSION:
+            return "Sky model format version";
+        case OSKAR_SKY_TAG_COLUMNS:
+            return "Stored columns";
+        case OSKAR_SKY_TAG_COLUMN_RANGE:
+            return "Column range";
         default:
             return "Unknown sky model group tag";
         }
@@ -9,6 +9,7 @@
 #include <stddef.h>
 
 #if defined(OSKAR_OS_LINUX)
+#   include <sys/resource.h>
 #   include <sys/types.h>
 #   include <sys/sysinfo.h>
 #   include <stdlib.h>
@@ -16,6 +17,7 @@
 #   include <string.h>
 #elif defined(OSKAR_OS_MAC)
 #   include <sys/param.h>
+#   include <sys/resource.h>
 #   include <sys/mount.h>
 #   include <sys/types.h>
 #   include <sys/sysctl.h>
@@ -112,21 +114,30 @@ static size_t parse_line(char* line)
 }
 #endif
 
-size_t oskar_get_memory_usage(void)
-{
 #ifdef OSKAR_OS_LINUX
+static size_t read_status_kb(const char* key)
+{
     FILE* file = fopen("/proc/self/status", "r");
+    const size_t len = strlen(key);
     size_t result = 0;
     char line[128];
+    if (!file) return 0;
     while (fgets(line, 128, file) != NULL) {
-        if (strncmp(line, "VmRSS:", 6) == 0) {
+        if (strncmp(line, key, len) == 0) {
             result = parse_line(line);
             break;
         }
     }
     fclose(file);
+    return result;
+}
+#endif
+
+size_t oskar_get_memory_usage(void)
+{
+#ifdef OSKAR_OS_LINUX
     /* Value in /proc/self/status is in kB. */
-    return result * 1024;
+    return read_status_kb("VmRSS:") * 1024;
 #elif defined(OSKAR_OS_MAC)
     struct task_basic_info t_info;
     mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
@@ -145,6 +156,51 @@ size_t oskar_get_memory_usage(void)
 #endif
 }
 
+size_t oskar_get_peak_memory_usage(void)
+{
+#ifdef OSKAR_OS_LINUX
+    /* Value in /proc/self/status is in kB. */
+    return read_status_kb("VmHWM:") * 1024;
+#elif defined(OSKAR_OS_MAC)
+    struct mach_task_basic_info t_info;
+    mach_msg_type_number_t t_info_count = MACH_TASK_BASIC_INFO_COUNT;
+    if (KERN_SUCCESS != task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                                  (task_info_t)&t_info, &t_info_count))
+        return 0L;
+    return t_info.resident_size_max;
+#elif defined(OSKAR_OS_WIN)
+    PROCESS_MEMORY_COUNTERS_EX pmc;
+    GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc,
+            sizeof(pmc));
+    return (size_t)pmc.PeakWorkingSetSize;
+#else
+    return 0L;
+#endif
+}
+
+double oskar_get_cpu_time(void)
+{
+#if defined(OSKAR_OS_LINUX) || defined(OSKAR_OS_MAC)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return (double) usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec +
+            (double) usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec;
+#elif defined(OSKAR_OS_WIN)
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    ULARGE_INTEGER k, u;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time,
+            &kernel_time, &user_time)) return 0.0;
+    k.LowPart = kernel_time.dwLowDateTime;
+    k.HighPart = kernel_time.dwHighDateTime;
+    u.LowPart = user_time.dwLowDateTime;
+    u.HighPart = user_time.dwHighDateTime;
+    /* Values are in units of 100 ns. */
+    return 1e-7 * (double) (k.QuadPart + u.QuadPart);
+#else
+    return 0.0;
+#endif
+}
+
 void oskar_log_mem(oskar_Log* log)
 {
     const size_t gigabyte = 1024 * 1024 * 1024;
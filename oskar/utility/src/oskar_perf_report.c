@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "binary/oskar_crc.h"
+#include "utility/oskar_get_memory_usage.h"
+#include "utility/oskar_get_num_procs.h"
+#include "utility/oskar_perf_report.h"
+#include "utility/oskar_version_string.h"
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX_DEPTH 32
+#define REPORT_VERSION 1
+
+struct oskar_PerfReport
+{
+    FILE* file;
+    int depth;
+    char closer[MAX_DEPTH]; /* Closing bracket at each level. */
+    int num_items[MAX_DEPTH]; /* Number of items written at each level. */
+};
+
+static void write_string(FILE* file, const char* str)
+{
+    const unsigned char* c = (const unsigned char*) str;
+    fputc('"', file);
+    for (; *c; ++c)
+    {
+        switch (*c)
+        {
+        case '"':  fputs("\\\"", file); break;
+        case '\\': fputs("\\\\", file); break;
+        case '\n': fputs("\\n", file); break;
+        case '\r': fputs("\\r", file); break;
+        case '\t': fputs("\\t", file); break;
+        default:
+            if (*c < 0x20)
+            {
+                fprintf(file, "\\u%04x", (unsigned int) *c);
+            }
+            else
+            {
+                fputc(*c, file);
+            }
+        }
+    }
+    fputc('"', file);
+}
+
+/* Starts a new item at the current level, writing its key if given. */
+static void write_key(oskar_PerfReport* r, const char* key)
+{
+    int i = 0;
+    if (r->depth < 0) return;
+    if (r->num_items[r->depth]++ > 0) fputc(',', r->file);
+    fputc('\n', r->file);
+    for (i = 0; i <= r->depth; ++i) fputs("  ", r->file);
+    if (key && r->closer[r->depth] == '}')
+    {
+        write_string(r->file, key);
+        fputs(": ", r->file);
+    }
+}
+
+static void begin(oskar_PerfReport* r, const char* key, char open, char close)
+{
+    if (!r || r->depth < 0 || r->depth >= MAX_DEPTH - 1) return;
+    write_key(r, key);
+    fputc(open, r->file);
+    r->depth++;
+    r->closer[r->depth] = close;
+    r->num_items[r->depth] = 0;
+}
+
+/* Returns the CRC-32C checksum of a file, and whether it could be read. */
+static unsigned long file_checksum(const char* filename, int* found)
+{
+    char* data = 0;
+    long size = 0;
+    unsigned long crc = 0;
+    oskar_CRC* crc_data = 0;
+    FILE* file = fopen(filename, "rb");
+    *found = 0;
+    if (!file) return 0;
+    if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    rewind(file);
+    data = (char*) malloc(size > 0 ? size : 1);
+    if (data && size >= 0 && fread(data, 1, size, file) == (size_t) size)
+    {
+        crc_data = oskar_crc_create(OSKAR_CRC_32C);
+        crc = oskar_crc_compute(crc_data, data, (size_t) size);
+        oskar_crc_free(crc_data);
+        *found = 1;
+    }
+    free(data);
+    fclose(file);
+    return crc;
+}
+
+
+oskar_PerfReport* oskar_perf_report_create(const char* filename,
+        const char* application, const char* settings_path, int* status)
+{
+    oskar_PerfReport* r = 0;
+    char date[32];
+    time_t now;
+    if (*status || !filename || strlen(filename) == 0) return 0;
+    r = (oskar_PerfReport*) calloc(1, sizeof(oskar_PerfReport));
+    if (!r)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+    r->file = fopen(filename, "w");
+    if (!r->file)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+        free(r);
+        return 0;
+    }
+    r->closer[0] = '}';
+    fputc('{', r->file);
+
+    /* Write the items common to all reports. */
+    now = time(0);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    oskar_perf_report_int(r, "report_version", REPORT_VERSION);
+    oskar_perf_report_string(r, "application", application);
+    oskar_perf_report_string(r, "oskar_version", oskar_version_string());
+    oskar_perf_report_string(r, "date", date);
+    oskar_perf_report_int(r, "num_cpu_cores", oskar_get_num_procs());
+    if (settings_path && strlen(settings_path) > 0)
+    {
+        int found = 0;
+        char hash[16];
+        const unsigned long crc = file_checksum(settings_path, &found);
+        oskar_perf_report_string(r, "settings_file", settings_path);
+        if (found)
+        {
+            sprintf(hash, "%08lx", crc & 0xFFFFFFFFuL);
+            oskar_perf_report_string(r, "settings_hash", hash);
+        }
+    }
+    return r;
+}
+
+
+void oskar_perf_report_close(oskar_PerfReport* report, int* status)
+{
+    if (!report) return;
+    while (report->depth > 0)
+    {
+        oskar_perf_report_end(report);
+    }
+    oskar_perf_report_begin_object(report, "process");
+    oskar_perf_report_double(report, "cpu_time_sec", oskar_get_cpu_time());
+    oskar_perf_report_int(report, "peak_memory_bytes",
+            (long long) oskar_get_peak_memory_usage());
+    oskar_perf_report_int(report, "memory_bytes",
+            (long long) oskar_get_memory_usage());
+    oskar_perf_report_end(report);
+    oskar_perf_report_end(report);
+    fputc('\n', report->file);
+    if (ferror(report->file) && !*status) *status = OSKAR_ERR_FILE_IO;
+    if (fclose(report->file) != 0 && !*status) *status = OSKAR_ERR_FILE_IO;
+    free(report);
+}
+
+
+void oskar_perf_report_begin_object(oskar_PerfReport* report, const char* key)
+{
+    begin(report, key, '{', '}');
+}
+
+
+void oskar_perf_report_begin_array(oskar_PerfReport* report, const char* key)
+{
+    begin(report, key, '[', ']');
+}
+
+
+void oskar_perf_report_end(oskar_PerfReport* report)
+{
+    int i = 0;
+    if (!report || report->depth < 0) return;
+    if (report->num_items[report->depth] > 0)
+    {
+        fputc('\n', report->file);
+        for (i = 0; i < report->depth; ++i) fputs("  ", report->file);
+    }
+    fputc(report->closer[report->depth], report->file);
+    report->depth--;
+}
+
+
+void oskar_perf_report_double(oskar_PerfReport* report, const char* key,
+        double value)
+{
+    if (!report || report->depth < 0) return;
+    write_key(report, key);
+    if (value == value && value <= DBL_MAX && value >= -DBL_MAX)
+    {
+        fprintf(report->file, "%.9g", value);
+    }
+    else
+    {
+        fputs("null", report->file);
+    }
+}
+
+
+void oskar_perf_report_int(oskar_PerfReport* report, const char* key,
+        long long value)
+{
+    if (!report || report->depth < 0) return;
+    write_key(report, key);
+    fprintf(report->file, "%lld", value);
+}
+
+
+void oskar_perf_report_string(oskar_PerfReport* report, const char* key,
+        const char* value)
+{
+    if (!report || report->depth < 0) return;
+    write_key(report, key);
+    if (value)
+    {
+        write_string(report->file, value);
+    }
+    else
+    {
+        fputs("null", report->file);
+    }
+}
+
+
+#ifdef __cplusplus
+}
+#endif
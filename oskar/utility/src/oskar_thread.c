@@ -97,7 +97,6 @@ struct oskar_ConditionVar
     pthread_cond_t var;
 #endif
 };
-typedef struct oskar_ConditionVar oskar_ConditionVar;
 
 static void oskar_condition_init(oskar_ConditionVar* var)
 {
@@ -119,17 +118,32 @@ static void oskar_condition_uninit(oskar_ConditionVar* var)
 #endif
 }
 
-static void oskar_condition_lock(oskar_ConditionVar* var)
+oskar_ConditionVar* oskar_condition_create(void)
+{
+    oskar_ConditionVar* var = 0;
+    var = (oskar_ConditionVar*) calloc(1, sizeof(oskar_ConditionVar));
+    oskar_condition_init(var);
+    return var;
+}
+
+void oskar_condition_free(oskar_ConditionVar* var)
+{
+    if (!var) return;
+    oskar_condition_uninit(var);
+    free(var);
+}
+
+void oskar_condition_lock(oskar_ConditionVar* var)
 {
     oskar_mutex_lock(&var->lock);
 }
 
-static void oskar_condition_unlock(oskar_ConditionVar* var)
+void oskar_condition_unlock(oskar_ConditionVar* var)
 {
     oskar_mutex_unlock(&var->lock);
 }
 
-static void oskar_condition_notify_all(oskar_ConditionVar* var)
+void oskar_condition_notify_all(oskar_ConditionVar* var)
 {
 #if defined(OSKAR_OS_WIN)
     WakeAllConditionVariable(&var->var);
@@ -138,7 +152,7 @@ static void oskar_condition_notify_all(oskar_ConditionVar* var)
 #endif
 }
 
-static void oskar_condition_wait(oskar_ConditionVar* var)
+void oskar_condition_wait(oskar_ConditionVar* var)
 {
 #if defined(OSKAR_OS_WIN)
     SleepConditionVariableCS(&var->var, &(var->lock.lock), INFINITE);
@@ -148,6 +162,43 @@ static void oskar_condition_wait(oskar_ConditionVar* var)
 }
 
 
+/* =========================================================================
+ *  ATOMICS
+ * =========================================================================*/
+
+long long oskar_atomic_load(volatile long long* ptr)
+{
+#ifdef OSKAR_OS_WIN
+    return (long long) InterlockedCompareExchange64(
+            (volatile LONG64*) ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#endif
+}
+
+long long oskar_atomic_add(volatile long long* ptr, long long value)
+{
+#ifdef OSKAR_OS_WIN
+    return (long long) InterlockedExchangeAdd64(
+            (volatile LONG64*) ptr, (LONG64) value) + value;
+#else
+    return __atomic_add_fetch(ptr, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+int oskar_atomic_compare_exchange(volatile long long* ptr,
+        long long expected, long long desired)
+{
+#ifdef OSKAR_OS_WIN
+    return InterlockedCompareExchange64((volatile LONG64*) ptr,
+            (LONG64) desired, (LONG64) expected) == (LONG64) expected;
+#else
+    return __atomic_compare_exchange_n(ptr, &expected, desired, 0,
+            __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? 1 : 0;
+#endif
+}
+
+
 /* =========================================================================
  *  THREAD
  * =========================================================================*/
@@ -163,6 +163,13 @@ double oskar_timer_elapsed(oskar_Timer* timer)
     return timer->elapsed;
 }
 
+void oskar_timer_add(oskar_Timer* timer, double seconds)
+{
+    oskar_mutex_lock(timer->mutex);
+    timer->elapsed += seconds;
+    oskar_mutex_unlock(timer->mutex);
+}
+
 void oskar_timer_pause(oskar_Timer* timer)
 {
     if (timer->paused) return;
@@ -113,3 +113,109 @@ TEST(thread, barriers)
     free(args);
     free(threads);
 }
+
+struct AtomicArgs
+{
+    int num_iter;
+    long long* counter_add;
+    long long* counter_cas;
+};
+typedef struct AtomicArgs AtomicArgs;
+
+void* thread_atomics(void* arg)
+{
+    AtomicArgs* args = (AtomicArgs*) arg;
+    for (int i = 0; i < args->num_iter; ++i)
+    {
+        oskar_atomic_add(args->counter_add, 1);
+        long long old_val = 0;
+        do
+        {
+            old_val = oskar_atomic_load(args->counter_cas);
+        }
+        while (!oskar_atomic_compare_exchange(args->counter_cas,
+                old_val, old_val + 2));
+    }
+    return 0;
+}
+
+struct ConditionArgs
+{
+    int thread_id, num_threads, *turn;
+    oskar_ConditionVar* var;
+};
+typedef struct ConditionArgs ConditionArgs;
+
+void* thread_conditions(void* arg)
+{
+    ConditionArgs* args = (ConditionArgs*) arg;
+    for (int i = 0; i < 4; ++i)
+    {
+        // Wait for this thread's turn, then pass it on to the next thread.
+        oskar_condition_lock(args->var);
+        while (*(args->turn) % args->num_threads != args->thread_id)
+        {
+            oskar_condition_wait(args->var);
+        }
+        print_from_thread(i, args->thread_id, "My turn");
+        (*(args->turn))++;
+        oskar_condition_notify_all(args->var);
+        oskar_condition_unlock(args->var);
+    }
+    return 0;
+}
+
+TEST(thread, atomics)
+{
+    const int num_threads = 8, num_iter = 10000;
+    long long counter_add = 0, counter_cas = 0;
+    oskar_Thread** threads = (oskar_Thread**)
+            calloc((size_t) num_threads, sizeof(oskar_Thread*));
+    AtomicArgs args;
+    args.num_iter = num_iter;
+    args.counter_add = &counter_add;
+    args.counter_cas = &counter_cas;
+    for (int i = 0; i < num_threads; ++i)
+    {
+        threads[i] = oskar_thread_create(thread_atomics, (void*)(&args), 0);
+    }
+    for (int i = 0; i < num_threads; ++i)
+    {
+        oskar_thread_join(threads[i]);
+        oskar_thread_free(threads[i]);
+    }
+    free(threads);
+    EXPECT_EQ((long long) num_threads * num_iter, counter_add);
+    EXPECT_EQ((long long) num_threads * num_iter * 2, counter_cas);
+    EXPECT_EQ(0, oskar_atomic_compare_exchange(&counter_add, 0, 1));
+    EXPECT_EQ(5, oskar_atomic_add(&counter_cas, 5 - counter_cas));
+}
+
+TEST(thread, condition_variables)
+{
+    const int num_threads = 8;
+    int turn = 0;
+    oskar_ConditionVar* var = oskar_condition_create();
+    oskar_Thread** threads = (oskar_Thread**)
+            calloc((size_t) num_threads, sizeof(oskar_Thread*));
+    ConditionArgs* args = (ConditionArgs*)
+            calloc((size_t) num_threads, sizeof(ConditionArgs));
+    for (int i = 0; i < num_threads; ++i)
+    {
+        args[i].thread_id = i;
+        args[i].num_threads = num_threads;
+        args[i].turn = &turn;
+        args[i].var = var;
+        threads[i] = oskar_thread_create(thread_conditions,
+                (void*)(&args[i]), 0);
+    }
+    for (int i = 0; i < num_threads; ++i)
+    {
+        oskar_thread_join(threads[i]);
+        oskar_thread_free(threads[i]);
+    }
+    EXPECT_EQ(4 * num_threads, turn);
+    oskar_condition_free(var);
+    free(args);
+    free(threads);
+}
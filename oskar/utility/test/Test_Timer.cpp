@@ -84,3 +84,16 @@ TEST(Timer, test_performance)
 #endif
     time_timer(OSKAR_TIMER_NATIVE, "Native");
 }
+
+TEST(Timer, add)
+{
+    oskar_Timer* tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    oskar_timer_add(tmr, 1.5);
+    EXPECT_DOUBLE_EQ(1.5, oskar_timer_elapsed(tmr));
+    oskar_timer_resume(tmr);
+    oskar_timer_add(tmr, 2.0);
+    oskar_timer_pause(tmr);
+    EXPECT_LE(3.5, oskar_timer_elapsed(tmr));
+    EXPECT_GT(4.0, oskar_timer_elapsed(tmr));
+    oskar_timer_free(tmr);
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "binary/oskar_crc.h"
+#include "utility/oskar_get_memory_usage.h"
+#include "utility/oskar_perf_report.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static std::string read_file(const char* filename)
+{
+    std::string contents;
+    char buffer[1024];
+    size_t n = 0;
+    FILE* file = fopen(filename, "rb");
+    if (!file) return contents;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        contents.append(buffer, n);
+    }
+    fclose(file);
+    return contents;
+}
+
+// Removes white space outside strings, to make the expected text shorter.
+static std::string compact(const std::string& json)
+{
+    std::string out;
+    bool in_string = false;
+    for (size_t i = 0; i < json.size(); ++i)
+    {
+        const char c = json[i];
+        if (c == '"' && (i == 0 || json[i - 1] != '\\')) in_string = !in_string;
+        if (!in_string && (c == ' ' || c == '\n')) continue;
+        out += c;
+    }
+    return out;
+}
+
+TEST(perf_report, write)
+{
+    int status = 0;
+    const char* settings = "temp_test_perf_report.ini";
+    const char* filename = "temp_test_perf_report.json";
+    const char settings_data[] = "[group]\nkey=value\n";
+
+    // Write a settings file.
+    FILE* file = fopen(settings, "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(settings_data, 1, strlen(settings_data), file);
+    fclose(file);
+
+    // Write a report with nested objects and arrays.
+    oskar_PerfReport* r = oskar_perf_report_create(filename,
+            "test \"app\"", settings, &status);
+    ASSERT_EQ(0, status);
+    ASSERT_TRUE(r != NULL);
+    oskar_perf_report_begin_object(r, "counts");
+    oskar_perf_report_int(r, "sources", 12345678901LL);
+    oskar_perf_report_end(r);
+    oskar_perf_report_begin_array(r, "devices");
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_perf_report_begin_object(r, 0);
+        oskar_perf_report_int(r, "index", i);
+        oskar_perf_report_double(r, "time", 0.5 * i);
+        oskar_perf_report_end(r);
+    }
+    oskar_perf_report_end(r);
+    oskar_perf_report_begin_array(r, "empty");
+    oskar_perf_report_end(r);
+    oskar_perf_report_double(r, "rate", 1.0 / 0.0);
+    oskar_perf_report_double(r, "nan", sqrt(-1.0));
+    oskar_perf_report_string(r, "none", 0);
+
+    // Leave an object open, which should be closed automatically.
+    oskar_perf_report_begin_object(r, "open");
+    oskar_perf_report_close(r, &status);
+    ASSERT_EQ(0, status);
+
+    // Check the contents.
+    const std::string json = compact(read_file(filename));
+    EXPECT_EQ(0u, json.find("{\"report_version\":1,"));
+    EXPECT_NE(std::string::npos, json.find(
+            "\"application\":\"test \\\"app\\\"\""));
+    EXPECT_NE(std::string::npos, json.find(
+            "\"counts\":{\"sources\":12345678901},"
+            "\"devices\":[{\"index\":0,\"time\":0},{\"index\":1,\"time\":0.5}],"
+            "\"empty\":[],\"rate\":null,\"nan\":null,\"none\":null,"
+            "\"open\":{},\"process\":{\"cpu_time_sec\":"));
+    EXPECT_EQ(json.size() - 2, json.rfind("}}"));
+
+    // Check the settings hash.
+    oskar_CRC* crc_data = oskar_crc_create(OSKAR_CRC_32C);
+    char hash[32];
+    sprintf(hash, "\"settings_hash\":\"%08lx\"", oskar_crc_compute(crc_data,
+            settings_data, strlen(settings_data)) & 0xFFFFFFFFuL);
+    oskar_crc_free(crc_data);
+    EXPECT_NE(std::string::npos, json.find(hash));
+
+    // Check that no report is created if the filename is empty.
+    EXPECT_TRUE(oskar_perf_report_create("", "test", 0, &status) == NULL);
+    EXPECT_EQ(0, status);
+
+    remove(filename);
+    remove(settings);
+}
+
+TEST(perf_report, unbalanced_end)
+{
+    int status = 0;
+    const char* filename = "temp_test_perf_report_unbalanced.json";
+
+    // Ending more levels than were begun must not write outside the report.
+    oskar_PerfReport* r = oskar_perf_report_create(filename, "test", 0,
+            &status);
+    ASSERT_EQ(0, status);
+    ASSERT_TRUE(r != NULL);
+    oskar_perf_report_end(r);
+    oskar_perf_report_end(r);
+    oskar_perf_report_begin_object(r, "ignored");
+    oskar_perf_report_int(r, "ignored", 1);
+    oskar_perf_report_close(r, &status);
+    EXPECT_EQ(0, status);
+
+    // Only the items written before the top level was closed are present.
+    const std::string json = compact(read_file(filename));
+    EXPECT_EQ(0u, json.find("{\"report_version\":1,"));
+    EXPECT_EQ(std::string::npos, json.find("ignored"));
+    EXPECT_EQ(std::string::npos, json.find("process"));
+    remove(filename);
+}
+
+TEST(perf_report, peak_memory)
+{
+    EXPECT_GE(oskar_get_peak_memory_usage(), oskar_get_memory_usage());
+}
@@ -0,0 +1,119 @@
+/* Copyright (c) 2026, The OSKAR Developers. See LICENSE file. */
+
+#include "math/private_random_helpers.h"
+
+/*
+ * Each baseline (or station, for autocorrelations) uses its own
+ * random generator counter, derived from its index, so the results do not
+ * depend on the order in which the work items are processed.
+ * Matrix data uses two counters per work item.
+ *
+ * The random numbers are always generated in double precision,
+ * and the station noise values are also combined in double precision.
+ */
+
+/* Returns the index of the first baseline of station Q. */
+#define OSKAR_BASELINE_ROW_START(NUM_STATIONS, Q) \
+    ((Q) * ((NUM_STATIONS) - 1) - ((Q) - 1) * (Q) / 2)
+
+/* Finds stations Q < P for the 1D baseline index B. */
+#define OSKAR_BASELINE_STATIONS(NUM_STATIONS, B, P, Q) {\
+        const double t__ = 2.0 * NUM_STATIONS - 1.0;\
+        Q = (int) ((t__ - sqrt(t__ * t__ - 8.0 * B)) / 2.0);\
+        if (Q < 0) Q = 0;\
+        while (Q > 0 && OSKAR_BASELINE_ROW_START(NUM_STATIONS, Q) > B) Q--;\
+        while (OSKAR_BASELINE_ROW_START(NUM_STATIONS, Q + 1) <= B) Q++;\
+        P = B - OSKAR_BASELINE_ROW_START(NUM_STATIONS, Q) + Q + 1;}\
+
+#define OSKAR_GAUSSIAN2(SEED, C0, C1, RND) {\
+        OSKAR_R123_GENERATE_2(SEED, C0, C1)\
+        oskar_box_muller_d(u.i[0], u.i[1], &RND[0], &RND[1]);}\
+
+#define OSKAR_GAUSSIAN4(SEED, C0, C1, RND) {\
+        OSKAR_R123_GENERATE_4(SEED, C0, C1, 0, 0)\
+        oskar_box_muller_d(u.i[0], u.i[1], &RND[0], &RND[1]);\
+        oskar_box_muller_d(u.i[2], u.i[3], &RND[2], &RND[3]);}\
+
+#define OSKAR_VIS_NOISE_CROSS_C(NAME, FP, FP2) KERNEL(NAME) (\
+        const unsigned int seed, const unsigned int slice,\
+        const int num_stations, const int num_baselines,\
+        const int offset_out, GLOBAL_IN(FP, st_std), GLOBAL_OUT(FP2, data))\
+{\
+    KERNEL_LOOP_PAR_X(int, b, 0, num_baselines)\
+    int p, q;\
+    double rnd[2];\
+    OSKAR_BASELINE_STATIONS(num_stations, b, p, q)\
+    OSKAR_GAUSSIAN2(seed, (unsigned int) b, slice, rnd)\
+    const double std = sqrt((double) (st_std[q] * st_std[p])) *\
+            (1.0 / sqrt(2.0));\
+    data[b + offset_out].x += std * rnd[0];\
+    data[b + offset_out].y += std * rnd[1];\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
+
+#define OSKAR_VIS_NOISE_CROSS_M(NAME, FP, FP4c) KERNEL(NAME) (\
+        const unsigned int seed, const unsigned int slice,\
+        const int num_stations, const int num_baselines,\
+        const int offset_out, GLOBAL_IN(FP, st_std), GLOBAL_OUT(FP4c, data))\
+{\
+    KERNEL_LOOP_PAR_X(int, b, 0, num_baselines)\
+    int p, q;\
+    double rnd[8];\
+    OSKAR_BASELINE_STATIONS(num_stations, b, p, q)\
+    OSKAR_GAUSSIAN4(seed, 2u * b, slice, rnd)\
+    OSKAR_GAUSSIAN4(seed, 2u * b + 1u, slice, (rnd + 4))\
+    const double std = sqrt((double) (st_std[q] * st_std[p]));\
+    const int i = b + offset_out;\
+    data[i].a.x += std * rnd[0];\
+    data[i].a.y += std * rnd[1];\
+    data[i].b.x += std * rnd[2];\
+    data[i].b.y += std * rnd[3];\
+    data[i].c.x += std * rnd[4];\
+    data[i].c.y += std * rnd[5];\
+    data[i].d.x += std * rnd[6];\
+    data[i].d.y += std * rnd[7];\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
+
+/* Phases are all zero after autocorrelation,
+ * so the imaginary components are ignored. */
+#define OSKAR_VIS_NOISE_AUTO_C(NAME, FP, FP2) KERNEL(NAME) (\
+        const unsigned int seed, const unsigned int slice,\
+        const unsigned int counter_offset, const int num_stations,\
+        const double sefd_factor,\
+        const int offset_out, GLOBAL_IN(FP, st_std), GLOBAL_OUT(FP2, data))\
+{\
+    KERNEL_LOOP_PAR_X(int, a, 0, num_stations)\
+    double rnd[2];\
+    OSKAR_GAUSSIAN2(seed, counter_offset + a, slice, rnd)\
+    const double std = st_std[a];\
+    const double mean = std * sefd_factor * 1.41421356237309504880;\
+    data[a + offset_out].x += std * rnd[0] + mean;\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
+
+#define OSKAR_VIS_NOISE_AUTO_M(NAME, FP, FP4c) KERNEL(NAME) (\
+        const unsigned int seed, const unsigned int slice,\
+        const unsigned int counter_offset, const int num_stations,\
+        const double sefd_factor,\
+        const int offset_out, GLOBAL_IN(FP, st_std), GLOBAL_OUT(FP4c, data))\
+{\
+    KERNEL_LOOP_PAR_X(int, a, 0, num_stations)\
+    double rnd[8];\
+    OSKAR_GAUSSIAN4(seed, counter_offset + 2u * a, slice, rnd)\
+    OSKAR_GAUSSIAN4(seed, counter_offset + 2u * a + 1u, slice, (rnd + 4))\
+    const double std = st_std[a] * 1.41421356237309504880;\
+    const double mean = std * sefd_factor;\
+    const int i = a + offset_out;\
+    data[i].a.x += std * rnd[0] + mean;\
+    data[i].b.x += std * rnd[1];\
+    data[i].b.y += std * rnd[2];\
+    data[i].c.x += std * rnd[3];\
+    data[i].c.y += std * rnd[4];\
+    data[i].d.x += std * rnd[5] + mean;\
+    KERNEL_LOOP_END\
+}\
+OSKAR_REGISTER_KERNEL(NAME)
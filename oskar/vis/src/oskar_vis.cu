@@ -0,0 +1,17 @@
+/* Copyright (c) 2026, The OSKAR Developers. See LICENSE file. */
+
+#include "vis/define_vis_block_add_system_noise.h"
+#include "utility/oskar_cuda_registrar.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+
+/* Kernels */
+
+OSKAR_VIS_NOISE_CROSS_C(vis_noise_cross_c_float, float, float2)
+OSKAR_VIS_NOISE_CROSS_M(vis_noise_cross_m_float, float, float4c)
+OSKAR_VIS_NOISE_AUTO_C(vis_noise_auto_c_float, float, float2)
+OSKAR_VIS_NOISE_AUTO_M(vis_noise_auto_m_float, float, float4c)
+OSKAR_VIS_NOISE_CROSS_C(vis_noise_cross_c_double, double, double2)
+OSKAR_VIS_NOISE_CROSS_M(vis_noise_cross_m_double, double, double4c)
+OSKAR_VIS_NOISE_AUTO_C(vis_noise_auto_c_double, double, double2)
+OSKAR_VIS_NOISE_AUTO_M(vis_noise_auto_m_double, double, double4c)
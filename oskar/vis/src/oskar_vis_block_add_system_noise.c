@@ -4,15 +4,26 @@
  */
 
 #include "math/oskar_find_closest_match.h"
-#include "math/oskar_random_gaussian.h"
 #include "vis/oskar_vis_block.h"
 #include "vis/private_vis_block.h"
-#include <math.h>
+#include "vis/define_vis_block_add_system_noise.h"
+#include "utility/oskar_device.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+OSKAR_VIS_NOISE_CROSS_C(vis_noise_cross_c_float, float, float2)
+OSKAR_VIS_NOISE_CROSS_M(vis_noise_cross_m_float, float, float4c)
+OSKAR_VIS_NOISE_AUTO_C(vis_noise_auto_c_float, float, float2)
+OSKAR_VIS_NOISE_AUTO_M(vis_noise_auto_m_float, float, float4c)
+OSKAR_VIS_NOISE_CROSS_C(vis_noise_cross_c_double, double, double2)
+OSKAR_VIS_NOISE_CROSS_M(vis_noise_cross_m_double, double, double4c)
+OSKAR_VIS_NOISE_AUTO_C(vis_noise_auto_c_double, double, double2)
+OSKAR_VIS_NOISE_AUTO_M(vis_noise_auto_m_double, double, double4c)
+
 static void oskar_get_station_std_dev_for_channel(oskar_Mem* station_std_dev,
         double frequency_hz, const oskar_Telescope* tel, int* status)
 {
@@ -44,18 +55,24 @@ static void oskar_vis_block_apply_noise(oskar_VisBlock* vis,
         int global_slice_idx, int local_slice_idx,
         double channel_bandwidth_hz, double time_int_sec, int* status)
 {
-    int a1 = 0, a2 = 0, b = 0, c = 0;
-    void *acorr_ptr = 0, *xcorr_ptr = 0;
-    double rnd[8];
-    const double inv_sqrt2 = 1.0 / sqrt(2.0);
-
-    /* Get pointer to start of block, and block dimensions. */
-    acorr_ptr = oskar_mem_void(oskar_vis_block_auto_correlations(vis));
-    xcorr_ptr = oskar_mem_void(oskar_vis_block_cross_correlations(vis));
+    if (*status) return;
+    oskar_Mem* xcorr = oskar_vis_block_cross_correlations(vis);
+    oskar_Mem* acorr = oskar_vis_block_auto_correlations(vis);
+    const int location = oskar_mem_location(xcorr);
+    const int type = oskar_mem_type(xcorr);
+    const int is_matrix = oskar_mem_is_matrix(xcorr);
     const int have_autocorr  = oskar_vis_block_has_auto_correlations(vis);
     const int have_crosscorr = oskar_vis_block_has_cross_correlations(vis);
     const int num_baselines  = oskar_vis_block_num_baselines(vis);
     const int num_stations   = oskar_vis_block_num_stations(vis);
+    const unsigned int slice = (unsigned int) global_slice_idx;
+    const int offset_xc = num_baselines * local_slice_idx;
+    const int offset_ac = num_stations * local_slice_idx;
+
+    /* The random generator counters for the autocorrelations follow those
+     * used for the cross-correlations. */
+    const unsigned int counter_offset = have_crosscorr ?
+            (unsigned int) ((is_matrix ? 2 : 1) * num_baselines) : 0u;
 
     /* Get factor for conversion of sigma to SEFD. */
     const double sefd_factor = sqrt(2.0 * channel_bandwidth_hz * time_int_sec);
@@ -67,167 +84,154 @@ static void oskar_vis_block_apply_noise(oskar_VisBlock* vis,
      * falls out naturally when evaluating Stokes I from the dipole
      * correlations (i.e. I = 0.5 (XX+YY) ). */
 
-    switch (oskar_mem_type(oskar_vis_block_cross_correlations(vis)))
-    {
-    case OSKAR_SINGLE_COMPLEX:
+    if (location == OSKAR_CPU)
     {
-        const float* st_std = oskar_mem_float_const(station_std_dev, status);
-        if (have_crosscorr)
+        switch (type)
+        {
+        case OSKAR_SINGLE_COMPLEX:
         {
-            float2* data = (float2*) xcorr_ptr + (num_baselines * local_slice_idx);
-            for (a1 = 0, b = 0; a1 < num_stations; ++a1)
+            const float* st_std = oskar_mem_float_const(station_std_dev, status);
+            if (have_crosscorr)
             {
-                for (a2 = a1 + 1; a2 < num_stations; ++b, ++a2)
-                {
-                    oskar_random_gaussian2(seed, c++, global_slice_idx, rnd);
-                    const double std = sqrt(st_std[a1] * st_std[a2]) * inv_sqrt2;
-                    data[b].x += std * rnd[0];
-                    data[b].y += std * rnd[1];
-                }
+                vis_noise_cross_c_float(seed, slice, num_stations,
+                        num_baselines, offset_xc, st_std,
+                        oskar_mem_float2(xcorr, status));
             }
-        }
-
-        if (have_autocorr)
-        {
-            /* Autocorrelation noise. Phases are all zero after
-             * autocorrelation, so ignore the imaginary components. */
-            float2* data = (float2*) acorr_ptr + (num_stations * local_slice_idx);
-            for (a1 = 0; a1 < num_stations; ++a1)
+            if (have_autocorr)
             {
-                oskar_random_gaussian2(seed, c++, global_slice_idx, rnd);
-                const double std = st_std[a1];
-                const double mean = sqrt(2.0) * st_std[a1];
-                data[a1].x += std * rnd[0] + mean * sefd_factor;
+                vis_noise_auto_c_float(seed, slice, counter_offset,
+                        num_stations, sefd_factor, offset_ac, st_std,
+                        oskar_mem_float2(acorr, status));
             }
+            break;
         }
-        break;
-    }
-    case OSKAR_SINGLE_COMPLEX_MATRIX:
-    {
-        const float* st_std = oskar_mem_float_const(station_std_dev, status);
-        if (have_crosscorr)
+        case OSKAR_SINGLE_COMPLEX_MATRIX:
         {
-            float4c* data = (float4c*) xcorr_ptr + (num_baselines * local_slice_idx);
-            for (a1 = 0, b = 0; a1 < num_stations; ++a1)
+            const float* st_std = oskar_mem_float_const(station_std_dev, status);
+            if (have_crosscorr)
             {
-                for (a2 = a1 + 1; a2 < num_stations; ++b, ++a2)
-                {
-                    oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd);
-                    oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd + 4);
-                    const double std = sqrt(st_std[a1] * st_std[a2]);
-                    data[b].a.x += std * rnd[0];
-                    data[b].a.y += std * rnd[1];
-                    data[b].b.x += std * rnd[2];
-                    data[b].b.y += std * rnd[3];
-                    data[b].c.x += std * rnd[4];
-                    data[b].c.y += std * rnd[5];
-                    data[b].d.x += std * rnd[6];
-                    data[b].d.y += std * rnd[7];
-                }
+                vis_noise_cross_m_float(seed, slice, num_stations,
+                        num_baselines, offset_xc, st_std,
+                        oskar_mem_float4c(xcorr, status));
             }
-        }
-
-        if (have_autocorr)
-        {
-            /* Autocorrelation noise. Phases are all zero after
-             * autocorrelation, so ignore the imaginary components. */
-            float4c* data = (float4c*) acorr_ptr + (num_stations * local_slice_idx);
-            for (a1 = 0; a1 < num_stations; ++a1)
+            if (have_autocorr)
             {
-                oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd);
-                oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd + 4);
-                const double std = st_std[a1] * sqrt(2.0);
-                const double mean = std * sefd_factor;
-                data[a1].a.x += std * rnd[0] + mean;
-                data[a1].b.x += std * rnd[1];
-                data[a1].b.y += std * rnd[2];
-                data[a1].c.x += std * rnd[3];
-                data[a1].c.y += std * rnd[4];
-                data[a1].d.x += std * rnd[5] + mean;
+                vis_noise_auto_m_float(seed, slice, counter_offset,
+                        num_stations, sefd_factor, offset_ac, st_std,
+                        oskar_mem_float4c(acorr, status));
             }
+            break;
         }
-        break;
-    }
-    case OSKAR_DOUBLE_COMPLEX:
-    {
-        const double* st_std = oskar_mem_double_const(station_std_dev, status);
-        if (have_crosscorr)
+        case OSKAR_DOUBLE_COMPLEX:
         {
-            double2* data = (double2*) xcorr_ptr + (num_baselines * local_slice_idx);
-            for (a1 = 0, b = 0; a1 < num_stations; ++a1)
+            const double* st_std = oskar_mem_double_const(station_std_dev, status);
+            if (have_crosscorr)
             {
-                for (a2 = a1 + 1; a2 < num_stations; ++b, ++a2)
-                {
-                    oskar_random_gaussian2(seed, c++, global_slice_idx, rnd);
-                    const double std = sqrt(st_std[a1] * st_std[a2]) * inv_sqrt2;
-                    data[b].x += std * rnd[0];
-                    data[b].y += std * rnd[1];
-                }
+                vis_noise_cross_c_double(seed, slice, num_stations,
+                        num_baselines, offset_xc, st_std,
+                        oskar_mem_double2(xcorr, status));
             }
+            if (have_autocorr)
+            {
+                vis_noise_auto_c_double(seed, slice, counter_offset,
+                        num_stations, sefd_factor, offset_ac, st_std,
+                        oskar_mem_double2(acorr, status));
+            }
+            break;
         }
-
-        if (have_autocorr)
+        case OSKAR_DOUBLE_COMPLEX_MATRIX:
         {
-            /* Autocorrelation noise. Phases are all zero after
-             * autocorrelation, so ignore the imaginary components. */
-            double2* data = (double2*) acorr_ptr + (num_stations * local_slice_idx);
-            for (a1 = 0; a1 < num_stations; ++a1)
+            const double* st_std = oskar_mem_double_const(station_std_dev, status);
+            if (have_crosscorr)
+            {
+                vis_noise_cross_m_double(seed, slice, num_stations,
+                        num_baselines, offset_xc, st_std,
+                        oskar_mem_double4c(xcorr, status));
+            }
+            if (have_autocorr)
             {
-                oskar_random_gaussian2(seed, c++, global_slice_idx, rnd);
-                const double std  = st_std[a1];
-                const double mean = st_std[a1] * sefd_factor * sqrt(2.0);
-                data[a1].x += std * rnd[0] + mean;
+                vis_noise_auto_m_double(seed, slice, counter_offset,
+                        num_stations, sefd_factor, offset_ac, st_std,
+                        oskar_mem_double4c(acorr, status));
             }
+            break;
+        }
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
         }
-        break;
     }
-    case OSKAR_DOUBLE_COMPLEX_MATRIX:
+    else if (location == OSKAR_GPU)
     {
-        const double* st_std = oskar_mem_double_const(station_std_dev, status);
+        size_t local_size[] = {256, 1, 1}, global_size[] = {1, 1, 1};
+        const char *k_xc = 0, *k_ac = 0;
+        switch (type)
+        {
+        case OSKAR_SINGLE_COMPLEX:
+            k_xc = "vis_noise_cross_c_float";
+            k_ac = "vis_noise_auto_c_float";
+            break;
+        case OSKAR_SINGLE_COMPLEX_MATRIX:
+            k_xc = "vis_noise_cross_m_float";
+            k_ac = "vis_noise_auto_m_float";
+            break;
+        case OSKAR_DOUBLE_COMPLEX:
+            k_xc = "vis_noise_cross_c_double";
+            k_ac = "vis_noise_auto_c_double";
+            break;
+        case OSKAR_DOUBLE_COMPLEX_MATRIX:
+            k_xc = "vis_noise_cross_m_double";
+            k_ac = "vis_noise_auto_m_double";
+            break;
+        default:
+            *status = OSKAR_ERR_BAD_DATA_TYPE;
+            return;
+        }
+        oskar_Mem* st_std = oskar_mem_create_copy(station_std_dev,
+                location, status);
+        oskar_device_check_local_size(location, 0, local_size);
         if (have_crosscorr)
         {
-            double4c* data = (double4c*) xcorr_ptr + (num_baselines * local_slice_idx);
-            for (a1 = 0, b = 0; a1 < num_stations; ++a1)
-            {
-                for (a2 = a1 + 1; a2 < num_stations; ++b, ++a2)
-                {
-                    oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd);
-                    oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd + 4);
-                    const double std = sqrt(st_std[a1] * st_std[a2]);
-                    data[b].a.x += std * rnd[0];
-                    data[b].a.y += std * rnd[1];
-                    data[b].b.x += std * rnd[2];
-                    data[b].b.y += std * rnd[3];
-                    data[b].c.x += std * rnd[4];
-                    data[b].c.y += std * rnd[5];
-                    data[b].d.x += std * rnd[6];
-                    data[b].d.y += std * rnd[7];
-                }
-            }
+            const oskar_Arg args[] = {
+                    {INT_SZ, &seed},
+                    {INT_SZ, &slice},
+                    {INT_SZ, &num_stations},
+                    {INT_SZ, &num_baselines},
+                    {INT_SZ, &offset_xc},
+                    {PTR_SZ, oskar_mem_buffer_const(st_std)},
+                    {PTR_SZ, oskar_mem_buffer(xcorr)}
+            };
+            global_size[0] = oskar_device_global_size(
+                    (size_t) num_baselines, local_size[0]);
+            oskar_device_launch_kernel(k_xc, location, 1,
+                    local_size, global_size,
+                    sizeof(args) / sizeof(oskar_Arg), args, 0, 0, status);
         }
-
         if (have_autocorr)
         {
-            /* Autocorrelation noise. Phases are all zero after
-             * autocorrelation, so ignore the imaginary components. */
-            double4c* data = (double4c*) acorr_ptr + (num_stations * local_slice_idx);
-            for (a1 = 0; a1 < num_stations; ++a1)
-            {
-                oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd);
-                oskar_random_gaussian4(seed, c++, global_slice_idx, 0, 0, rnd + 4);
-                const double std  = st_std[a1] * sqrt(2.0);
-                const double mean = std * sefd_factor;
-                data[a1].a.x += std * rnd[0] + mean;
-                data[a1].b.x += std * rnd[1];
-                data[a1].b.y += std * rnd[2];
-                data[a1].c.x += std * rnd[3];
-                data[a1].c.y += std * rnd[4];
-                data[a1].d.x += std * rnd[5] + mean;
-            }
+            const oskar_Arg args[] = {
+                    {INT_SZ, &seed},
+                    {INT_SZ, &slice},
+                    {INT_SZ, &counter_offset},
+                    {INT_SZ, &num_stations},
+                    {DBL_SZ, &sefd_factor},
+                    {INT_SZ, &offset_ac},
+                    {PTR_SZ, oskar_mem_buffer_const(st_std)},
+                    {PTR_SZ, oskar_mem_buffer(acorr)}
+            };
+            global_size[0] = oskar_device_global_size(
+                    (size_t) num_stations, local_size[0]);
+            oskar_device_launch_kernel(k_ac, location, 1,
+                    local_size, global_size,
+                    sizeof(args) / sizeof(oskar_Arg), args, 0, 0, status);
         }
-        break;
+        oskar_mem_free(st_std, status);
+    }
+    else
+    {
+        /* There is no OpenCL version of the random number generator. */
+        *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
     }
-    };
 }
 
 void oskar_vis_block_add_system_noise(oskar_VisBlock* vis,
@@ -242,9 +246,10 @@ void oskar_vis_block_add_system_noise(oskar_VisBlock* vis,
     double channel_bandwidth_hz = 0.0, time_int_sec = 0.0;
     if (*status) return;
 
-    /* Check baseline dimensions match. */
-    if (oskar_telescope_num_baselines(telescope) !=
-            oskar_vis_block_num_baselines(vis))
+    /* Check station dimensions match.
+     * (The block has no baselines if it holds only autocorrelations.) */
+    if (oskar_telescope_num_stations(telescope) !=
+            oskar_vis_block_num_stations(vis))
     {
         *status = OSKAR_ERR_DIMENSION_MISMATCH;
         return;
@@ -16,58 +16,105 @@ extern "C" {
 
 #define D2R (M_PI / 180.0)
 
-#define ASSEMBLE_ALL_FOR_TIME(FP, FP2, FP4c) {\
-    unsigned int a1 = 0, a2 = 0, b = 0, c = 0, j = 0;\
-    if (start_chan_index == 0) {\
-        /* Assemble baseline coordinates. */\
-        for (a1 = 0, b = 0, j = 0; a1 < num_stations; ++a1) {\
-            if (have_auto) {\
-                ((FP*)uu_out)[j] = ((FP*)vv_out)[j] = ((FP*)ww_out)[j] = 0.0;\
-                ++j;\
-            }\
-            if (have_cross) {\
-                for (a2 = a1 + 1; a2 < num_stations; ++a2, ++b, ++j) {\
-                    const unsigned int i = num_baseln_in * t + b;\
-                    ((FP*)uu_out)[j] = ((const FP*)uu_in)[i];\
-                    ((FP*)vv_out)[j] = ((const FP*)vv_in)[i];\
-                    ((FP*)ww_out)[j] = ((const FP*)ww_in)[i];\
-                }\
-            }\
+/* Number of baselines copied for all channels before moving on,
+ * to keep the output in cache while transposing. */
+#define TILE_SIZE 64
+
+/* Copies one visibility, converting to single precision, and
+ * expanding scalar values to a diagonal matrix if required. */
+#define COPY_VIS(OUT, IN) {\
+        if (n_in == n_out) {\
+            for (p = 0; p < n_in; ++p) (OUT)[p] = (float) (IN)[p];\
+        } else {\
+            (OUT)[0] = (OUT)[6] = (float) (IN)[0];\
+            (OUT)[1] = (OUT)[7] = (float) (IN)[1];\
+            (OUT)[2] = (OUT)[3] = (OUT)[4] = (OUT)[5] = 0.0f;\
+        }}
+
+/*
+ * Copies the visibilities for one station and time into a block in
+ * Measurement Set order, with polarisation the fastest varying dimension,
+ * then channel, then row.
+ *
+ * The station gives a contiguous run of output rows (its autocorrelation,
+ * then its cross-correlations with later stations), which is copied from
+ * contiguous input data for each channel, in tiles of baselines.
+ */
+#define ASSEMBLE_VIS(NAME, FP) \
+static void NAME(unsigned int t, unsigned int a1,\
+        unsigned int num_channels, unsigned int num_stations,\
+        unsigned int num_baseln_in, unsigned int num_baseln_out,\
+        unsigned int n_in, unsigned int n_out,\
+        unsigned int have_auto, unsigned int have_cross,\
+        const FP* acorr, const FP* xcorr, float* out)\
+{\
+    unsigned int c = 0, k = 0, k0 = 0, p = 0;\
+    const unsigned int num_auto = have_auto ? 1 : 0;\
+    const unsigned int num_cross = have_cross ? num_stations - a1 - 1 : 0;\
+    const unsigned int b_in = have_cross ?\
+            a1 * (num_stations - 1) - (a1 * (a1 - 1)) / 2 : 0;\
+    const size_t row0 = (size_t) t * num_baseln_out + num_auto * a1 + b_in;\
+    if (have_auto)\
+    {\
+        for (c = 0; c < num_channels; ++c)\
+        {\
+            const FP* in = acorr + n_in * ((size_t) num_stations *\
+                    (t * num_channels + c) + a1);\
+            float* o = out + n_out * (row0 * num_channels + c);\
+            COPY_VIS(o, in)\
         }\
     }\
-    /* Assemble visibilities. */\
-    for (c = 0, j = 0; c < num_channels; ++c) {\
-        const unsigned int ia = num_stations * (t * num_channels + c);\
-        const unsigned int ix = num_baseln_in * (t * num_channels + c);\
-        if (num_pols_in == 4) ASSEMBLE_VIS(FP4c)\
-        else if (num_pols_out == 1) ASSEMBLE_VIS(FP2)\
-        else {\
-            FP2 zero; zero.x = zero.y = 0.0;\
-            for (a1 = 0, b = 0; a1 < num_stations; ++a1) {\
-                if (have_auto) COPY_SCALAR(FP2, acorr, ia + a1)\
-                if (have_cross)\
-                    for (a2 = a1 + 1; a2 < num_stations; ++b, ++a2)\
-                        COPY_SCALAR(FP2, xcorr, ix + b)\
+    for (k0 = 0; k0 < num_cross; k0 += TILE_SIZE)\
+    {\
+        const unsigned int k1 = (k0 + TILE_SIZE < num_cross) ?\
+                k0 + TILE_SIZE : num_cross;\
+        for (c = 0; c < num_channels; ++c)\
+        {\
+            const FP* in = xcorr + n_in * ((size_t) num_baseln_in *\
+                    (t * num_channels + c) + b_in);\
+            float* o = out + n_out * ((row0 + num_auto) * num_channels + c);\
+            for (k = k0; k < k1; ++k)\
+            {\
+                COPY_VIS(o + (size_t) n_out * num_channels * k, in + n_in * k)\
             }\
         }\
     }\
 }
 
-#define ASSEMBLE_VIS(T) {\
-            for (a1 = 0, b = 0; a1 < num_stations; ++a1) {\
-                if (have_auto) ((T*)out)[j++] = ((const T*)acorr)[ia + a1];\
-                if (have_cross)\
-                    for (a2 = a1 + 1; a2 < num_stations; ++b, ++a2)\
-                        ((T*)out)[j++] = ((const T*)xcorr)[ix + b];\
+ASSEMBLE_VIS(assemble_vis_f, float)
+ASSEMBLE_VIS(assemble_vis_d, double)
+
+/* Assembles the baseline coordinates for one time, in double precision,
+ * with zeros for the autocorrelations. */
+#define ASSEMBLE_COORDS(NAME, FP) \
+static void NAME(unsigned int t, unsigned int num_stations,\
+        unsigned int num_baseln_in, unsigned int have_auto,\
+        unsigned int have_cross, const FP* uu_in, const FP* vv_in,\
+        const FP* ww_in, double* uu_out, double* vv_out, double* ww_out)\
+{\
+    unsigned int a1 = 0, a2 = 0, b = 0, j = 0;\
+    for (a1 = 0, b = 0, j = 0; a1 < num_stations; ++a1)\
+    {\
+        if (have_auto)\
+        {\
+            uu_out[j] = vv_out[j] = ww_out[j] = 0.0;\
+            ++j;\
+        }\
+        if (have_cross)\
+        {\
+            for (a2 = a1 + 1; a2 < num_stations; ++a2, ++b, ++j)\
+            {\
+                const size_t i = (size_t) num_baseln_in * t + b;\
+                uu_out[j] = uu_in[i];\
+                vv_out[j] = vv_in[i];\
+                ww_out[j] = ww_in[i];\
             }\
         }\
+    }\
+}
 
-#define COPY_SCALAR(FP2, DATA, IDX) {\
-                    const FP2 val = ((const FP2*)DATA)[IDX];\
-                    ((FP2*)out)[j + 0] = val;  ((FP2*)out)[j + 1] = zero;\
-                    ((FP2*)out)[j + 2] = zero; ((FP2*)out)[j + 3] = val;\
-                    j += 4;\
-                }\
+ASSEMBLE_COORDS(assemble_coords_f, float)
+ASSEMBLE_COORDS(assemble_coords_d, double)
 
 
 void oskar_vis_block_write_ms(const oskar_VisBlock* blk,
@@ -75,18 +122,19 @@ void oskar_vis_block_write_ms(const oskar_VisBlock* blk,
 {
     const oskar_Mem *in_acorr = 0, *in_xcorr = 0;
     const oskar_Mem *in_uu = 0, *in_vv = 0, *in_ww = 0;
-    oskar_Mem *temp_vis = 0, *temp_uu = 0, *temp_vv = 0, *temp_ww = 0;
+    const double *acorr_d = 0, *xcorr_d = 0;
+    const float *acorr_f = 0, *xcorr_f = 0;
+    float *vis_out = 0;
+    double *coords = 0, *uu_out = 0, *vv_out = 0, *ww_out = 0;
     double exposure_sec = 0.0, interval_sec = 0.0;
     double t_start_mjd = 0.0, t_start_sec = 0.0;
     double lon_rad = 0.0, lat_rad = 0.0, freq_start_hz = 0.0;
-    int coord_type = 0;
+    int coord_type = 0, i = 0, num_runs = 0;
     unsigned int num_baseln_in = 0, num_baseln_out = 0, num_channels = 0;
     unsigned int num_pols_in = 0, num_pols_out = 0;
     unsigned int num_stations = 0, num_times = 0, t = 0;
     unsigned int prec = 0, start_time_index = 0, start_chan_index = 0;
-    unsigned int have_auto = 0, have_cross = 0;
-    const void *uu_in = 0, *vv_in = 0, *ww_in = 0, *xcorr = 0, *acorr = 0;
-    void *uu_out = 0, *vv_out = 0, *ww_out = 0, *out = 0;
+    unsigned int have_auto = 0, have_cross = 0, num_rows = 0, row0 = 0;
     if (*status) return;
 
     /* Pull data from visibility structures. */
@@ -157,75 +205,89 @@ void oskar_vis_block_write_ms(const oskar_VisBlock* blk,
         return;
     }
 
-    /* Write visibilities and (u,v,w) coordinates. */
-    temp_vis = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
-            num_baseln_out * num_channels * num_pols_out, status);
-    temp_uu = oskar_mem_create(prec, OSKAR_CPU, num_baseln_out, status);
-    temp_vv = oskar_mem_create(prec, OSKAR_CPU, num_baseln_out, status);
-    temp_ww = oskar_mem_create(prec, OSKAR_CPU, num_baseln_out, status);
-    out     = oskar_mem_void(temp_vis);
-    uu_out  = oskar_mem_void(temp_uu);
-    vv_out  = oskar_mem_void(temp_vv);
-    ww_out  = oskar_mem_void(temp_ww);
-    xcorr   = oskar_mem_void_const(in_xcorr);
-    acorr   = oskar_mem_void_const(in_acorr);
-    uu_in   = oskar_mem_void_const(in_uu);
-    vv_in   = oskar_mem_void_const(in_vv);
-    ww_in   = oskar_mem_void_const(in_ww);
+    /* Assemble all the visibilities in the block directly in
+     * Measurement Set order, in a buffer owned by the Measurement Set,
+     * and write them with a single call. */
+    num_rows = num_times * num_baseln_out;
+    row0 = start_time_index * num_baseln_out;
+    vis_out = oskar_ms_vis_buffer(ms, num_rows, num_channels);
+    if (!vis_out)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
     if (prec == OSKAR_DOUBLE)
     {
-        for (t = 0; t < num_times; ++t)
-        {
-            /* Assemble the baseline coordinates and all visibilities
-             * for the given time. */
-            ASSEMBLE_ALL_FOR_TIME(double, double2, double4c)
-            const unsigned int row0 = (start_time_index + t) * num_baseln_out;
-            oskar_ms_write_vis_d(ms, row0, start_chan_index,
-                    num_channels, num_baseln_out, (double*)out);
-
-            /* Only write the coordinates for the first channel. */
-            if (start_chan_index == 0)
-            {
-                oskar_ms_write_coords_d(ms, row0, num_baseln_out,
-                        (double*)uu_out, (double*)vv_out, (double*)ww_out,
-                        exposure_sec, interval_sec,
-                        (start_time_index + t + 0.5) * interval_sec +
-                        t_start_sec);
-            }
-        }
+        acorr_d = oskar_mem_double_const(in_acorr, status);
+        xcorr_d = oskar_mem_double_const(in_xcorr, status);
     }
     else if (prec == OSKAR_SINGLE)
     {
-        for (t = 0; t < num_times; ++t)
-        {
-            /* Assemble the baseline coordinates and all visibilities
-             * for the given time. */
-            ASSEMBLE_ALL_FOR_TIME(float, float2, float4c)
-            const unsigned int row0 = (start_time_index + t) * num_baseln_out;
-            oskar_ms_write_vis_f(ms, row0, start_chan_index,
-                    num_channels, num_baseln_out, (float*)out);
-
-            /* Only write the coordinates for the first channel. */
-            if (start_chan_index == 0)
-            {
-                oskar_ms_write_coords_f(ms, row0, num_baseln_out,
-                        (float*)uu_out, (float*)vv_out, (float*)ww_out,
-                        exposure_sec, interval_sec,
-                        (start_time_index + t + 0.5) * interval_sec +
-                        t_start_sec);
-            }
-        }
+        acorr_f = oskar_mem_float_const(in_acorr, status);
+        xcorr_f = oskar_mem_float_const(in_xcorr, status);
     }
     else
     {
         *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+    num_runs = (int) (num_times * num_stations);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i = 0; i < num_runs; ++i)
+    {
+        const unsigned int t = i / num_stations, a1 = i % num_stations;
+        if (prec == OSKAR_DOUBLE)
+        {
+            assemble_vis_d(t, a1, num_channels, num_stations, num_baseln_in,
+                    num_baseln_out, 2 * num_pols_in, 2 * num_pols_out,
+                    have_auto, have_cross, acorr_d, xcorr_d, vis_out);
+        }
+        else
+        {
+            assemble_vis_f(t, a1, num_channels, num_stations, num_baseln_in,
+                    num_baseln_out, 2 * num_pols_in, 2 * num_pols_out,
+                    have_auto, have_cross, acorr_f, xcorr_f, vis_out);
+        }
     }
+    oskar_ms_write_vis_rows_f(ms, row0, start_chan_index,
+            num_channels, num_rows, vis_out);
 
-    /* Cleanup. */
-    oskar_mem_free(temp_vis, status);
-    oskar_mem_free(temp_uu, status);
-    oskar_mem_free(temp_vv, status);
-    oskar_mem_free(temp_ww, status);
+    /* Only write the coordinates for the first channel. */
+    if (start_chan_index != 0) return;
+    coords = oskar_ms_coord_buffer(ms, num_baseln_out);
+    if (!coords)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    uu_out = coords;
+    vv_out = coords + num_baseln_out;
+    ww_out = coords + 2 * num_baseln_out;
+    for (t = 0; t < num_times; ++t)
+    {
+        if (prec == OSKAR_DOUBLE)
+        {
+            assemble_coords_d(t, num_stations, num_baseln_in,
+                    have_auto, have_cross,
+                    oskar_mem_double_const(in_uu, status),
+                    oskar_mem_double_const(in_vv, status),
+                    oskar_mem_double_const(in_ww, status),
+                    uu_out, vv_out, ww_out);
+        }
+        else
+        {
+            assemble_coords_f(t, num_stations, num_baseln_in,
+                    have_auto, have_cross,
+                    oskar_mem_float_const(in_uu, status),
+                    oskar_mem_float_const(in_vv, status),
+                    oskar_mem_float_const(in_ww, status),
+                    uu_out, vv_out, ww_out);
+        }
+        oskar_ms_write_coords_d(ms, row0 + t * num_baseln_out,
+                num_baseln_out, uu_out, vv_out, ww_out,
+                exposure_sec, interval_sec,
+                (start_time_index + t + 0.5) * interval_sec + t_start_sec);
+    }
 }
 
 #ifdef __cplusplus
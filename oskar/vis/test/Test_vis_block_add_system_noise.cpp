@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/oskar_find_closest_match.h"
+#include "math/oskar_random_gaussian.h"
+#include "telescope/oskar_telescope.h"
+#include "utility/oskar_get_error_string.h"
+#include "vis/oskar_vis_block.h"
+#include "vis/oskar_vis_header.h"
+
+#include <cfloat>
+#include <cmath>
+
+// The original serial version, which increments a single counter.
+template <typename FP>
+static void apply_noise_serial(oskar_VisBlock* vis, const FP* st_std,
+        unsigned int seed, int global_slice, int local_slice,
+        double sefd_factor)
+{
+    double rnd[8];
+    unsigned int c = 0;
+    const double inv_sqrt2 = 1.0 / sqrt(2.0);
+    const int num_stations = oskar_vis_block_num_stations(vis);
+    const int num_baselines = oskar_vis_block_num_baselines(vis);
+    oskar_Mem* xcorr = oskar_vis_block_cross_correlations(vis);
+    oskar_Mem* acorr = oskar_vis_block_auto_correlations(vis);
+    const int n = oskar_mem_is_matrix(xcorr) ? 8 : 2;
+    if (oskar_vis_block_has_cross_correlations(vis))
+    {
+        FP* data = (FP*) oskar_mem_void(xcorr) +
+                n * num_baselines * local_slice;
+        for (int a1 = 0, b = 0; a1 < num_stations; ++a1)
+        {
+            for (int a2 = a1 + 1; a2 < num_stations; ++b, ++a2)
+            {
+                const double std = sqrt((double) (st_std[a1] * st_std[a2]));
+                if (n == 8)
+                {
+                    oskar_random_gaussian4(seed, c++, global_slice, 0, 0, rnd);
+                    oskar_random_gaussian4(seed, c++, global_slice, 0, 0,
+                            rnd + 4);
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        data[8 * b + k] += std * rnd[k];
+                    }
+                }
+                else
+                {
+                    oskar_random_gaussian2(seed, c++, global_slice, rnd);
+                    data[2 * b]     += std * inv_sqrt2 * rnd[0];
+                    data[2 * b + 1] += std * inv_sqrt2 * rnd[1];
+                }
+            }
+        }
+    }
+    if (oskar_vis_block_has_auto_correlations(vis))
+    {
+        FP* data = (FP*) oskar_mem_void(acorr) +
+                n * num_stations * local_slice;
+        for (int a1 = 0; a1 < num_stations; ++a1)
+        {
+            if (n == 8)
+            {
+                oskar_random_gaussian4(seed, c++, global_slice, 0, 0, rnd);
+                oskar_random_gaussian4(seed, c++, global_slice, 0, 0, rnd + 4);
+                const double std = st_std[a1] * sqrt(2.0);
+                const double mean = std * sefd_factor;
+                data[8 * a1]     += std * rnd[0] + mean;
+                data[8 * a1 + 2] += std * rnd[1];
+                data[8 * a1 + 3] += std * rnd[2];
+                data[8 * a1 + 4] += std * rnd[3];
+                data[8 * a1 + 5] += std * rnd[4];
+                data[8 * a1 + 6] += std * rnd[5] + mean;
+            }
+            else
+            {
+                oskar_random_gaussian2(seed, c++, global_slice, rnd);
+                const double std = st_std[a1];
+                if (sizeof(FP) == sizeof(float))
+                {
+                    const double mean = sqrt(2.0) * st_std[a1];
+                    data[2 * a1] += std * rnd[0] + mean * sefd_factor;
+                }
+                else
+                {
+                    const double mean = st_std[a1] * sefd_factor * sqrt(2.0);
+                    data[2 * a1] += std * rnd[0] + mean;
+                }
+            }
+        }
+    }
+}
+
+static void check_noise(int precision, int matrix, int autocorr, int xcorr)
+{
+    int status = 0;
+    const int num_stations = 37, num_times = 3, num_channels = 2;
+    const int start_time = 4, start_channel = 1, num_channels_total = 5;
+    const double freq_start_hz = 100e6, freq_inc_hz = 10e6;
+    const double bandwidth_hz = 1e4, time_average_sec = 2.0;
+    const unsigned int seed = 42;
+    const int amp_type = precision | OSKAR_COMPLEX |
+            (matrix ? OSKAR_MATRIX : 0);
+
+    // Create a telescope model with different noise for each station.
+    oskar_Telescope* tel = oskar_telescope_create(precision, OSKAR_CPU,
+            num_stations, &status);
+    oskar_telescope_resize_station_array(tel, num_stations, &status);
+    int* type_map = oskar_mem_int(
+            oskar_telescope_station_type_map(tel), &status);
+    for (int i = 0; i < num_stations; ++i) type_map[i] = i;
+    oskar_telescope_set_enable_noise(tel, 1, seed);
+    oskar_telescope_set_noise_freq(tel, freq_start_hz, freq_inc_hz,
+            num_channels_total, &status);
+    oskar_telescope_set_noise_rms(tel, 1.0, 2.0, &status);
+    for (int i = 0; i < num_stations; ++i)
+    {
+        oskar_mem_scale_real(oskar_station_noise_rms_jy(
+                oskar_telescope_station(tel, i)), 1.0 + 0.1 * i,
+                0, num_channels_total, &status);
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create two identical visibility blocks.
+    oskar_VisHeader* hdr = oskar_vis_header_create(amp_type, precision,
+            num_times, 10, num_channels, num_channels_total, num_stations,
+            autocorr, xcorr, &status);
+    oskar_vis_header_set_freq_start_hz(hdr, freq_start_hz);
+    oskar_vis_header_set_freq_inc_hz(hdr, freq_inc_hz);
+    oskar_vis_header_set_channel_bandwidth_hz(hdr, bandwidth_hz);
+    oskar_vis_header_set_time_average_sec(hdr, time_average_sec);
+    oskar_VisBlock* blk[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        blk[i] = oskar_vis_block_create_from_header(OSKAR_CPU, hdr, &status);
+        oskar_vis_block_set_start_time_index(blk[i], start_time);
+        oskar_vis_block_set_start_channel_index(blk[i], start_channel);
+        oskar_mem_random_uniform(oskar_vis_block_cross_correlations(blk[i]),
+                1, 2, 3, 4, &status);
+        oskar_mem_random_uniform(oskar_vis_block_auto_correlations(blk[i]),
+                5, 6, 7, 8, &status);
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Add noise to the first block.
+    oskar_Mem* work = oskar_mem_create(precision, OSKAR_CPU, 0, &status);
+    oskar_vis_block_add_system_noise(blk[0], hdr, tel, work, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Add noise to the second block using the serial version.
+    oskar_Mem* st_std = oskar_mem_create(precision, OSKAR_CPU,
+            num_stations, &status);
+    const double sefd_factor = sqrt(2.0 * bandwidth_hz * time_average_sec);
+    for (int c = 0; c < num_channels; ++c)
+    {
+        const int channel = c + start_channel;
+        const double freq_hz = freq_start_hz + channel * freq_inc_hz;
+        for (int i = 0; i < num_stations; ++i)
+        {
+            const oskar_Station* s = oskar_telescope_station_const(tel, i);
+            const int j = oskar_find_closest_match(freq_hz,
+                    oskar_station_noise_freq_hz_const(s), &status);
+            oskar_mem_copy_contents(st_std,
+                    oskar_station_noise_rms_jy_const(s), i, j, 1, &status);
+        }
+        for (int t = 0; t < num_times; ++t)
+        {
+            const int local_slice = t * num_channels + c;
+            const int global_slice =
+                    (t + start_time) * num_channels_total + channel;
+            if (precision == OSKAR_DOUBLE)
+            {
+                apply_noise_serial(blk[1],
+                        oskar_mem_double_const(st_std, &status), seed,
+                        global_slice, local_slice, sefd_factor);
+            }
+            else
+            {
+                apply_noise_serial(blk[1],
+                        oskar_mem_float_const(st_std, &status), seed,
+                        global_slice, local_slice, sefd_factor);
+            }
+        }
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Check that the results are identical.
+    // Single-precision scalar autocorrelations may differ in the last bit,
+    // as the mean is not added in the same order, so allow a few ULP.
+    EXPECT_EQ(0, oskar_mem_different(
+            oskar_vis_block_cross_correlations(blk[0]),
+            oskar_vis_block_cross_correlations(blk[1]), 0, &status));
+    if (autocorr && precision == OSKAR_SINGLE)
+    {
+        double min_err = 0.0, max_err = 0.0, avg_err = 0.0, std_err = 0.0;
+        oskar_mem_evaluate_relative_error(
+                oskar_vis_block_auto_correlations(blk[0]),
+                oskar_vis_block_auto_correlations(blk[1]),
+                &min_err, &max_err, &avg_err, &std_err, &status);
+        EXPECT_LE(max_err, 4.0 * FLT_EPSILON);
+    }
+    else
+    {
+        EXPECT_EQ(0, oskar_mem_different(
+                oskar_vis_block_auto_correlations(blk[0]),
+                oskar_vis_block_auto_correlations(blk[1]), 0, &status));
+    }
+
+    // Check that some noise was actually added.
+    oskar_VisBlock* blk_orig = oskar_vis_block_create_from_header(OSKAR_CPU,
+            hdr, &status);
+    oskar_mem_random_uniform(oskar_vis_block_cross_correlations(blk_orig),
+            1, 2, 3, 4, &status);
+    oskar_mem_random_uniform(oskar_vis_block_auto_correlations(blk_orig),
+            5, 6, 7, 8, &status);
+    if (xcorr)
+    {
+        EXPECT_NE(0, oskar_mem_different(
+                oskar_vis_block_cross_correlations(blk[0]),
+                oskar_vis_block_cross_correlations(blk_orig), 0, &status));
+    }
+    if (autocorr)
+    {
+        EXPECT_NE(0, oskar_mem_different(
+                oskar_vis_block_auto_correlations(blk[0]),
+                oskar_vis_block_auto_correlations(blk_orig), 0, &status));
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    oskar_vis_block_free(blk[0], &status);
+    oskar_vis_block_free(blk[1], &status);
+    oskar_vis_block_free(blk_orig, &status);
+    oskar_vis_header_free(hdr, &status);
+    oskar_telescope_free(tel, &status);
+    oskar_mem_free(work, &status);
+    oskar_mem_free(st_std, &status);
+}
+
+TEST(vis_block_add_system_noise, scalar_double)
+{
+    check_noise(OSKAR_DOUBLE, 0, 1, 1);
+    check_noise(OSKAR_DOUBLE, 0, 0, 1);
+    check_noise(OSKAR_DOUBLE, 0, 1, 0);
+}
+
+TEST(vis_block_add_system_noise, matrix_double)
+{
+    check_noise(OSKAR_DOUBLE, 1, 1, 1);
+    check_noise(OSKAR_DOUBLE, 1, 0, 1);
+    check_noise(OSKAR_DOUBLE, 1, 1, 0);
+}
+
+TEST(vis_block_add_system_noise, scalar_single)
+{
+    check_noise(OSKAR_SINGLE, 0, 1, 1);
+    check_noise(OSKAR_SINGLE, 0, 0, 1);
+    check_noise(OSKAR_SINGLE, 0, 1, 0);
+}
+
+TEST(vis_block_add_system_noise, matrix_single)
+{
+    check_noise(OSKAR_SINGLE, 1, 1, 1);
+    check_noise(OSKAR_SINGLE, 1, 0, 1);
+    check_noise(OSKAR_SINGLE, 1, 1, 0);
+}